@@ -0,0 +1,477 @@
+#! /usr/bin/env python3
+"""
+Monte-Carlo flight test runner for SITL.
+
+Runs many short flights in parallel. Every flight is a px4 SITL instance in
+lockstep with its own shm_sim physics process (SIH rigid body dynamics over the
+shared memory simulator link), so flights run faster than real time and do not
+interfere with each other.
+
+Each flight gets a randomized vehicle (mass, thrust), wind with gusts, sensor
+noise and, with a given probability, a partial motor failure. It takes off,
+holds position and lands. The ground truth metrics written by shm_sim and, if
+pyulog is installed, the tracking error and estimator faults from the flight
+log are collected into report.json and report.csv in the output directory.
+
+The exit code is non-zero if any flight without injected failure failed, so the
+runner can gate a release.
+
+Requires a Linux build of 'make px4_sitl_default', which builds px4 and shm_sim.
+
+Example:
+    ./Tools/montecarlo_run.py -n 200 -j 8 --seed 42
+"""
+
+import argparse
+import csv
+import glob
+import json
+import math
+import os
+import queue
+import random
+import shutil
+import subprocess
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+try:
+    import numpy as np
+    from pyulog import ULog
+except ImportError:
+    ULog = None
+
+MAX_FLIGHTS = 1000
+
+
+def get_arguments():
+    src_path = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+    parser = argparse.ArgumentParser(description='Run randomized SITL flights in parallel and report pass/fail metrics')
+    parser.add_argument('-n', '--flights', type=int, default=100,
+                        help='number of flights, at most {:d}'.format(MAX_FLIGHTS))
+    parser.add_argument('-j', '--jobs', type=int, default=max(1, (os.cpu_count() or 2) // 2),
+                        help='flights running at the same time (each uses two processes)')
+    parser.add_argument('--seed', type=int, default=0, help='seed of the scenario generator')
+    parser.add_argument('--build-path', default=os.path.join(src_path, 'build', 'px4_sitl_default'))
+    parser.add_argument('-o', '--output', default=None,
+                        help='output directory, default <build-path>/montecarlo/<date>')
+    parser.add_argument('--keep', action='store_true', help='keep the working directory (logs) of passed flights')
+
+    scenario = parser.add_argument_group('scenario')
+    scenario.add_argument('--settle-time', type=float, default=10., help='simulated seconds before takeoff')
+    scenario.add_argument('--hover-time', type=float, default=20., help='simulated seconds of position hold')
+    scenario.add_argument('--max-time', type=float, default=120., help='simulated seconds before a flight is aborted')
+    scenario.add_argument('--mass-var', type=float, default=0.1, help='relative mass and inertia variation')
+    scenario.add_argument('--thrust-var', type=float, default=0.05, help='relative motor thrust variation')
+    scenario.add_argument('--wind-max', type=float, default=5., help='maximum mean wind speed [m/s]')
+    scenario.add_argument('--gust-max', type=float, default=1.5, help='maximum gust standard deviation [m/s]')
+    scenario.add_argument('--noise-max', type=float, default=2., help='maximum sensor noise scale')
+    scenario.add_argument('--failure-prob', type=float, default=0.1,
+                          help='probability of a partial motor failure during the hold')
+
+    limits = parser.add_argument_group('pass criteria')
+    limits.add_argument('--max-landing-error', type=float, default=1.5, help='[m] from the takeoff point')
+    limits.add_argument('--max-drift', type=float, default=3., help='[m] horizontal distance to the takeoff point')
+    limits.add_argument('--max-tilt', type=float, default=35., help='[deg]')
+    limits.add_argument('--max-touchdown-speed', type=float, default=2., help='[m/s]')
+    limits.add_argument('--max-tracking-rms', type=float, default=1., help='[m] estimate to setpoint, needs pyulog')
+
+    args = parser.parse_args()
+    args.src_path = src_path
+
+    if not 0 < args.flights <= MAX_FLIGHTS:
+        parser.error('the number of flights must be in [1, {:d}]'.format(MAX_FLIGHTS))
+
+    if args.jobs < 1:
+        parser.error('at least one job is needed')
+
+    if args.output is None:
+        args.output = os.path.join(args.build_path, 'montecarlo', time.strftime('%Y-%m-%d_%H-%M-%S'))
+
+    return args
+
+
+def sample_scenario(args, index):
+    """ Randomized flight conditions, reproducible from the run seed and the flight index. """
+    rng = random.Random(args.seed * 100003 + index)
+    wind_speed = rng.uniform(0., args.wind_max)
+    wind_dir = rng.uniform(0., 2. * math.pi)
+
+    scenario = {
+        'seed': rng.randrange(1, 2 ** 32),
+        'mass_scale': round(rng.uniform(1. - args.mass_var, 1. + args.mass_var), 4),
+        'thrust_scale': round(rng.uniform(1. - args.thrust_var, 1. + args.thrust_var), 4),
+        'wind_n': round(wind_speed * math.cos(wind_dir), 3),
+        'wind_e': round(wind_speed * math.sin(wind_dir), 3),
+        'gust': round(rng.uniform(0., args.gust_max), 3),
+        'noise_scale': round(rng.uniform(0., args.noise_max), 3),
+        'failed_motor': -1,
+        'failure_time_s': 0.,
+        'failure_efficiency': 1.,
+    }
+
+    if rng.random() < args.failure_prob:
+        scenario['failed_motor'] = rng.randrange(4)
+        scenario['failure_time_s'] = round(args.settle_time + rng.uniform(5., 5. + args.hover_time), 2)
+        scenario['failure_efficiency'] = round(rng.uniform(0.5, 0.9), 3)
+
+    return scenario
+
+
+def analyse_ulog(path):
+    """ Tracking error and estimator faults from the flight log. """
+    ulog = ULog(path, ['vehicle_local_position', 'vehicle_local_position_setpoint', 'estimator_status'])
+    data = {d.name: d.data for d in ulog.data_list if d.multi_id == 0}
+    metrics = {}
+
+    if 'estimator_status' in data:
+        status = data['estimator_status']
+        metrics['filter_faults_max'] = int(np.amax(status['filter_fault_flags']))
+        metrics['innovation_fail_ratio'] = round(float(np.mean(status['innovation_check_flags'] != 0)), 4)
+
+    if 'vehicle_local_position' in data and 'vehicle_local_position_setpoint' in data:
+        pos = data['vehicle_local_position']
+        sp = data['vehicle_local_position_setpoint']
+        idx = np.clip(np.searchsorted(pos['timestamp'], sp['timestamp']), 0, len(pos['timestamp']) - 1)
+        err_sq = sum((sp[axis] - pos[axis][idx]) ** 2 for axis in ('x', 'y', 'z'))
+        err_sq = err_sq[np.isfinite(err_sq)]
+
+        if len(err_sq) > 0:
+            metrics['tracking_rms_m'] = round(float(np.sqrt(np.mean(err_sq))), 3)
+
+    return metrics
+
+
+class Flight:
+    def __init__(self, args, index, slot):
+        self.args = args
+        self.index = index
+        self.slot = slot
+        self.scenario = sample_scenario(args, index)
+        self.directory = os.path.join(args.output, 'flight_{:04d}'.format(index))
+        self.bin_path = os.path.join(args.build_path, 'bin')
+
+        self._lock = threading.Lock()
+        self._sim_time = 0.
+        self._flown = False
+        self._landed = False
+        self._takeoff_time = 0.
+
+    def _read_sim_output(self, stream, log):
+        for line in stream:
+            log.write(line)
+
+            if line.startswith('shm_sim: t=') and ' flown=' in line:
+                fields = dict(field.split('=') for field in line[len('shm_sim: '):].split())
+
+                with self._lock:
+                    self._sim_time = float(fields['t'])
+
+                    if fields['flown'] == '1' and not self._flown:
+                        self._flown = True
+                        self._takeoff_time = self._sim_time
+
+                    self._landed = fields['landed'] == '1'
+
+    def _state(self):
+        with self._lock:
+            return self._sim_time, self._flown, self._landed
+
+    def _wait_sim_time(self, sim_time, sim, condition=None):
+        """ Wait until the simulation reaches sim_time or condition() holds, False if shm_sim exited. """
+        while sim.poll() is None:
+            if self._state()[0] >= sim_time or (condition is not None and condition()):
+                return True
+
+            time.sleep(0.05)
+
+        return False
+
+    def _command(self, *command):
+        cmd = [os.path.join(self.bin_path, 'px4-' + command[0]), '--instance', str(self.slot)] + list(command[1:])
+        return subprocess.call(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, timeout=10) == 0
+
+    def _fly(self, sim):
+        args = self.args
+
+        # if shm_sim ends early the result file tells what happened
+        if not self._wait_sim_time(args.settle_time, sim):
+            return None
+
+        # the estimator may need a little longer for a position lock, so retry
+        next_try = args.settle_time
+
+        while not self._state()[1]:
+            if self._state()[0] >= next_try:
+                if next_try > args.settle_time + 30.:
+                    return 'no takeoff'
+
+                self._command('commander', 'takeoff')
+                next_try += 5.
+
+            if not self._wait_sim_time(next_try, sim, lambda: self._state()[1]):
+                return None
+
+        if not self._wait_sim_time(self._takeoff_time + args.hover_time, sim, lambda: self._state()[2]):
+            return None
+
+        if not self._state()[2]:
+            self._command('commander', 'land')
+
+        return None
+
+    def run(self):
+        os.makedirs(self.directory, exist_ok=True)
+        result_path = os.path.join(self.directory, 'result.json')
+        s = self.scenario
+        start = time.monotonic()
+
+        env = dict(os.environ)
+        env['PX4_SIM_MODEL'] = 'iris'
+        env['PX4_SIM_SHM'] = '1'
+        env['PX4_PARALLEL_START'] = '1'
+        # a fresh segment per flight: a PX4 or shm_sim left over from the previous flight in this
+        # slot can never attach to the new one
+        shm_name = 'px4_sim_{:d}_{:d}'.format(self.slot, self.index)
+        env['PX4_SIM_SHM_NAME'] = shm_name
+
+        px4_cmd = [os.path.join(self.bin_path, 'px4'), '-i', str(self.slot), '-d',
+                   os.path.join(self.args.src_path, 'ROMFS', 'px4fmu_common'),
+                   '-s', 'etc/init.d-posix/rcS', '-t', os.path.join(self.args.src_path, 'test_data')]
+        sim_cmd = [os.path.join(self.bin_path, 'shm_sim'), '-n', shm_name,
+                   '-d', str(self.args.max_time), '-s', str(s['seed']), '-M', str(s['mass_scale']),
+                   '-T', str(s['thrust_scale']), '-w', '{},{},{}'.format(s['wind_n'], s['wind_e'], s['gust']),
+                   '-N', str(s['noise_scale']), '-o', result_path, '-l', '-p']
+
+        if s['failed_motor'] >= 0:
+            sim_cmd += ['-f', '{},{},{}'.format(s['failed_motor'], s['failure_time_s'], s['failure_efficiency'])]
+
+        with open(os.path.join(self.directory, 'px4.log'), 'w') as px4_log, \
+                open(os.path.join(self.directory, 'sim.log'), 'w') as sim_log:
+            px4 = subprocess.Popen(px4_cmd, cwd=self.directory, env=env, stdout=px4_log, stderr=subprocess.STDOUT)
+            sim = subprocess.Popen(sim_cmd, cwd=self.directory, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                   universal_newlines=True)
+            reader = threading.Thread(target=self._read_sim_output, args=(sim.stdout, sim_log))
+            reader.start()
+
+            try:
+                error = self._fly(sim)
+                # shm_sim ends shortly after landing or at the maximum flight time
+                sim.wait(timeout=max(60., 4. * self.args.max_time))
+
+            except subprocess.TimeoutExpired:
+                error = 'simulation timeout'
+
+            finally:
+                self._stop(px4, sim)
+                reader.join()
+                self._remove_shm(shm_name)
+
+        return self._evaluate(error, result_path, time.monotonic() - start)
+
+    def _stop(self, px4, sim):
+        if sim.poll() is None:
+            sim.terminate()
+
+        if px4.poll() is None:
+            try:
+                self._command('shutdown')
+
+            except subprocess.TimeoutExpired:
+                pass
+
+        for process in (sim, px4):
+            try:
+                process.wait(timeout=10)
+
+            except subprocess.TimeoutExpired:
+                process.kill()
+                process.wait()
+
+    @staticmethod
+    def _remove_shm(name):
+        """ PX4 unlinks the segment on shutdown, but not if it had to be killed. """
+        try:
+            os.remove(os.path.join('/dev/shm', name))
+
+        except OSError:
+            pass
+
+    def _evaluate(self, error, result_path, wall_time):
+        args = self.args
+        reasons = [error] if error else []
+        metrics = {}
+
+        try:
+            with open(result_path) as f:
+                metrics = json.load(f)
+
+        except (IOError, ValueError):
+            reasons.append('no simulation result')
+
+        if ULog is not None:
+            logs = sorted(glob.glob(os.path.join(self.directory, 'log', '**', '*.ulg'), recursive=True))
+
+            if logs:
+                try:
+                    metrics.update(analyse_ulog(logs[-1]))
+
+                except Exception as e:
+                    reasons.append('log analysis failed: {}'.format(e))
+
+        if 'flown' in metrics:
+            if not metrics['flown']:
+                reasons.append('not flown')
+
+            elif not metrics['landed']:
+                reasons.append('not landed')
+
+            checks = [('landing_error_m', args.max_landing_error), ('horizontal_max_m', args.max_drift),
+                      ('max_tilt_deg', args.max_tilt), ('touchdown_speed_m_s', args.max_touchdown_speed),
+                      ('tracking_rms_m', args.max_tracking_rms)]
+
+            for key, limit in checks:
+                if key in metrics and metrics[key] > limit:
+                    reasons.append('{} {:.2f} > {:.2f}'.format(key, metrics[key], limit))
+
+            if metrics.get('filter_faults_max', 0) != 0:
+                reasons.append('estimator filter faults 0x{:x}'.format(metrics['filter_faults_max']))
+
+        passed = not reasons
+
+        if passed and not args.keep:
+            shutil.rmtree(self.directory, ignore_errors=True)
+
+        return {
+            'index': self.index,
+            'passed': passed,
+            'reasons': reasons,
+            'failure_injected': self.scenario['failed_motor'] >= 0,
+            'wall_time_s': round(wall_time, 2),
+            'scenario': self.scenario,
+            'metrics': metrics,
+        }
+
+
+def percentiles(results, key):
+    values = sorted(r['metrics'][key] for r in results if key in r['metrics'])
+
+    if not values:
+        return None
+
+    def at(p):
+        return values[min(len(values) - 1, int(round(p * (len(values) - 1))))]
+
+    return {'p50': at(0.5), 'p95': at(0.95), 'max': values[-1]}
+
+
+def write_report(args, results, wall_time):
+    nominal = [r for r in results if not r['failure_injected']]
+    injected = [r for r in results if r['failure_injected']]
+
+    summary = {
+        'flights': len(results),
+        'passed': sum(r['passed'] for r in results),
+        'nominal_flights': len(nominal),
+        'nominal_passed': sum(r['passed'] for r in nominal),
+        'failure_flights': len(injected),
+        'failure_passed': sum(r['passed'] for r in injected),
+        'wall_time_s': round(wall_time, 1),
+        'seed': args.seed,
+    }
+
+    for key in ('landing_error_m', 'horizontal_rms_m', 'horizontal_max_m', 'max_tilt_deg', 'tracking_rms_m'):
+        stats = percentiles(results, key)
+
+        if stats:
+            summary[key] = stats
+
+    with open(os.path.join(args.output, 'report.json'), 'w') as f:
+        json.dump({'summary': summary, 'flights': results}, f, indent=2)
+
+    scenario_keys = list(results[0]['scenario'].keys()) if results else []
+    metric_keys = sorted({key for r in results for key in r['metrics']})
+
+    with open(os.path.join(args.output, 'report.csv'), 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['index', 'passed', 'reasons'] + scenario_keys + metric_keys)
+
+        for r in results:
+            writer.writerow([r['index'], int(r['passed']), '; '.join(r['reasons'])] +
+                            [r['scenario'][key] for key in scenario_keys] +
+                            [r['metrics'].get(key, '') for key in metric_keys])
+
+    return summary
+
+
+def main():
+    args = get_arguments()
+
+    for binary in ('px4', 'shm_sim'):
+        if not os.path.isfile(os.path.join(args.build_path, 'bin', binary)):
+            print('{} not found in {}, build px4_sitl_default first'.format(binary, args.build_path))
+            return 1
+
+    if ULog is None:
+        print('pyulog not found, tracking error and estimator faults are not evaluated')
+        print("You may need to install it with 'pip install pyulog'")
+
+    os.makedirs(args.output, exist_ok=True)
+    print('running {:d} flights, {:d} at a time, output in {}'.format(args.flights, args.jobs, args.output))
+
+    # every concurrent flight needs its own px4 instance id (ports, lock file and shared memory name)
+    slots = queue.Queue()
+
+    for slot in range(args.jobs):
+        slots.put(slot)
+
+    results = []
+    results_lock = threading.Lock()
+    start = time.monotonic()
+
+    def run_flight(index):
+        slot = slots.get()
+
+        try:
+            result = Flight(args, index, slot).run()
+
+        finally:
+            slots.put(slot)
+
+        with results_lock:
+            results.append(result)
+            status = 'pass' if result['passed'] else 'FAIL: ' + ', '.join(result['reasons'])
+            print('[{:4d}/{:d}] flight {:4d} {}'.format(len(results), args.flights, index, status))
+            sys.stdout.flush()
+
+    # the children are in our process group, a Ctrl-C stops them and the running flights fail fast
+    try:
+        with ThreadPoolExecutor(max_workers=args.jobs) as executor:
+            for future in [executor.submit(run_flight, i) for i in range(args.flights)]:
+                future.result()
+
+    except KeyboardInterrupt:
+        print('interrupted, writing the report of the finished flights')
+
+    results.sort(key=lambda r: r['index'])
+    summary = write_report(args, results, time.monotonic() - start)
+
+    print('')
+    print('flights passed: {:d}/{:d}'.format(summary['passed'], summary['flights']))
+    print('  nominal:           {:d}/{:d}'.format(summary['nominal_passed'], summary['nominal_flights']))
+    print('  failure injected:  {:d}/{:d}'.format(summary['failure_passed'], summary['failure_flights']))
+
+    for key in ('landing_error_m', 'horizontal_rms_m', 'max_tilt_deg', 'tracking_rms_m'):
+        if key in summary:
+            print('  {:18s} p50 {:.2f}  p95 {:.2f}  max {:.2f}'.format(
+                key, summary[key]['p50'], summary[key]['p95'], summary[key]['max']))
+
+    print('report: {}'.format(os.path.join(args.output, 'report.json')))
+
+    return 0 if summary['nominal_passed'] == summary['nominal_flights'] else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
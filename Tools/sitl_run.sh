@@ -67,6 +67,13 @@ if [ "$program" == "jmavsim" ] && [ ! -n "$no_sim" ]; then
 	# Start Java simulator
 	"$src_path"/Tools/jmavsim_run.sh -r 250 -l &
 	SIM_PID=`echo $!`
+elif [ "$program" == "shm_sim" ] && [ ! -n "$no_sim" ]; then
+	# Minimal physics over the shared memory link
+	export PX4_SIM_SHM=1
+	# a segment left behind by a killed PX4 would be attached to first
+	rm -f /dev/shm/px4_sim_0
+	"$build_path"/bin/shm_sim -n px4_sim_0 &
+	SIM_PID=`echo $!`
 elif [ "$program" == "gazebo" ] && [ ! -n "$no_sim" ]; then
 	if [ -x "$(command -v gazebo)" ]; then
 		if  [[ -z "$DONT_RUN" ]]; then
@@ -138,6 +145,8 @@ if [[ -z "$DONT_RUN" ]]; then
 	if [ "$program" == "jmavsim" ]; then
 		pkill -9 -P $SIM_PID
 		kill -9 $SIM_PID
+	elif [ "$program" == "shm_sim" ]; then
+		kill -9 $SIM_PID
 	elif [ "$program" == "gazebo" ]; then
 		kill -9 $SIM_PID
 		if [[ ! -n "$HEADLESS" ]]; then
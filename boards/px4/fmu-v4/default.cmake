@@ -65,6 +65,7 @@ px4_add_board(
 		mc_att_control
 		mc_pos_control
 		navigator
+		rtl_energy
 		sensors
 		sih
 		vmount
@@ -39,6 +39,7 @@ px4_add_board(
 		mc_att_control
 		mc_pos_control
 		navigator
+		rtl_energy
 		replay
 		sensors
 		simulator
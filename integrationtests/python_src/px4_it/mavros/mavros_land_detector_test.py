@@ -0,0 +1,208 @@
+#!/usr/bin/env python2
+#***************************************************************************
+#
+#   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+# 3. Neither the name PX4 nor the names of its contributors may be
+#    used to endorse or promote products derived from this software
+#    without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+# OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+# AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+# ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+#***************************************************************************/
+
+# The shebang of this file is currently Python2 because some
+# dependencies such as pymavlink don't play well with Python3 yet.
+from __future__ import division
+
+PKG = 'px4'
+
+import rospy
+from geometry_msgs.msg import PoseStamped
+from mavros_test_common import MavrosTestCommon
+from pymavlink import mavutil
+from std_msgs.msg import Header
+from threading import Thread
+
+
+class MavrosLandDetectorTest(MavrosTestCommon):
+    """
+    Measures the time from touchdown until the land detector reports the
+    vehicle on the ground.
+
+    The vehicle lands twice: once right after a low hover, where the land
+    detector runs at its full rate throughout, and once after a long hover
+    well above the ground, where it drops to the reduced cruise rate before
+    the descent. The latency after cruise must not exceed the one without
+    by more than LATENCY_MARGIN.
+
+    The landed state arrives with the EXTENDED_SYS_STATE stream (5 Hz on
+    the onboard link), so the latencies have a resolution of about 0.2 s.
+    """
+
+    TOUCHDOWN_HEIGHT = 0.2  # m above the takeoff height
+    LATENCY_MAX = 3.0  # s
+    LATENCY_MARGIN = 0.5  # s, one cruise interval plus telemetry resolution
+
+    def setUp(self):
+        super(MavrosLandDetectorTest, self).setUp()
+
+        self.pos = PoseStamped()
+        self.ground_z = None
+        self.touchdown_time = None
+
+        self.pos_setpoint_pub = rospy.Publisher(
+            'mavros/setpoint_position/local', PoseStamped, queue_size=1)
+
+        # send setpoints in seperate thread to better prevent failsafe
+        self.pos_thread = Thread(target=self.send_pos, args=())
+        self.pos_thread.daemon = True
+        self.pos_thread.start()
+
+    def tearDown(self):
+        super(MavrosLandDetectorTest, self).tearDown()
+
+    #
+    # Callback functions
+    #
+    def local_position_callback(self, data):
+        super(MavrosLandDetectorTest, self).local_position_callback(data)
+
+        # first sample below the touchdown height during a landing
+        if (self.touchdown_time is None and self.ground_z is not None
+                and self.state.mode == "AUTO.LAND" and
+                data.pose.position.z < self.ground_z + self.TOUCHDOWN_HEIGHT):
+            self.touchdown_time = rospy.Time.now()
+
+    #
+    # Helper methods
+    #
+    def send_pos(self):
+        rate = rospy.Rate(10)  # Hz
+        self.pos.header = Header()
+        self.pos.header.frame_id = "base_footprint"
+
+        while not rospy.is_shutdown():
+            self.pos.header.stamp = rospy.Time.now()
+            self.pos_setpoint_pub.publish(self.pos)
+            try:  # prevent garbage in console output when thread is killed
+                rate.sleep()
+            except rospy.ROSInterruptException:
+                pass
+
+    def reach_height(self, z, timeout):
+        """timeout(int): seconds"""
+        self.pos.pose.position.x = 0
+        self.pos.pose.position.y = 0
+        self.pos.pose.position.z = z
+        self.pos.pose.orientation.w = 1
+        rospy.loginfo("attempting to reach height {0}".format(z))
+
+        loop_freq = 2  # Hz
+        rate = rospy.Rate(loop_freq)
+        reached = False
+        for i in xrange(timeout * loop_freq):
+            if abs(self.local_position.pose.position.z - z) < 0.5:
+                rospy.loginfo("height reached | seconds: {0} of {1}".format(
+                    i / loop_freq, timeout))
+                reached = True
+                break
+
+            try:
+                rate.sleep()
+            except rospy.ROSException as e:
+                self.fail(e)
+
+        self.assertTrue(reached, (
+            "took too long to get to height | current height: {0:.2f}, timeout(seconds): {1}".
+            format(self.local_position.pose.position.z, timeout)))
+
+    def fly_and_land(self, height, hover_time):
+        """Take off, hover and land, return the touchdown latency in seconds"""
+        self.wait_for_landed_state(mavutil.mavlink.MAV_LANDED_STATE_ON_GROUND,
+                                   30, -1)
+        self.ground_z = self.local_position.pose.position.z
+        self.touchdown_time = None
+        self.pos.pose.position.z = self.ground_z
+
+        self.set_mode("OFFBOARD", 5)
+        self.set_arm(True, 5)
+        self.reach_height(self.ground_z + height, 30)
+        rospy.sleep(hover_time)
+
+        self.set_mode("AUTO.LAND", 5)
+
+        # wait for touchdown, then for the land detector
+        loop_freq = 50  # Hz
+        rate = rospy.Rate(loop_freq)
+        landed_time = None
+        for i in xrange(60 * loop_freq):
+            if (self.touchdown_time is not None and
+                    self.extended_state.landed_state ==
+                    mavutil.mavlink.MAV_LANDED_STATE_ON_GROUND):
+                landed_time = rospy.Time.now()
+                break
+
+            try:
+                rate.sleep()
+            except rospy.ROSException as e:
+                self.fail(e)
+
+        self.assertIsNotNone(self.touchdown_time, "no touchdown")
+        self.assertIsNotNone(landed_time, "landing not detected")
+        self.set_arm(False, 5)
+
+        latency = (landed_time - self.touchdown_time).to_sec()
+        rospy.loginfo(
+            "touchdown detection latency after {0} m, {1} s hover: {2:.2f} s".
+            format(height, hover_time, latency))
+        return latency
+
+    #
+    # Test method
+    #
+    def test_touchdown_latency(self):
+        """Test the touchdown detection latency with and without cruise"""
+
+        # make sure the simulation is ready to start the test
+        self.wait_for_topics(60)
+        self.log_topic_vars()
+
+        # below the cruise height, full rate throughout
+        latency_full_rate = self.fly_and_land(5, 2)
+
+        # well above the cruise height for longer than the cruise trigger time
+        latency_cruise = self.fly_and_land(20, 15)
+
+        self.assertLess(latency_full_rate, self.LATENCY_MAX)
+        self.assertLess(latency_cruise, self.LATENCY_MAX)
+        self.assertLess(latency_cruise,
+                        latency_full_rate + self.LATENCY_MARGIN)
+
+
+if __name__ == '__main__':
+    import rostest
+    rospy.init_node('test_node', anonymous=True)
+
+    rostest.rosrun(PKG, 'mavros_land_detector_test', MavrosLandDetectorTest)
@@ -44,7 +44,9 @@
 #include <px4_defines.h>
 #include <px4_log.h>
 
+#if defined(__PX4_NUTTX)
 pthread_mutex_t px4_modules_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 #ifndef __PX4_NUTTX
 
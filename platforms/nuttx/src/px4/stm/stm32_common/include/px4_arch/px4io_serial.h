@@ -47,6 +47,7 @@
 
 #include <drivers/device/device.h>
 #include <modules/px4iofirmware/protocol.h>
+#include <px4io_batch/px4io_batch.h>
 
 class PX4IO_serial : public device::Device
 {
@@ -58,6 +59,12 @@ public:
 	virtual int	read(unsigned offset, void *data, unsigned count = 1);
 	virtual int	write(unsigned address, void *data, unsigned count = 1);
 
+	/**
+	 * Exchange a batch of register reads and writes in a single transaction.
+	 * @return 0 on success, negative error otherwise
+	 */
+	int		batch(PX4IOBatch &batch);
+
 protected:
 	/**
 	 * Does the PX4IO_serial instance initialization.
@@ -46,7 +46,7 @@ ExternalProject_Add(sitl_gazebo
 )
 
 # create targets for each viewer/model/debugger combination
-set(viewers none jmavsim gazebo)
+set(viewers none jmavsim gazebo shm_sim)
 set(debuggers none ide gdb lldb ddd valgrind callgrind)
 set(models none shell
 	if750a iris iris_opt_flow iris_vision iris_rplidar iris_irlock iris_obs_avoid solo typhoon_h480
@@ -89,6 +89,8 @@ foreach(viewer ${viewers})
 				add_dependencies(${_targ_name} px4 sitl_gazebo)
 			elseif(viewer STREQUAL "jmavsim")
 				add_dependencies(${_targ_name} px4 git_jmavsim)
+			elseif(viewer STREQUAL "shm_sim")
+				add_dependencies(${_targ_name} px4 shm_sim)
 			endif()
 		endforeach()
 	endforeach()
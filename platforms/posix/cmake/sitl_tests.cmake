@@ -33,6 +33,7 @@ set(tests
 	servo
 	#sf0x
 	sleep
+	SpscRingBuffer
 	uorb
 	versioning
 	)
@@ -121,6 +121,7 @@ int main(int argc, char **argv)
 {
 	bool is_client = false;
 	bool pxh_off = false;
+	bool verbose_startup = false;
 
 	/* Symlinks point to all commands that can be used as a client with a prefix. */
 	const char prefix[] = PX4_SHELL_COMMAND_PREFIX;
@@ -173,6 +174,12 @@ int main(int argc, char **argv)
 		argv[0] += path_length + strlen(prefix);
 
 		px4_daemon::Client client(instance);
+
+		if (strcmp(argv[0], "session") == 0) {
+			/* px4-session: run the commands from stdin over one connection */
+			return client.process_session(stdin);
+		}
+
 		return client.process_args(argc, (const char **)argv);
 
 	} else {
@@ -188,7 +195,7 @@ int main(int argc, char **argv)
 		int ch;
 		const char *myoptarg = nullptr;
 
-		while ((ch = px4_getopt(argc, argv, "hdt:s:i:w:", &myoptind, &myoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "hdvt:s:i:w:", &myoptind, &myoptarg)) != EOF) {
 			switch (ch) {
 			case 'h':
 				print_usage();
@@ -198,6 +205,10 @@ int main(int argc, char **argv)
 				pxh_off = true;
 				break;
 
+			case 'v':
+				verbose_startup = true;
+				break;
+
 			case 't':
 				test_data_path = myoptarg;
 				break;
@@ -286,8 +297,20 @@ int main(int argc, char **argv)
 		px4::init_once();
 		px4::init(argc, argv, "px4");
 
+		// PX4_STARTUP_TIMING lists every startup command instead of the slowest ones
+		const bool list_startup_commands = getenv("PX4_STARTUP_TIMING") != nullptr;
+		const bool startup_timing = verbose_startup || list_startup_commands;
+
+		if (startup_timing) {
+			server.start_timing();
+		}
+
 		ret = run_startup_script(commands_file, absolute_binary_path, instance);
 
+		if (startup_timing) {
+			server.print_timing(list_startup_commands);
+		}
+
 		// We now block here until we need to exit.
 		if (pxh_off) {
 			wait_to_exit();
@@ -419,9 +442,10 @@ void register_sig_handler()
 	(void)sig_int; // this variable is unused
 #else
 	sigaction(SIGINT, &sig_int, nullptr);
+	// SIGTERM (kill, launch scripts) exits the same way, so the shutdown hooks run
+	sigaction(SIGTERM, &sig_int, nullptr);
 #endif
 
-	//sigaction(SIGTERM, &sig_int, nullptr);
 	sigaction(SIGFPE, &sig_fpe, nullptr);
 	sigaction(SIGPIPE, &sig_pipe, nullptr);
 }
@@ -556,7 +580,7 @@ void print_usage()
 {
 	printf("Usage for Server/daemon process: \n");
 	printf("\n");
-	printf("    px4 [-h|-d] [-s <startup_file>] [-t <test_data_directory>] [<rootfs_directory>] [-i <instance>] [-w <working_directory>]\n");
+	printf("    px4 [-h|-d|-v] [-s <startup_file>] [-t <test_data_directory>] [<rootfs_directory>] [-i <instance>] [-w <working_directory>]\n");
 	printf("\n");
 	printf("    -s <startup_file>      shell script to be used as startup (default=etc/init.d/rcS)\n");
 	printf("    <rootfs_directory>     directory where startup files and mixers are located,\n");
@@ -565,11 +589,15 @@ void print_usage()
 	printf("    -w <working_directory> directory to change to\n");
 	printf("    -h                     help/usage information\n");
 	printf("    -d                     daemon mode, don't start pxh shell\n");
+	printf("    -v                     print the startup time and the slowest startup commands\n");
 	printf("\n");
 	printf("Usage for client: \n");
 	printf("\n");
 	printf("    px4-MODULE [--instance <instance>] command using symlink.\n");
 	printf("        e.g.: px4-commander status\n");
+	printf("    px4-session [--instance <instance>] runs the commands from stdin, one per line,\n");
+	printf("        over a single connection.\n");
+	printf("        e.g.: printf 'param set MPC_XY_VEL_MAX 5\\nlistener vehicle_status\\n' | px4-session\n");
 }
 
 bool is_already_running(int instance)
@@ -62,7 +62,7 @@ Client::Client(int instance_id) :
 {}
 
 int
-Client::process_args(const int argc, const char **argv)
+Client::_connect()
 {
 	std::string sock_path = get_socket_path(_instance_id);
 
@@ -82,6 +82,16 @@ Client::process_args(const int argc, const char **argv)
 		return -1;
 	}
 
+	return 0;
+}
+
+int
+Client::process_args(const int argc, const char **argv)
+{
+	if (_connect() != 0) {
+		return -1;
+	}
+
 	int ret = _send_cmds(argc, argv);
 
 	if (ret != 0) {
@@ -110,6 +120,12 @@ Client::_send_cmds(const int argc, const char **argv)
 	// Last byte is 'isatty'.
 	cmd_buf.push_back(isatty(STDOUT_FILENO));
 
+	return _write(cmd_buf);
+}
+
+int
+Client::_write(const std::string &cmd_buf)
+{
 	size_t n = cmd_buf.size();
 	const char *buf = cmd_buf.data();
 
@@ -177,6 +193,94 @@ Client::_listen()
 	}
 }
 
+int
+Client::process_session(FILE *in)
+{
+	if (_connect() != 0) {
+		return -1;
+	}
+
+	if (_write(std::string(1, SESSION_MARKER)) != 0) {
+		PX4_ERR("Could not open session");
+		return -3;
+	}
+
+	const char tty = isatty(STDOUT_FILENO);
+	int last_error = 0;
+	char line[512];
+
+	while (fgets(line, sizeof(line), in)) {
+		std::string cmd = line;
+
+		while (!cmd.empty() && (cmd.back() == '\n' || cmd.back() == '\r')) {
+			cmd.pop_back();
+		}
+
+		if (cmd.empty() || cmd[0] == '#') {
+			continue;
+		}
+
+		cmd.push_back(tty);
+
+		if (_write(cmd) != 0) {
+			PX4_ERR("Could not send command");
+			return -3;
+		}
+
+		int ret = _listen_session();
+
+		if (ret == -1) {
+			return -1;
+		}
+
+		if (ret != 0) {
+			last_error = ret;
+		}
+
+		fflush(stdout);
+	}
+
+	return last_error;
+}
+
+int
+Client::_listen_session()
+{
+	char buffer[1024];
+	bool have_end = false;
+
+	// The response to each command ends in {0, retval}, but the connection
+	// stays open, so a 0 byte marks the end of the output.
+	// Only one command is in flight, so nothing follows the return value.
+	while (true) {
+		int n_read = read(_fd, buffer, sizeof buffer);
+
+		if (n_read <= 0) {
+			PX4_ERR("session closed by the server");
+			return -1;
+		}
+
+		if (have_end) {
+			return buffer[0];
+		}
+
+		const char *end = (const char *)memchr(buffer, 0, n_read);
+
+		if (end == nullptr) {
+			fwrite(buffer, n_read, 1, stdout);
+			continue;
+		}
+
+		fwrite(buffer, end - buffer, 1, stdout);
+
+		if (end + 1 < buffer + n_read) {
+			return end[1];
+		}
+
+		have_end = true;
+	}
+}
+
 Client::~Client()
 {
 	if (_fd >= 0) {
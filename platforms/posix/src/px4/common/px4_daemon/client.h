@@ -40,6 +40,9 @@
  * It the client dies, the connection gets closed automatically and the corresponding
  * thread in the server gets cancelled.
  *
+ * In session mode (px4-session) the connection stays open and the commands read
+ * from stdin are sent one after the other, for scripts that issue many commands.
+ *
  * @author Julian Oes <julian@oes.ch>
  * @author Beat Küng <beat-kueng@gmx.net>
  * @author Mara Bos <m-ou.se@m-ou.se>
@@ -47,6 +50,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdio.h>
+#include <string>
 
 #include "sock_protocol.h"
 
@@ -76,9 +81,21 @@ public:
 	 */
 	int process_args(const int argc, const char **argv);
 
+	/**
+	 * Open a persistent session and run the commands read from the supplied
+	 * stream over it, one per line. Output is written to stdout.
+	 *
+	 * @param in: stream to read the commands from
+	 * @return 0 if all commands succeeded, otherwise the last non-zero return value
+	 */
+	int process_session(FILE *in);
+
 private:
+	int _connect();
+	int _write(const std::string &buf);
 	int _send_cmds(const int argc, const char **argv);
 	int _listen();
+	int _listen_session();
 
 	int _fd;
 	int _instance_id; ///< instance ID for running multiple instances of the px4 server
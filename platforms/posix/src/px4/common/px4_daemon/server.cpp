@@ -50,6 +50,8 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/un.h>
+#include <time.h>
+#include <algorithm>
 #include <vector>
 
 #include <px4_log.h>
@@ -64,6 +66,7 @@ Server *Server::_instance = nullptr;
 
 Server::Server(int instance_id)
 	: _mutex(PTHREAD_MUTEX_INITIALIZER),
+	  _pending_cond(PTHREAD_COND_INITIALIZER),
 	  _instance_id(instance_id)
 {
 	_instance = this;
@@ -177,18 +180,13 @@ Server::_server_main()
 				// Set stream to line buffered.
 				setvbuf(thread_stdout, nullptr, _IOLBF, BUFSIZ);
 
-				// Start a new thread to handle the client.
-				pthread_t *thread = &_fd_to_thread[client];
-				ret = pthread_create(thread, nullptr, Server::_handle_client, thread_stdout);
-
-				if (ret != 0) {
-					PX4_ERR("could not start pthread (%i)", ret);
-					_fd_to_thread.erase(client);
+				// Hand the client to an idle worker, or start a new one if all are busy.
+				if (_pending.size() >= (size_t)_idle_workers && !_start_worker()) {
 					fclose(thread_stdout);
 
 				} else {
-					// We won't join the thread, so detach to automatically release resources at its end
-					pthread_detach(*thread);
+					_pending.push_back(thread_stdout);
+					pthread_cond_signal(&_pending_cond);
 
 					// Start listening for the client hanging up.
 					poll_fds.push_back(pollfd {client, POLLHUP, 0});
@@ -204,15 +202,33 @@ Server::_server_main()
 			if (poll_fds[i].revents) {
 				--n_ready;
 				auto thread = _fd_to_thread.find(poll_fds[i].fd);
+				bool close_stream = true;
+
+				if (thread == _fd_to_thread.end()) {
+					// Not picked up by a worker yet (or the worker is done with it).
+					auto pending = std::find(_pending.begin(), _pending.end(), stdouts[i - 1]);
+
+					if (pending != _pending.end()) {
+						_pending.erase(pending);
+					}
 
-				if (thread != _fd_to_thread.end()) {
-					// Thread is still running, so we cancel it.
+				} else if (thread->second.running_command) {
+					// Command is still running, so we cancel the thread.
 					// TODO: use a more graceful exit method to avoid resource leaks
-					pthread_cancel(thread->second);
+					pthread_cancel(thread->second.thread);
 					_fd_to_thread.erase(thread);
+
+				} else {
+					// The worker is blocked reading from the client and will see the
+					// end of the stream. Let it close the stream and keep the worker.
+					thread->second.hung_up = true;
+					close_stream = false;
+				}
+
+				if (close_stream) {
+					fclose(stdouts[i - 1]);
 				}
 
-				fclose(stdouts[i - 1]);
 				stdouts.erase(stdouts.begin() + i - 1);
 				poll_fds.erase(poll_fds.begin() + i);
 
@@ -227,76 +243,246 @@ Server::_server_main()
 	close(_fd);
 }
 
+bool
+Server::_start_worker()
+{
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	// We won't join the thread, so detach to automatically release resources at its end
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+	pthread_t thread;
+	int ret = pthread_create(&thread, &attr, Server::_worker, this);
+	pthread_attr_destroy(&attr);
+
+	if (ret != 0) {
+		PX4_ERR("could not start pthread (%i)", ret);
+		return false;
+	}
+
+	// Called with the lock held. The new worker is idle until it takes a client.
+	++_idle_workers;
+	return true;
+}
+
 void
-*Server::_handle_client(void *arg)
+*Server::_worker(void *arg)
 {
-	FILE *out = (FILE *)arg;
-	int fd = fileno(out);
+	Server *self = (Server *)arg;
 
-	// Read until the end of the incoming stream.
-	std::string cmd;
+	self->_lock();
 
 	while (true) {
-		size_t n = cmd.size();
-		cmd.resize(n + 1024);
-		ssize_t n_read = read(fd, &cmd[n], cmd.size() - n);
-
-		if (n_read <= 0) {
-			_cleanup(fd);
-			return nullptr;
+		// Idle workers are not in _fd_to_thread, so they never get cancelled while waiting.
+		while (self->_pending.empty()) {
+			pthread_cond_wait(&self->_pending_cond, &self->_mutex);
 		}
 
-		cmd.resize(n + n_read);
+		FILE *out = self->_pending.front();
+		self->_pending.pop_front();
+		--self->_idle_workers;
+		self->_fd_to_thread[fileno(out)] = ClientThread{pthread_self(), false, false};
+		self->_unlock();
 
-		// Command ends in 0x00 (no tty) or 0x01 (tty).
-		if (!cmd.empty() && cmd.back() < 2) {
+		self->_handle_client(out);
+
+		self->_lock();
+
+		if (self->_idle_workers >= MAX_IDLE_WORKERS) {
+			// Enough workers around already, let this one exit.
 			break;
 		}
-	}
 
-	if (cmd.size() < 2) {
-		_cleanup(fd);
-		return nullptr;
+		++self->_idle_workers;
 	}
 
-	// Last byte is 'isatty'.
-	uint8_t isatty = cmd.back();
-	cmd.pop_back();
+	self->_unlock();
+	return nullptr;
+}
+
+void
+Server::_handle_client(FILE *out)
+{
+	int fd = fileno(out);
+
+	std::string buf;
+	bool first_read = true;
+	bool session = false;
+
+	while (true) {
+		// Read until a complete command is buffered.
+		// Command ends in 0x00 (no tty) or 0x01 (tty).
+		auto is_end = [](char c) { return (uint8_t)c < 2; };
+		auto end = std::find_if(buf.begin(), buf.end(), is_end);
+
+		while (end == buf.end()) {
+			size_t n = buf.size();
+			buf.resize(n + 1024);
+			ssize_t n_read = read(fd, &buf[n], buf.size() - n);
+
+			if (n_read <= 0) {
+				_cleanup(out);
+				return;
+			}
+
+			buf.resize(n + n_read);
+
+			if (first_read) {
+				first_read = false;
+
+				if (buf[0] == SESSION_MARKER) {
+					session = true;
+					buf.erase(0, 1);
+				}
+			}
+
+			end = std::find_if(buf.begin(), buf.end(), is_end);
+		}
+
+		std::string cmd(buf.begin(), end);
+
+		// Last byte is 'isatty'.
+		uint8_t isatty = *end;
+		buf.erase(buf.begin(), end + 1);
+
+		if (cmd.empty() && !session) {
+			_cleanup(out);
+			return;
+		}
 
-	// We register thread specific data. This is used for PX4_INFO (etc.) log calls.
-	CmdThreadSpecificData *thread_data_ptr;
+		// We register thread specific data. This is used for PX4_INFO (etc.) log calls.
+		// Workers are reused across clients, so the stream is updated for every command.
+		CmdThreadSpecificData *thread_data_ptr;
+
+		if ((thread_data_ptr = (CmdThreadSpecificData *)pthread_getspecific(_key)) == nullptr) {
+			thread_data_ptr = new CmdThreadSpecificData;
+			(void)pthread_setspecific(_key, (void *)thread_data_ptr);
+		}
 
-	if ((thread_data_ptr = (CmdThreadSpecificData *)pthread_getspecific(_instance->_key)) == nullptr) {
-		thread_data_ptr = new CmdThreadSpecificData;
 		thread_data_ptr->thread_stdout = out;
 		thread_data_ptr->is_atty = isatty;
 
-		(void)pthread_setspecific(_instance->_key, (void *)thread_data_ptr);
+		// Run the actual command.
+		_set_running_command(fd, true);
+		const uint64_t start_us = _monotonic_us();
+		int retval = cmd.empty() ? 0 : Pxh::process_line(cmd, true);
+		const uint64_t end_us = _monotonic_us();
+		_set_running_command(fd, false);
+
+		_lock();
+
+		if (_timing_enabled) {
+			_timings.push_back(CommandTiming{cmd, start_us - _timing_start_us, end_us - start_us});
+		}
+
+		_unlock();
+
+		// Report return value.
+		char ret_buf[2] = {0, (char)retval};
+
+		if (fwrite(ret_buf, sizeof ret_buf, 1, out) != 1) {
+			// Don't care it went wrong, as we're cleaning up anyway.
+		}
+
+		// Flush the FILE*'s buffer before we shut down the connection
+		// or wait for the next command of the session.
+		fflush(out);
+
+		if (!session) {
+			_cleanup(out);
+			return;
+		}
 	}
+}
+
+void
+Server::_set_running_command(int fd, bool running)
+{
+	_lock();
+	auto thread = _fd_to_thread.find(fd);
+
+	if (thread != _fd_to_thread.end()) {
+		thread->second.running_command = running;
+	}
+
+	_unlock();
+}
 
-	// Run the actual command.
-	int retval = Pxh::process_line(cmd, true);
+uint64_t
+Server::_monotonic_us()
+{
+	// wall clock on purpose, the lockstep time does not advance during startup
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void
+Server::start_timing()
+{
+	_lock();
+	_timings.clear();
+	_timing_start_us = _monotonic_us();
+	_timing_enabled = true;
+	_unlock();
+}
 
-	// Report return value.
-	char buf[2] = {0, (char)retval};
+void
+Server::print_timing(bool verbose)
+{
+	_lock();
+	_timing_enabled = false;
+	const uint64_t total_us = _monotonic_us() - _timing_start_us;
+	std::vector<CommandTiming> timings;
+	timings.swap(_timings);
+	_unlock();
+
+	uint64_t busy_us = 0;
 
-	if (fwrite(buf, sizeof buf, 1, out) != 1) {
-		// Don't care it went wrong, as we're cleaning up anyway.
+	for (const CommandTiming &t : timings) {
+		busy_us += t.duration_us;
 	}
 
-	// Flush the FILE*'s buffer before we shut down the connection.
-	fflush(out);
+	// commands overlap in parallel start mode, so the sum can exceed the total
+	PX4_INFO("Startup: %zu commands in %.1f ms, %.1f ms spent in commands", timings.size(),
+		 total_us * 1e-3, busy_us * 1e-3);
 
-	_cleanup(fd);
-	return nullptr;
+	if (!verbose) {
+		static constexpr size_t SLOWEST = 5;
+		std::sort(timings.begin(), timings.end(), [](const CommandTiming & a, const CommandTiming & b) {
+			return a.duration_us > b.duration_us;
+		});
+
+		if (timings.size() > SLOWEST) {
+			timings.resize(SLOWEST);
+		}
+	}
+
+	for (const CommandTiming &t : timings) {
+		PX4_INFO("  %8.1f ms +%7.1f ms  %s", t.start_us * 1e-3, t.duration_us * 1e-3, t.command.c_str());
+	}
 }
 
 void
-Server::_cleanup(int fd)
+Server::_cleanup(FILE *out)
 {
-	_instance->_lock();
-	_instance->_fd_to_thread.erase(fd);
-	_instance->_unlock();
+	int fd = fileno(out);
+
+	_lock();
+	auto thread = _fd_to_thread.find(fd);
+	const bool hung_up = thread != _fd_to_thread.end() && thread->second.hung_up;
+
+	if (thread != _fd_to_thread.end()) {
+		_fd_to_thread.erase(thread);
+	}
+
+	_unlock();
+
+	if (hung_up) {
+		// The main thread already stopped polling this fd, so it's ours to close.
+		fclose(out);
+		return;
+	}
 
 	// We can't close() the fd here, since the main thread is probably
 	// polling for it: close()ing it causes a race condition.
@@ -39,6 +39,14 @@
  * The server will return the stdout of the executing command, as well as the return
  * value to the client.
  *
+ * A client can instead open a persistent session (see SESSION_MARKER) and send any
+ * number of commands over the same connection, which avoids the connection setup
+ * for every command.
+ *
+ * Connections are served by a pool of worker threads: a worker that finished with
+ * a client waits for the next one instead of exiting, so a command does not pay
+ * for a thread creation either.
+ *
  * There should only every be one server running, therefore the static instance.
  * The Singleton implementation is not complete, but it should be obvious not
  * to instantiate multiple servers.
@@ -53,7 +61,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include <deque>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "sock_protocol.h"
 
@@ -89,7 +100,28 @@ public:
 	{
 		return _instance->_key;
 	}
+
+	/**
+	 * Record the wall clock duration of every command processed from now on,
+	 * used to profile the startup script.
+	 */
+	void start_timing();
+
+	/**
+	 * Stop recording and print the number of commands, the total time and the slowest commands.
+	 * @param verbose print every command instead of the slowest ones
+	 */
+	void print_timing(bool verbose);
+
 private:
+	struct CommandTiming {
+		std::string command;
+		uint64_t start_us; ///< relative to start_timing()
+		uint64_t duration_us;
+	};
+
+	static uint64_t _monotonic_us();
+
 	static void *_server_main_trampoline(void *arg);
 	void _server_main();
 
@@ -103,13 +135,31 @@ private:
 		pthread_mutex_unlock(&_mutex);
 	}
 
-	static void *_handle_client(void *arg);
-	static void _cleanup(int fd);
+	struct ClientThread {
+		pthread_t thread;
+		bool running_command; ///< false while waiting for (the rest of) the next command
+		bool hung_up; ///< client hung up while not running a command, the worker closes the stream
+	};
+
+	static constexpr int MAX_IDLE_WORKERS = 4;
+
+	bool _start_worker();
+	static void *_worker(void *arg);
+	void _handle_client(FILE *out);
+	void _set_running_command(int fd, bool running);
+	void _cleanup(FILE *out);
 
 	pthread_t _server_main_pthread;
 
-	std::map<int, pthread_t> _fd_to_thread;
-	pthread_mutex_t _mutex; ///< Protects _fd_to_thread.
+	std::map<int, ClientThread> _fd_to_thread;
+	std::deque<FILE *> _pending; ///< accepted connections not yet picked up by a worker
+	int _idle_workers{0};
+	pthread_mutex_t _mutex; ///< Protects _fd_to_thread, _pending, _idle_workers and the timing.
+	pthread_cond_t _pending_cond; ///< signalled when a connection is added to _pending
+
+	bool _timing_enabled{false};
+	uint64_t _timing_start_us{0};
+	std::vector<CommandTiming> _timings;
 
 	pthread_key_t _key;
 
@@ -44,5 +44,14 @@ namespace px4_daemon
 
 std::string get_socket_path(int instance_id);
 
+/**
+ * First byte sent by a client to open a persistent session instead of a single
+ * command. A session carries any number of commands, each terminated by the
+ * 'isatty' byte (0 or 1) like a one-shot command, and the server answers each
+ * with the command output followed by {0, retval} without closing the connection.
+ * The 0 byte ends the output, so session commands must not print 0 bytes.
+ */
+static constexpr char SESSION_MARKER = 0x02;
+
 } // namespace px4_daemon
 
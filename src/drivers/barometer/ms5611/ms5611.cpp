@@ -171,8 +171,12 @@ protected:
 
 	/**
 	 * Collect the result of the most recent measurement.
+	 *
+	 * @param next_cmd	Conversion command to start right after the result
+	 *			is read, in the same bus transaction where the
+	 *			interface supports it, or 0 for none.
 	 */
-	virtual int		collect();
+	virtual int		collect(unsigned next_cmd = 0);
 };
 
 /*
@@ -510,8 +514,20 @@ MS5611::Run()
 	/* collection phase? */
 	if (_collect_phase) {
 
+		/*
+		 * Is there a collect->measure gap?
+		 * Don't inject one after temperature measurements, so we can keep
+		 * doing pressure measurements at something close to the desired rate.
+		 * Without a gap the next conversion is started together with the read.
+		 */
+		unsigned next_phase = _measure_phase;
+		INCREMENT(next_phase, MS5611_MEASUREMENT_RATIO + 1);
+
+		const bool gap = (next_phase != 0) && (_measure_interval > MS5611_CONVERSION_INTERVAL);
+		const unsigned next_cmd = gap ? 0 : ((next_phase == 0) ? ADDR_CMD_CONVERT_D2 : ADDR_CMD_CONVERT_D1);
+
 		/* perform collection */
-		ret = collect();
+		ret = collect(next_cmd);
 
 		if (ret != OK) {
 			if (ret == -6) {
@@ -534,22 +550,19 @@ MS5611::Run()
 			return;
 		}
 
+		if (!gap) {
+			/* the next conversion is running, collect it when done */
+			ScheduleDelayed(MS5611_CONVERSION_INTERVAL);
+			return;
+		}
+
 		/* next phase is measurement */
 		_collect_phase = false;
 
-		/*
-		 * Is there a collect->measure gap?
-		 * Don't inject one after temperature measurements, so we can keep
-		 * doing pressure measurements at something close to the desired rate.
-		 */
-		if ((_measure_phase != 0) &&
-		    (_measure_interval > MS5611_CONVERSION_INTERVAL)) {
-
-			/* schedule a fresh cycle call when we are ready to measure again */
-			ScheduleDelayed(_measure_interval - MS5611_CONVERSION_INTERVAL);
+		/* schedule a fresh cycle call when we are ready to measure again */
+		ScheduleDelayed(_measure_interval - MS5611_CONVERSION_INTERVAL);
 
-			return;
-		}
+		return;
 	}
 
 	/* measurement phase */
@@ -597,7 +610,7 @@ MS5611::measure()
 }
 
 int
-MS5611::collect()
+MS5611::collect(unsigned next_cmd)
 {
 	int ret;
 	uint32_t raw;
@@ -609,8 +622,8 @@ MS5611::collect()
 	report.timestamp = hrt_absolute_time();
 	report.error_count = perf_event_count(_comms_errors);
 
-	/* read the most recent measurement - read offset/size are hardcoded in the interface */
-	ret = _interface->read(0, (void *)&raw, 0);
+	/* read the most recent measurement - read size is hardcoded in the interface, the offset starts the next one */
+	ret = _interface->read(next_cmd, (void *)&raw, 0);
 
 	if (ret < 0) {
 		perf_count(_comms_errors);
@@ -62,6 +62,11 @@
 #define IOCTL_RESET			2
 #define IOCTL_MEASURE			3
 
+/*
+ * Interface read: returns the result of the last conversion. A non-zero
+ * offset is the conversion command to issue right after the result is read.
+ */
+
 namespace ms5611
 {
 
@@ -117,6 +117,11 @@ MS5611_I2C::read(unsigned offset, void *data, unsigned count)
 		cvt->b[1] = buf[1];
 		cvt->b[2] = buf[0];
 		cvt->b[3] = 0;
+
+		/* start the next measurement */
+		if (offset != 0) {
+			ret = _measure(offset);
+		}
 	}
 
 	return ret;
@@ -82,13 +82,6 @@ private:
 	 */
 	int		_read_prom();
 
-	/**
-	 * Read a 16-bit register value.
-	 *
-	 * @param reg		The register to read.
-	 */
-	uint16_t	_reg16(unsigned reg);
-
 	/**
 	 * Wrapper around transfer() that prevents interrupt-context transfers
 	 * from pre-empting us. The sensor may (does) share a bus with sensors
@@ -159,9 +152,15 @@ MS5611_SPI::read(unsigned offset, void *data, unsigned count)
 		uint32_t w;
 	} *cvt = (_cvt *)data;
 	uint8_t buf[4] = { 0 | DIR_WRITE, 0, 0, 0 };
+	uint8_t cmd = offset | DIR_WRITE;
 
-	/* read the most recent measurement */
-	int ret = _transfer(&buf[0], &buf[0], sizeof(buf));
+	/* read the most recent measurement and start the next one in the same batch */
+	const Transfer transfers[] {
+		{&buf[0], &buf[0], sizeof(buf)},
+		{&cmd, nullptr, 1},
+	};
+
+	int ret = transfer_multi(transfers, (offset != 0) ? 2 : 1);
 
 	if (ret == OK) {
 		/* fetch the raw value */
@@ -228,12 +227,28 @@ MS5611_SPI::_read_prom()
 	 */
 	px4_usleep(3000);
 
-	/* read and convert PROM words */
+	/* read all PROM words in one batch, each word is a separate transaction */
+	static constexpr unsigned PROM_WORDS = 8;
+	static_assert(PROM_WORDS <= MAX_TRANSFERS, "PROM read does not fit into one batch");
+
+	uint8_t buf[PROM_WORDS][3] {};
+	Transfer transfers[PROM_WORDS];
+
+	for (unsigned i = 0; i < PROM_WORDS; i++) {
+		buf[i][0] = (ADDR_PROM_SETUP + (i * 2)) | DIR_READ;
+		transfers[i] = Transfer{&buf[i][0], &buf[i][0], sizeof(buf[i])};
+	}
+
+	if (transfer_multi(transfers, PROM_WORDS) != OK) {
+		PX4_DEBUG("prom read failed");
+		return -EIO;
+	}
+
+	/* convert PROM words */
 	bool all_zero = true;
 
-	for (int i = 0; i < 8; i++) {
-		uint8_t cmd = (ADDR_PROM_SETUP + (i * 2));
-		_prom.c[i] = _reg16(cmd);
+	for (unsigned i = 0; i < PROM_WORDS; i++) {
+		_prom.c[i] = (uint16_t)(buf[i][1] << 8) | buf[i][2];
 
 		if (_prom.c[i] != 0) {
 			all_zero = false;
@@ -257,16 +272,6 @@ MS5611_SPI::_read_prom()
 	return ret;
 }
 
-uint16_t
-MS5611_SPI::_reg16(unsigned reg)
-{
-	uint8_t cmd[3] = { (uint8_t)(reg | DIR_READ), 0, 0 };
-
-	_transfer(cmd, cmd, sizeof(cmd));
-
-	return (uint16_t)(cmd[1] << 8) | cmd[2];
-}
-
 int
 MS5611_SPI::_transfer(uint8_t *send, uint8_t *recv, unsigned len)
 {
@@ -78,30 +78,32 @@ MS5525::init_ms5525()
 	// 0 factory data and the setup
 	// 1-6 calibration coefficients
 	// 7 serial code and CRC
-	uint16_t prom[8];
+	static constexpr unsigned PROM_WORDS = 8;
+	uint16_t prom[PROM_WORDS];
 
-	for (uint8_t i = 0; i < 8; i++) {
-		cmd = CMD_PROM_START + i * 2;
+	uint8_t prom_cmd[PROM_WORDS];
+	uint8_t prom_val[PROM_WORDS][2];
+	Transfer transfers[PROM_WORDS];
 
-		// request PROM value
-		ret = transfer(&cmd, 1, nullptr, 0);
+	for (unsigned i = 0; i < PROM_WORDS; i++) {
+		// request PROM value and read the 2 byte value
+		prom_cmd[i] = CMD_PROM_START + i * 2;
+		transfers[i] = Transfer{&prom_cmd[i], 1, &prom_val[i][0], 2};
+	}
+
+	// read several words per bus transaction
+	for (unsigned i = 0; i < PROM_WORDS; i += MAX_TRANSFERS) {
+		const unsigned count = (PROM_WORDS - i < MAX_TRANSFERS) ? (PROM_WORDS - i) : MAX_TRANSFERS;
+		ret = transfer_multi(&transfers[i], count);
 
 		if (ret != PX4_OK) {
 			perf_count(_comms_errors);
 			return false;
 		}
+	}
 
-		// read 2 byte value
-		uint8_t val[2];
-		ret = transfer(nullptr, 0, &val[0], 2);
-
-		if (ret == PX4_OK) {
-			prom[i] = (val[0] << 8) | val[1];
-
-		} else {
-			perf_count(_comms_errors);
-			return false;
-		}
+	for (unsigned i = 0; i < PROM_WORDS; i++) {
+		prom[i] = (prom_val[i][0] << 8) | prom_val[i][1];
 	}
 
 	// Step 3 - check CRC
@@ -171,18 +173,10 @@ MS5525::collect()
 {
 	perf_begin(_sample_perf);
 
-	// read ADC
+	// read ADC: send the read command and get the 24 bits from the sensor in a single transaction
 	uint8_t cmd = CMD_ADC_READ;
-	int ret = transfer(&cmd, 1, nullptr, 0);
-
-	if (ret != PX4_OK) {
-		perf_count(_comms_errors);
-		return ret;
-	}
-
-	// read 24 bits from the sensor
 	uint8_t val[3];
-	ret = transfer(nullptr, 0, &val[0], 3);
+	int ret = transfer(&cmd, 1, &val[0], 3);
 
 	if (ret != PX4_OK) {
 		perf_count(_comms_errors);
@@ -49,6 +49,7 @@
 
 #include <mathlib/mathlib.h>
 #include <matrix/math.hpp>
+#include <perf/perf_counter.h>
 #include <px4_cli.h>
 #include <px4_getopt.h>
 #include <px4_module.h>
@@ -167,6 +168,8 @@ private:
 	float				_rate{0.0f};					///< position update rate
 	float				_rate_rtcm_injection{0.0f};			///< RTCM message injection rate
 	unsigned			_last_rate_rtcm_injection_count{0}; 		///< counter for number of RTCM messages
+	float				_rate_rtcm_injection_bytes{0.0f};		///< RTCM injection data rate [B/s]
+	unsigned			_last_rate_rtcm_injection_bytes{0};		///< counter for number of injected RTCM bytes
 
 	const bool			_fake_gps;					///< fake gps output
 
@@ -178,6 +181,12 @@ private:
 	gps_dump_s			*_dump_from_device{nullptr};
 	bool				_should_dump_communication{false};			///< if true, dump communication
 
+	/// RTCM fragments collected in one poll cycle, written to the device at once
+	uint8_t				_inject_buffer[gps_inject_data_s::ORB_QUEUE_LENGTH * sizeof(gps_inject_data_s::data)];
+
+	perf_counter_t			_inject_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": inject")};
+	perf_counter_t			_dump_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": dump")};
+
 	static volatile bool _is_gps_main_advertised; ///< for the second gps we want to make sure that it gets instance 1
 	/// and thus we wait until the first one publishes at least one message.
 
@@ -209,6 +218,8 @@ private:
 
 	/**
 	 * check for new messages on the inject data topic & handle them
+	 *
+	 * All pending messages are written to the device in a single write.
 	 */
 	void handleInjectDataTopic();
 
@@ -217,7 +228,7 @@ private:
 	 * @param data
 	 * @param len
 	 */
-	inline bool injectData(uint8_t *data, size_t len);
+	inline bool injectData(const uint8_t *data, size_t len);
 
 	/**
 	 * set the Baudrate
@@ -237,7 +248,7 @@ private:
 	 * @param len length of the message
 	 * @param msg_to_gps_device if true, this is a message sent to the gps device, otherwise it's from the device
 	 */
-	void dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device);
+	void dumpGpsData(const uint8_t *data, size_t len, bool msg_to_gps_device);
 
 	void initializeCommunicationDump();
 };
@@ -305,6 +316,8 @@ GPS::~GPS()
 		delete (_dump_from_device);
 	}
 
+	perf_free(_inject_perf);
+	perf_free(_dump_perf);
 }
 
 int GPS::callback(GPSCallbackType type, void *data1, int data2, void *user)
@@ -414,41 +427,48 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 void GPS::handleInjectDataTopic()
 {
-	bool updated = false;
-
-	// Limit maximum number of GPS injections to 6 since usually
+	// Limit maximum number of GPS injections to 6 (the topic queue length) since usually
 	// GPS injections should consist of 1-4 packets (GPS, Glonass, Baidu, Galileo).
 	// Looking at 6 packets thus guarantees, that at least a full injection
 	// data set is evaluated.
-	const size_t max_num_injections = 6;
+	const size_t max_num_injections = gps_inject_data_s::ORB_QUEUE_LENGTH;
 	size_t num_injections = 0;
+	size_t inject_len = 0;
 
-	do {
+	while (num_injections < max_num_injections && _orb_inject_data_sub.updated()) {
 		num_injections++;
-		updated = _orb_inject_data_sub.updated();
 
-		if (updated) {
-			gps_inject_data_s msg;
-			_orb_inject_data_sub.copy(&msg);
+		gps_inject_data_s msg;
 
-			/* Write the message to the gps device. Note that the message could be fragmented.
-			 * But as we don't write anywhere else to the device during operation, we don't
-			 * need to assemble the message first.
+		if (_orb_inject_data_sub.copy(&msg)) {
+			/* Append the message to the data for the gps device. Note that the message could
+			 * be fragmented. But as we don't write anywhere else to the device during operation,
+			 * we don't need to assemble the message first.
 			 */
-			injectData(msg.data, msg.len);
+			const size_t len = math::min((size_t)msg.len, sizeof(msg.data));
+			memcpy(&_inject_buffer[inject_len], msg.data, len);
+			inject_len += len;
 
 			++_last_rate_rtcm_injection_count;
 		}
-	} while (updated && num_injections < max_num_injections);
+	}
+
+	if (inject_len > 0) {
+		perf_begin(_inject_perf);
+		injectData(_inject_buffer, inject_len);
+		perf_end(_inject_perf);
+
+		_last_rate_rtcm_injection_bytes += inject_len;
+	}
 }
 
-bool GPS::injectData(uint8_t *data, size_t len)
+bool GPS::injectData(const uint8_t *data, size_t len)
 {
 	dumpGpsData(data, len, true);
 
-	size_t written = ::write(_serial_fd, data, len);
+	ssize_t written = ::write(_serial_fd, data, len);
 	::fsync(_serial_fd);
-	return written == len;
+	return written == (ssize_t)len;
 }
 
 int GPS::setBaudrate(unsigned baud)
@@ -566,12 +586,14 @@ void GPS::initializeCommunicationDump()
 	_should_dump_communication = true;
 }
 
-void GPS::dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device)
+void GPS::dumpGpsData(const uint8_t *data, size_t len, bool msg_to_gps_device)
 {
 	if (!_should_dump_communication) {
 		return;
 	}
 
+	perf_begin(_dump_perf);
+
 	gps_dump_s *dump_data = msg_to_gps_device ? _dump_to_device : _dump_from_device;
 
 	while (len > 0) {
@@ -596,6 +618,8 @@ void GPS::dumpGpsData(uint8_t *data, size_t len, bool msg_to_gps_device)
 			dump_data->len = 0;
 		}
 	}
+
+	perf_end(_dump_perf);
 }
 
 void
@@ -754,9 +778,11 @@ GPS::run()
 						float dt = (float)((hrt_absolute_time() - last_rate_measurement)) / 1000000.0f;
 						_rate = last_rate_count / dt;
 						_rate_rtcm_injection = _last_rate_rtcm_injection_count / dt;
+						_rate_rtcm_injection_bytes = _last_rate_rtcm_injection_bytes / dt;
 						last_rate_measurement = hrt_absolute_time();
 						last_rate_count = 0;
 						_last_rate_rtcm_injection_count = 0;
+						_last_rate_rtcm_injection_bytes = 0;
 						_helper->storeUpdateRates();
 						_helper->resetUpdateRates();
 					}
@@ -795,6 +821,7 @@ GPS::run()
 					_healthy = false;
 					_rate = 0.0f;
 					_rate_rtcm_injection = 0.0f;
+					_rate_rtcm_injection_bytes = 0.0f;
 				}
 			}
 
@@ -893,12 +920,21 @@ GPS::print_status()
 
 		if (!_fake_gps) {
 			PX4_INFO("rate publication:\t\t%6.2f Hz", (double)_rate);
-			PX4_INFO("rate RTCM injection:\t%6.2f Hz", (double)_rate_rtcm_injection);
+			PX4_INFO("rate RTCM injection:\t%6.2f Hz, %6.0f B/s", (double)_rate_rtcm_injection,
+				 (double)_rate_rtcm_injection_bytes);
 		}
 
 		print_message(_report_gps_pos);
 	}
 
+	if (!_fake_gps) {
+		perf_print_counter(_inject_perf);
+
+		if (_should_dump_communication) {
+			perf_print_counter(_dump_perf);
+		}
+	}
+
 	if (_instance == Instance::Main && _secondary_instance) {
 		GPS *secondary_instance = (GPS *)_secondary_instance;
 		secondary_instance->print_status();
@@ -254,7 +254,6 @@ BMM150::BMM150(int bus, const char *path, enum Rotation rotation) :
 	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id())),
 	_running(false),
 	_call_interval(0),
-	_reports(nullptr),
 	_collect_phase(false),
 	_scale{},
 	_range_scale(0.01), /* default range scale from from uT to gauss */
@@ -300,11 +299,6 @@ BMM150 :: ~BMM150()
 	/* make sure we are truly inactive */
 	stop();
 
-	/* free any existing reports */
-	if (_reports != nullptr) {
-		delete _reports;
-	}
-
 
 	if (_class_instance != -1) {
 		unregister_class_devname(MAG_BASE_DEVICE_PATH, _class_instance);
@@ -338,13 +332,6 @@ int BMM150::init()
 		return ret;
 	}
 
-	/* allocate basic report buffers */
-	_reports = new ringbuffer::RingBuffer(2, sizeof(mag_report));
-
-	if (_reports == nullptr) {
-		goto out;
-	}
-
 	/* Bring the device to sleep mode */
 	modify_reg(BMM150_POWER_CTRL_REG, 1, 1);
 	up_udelay(10000);
@@ -376,7 +363,7 @@ int BMM150::init()
 
 	/* advertise sensor topic, measure manually to initialize valid report */
 	struct mag_report mrb;
-	_reports->get(&mrb);
+	_reports.get(mrb);
 
 	/* measurement will have generated a report, publish */
 	_topic = orb_advertise_multi(ORB_ID(sensor_mag), &mrb,
@@ -410,7 +397,7 @@ BMM150::start()
 	/* reset the report ring and state machine */
 	_collect_phase = false;
 	_running = true;
-	_reports->flush();
+	_reports.flush();
 
 	/* schedule a cycle to start things */
 	ScheduleNow();
@@ -442,12 +429,7 @@ BMM150::read(struct file *filp, char *buffer, size_t buflen)
 		 * Note that we may be pre-empted by the workq thread while we are doing this;
 		 * we are careful to avoid racing with them.
 		 */
-		while (count--) {
-			if (_reports->get(mag_buf)) {
-				ret += sizeof(struct mag_report);
-				mag_buf++;
-			}
-		}
+		ret = _reports.get(mag_buf, count) * sizeof(struct mag_report);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -456,7 +438,7 @@ BMM150::read(struct file *filp, char *buffer, size_t buflen)
 	/* manual measurement - run one conversion */
 	/* XXX really it'd be nice to lock against other readers here */
 	do {
-		_reports->flush();
+		_reports.flush();
 
 		/* trigger a measurement */
 		if (OK != measure()) {
@@ -474,7 +456,7 @@ BMM150::read(struct file *filp, char *buffer, size_t buflen)
 		}
 
 
-		if (_reports->get(mag_buf)) {
+		if (_reports.get(*mag_buf)) {
 			ret = sizeof(struct mag_report);
 		}
 	} while (0);
@@ -687,7 +669,7 @@ BMM150::collect()
 	_last_report.y = mrb.y;
 	_last_report.z = mrb.z;
 
-	_reports->force(&mrb);
+	_reports.force(mrb);
 
 	/* notify anyone waiting for data */
 	if (mag_notify) {
@@ -1029,7 +1011,7 @@ BMM150::print_info()
 	perf_print_counter(_sample_perf);
 	perf_print_counter(_bad_transfers);
 	perf_print_counter(_good_transfers);
-	_reports->print_info("mag queue");
+	_reports.print_info("mag queue");
 
 	printf("output  (%.2f %.2f %.2f)\n", (double)_last_report.x, (double)_last_report.y, (double)_last_report.z);
 	printf("offsets (%.2f %.2f %.2f)\n", (double)_scale.x_offset, (double)_scale.y_offset, (double)_scale.z_offset);
@@ -29,7 +29,7 @@
 #include <board_config.h>
 #include <drivers/drv_hrt.h>
 
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SpscRingBuffer.hpp>
 #include <drivers/device/integrator.h>
 #include <drivers/device/i2c.h>
 #include <drivers/drv_mag.h>
@@ -225,7 +225,7 @@ private:
 
 
 	mag_report _report {};
-	ringbuffer::RingBuffer  *_reports;
+	ringbuffer::SpscRingBuffer<mag_report, 2>  _reports;
 
 	bool            _collect_phase;
 
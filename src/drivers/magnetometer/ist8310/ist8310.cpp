@@ -68,7 +68,7 @@
 #include <drivers/device/i2c.h>
 #include <drivers/drv_mag.h>
 #include <drivers/drv_hrt.h>
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SpscRingBuffer.hpp>
 #include <drivers/drv_device.h>
 
 #include <uORB/uORB.h>
@@ -206,7 +206,7 @@ private:
 
 	unsigned        _measure_interval{0};
 
-	ringbuffer::RingBuffer  *_reports{nullptr};
+	ringbuffer::SpscRingBuffer<mag_report, 2>  _reports;
 
 	struct mag_calibration_s	_scale {};
 	float				_range_scale{0.003f}; /* default range scale from counts to gauss */
@@ -400,10 +400,6 @@ IST8310::~IST8310()
 	/* make sure we are truly inactive */
 	stop();
 
-	if (_reports != nullptr) {
-		delete _reports;
-	}
-
 	if (_class_instance != -1) {
 		unregister_class_devname(MAG_BASE_DEVICE_PATH, _class_instance);
 	}
@@ -427,13 +423,6 @@ IST8310::init()
 		goto out;
 	}
 
-	/* allocate basic report buffers */
-	_reports = new ringbuffer::RingBuffer(2, sizeof(mag_report));
-
-	if (_reports == nullptr) {
-		goto out;
-	}
-
 	/* reset the device configuration */
 	reset();
 
@@ -531,12 +520,7 @@ IST8310::read(struct file *filp, char *buffer, size_t buflen)
 		 * Note that we may be pre-empted by the workq thread while we are doing this;
 		 * we are careful to avoid racing with them.
 		 */
-		while (count--) {
-			if (_reports->get(mag_buf)) {
-				ret += sizeof(struct mag_report);
-				mag_buf++;
-			}
-		}
+		ret = _reports.get(mag_buf, count) * sizeof(struct mag_report);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -545,7 +529,7 @@ IST8310::read(struct file *filp, char *buffer, size_t buflen)
 	/* manual measurement - run one conversion */
 	/* XXX really it'd be nice to lock against other readers here */
 	do {
-		_reports->flush();
+		_reports.flush();
 
 		/* trigger a measurement */
 		if (OK != measure()) {
@@ -562,7 +546,7 @@ IST8310::read(struct file *filp, char *buffer, size_t buflen)
 			break;
 		}
 
-		if (_reports->get(mag_buf)) {
+		if (_reports.get(*mag_buf)) {
 			ret = sizeof(struct mag_report);
 		}
 	} while (0);
@@ -656,7 +640,7 @@ IST8310::start()
 {
 	/* reset the report ring and state machine */
 	_collect_phase = false;
-	_reports->flush();
+	_reports.flush();
 
 	/* schedule a cycle to start things */
 	ScheduleNow();
@@ -872,7 +856,7 @@ IST8310::collect()
 	_last_report = new_report;
 
 	/* post a report to the ring */
-	_reports->force(&new_report);
+	_reports.force(new_report);
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
@@ -1117,7 +1101,7 @@ IST8310::print_info()
 	perf_print_counter(_comms_errors);
 	printf("poll interval:  %u interval\n", _measure_interval);
 	print_message(_last_report);
-	_reports->print_info("report queue");
+	_reports.print_info("report queue");
 }
 
 /**
@@ -46,7 +46,6 @@ LIS3MDL::LIS3MDL(device::Device *interface, const char *path, enum Rotation rota
 	CDev("LIS3MDL", path),
 	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(interface->get_device_id())),
 	_interface(interface),
-	_reports(nullptr),
 	_scale{},
 	_last_report{},
 	_mag_topic(nullptr),
@@ -98,10 +97,6 @@ LIS3MDL::~LIS3MDL()
 		orb_unadvertise(_mag_topic);
 	}
 
-	if (_reports != nullptr) {
-		delete _reports;
-	}
-
 	if (_class_instance != -1) {
 		unregister_class_devname(MAG_BASE_DEVICE_PATH, _class_instance);
 	}
@@ -426,7 +421,7 @@ LIS3MDL::collect()
 	_last_report = new_mag_report;
 
 	/* post a report to the ring */
-	_reports->force(&new_mag_report);
+	_reports.force(new_mag_report);
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
@@ -476,13 +471,6 @@ LIS3MDL::init()
 		return ret;
 	}
 
-	/* allocate basic report buffers */
-	_reports = new ringbuffer::RingBuffer(2, sizeof(mag_report));
-
-	if (_reports == nullptr) {
-		return PX4_ERROR;
-	}
-
 	/* reset the device configuration */
 	reset();
 
@@ -605,7 +593,7 @@ LIS3MDL::print_info()
 	perf_print_counter(_comms_errors);
 	PX4_INFO("poll interval:  %u", _measure_interval);
 	print_message(_last_report);
-	_reports->print_info("report queue");
+	_reports.print_info("report queue");
 }
 
 int
@@ -647,12 +635,7 @@ LIS3MDL::read(struct file *file_pointer, char *buffer, size_t buffer_len)
 		 * Note that we may be pre-empted by the workq thread while we are doing this;
 		 * we are careful to avoid racing with them.
 		 */
-		while (count--) {
-			if (_reports->get(mag_buf)) {
-				ret += sizeof(struct mag_report);
-				mag_buf++;
-			}
-		}
+		ret = _reports.get(mag_buf, count) * sizeof(struct mag_report);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -661,7 +644,7 @@ LIS3MDL::read(struct file *file_pointer, char *buffer, size_t buffer_len)
 	/* manual measurement - run one conversion */
 	/* XXX really it'd be nice to lock against other readers here */
 	do {
-		_reports->flush();
+		_reports.flush();
 
 		/* trigger a measurement */
 		if (measure() != OK) {
@@ -678,7 +661,7 @@ LIS3MDL::read(struct file *file_pointer, char *buffer, size_t buffer_len)
 			break;
 		}
 
-		if (_reports->get(mag_buf)) {
+		if (_reports.get(*mag_buf)) {
 			ret = sizeof(struct mag_report);
 		}
 	} while (0);
@@ -785,7 +768,7 @@ void
 LIS3MDL::start()
 {
 	/* reset the report ring and state machine */
-	_reports->flush();
+	_reports.flush();
 
 	set_default_register_values();
 
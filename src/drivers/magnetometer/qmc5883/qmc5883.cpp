@@ -66,7 +66,7 @@
 
 #include <drivers/drv_mag.h>
 #include <drivers/drv_hrt.h>
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SpscRingBuffer.hpp>
 #include <drivers/drv_device.h>
 
 #include <uORB/uORB.h>
@@ -161,7 +161,7 @@ protected:
 private:
 	unsigned		_measure_interval{0};
 
-	ringbuffer::RingBuffer	*_reports;
+	ringbuffer::SpscRingBuffer<mag_report, 2>	_reports;
 	struct mag_calibration_s	_scale;
 	float 			_range_scale;
 	float 			_range_ga;
@@ -263,7 +263,6 @@ QMC5883::QMC5883(device::Device *interface, const char *path, enum Rotation rota
 	CDev("QMC5883", path),
 	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(interface->get_device_id())),
 	_interface(interface),
-	_reports(nullptr),
 	_scale{},
 	_range_scale(1.0f / 12000.0f),
 	_range_ga(2.0f),
@@ -302,10 +301,6 @@ QMC5883::~QMC5883()
 	/* make sure we are truly inactive */
 	stop();
 
-	if (_reports != nullptr) {
-		delete _reports;
-	}
-
 	if (_class_instance != -1) {
 		unregister_class_devname(MAG_BASE_DEVICE_PATH, _class_instance);
 	}
@@ -329,13 +324,6 @@ QMC5883::init()
 		goto out;
 	}
 
-	/* allocate basic report buffers */
-	_reports = new ringbuffer::RingBuffer(2, sizeof(mag_report));
-
-	if (_reports == nullptr) {
-		goto out;
-	}
-
 	/* reset the device configuration */
 	reset();
 
@@ -394,12 +382,7 @@ QMC5883::read(struct file *filp, char *buffer, size_t buflen)
 		 * Note that we may be pre-empted by the workq thread while we are doing this;
 		 * we are careful to avoid racing with them.
 		 */
-		while (count--) {
-			if (_reports->get(mag_buf)) {
-				ret += sizeof(struct mag_report);
-				mag_buf++;
-			}
-		}
+		ret = _reports.get(mag_buf, count) * sizeof(struct mag_report);
 
 		/* if there was no data, warn the caller */
 		return ret ? ret : -EAGAIN;
@@ -408,7 +391,7 @@ QMC5883::read(struct file *filp, char *buffer, size_t buflen)
 	/* manual measurement - run one conversion */
 	/* XXX really it'd be nice to lock against other readers here */
 	do {
-		_reports->flush();
+		_reports.flush();
 
 		/* wait for it to complete */
 		usleep(QMC5883_CONVERSION_INTERVAL);
@@ -419,7 +402,7 @@ QMC5883::read(struct file *filp, char *buffer, size_t buflen)
 			break;
 		}
 
-		if (_reports->get(mag_buf)) {
+		if (_reports.get(*mag_buf)) {
 			ret = sizeof(struct mag_report);
 		}
 	} while (0);
@@ -513,7 +496,7 @@ QMC5883::start()
 {
 	/* reset the report ring and state machine */
 	_collect_phase = false;
-	_reports->flush();
+	_reports.flush();
 
 	/* schedule a cycle to start things */
 	ScheduleNow();
@@ -745,7 +728,7 @@ QMC5883::collect()
 	_last_report = new_report;
 
 	/* post a report to the ring */
-	_reports->force(&new_report);
+	_reports.force(new_report);
 
 	/* notify anyone waiting for data */
 	poll_notify(POLLIN);
@@ -794,7 +777,7 @@ QMC5883::print_info()
 	perf_print_counter(_comms_errors);
 	printf("poll interval:  %u us\n", _measure_interval);
 	print_message(_last_report);
-	_reports->print_info("report queue");
+	_reports.print_info("report queue");
 }
 
 /**
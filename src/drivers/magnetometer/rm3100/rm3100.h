@@ -42,7 +42,7 @@
 #include <float.h>
 
 #include <drivers/device/i2c.h>
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SpscRingBuffer.hpp>
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_mag.h>
 
@@ -148,7 +148,7 @@ protected:
 
 private:
 
-	ringbuffer::RingBuffer *_reports;
+	ringbuffer::SpscRingBuffer<mag_report, 2> _reports;
 
 	struct mag_calibration_s _scale;
 
@@ -77,7 +77,7 @@
 
 #include <drivers/drv_device.h>
 #include <drivers/device/device.h>
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SpscRingBuffer.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -248,7 +248,7 @@ private:
 	uint32_t _last_width;
 	hrt_abstime _last_poll_time;
 	hrt_abstime _last_read_time;
-	ringbuffer::RingBuffer *_reports;
+	ringbuffer::SpscRingBuffer<pwm_input_s, 2> _reports;	/* written from the timer ISR, read in read() */
 	bool _timer_started;
 
 	hrt_call _hard_reset_call;	/* HRT callout for note completion */
@@ -277,16 +277,12 @@ PWMIN::PWMIN() :
 	_pulses_captured(0),
 	_last_period(0),
 	_last_width(0),
-	_reports(nullptr),
 	_timer_started(false)
 {
 }
 
 PWMIN::~PWMIN()
 {
-	if (_reports != nullptr) {
-		delete _reports;
-	}
 }
 
 /*
@@ -302,12 +298,6 @@ PWMIN::init()
 	 * activate the timer when requested to when the device is opened */
 	CDev::init();
 
-	_reports = new ringbuffer::RingBuffer(2, sizeof(struct pwm_input_s));
-
-	if (_reports == nullptr) {
-		return -ENOMEM;
-	}
-
 	/* Schedule freeze check to invoke periodically */
 	hrt_call_every(&_freeze_test_call, 0, TIMEOUT_POLL, reinterpret_cast<hrt_callout>(&PWMIN::_freeze_test), this);
 
@@ -471,12 +461,7 @@ PWMIN::read(struct file *filp, char *buffer, size_t buflen)
 		return -ENOSPC;
 	}
 
-	while (count--) {
-		if (_reports->get(buf)) {
-			ret += sizeof(struct pwm_input_s);
-			buf++;
-		}
-	}
+	ret = _reports.get(buf, count) * sizeof(struct pwm_input_s);
 
 	/* if there was no data, warn the caller */
 	return ret ? ret : -EAGAIN;
@@ -501,7 +486,7 @@ void PWMIN::publish(uint16_t status, uint32_t period, uint32_t pulse_width)
 	pwmin_report.period = period;
 	pwmin_report.pulse_width = pulse_width;
 
-	_reports->force(&pwmin_report);
+	_reports.force(pwmin_report);
 }
 
 /*
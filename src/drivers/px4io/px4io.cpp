@@ -94,6 +94,7 @@
 #include <debug.h>
 
 #include <modules/px4iofirmware/protocol.h>
+#include <px4io_batch/px4io_batch.h>
 
 #include "uploader.h"
 
@@ -243,6 +244,21 @@ private:
 	perf_counter_t		_perf_update;		///< local performance counter for status updates
 	perf_counter_t		_perf_write;		///< local performance counter for PWM control writes
 	perf_counter_t		_perf_sample_latency;	///< total system latency (based on passed-through timestamp)
+	perf_counter_t		_perf_io_latency;	///< latency from actuator_controls sample until the controls are on IO
+
+	/* batched register transactions */
+	PX4IOBatch		_batch;			///< register accesses queued for the next transaction
+	int			_batch_result{OK};	///< first error of the transactions since io_batch_flush()
+	bool			_batch_reads_valid{true};	///< all reads since io_batch_flush() were delivered
+	hrt_abstime		_controls_sample{0};	///< sample timestamp of the queued group 0 controls
+
+	/* registers fetched from IO in the poll cycle */
+	struct {
+		uint16_t	status[6];
+		uint16_t	raw_rc[(PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT) + input_rc_s::RC_INPUT_MAX_CHANNELS];
+		uint16_t	servos[16];
+		uint16_t	mixer;
+	} _poll_regs{};
 
 	/* cached IO state */
 	uint16_t		_status;		///< Various IO status flags
@@ -298,17 +314,17 @@ private:
 	void			task_main();
 
 	/**
-	 * Send controls for one group to IO
+	 * Queue controls for one group for IO
 	 */
 	int			io_set_control_state(unsigned group);
 
 	/**
-	 * Send all controls to IO
+	 * Queue all controls for IO
 	 */
 	int			io_set_control_groups();
 
 	/**
-	 * Update IO's arming-related state
+	 * Queue an update of IO's arming-related state
 	 */
 	int			io_set_arming_state();
 
@@ -330,7 +346,18 @@ private:
 	int			io_disable_rc_handling();
 
 	/**
-	 * Fetch RC inputs from IO.
+	 * Queue the reads of status, RC input, PWM outputs and mixer status for
+	 * the poll cycle. The values are handled by io_handle_poll().
+	 */
+	void			io_queue_poll();
+
+	/**
+	 * Handle and publish the registers fetched in the poll cycle.
+	 */
+	void			io_handle_poll();
+
+	/**
+	 * Decode RC inputs fetched from IO, reading the channels beyond the first 9.
 	 *
 	 * @param input_rc	Input structure to populate.
 	 * @return		OK if data was returned.
@@ -338,12 +365,12 @@ private:
 	int			io_get_raw_rc_input(input_rc_s &input_rc);
 
 	/**
-	 * Fetch and publish raw RC input data.
+	 * Publish raw RC input data fetched from IO.
 	 */
 	int			io_publish_raw_rc();
 
 	/**
-	 * Fetch and publish the PWM servo outputs.
+	 * Publish the PWM servo outputs fetched from IO.
 	 */
 	int			io_publish_pwm_outputs();
 
@@ -399,6 +426,40 @@ private:
 	 */
 	int			io_reg_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits);
 
+	/**
+	 * Queue a register write for the next batched transaction.
+	 *
+	 * A full batch is sent first to make room; the result of the transactions is
+	 * returned by io_batch_flush().
+	 */
+	void			io_batch_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+	void			io_batch_set(uint8_t page, uint8_t offset, uint16_t value) { io_batch_set(page, offset, &value, 1); }
+
+	/**
+	 * Queue a register read for the next batched transaction. values must stay
+	 * valid until io_batch_flush() returned.
+	 */
+	void			io_batch_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values);
+
+	/**
+	 * Queue a register modification, applied on IO, for the next batched transaction.
+	 */
+	void			io_batch_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits);
+
+	/**
+	 * Send the queued register accesses to IO.
+	 *
+	 * @param reads_valid	if not null, set to whether all reads since the last flush were
+	 *			delivered, regardless of failed writes.
+	 * @return		OK if all transactions since the last flush succeeded.
+	 */
+	int			io_batch_flush(bool *reads_valid = nullptr);
+
+	/**
+	 * Send the queued register accesses without resetting the result.
+	 */
+	void			io_batch_send();
+
 	/**
 	 * Send mixer definition text to IO
 	 */
@@ -470,6 +531,7 @@ PX4IO::PX4IO(device::Device *interface) :
 	_perf_update(perf_alloc(PC_ELAPSED, "io update")),
 	_perf_write(perf_alloc(PC_ELAPSED, "io write")),
 	_perf_sample_latency(perf_alloc(PC_ELAPSED, "io control latency")),
+	_perf_io_latency(perf_alloc(PC_ELAPSED, "io output latency")),
 	_status(0),
 	_alarms(0),
 	_last_written_arming_s(0),
@@ -518,6 +580,7 @@ PX4IO::~PX4IO()
 	perf_free(_perf_update);
 	perf_free(_perf_write);
 	perf_free(_perf_sample_latency);
+	perf_free(_perf_io_latency);
 
 	g_dev = nullptr;
 }
@@ -938,6 +1001,12 @@ PX4IO::task_main()
 		perf_begin(_perf_update);
 		hrt_abstime now = hrt_absolute_time();
 
+		/*
+		 * Controls, the poll cycle reads and the arming state are queued and
+		 * exchanged with IO in a single batched transaction.
+		 */
+		_controls_sample = 0;
+
 		/* if we have new control data from the ORB, handle it */
 		if (fds[0].revents & POLLIN) {
 
@@ -946,18 +1015,15 @@ PX4IO::task_main()
 			(void)io_set_control_groups();
 		}
 
+		bool polling = false;
+
 		if (now >= poll_last + IO_POLL_INTERVAL) {
 			/* run at 50-250Hz */
 			poll_last = now;
+			polling = true;
 
-			/* pull status and alarms from IO */
-			io_get_status();
-
-			/* get raw R/C input from IO */
-			io_publish_raw_rc();
-
-			/* fetch PWM outputs from IO */
-			io_publish_pwm_outputs();
+			/* pull status, alarms, raw R/C input, PWM outputs and mixer status from IO */
+			io_queue_poll();
 
 			/* check updates on uORB topics and handle it */
 			bool updated = false;
@@ -974,6 +1040,17 @@ PX4IO::task_main()
 			}
 		}
 
+		bool reads_valid = false;
+
+		if (io_batch_flush(&reads_valid) == OK && _controls_sample != 0) {
+			perf_set_elapsed(_perf_io_latency, hrt_elapsed_time(&_controls_sample));
+		}
+
+		/* a rejected write must not starve status and RC input */
+		if (polling && reads_valid) {
+			io_handle_poll();
+		}
+
 		if (!_armed && (now >= orb_check_last + ORB_CHECK_INTERVAL)) {
 			/* run at 5Hz */
 			orb_check_last = now;
@@ -1030,12 +1107,12 @@ PX4IO::task_main()
 				/* Check if the IO safety circuit breaker has been updated */
 				bool circuit_breaker_io_safety_enabled = circuit_breaker_enabled("CBRK_IO_SAFETY", CBRK_IO_SAFETY_KEY);
 				/* Bypass IO safety switch logic by setting FORCE_SAFETY_OFF */
-				(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FORCE_SAFETY_OFF, circuit_breaker_io_safety_enabled);
+				io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FORCE_SAFETY_OFF, circuit_breaker_io_safety_enabled);
 
 				/* Check if the flight termination circuit breaker has been updated */
 				_cb_flighttermination = circuit_breaker_enabled("CBRK_FLIGHTTERM", CBRK_FLIGHTTERM_KEY);
 				/* Tell IO that it can terminate the flight if FMU is not responding or if a failure has been reported by the FailureDetector logic */
-				(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ENABLE_FLIGHTTERMINATION, !_cb_flighttermination);
+				io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ENABLE_FLIGHTTERMINATION, !_cb_flighttermination);
 
 				param_get(param_find("RC_RSSI_PWM_CHAN"), &_rssi_pwm_chan);
 				param_get(param_find("RC_RSSI_PWM_MAX"), &_rssi_pwm_max);
@@ -1061,7 +1138,7 @@ PX4IO::task_main()
 							tctrl = PX4IO_THERMAL_OFF;
 						}
 
-						ret = io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_THERMAL, tctrl);
+						io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_THERMAL, tctrl);
 					}
 				}
 
@@ -1084,7 +1161,7 @@ PX4IO::task_main()
 					}
 				}
 
-				(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_REVERSE, pwm_invert_mask);
+				io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_REVERSE, pwm_invert_mask);
 
 				// update trim values
 				struct pwm_output_values pwm_values;
@@ -1108,7 +1185,7 @@ PX4IO::task_main()
 				}
 
 				/* copy values to registers in IO */
-				ret = io_reg_set(PX4IO_PAGE_CONTROL_TRIM_PWM, 0, pwm_values.values, _max_actuators);
+				io_batch_set(PX4IO_PAGE_CONTROL_TRIM_PWM, 0, pwm_values.values, _max_actuators);
 
 				float param_val;
 				param_t parm_handle;
@@ -1117,42 +1194,42 @@ PX4IO::task_main()
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_ROLL, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_ROLL, FLOAT_TO_REG(param_val));
 				}
 
 				parm_handle = param_find("TRIM_PITCH");
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_PITCH, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_PITCH, FLOAT_TO_REG(param_val));
 				}
 
 				parm_handle = param_find("TRIM_YAW");
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_YAW, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_TRIM_YAW, FLOAT_TO_REG(param_val));
 				}
 
 				parm_handle = param_find("FW_MAN_R_SC");
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_ROLL, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_ROLL, FLOAT_TO_REG(param_val));
 				}
 
 				parm_handle = param_find("FW_MAN_P_SC");
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_PITCH, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_PITCH, FLOAT_TO_REG(param_val));
 				}
 
 				parm_handle = param_find("FW_MAN_Y_SC");
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_YAW, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_SCALE_YAW, FLOAT_TO_REG(param_val));
 				}
 
 				/* S.BUS output */
@@ -1164,16 +1241,16 @@ PX4IO::task_main()
 
 					if (sbus_mode == 1) {
 						/* enable S.BUS 1 */
-						(void)io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES, 0, PX4IO_P_SETUP_FEATURES_SBUS1_OUT);
+						io_batch_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES, 0, PX4IO_P_SETUP_FEATURES_SBUS1_OUT);
 
 					} else if (sbus_mode == 2) {
 						/* enable S.BUS 2 */
-						(void)io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES, 0, PX4IO_P_SETUP_FEATURES_SBUS2_OUT);
+						io_batch_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES, 0, PX4IO_P_SETUP_FEATURES_SBUS2_OUT);
 
 					} else {
 						/* disable S.BUS */
-						(void)io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES,
-								    (PX4IO_P_SETUP_FEATURES_SBUS1_OUT | PX4IO_P_SETUP_FEATURES_SBUS2_OUT), 0);
+						io_batch_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_FEATURES,
+								(PX4IO_P_SETUP_FEATURES_SBUS1_OUT | PX4IO_P_SETUP_FEATURES_SBUS2_OUT), 0);
 					}
 				}
 
@@ -1182,7 +1259,7 @@ PX4IO::task_main()
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_THR_MDL_FAC, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_THR_MDL_FAC, FLOAT_TO_REG(param_val));
 				}
 
 				/* maximum motor pwm slew rate */
@@ -1190,7 +1267,7 @@ PX4IO::task_main()
 
 				if (parm_handle != PARAM_INVALID) {
 					param_get(parm_handle, &param_val);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_MOTOR_SLEW_MAX, FLOAT_TO_REG(param_val));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_MOTOR_SLEW_MAX, FLOAT_TO_REG(param_val));
 				}
 
 				/* air-mode */
@@ -1199,8 +1276,11 @@ PX4IO::task_main()
 				if (parm_handle != PARAM_INVALID) {
 					int32_t param_val_int;
 					param_get(parm_handle, &param_val_int);
-					(void)io_reg_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_AIRMODE, SIGNED_TO_REG(param_val_int));
+					io_batch_set(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_AIRMODE, SIGNED_TO_REG(param_val_int));
 				}
+
+				/* send the parameter updates queued above */
+				(void)io_batch_flush();
 			}
 
 		}
@@ -1251,6 +1331,7 @@ PX4IO::io_set_control_state(unsigned group)
 			if (changed) {
 				orb_copy(ORB_ID(actuator_controls_0), _t_actuator_controls_0, &controls);
 				perf_set_elapsed(_perf_sample_latency, hrt_elapsed_time(&controls.timestamp_sample));
+				_controls_sample = controls.timestamp_sample;
 			}
 		}
 		break;
@@ -1296,12 +1377,14 @@ PX4IO::io_set_control_state(unsigned group)
 	}
 
 	if (!_test_fmu_fail) {
-		/* copy values to registers in IO */
-		return io_reg_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
+		/* queue values for the registers in IO */
+		io_batch_set(PX4IO_PAGE_CONTROLS, group * PX4IO_PROTOCOL_MAX_CONTROL_COUNT, regs, _max_controls);
 
 	} else {
-		return OK;
+		_controls_sample = 0;
 	}
+
+	return OK;
 }
 
 int
@@ -1379,7 +1462,7 @@ PX4IO::io_set_arming_state()
 	if (_last_written_arming_s != set || _last_written_arming_c != clear) {
 		_last_written_arming_s = set;
 		_last_written_arming_c = clear;
-		return io_reg_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, clear, set);
+		io_batch_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, clear, set);
 	}
 
 	return 0;
@@ -1686,28 +1769,54 @@ PX4IO::io_get_status()
 	return ret;
 }
 
+void
+PX4IO::io_queue_poll()
+{
+	/* get
+	 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
+	 * STATUS_VSERVO, STATUS_VRSSI, STATUS_PRSSI
+	 * in that order */
+	io_batch_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &_poll_regs.status[0],
+		     sizeof(_poll_regs.status) / sizeof(_poll_regs.status[0]));
+
+	/*
+	 * Read the channel count and the first 9 channels.
+	 *
+	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
+	 */
+	io_batch_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &_poll_regs.raw_rc[0],
+		     (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT) + 9);
+
+	/* get servo values and mixer status flags */
+	io_batch_get(PX4IO_PAGE_SERVOS, 0, &_poll_regs.servos[0], _max_actuators);
+	io_batch_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &_poll_regs.mixer, 1);
+}
+
+void
+PX4IO::io_handle_poll()
+{
+	io_handle_status(_poll_regs.status[0]);
+	io_handle_alarms(_poll_regs.status[1]);
+
+	io_handle_vservo(_poll_regs.status[4], _poll_regs.status[5]);
+
+	io_publish_raw_rc();
+
+	io_publish_pwm_outputs();
+}
+
 int
 PX4IO::io_get_raw_rc_input(input_rc_s &input_rc)
 {
 	uint32_t channel_count;
-	int	ret;
+	int	ret = OK;
 
 	/* we don't have the status bits, so input_source has to be set elsewhere */
 	input_rc.input_source = input_rc_s::RC_INPUT_SOURCE_UNKNOWN;
 
+	/* channel count and the first 9 channels were fetched by io_queue_poll() */
 	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
-	uint16_t regs[input_rc_s::RC_INPUT_MAX_CHANNELS + prolog];
-
-	/*
-	 * Read the channel count and the first 9 channels.
-	 *
-	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
-	 */
-	ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
-
-	if (ret != OK) {
-		return ret;
-	}
+	uint16_t *regs = &_poll_regs.raw_rc[0];
 
 	/*
 	 * Get the channel count any any extra channels. This is no more expensive than reading the
@@ -1836,13 +1945,8 @@ PX4IO::io_publish_raw_rc()
 int
 PX4IO::io_publish_pwm_outputs()
 {
-	/* get servo values from IO */
-	uint16_t ctl[_max_actuators];
-	int ret = io_reg_get(PX4IO_PAGE_SERVOS, 0, ctl, _max_actuators);
-
-	if (ret != OK) {
-		return ret;
-	}
+	/* servo values were fetched by io_queue_poll() */
+	const uint16_t *ctl = &_poll_regs.servos[0];
 
 	actuator_outputs_s outputs = {};
 	outputs.timestamp = hrt_absolute_time();
@@ -1855,13 +1959,9 @@ PX4IO::io_publish_pwm_outputs()
 
 	_to_outputs.publish(outputs);
 
-	/* get mixer status flags from IO */
+	/* mixer status flags from IO */
 	MultirotorMixer::saturation_status saturation_status;
-	ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &saturation_status.value, 1);
-
-	if (ret != OK) {
-		return ret;
-	}
+	saturation_status.value = _poll_regs.mixer;
 
 	/* publish mixer status */
 	if (saturation_status.flags.valid) {
@@ -1949,6 +2049,90 @@ PX4IO::io_reg_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t
 	return io_reg_set(page, offset, value);
 }
 
+void
+PX4IO::io_batch_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	if (!_batch.add_write(page, offset, values, num_values)) {
+		/* make room and try again, a write too large for any batch goes out on its own */
+		io_batch_send();
+
+		if (!_batch.add_write(page, offset, values, num_values) && io_reg_set(page, offset, values, num_values) != OK
+		    && _batch_result == OK) {
+			_batch_result = -EIO;
+		}
+	}
+}
+
+void
+PX4IO::io_batch_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
+{
+	if (!_batch.add_read(page, offset, values, num_values)) {
+		io_batch_send();
+
+		if (!_batch.add_read(page, offset, values, num_values) && io_reg_get(page, offset, values, num_values) != OK) {
+			_batch_reads_valid = false;
+
+			if (_batch_result == OK) {
+				_batch_result = -EIO;
+			}
+		}
+	}
+}
+
+void
+PX4IO::io_batch_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits)
+{
+	if (!_batch.add_modify(page, offset, clearbits, setbits)) {
+		io_batch_send();
+		(void)_batch.add_modify(page, offset, clearbits, setbits);
+	}
+}
+
+void
+PX4IO::io_batch_send()
+{
+	if (_batch.empty()) {
+		return;
+	}
+
+#ifdef PX4IO_SERIAL_BASE
+	int ret = PX4IO_serial_batch(_interface, _batch);
+#else
+	int ret = -ENOTSUP;
+#endif
+
+	if (ret != OK) {
+		PX4_DEBUG("io_batch(%u regs): error %d, failed entries 0x%04x", _batch.request_count(), ret,
+			  _batch.failed_entries());
+
+		if (_batch_result == OK) {
+			_batch_result = ret;
+		}
+
+		if (!_batch.reads_valid()) {
+			_batch_reads_valid = false;
+		}
+	}
+
+	_batch.reset();
+}
+
+int
+PX4IO::io_batch_flush(bool *reads_valid)
+{
+	io_batch_send();
+
+	if (reads_valid != nullptr) {
+		*reads_valid = _batch_reads_valid;
+	}
+
+	int ret = _batch_result;
+	_batch_result = OK;
+	_batch_reads_valid = true;
+
+	return ret;
+}
+
 int
 PX4IO::print_debug()
 {
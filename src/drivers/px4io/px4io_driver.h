@@ -43,6 +43,13 @@
 
 #ifdef PX4IO_SERIAL_BASE
 #include <drivers/device/device.h>
+#include <px4io_batch/px4io_batch.h>
 
 device::Device	*PX4IO_serial_interface();
+
+/**
+ * Exchange a batch of register reads and writes with IO in one transaction.
+ * @param interface	interface returned by PX4IO_serial_interface()
+ */
+int		PX4IO_serial_batch(device::Device *interface, PX4IOBatch &batch);
 #endif
@@ -49,6 +49,12 @@ device::Device
 	return new ArchPX4IOSerial();
 }
 
+int
+PX4IO_serial_batch(device::Device *interface, PX4IOBatch &batch)
+{
+	return static_cast<PX4IO_serial *>(interface)->batch(batch);
+}
+
 PX4IO_serial::PX4IO_serial() :
 	Device("PX4IO_serial"),
 	_pc_txns(perf_alloc(PC_ELAPSED, "io_txns")),
@@ -228,3 +234,50 @@ PX4IO_serial::read(unsigned address, void *data, unsigned count)
 
 	return result;
 }
+
+int
+PX4IO_serial::batch(PX4IOBatch &batch)
+{
+	if (batch.empty()) {
+		return OK;
+	}
+
+	px4_sem_wait(&_bus_semaphore);
+
+	int result;
+
+	/*
+	 * Retrying is safe: writes are idempotent and modify entries set and clear
+	 * fixed bits, so a batch that was applied but whose reply got lost has the
+	 * same effect when repeated.
+	 */
+	for (unsigned retries = 0; retries < 3; retries++) {
+
+		batch.encode(*_io_buffer_ptr);
+
+		_io_buffer_ptr->crc = 0;
+		_io_buffer_ptr->crc = crc_packet(_io_buffer_ptr);
+
+		/* start the transaction and wait for it to complete */
+		result = _bus_exchange(_io_buffer_ptr);
+
+		/* successful transaction? */
+		if (result == OK) {
+
+			/* check the result code and copy back the read registers - no point retrying on error */
+			result = batch.decode(*_io_buffer_ptr);
+
+			if (result != OK) {
+				perf_count(_pc_protoerrs);
+			}
+
+			break;
+		}
+
+		perf_count(_pc_retries);
+	}
+
+	px4_sem_post(&_bus_semaphore);
+
+	return result;
+}
@@ -84,6 +84,15 @@ CollisionPrevention::CollisionPrevention(ModuleParams *parent) :
 		_data_timestamps[i] = current_time;
 		_data_maxranges[i] = 0;
 		_obstacle_map_body_frame.distances[i] = UINT16_MAX;
+
+		// the bins are fixed in body frame, precompute their directions once
+		const float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
+		_bin_cos[i] = cosf(angle);
+		_bin_sin[i] = sinf(angle);
+	}
+
+	if (_param_mpc_col_prev_map.get() > 0) {
+		_occupancy_map.init(_param_mpc_col_prev_map.get() * 1024);
 	}
 }
 
@@ -190,6 +199,17 @@ void
 CollisionPrevention::_updateObstacleMap()
 {
 	_sub_vehicle_attitude.update();
+	_sub_vehicle_local_position.update();
+
+	const vehicle_local_position_s &local_position = _sub_vehicle_local_position.get();
+	const bool map_active = _occupancy_map.isInitialized() && local_position.xy_valid && local_position.z_valid;
+
+	if (_occupancy_map.isInitialized()) {
+		_maintainOccupancyMap(local_position);
+	}
+
+	const Vector3f position(local_position.x, local_position.y, local_position.z);
+	const Quatf attitude(_sub_vehicle_attitude.get().q);
 
 	// add distance sensor data
 	for (unsigned i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
@@ -211,7 +231,13 @@ CollisionPrevention::_updateObstacleMap()
 				_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
 									(uint16_t)(distance_sensor.min_distance * 100.0f));
 
-				_addDistanceSensorData(distance_sensor, Quatf(_sub_vehicle_attitude.get().q));
+				_addDistanceSensorData(distance_sensor, attitude);
+
+				if (map_active && distance_sensor.current_distance > distance_sensor.min_distance) {
+					const float yaw_offset = _sensorOrientationToYawOffset(distance_sensor, _obstacle_map_body_frame.angle_offset);
+					const Vector3f direction = Dcmf(attitude) * Vector3f(cosf(yaw_offset), sinf(yaw_offset), 0.f);
+					_addOccupancyMapData(position, direction, distance_sensor.current_distance, distance_sensor.max_distance);
+				}
 			}
 		}
 	}
@@ -228,14 +254,97 @@ CollisionPrevention::_updateObstacleMap()
 								(int)obstacle_distance.max_distance);
 			_obstacle_map_body_frame.min_distance = math::min((int)_obstacle_map_body_frame.min_distance,
 								(int)obstacle_distance.min_distance);
-			_addObstacleSensorData(obstacle_distance, Quatf(_sub_vehicle_attitude.get().q));
+			_addObstacleSensorData(obstacle_distance, attitude);
+
+			if (map_active) {
+				// the message is planar, insert it at the vehicle altitude
+				const float yaw_offset_deg = (obstacle_distance.frame == obstacle_distance.MAV_FRAME_BODY_FRD) ?
+							     math::degrees(Eulerf(attitude).psi()) : 0.f;
+				const int num_bins = math::min((int)(360.f / obstacle_distance.increment),
+							       (int)(sizeof(obstacle_distance.distances) / sizeof(obstacle_distance.distances[0])));
+
+				for (int i = 0; i < num_bins; i++) {
+					if (obstacle_distance.distances[i] != UINT16_MAX) {
+						const float angle = math::radians(yaw_offset_deg + obstacle_distance.angle_offset + i * obstacle_distance.increment);
+						_addOccupancyMapData(position, Vector3f(cosf(angle), sinf(angle), 0.f), obstacle_distance.distances[i] * 0.01f,
+								     obstacle_distance.max_distance * 0.01f);
+					}
+				}
+			}
 		}
 	}
 
+	if (map_active) {
+		_fillFromOccupancyMap(position, Eulerf(attitude).psi());
+	}
+
 	// publish fused obtacle distance message with data from offboard obstacle_distance and distance sensor
 	_obstacle_distance_pub.publish(_obstacle_map_body_frame);
 }
 
+void
+CollisionPrevention::_maintainOccupancyMap(const vehicle_local_position_s &local_position)
+{
+	// the voxels are stored in the local frame, which jumps with a position reset of the estimator
+	if (local_position.xy_reset_counter != _xy_reset_counter || local_position.z_reset_counter != _z_reset_counter) {
+		_occupancy_map.clear();
+		_xy_reset_counter = local_position.xy_reset_counter;
+		_z_reset_counter = local_position.z_reset_counter;
+	}
+
+	if (getElapsedTime(&_last_map_decay) >= MAP_DECAY_INTERVAL_US) {
+		_occupancy_map.decay(1);
+		_last_map_decay = getTime();
+	}
+}
+
+float
+CollisionPrevention::getMapObstacleDistance(const Vector3f &position, const Vector2f &direction, float max_range) const
+{
+	// Tilted sensors insert obstacles above and below the vehicle altitude, so a single voxel layer misses them.
+	// Search a slab instead: anything within the keep distance above or below blocks the way.
+	return _occupancy_map.raycast(position, Vector3f(direction(0), direction(1), 0.f), max_range,
+				      _param_mpc_col_prev_d.get());
+}
+
+void
+CollisionPrevention::_addOccupancyMapData(const Vector3f &position, const Vector3f &direction, float distance,
+		float max_distance)
+{
+	// readings at or beyond the maximum range only tell that the space in between is free
+	const bool hit = distance < max_distance;
+	_occupancy_map.insertRay(position, position + direction * math::min(distance, max_distance), hit);
+}
+
+void
+CollisionPrevention::_fillFromOccupancyMap(const Vector3f &position, float vehicle_yaw_angle_rad)
+{
+	const float max_range = _obstacle_map_body_frame.max_distance * 0.01f;
+
+	if (!(max_range > 0.f)) {
+		return;
+	}
+
+	const float cos_yaw = cosf(vehicle_yaw_angle_rad);
+	const float sin_yaw = sinf(vehicle_yaw_angle_rad);
+
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
+		if (_obstacle_map_body_frame.distances[i] != UINT16_MAX) {
+			continue;
+		}
+
+		const Vector2f bin_direction = _binDirection(i, cos_yaw, sin_yaw);
+		const float distance = getMapObstacleDistance(position, bin_direction, max_range);
+
+		if (PX4_ISFINITE(distance)) {
+			// the map remembers obstacles that are currently not in the field of view of any sensor
+			_obstacle_map_body_frame.distances[i] = (uint16_t)(100 * distance);
+			_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
+			_data_maxranges[i] = _obstacle_map_body_frame.max_distance;
+		}
+	}
+}
+
 void
 CollisionPrevention::_addDistanceSensorData(distance_sensor_s &distance_sensor, const matrix::Quatf &vehicle_attitude)
 {
@@ -314,10 +423,7 @@ CollisionPrevention::_adaptSetpointDirection(Vector2f &setpoint_dir, int &setpoi
 
 		if (bin_cost < best_cost && _obstacle_map_body_frame.distances[bin] != UINT16_MAX) {
 			best_cost = bin_cost;
-
-			float angle = math::radians((float)bin * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-			angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
-			setpoint_dir = {cosf(angle), sinf(angle)};
+			setpoint_dir = _binDirection(bin, cosf(vehicle_yaw_angle_rad), sinf(vehicle_yaw_angle_rad));
 			setpoint_index = bin;
 		}
 	}
@@ -403,25 +509,23 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 			// change setpoint direction slightly (max by _param_mpc_col_prev_cng degrees) to help guide through narrow gaps
 			_adaptSetpointDirection(setpoint_dir, sp_index, vehicle_yaw_angle_rad);
 
-			// limit speed for safe flight
-			for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) { // disregard unused bins at the end of the message
+			// delete stale values
+			_purgeStaleData(constrain_time);
 
-				// delete stale values
-				const hrt_abstime data_age = constrain_time - _data_timestamps[i];
-
-				if (data_age > RANGE_STREAM_TIMEOUT_US) {
-					_obstacle_map_body_frame.distances[i] = UINT16_MAX;
-				}
+			// only bins in the half plane of the setpoint direction can limit the speed
+			const float cos_yaw = cosf(vehicle_yaw_angle_rad);
+			const float sin_yaw = sinf(vehicle_yaw_angle_rad);
+			const int half_plane_bins = math::min(INTERNAL_MAP_USED_BINS / 4 + 1, INTERNAL_MAP_USED_BINS / 2);
 
+			// limit speed for safe flight
+			for (int j = sp_index - half_plane_bins; j <= sp_index + half_plane_bins + 1; j++) {
+				const int i = wrap_bin(j);
+				const hrt_abstime data_age = constrain_time - _data_timestamps[i];
 				const float distance = _obstacle_map_body_frame.distances[i] * 0.01f; // convert to meters
 				const float max_range = _data_maxranges[i] * 0.01f; // convert to meters
-				float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
 
-				// convert from body to local frame in the range [0, 2*pi]
-				angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
-
-				// get direction of current bin
-				const Vector2f bin_direction = {cosf(angle), sinf(angle)};
+				// get direction of current bin in local frame
+				const Vector2f bin_direction = _binDirection(i, cos_yaw, sin_yaw);
 
 				if (_obstacle_map_body_frame.distances[i] > _obstacle_map_body_frame.min_distance
 				    && _obstacle_map_body_frame.distances[i] < UINT16_MAX) {
@@ -467,6 +571,16 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 	}
 }
 
+void
+CollisionPrevention::_purgeStaleData(const hrt_abstime now)
+{
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) { // disregard unused bins at the end of the message
+		if (now - _data_timestamps[i] > RANGE_STREAM_TIMEOUT_US) {
+			_obstacle_map_body_frame.distances[i] = UINT16_MAX;
+		}
+	}
+}
+
 void
 CollisionPrevention::modifySetpoint(Vector2f &original_setpoint, const float max_speed, const Vector2f &curr_pos,
 				    const Vector2f &curr_vel)
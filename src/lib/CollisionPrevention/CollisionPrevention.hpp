@@ -47,6 +47,7 @@
 #include <drivers/drv_hrt.h>
 #include <mathlib/mathlib.h>
 #include <matrix/matrix/math.hpp>
+#include <OccupancyMap/OccupancyMap.hpp>
 #include <px4_module_params.h>
 #include <systemlib/mavlink_log.h>
 #include <uORB/Publication.hpp>
@@ -58,6 +59,7 @@
 #include <uORB/topics/obstacle_distance.h>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_command.h>
+#include <uORB/topics/vehicle_local_position.h>
 
 using namespace time_literals;
 
@@ -82,12 +84,30 @@ public:
 	void modifySetpoint(matrix::Vector2f &original_setpoint, const float max_speed,
 			    const matrix::Vector2f &curr_pos, const matrix::Vector2f &curr_vel);
 
+	/**
+	 * Queries the occupancy map for the closest obstacle in a horizontal direction
+	 * @param position, start of the query in local frame
+	 * @param direction, horizontal unit vector in local frame
+	 * @param max_range, maximum distance to search in meters
+	 * @return distance to the closest obstacle up to MPC_COL_PREV_D above or below the ray in meters,
+	 * NAN if there is none or the map is not used
+	 */
+	float getMapObstacleDistance(const matrix::Vector3f &position, const matrix::Vector2f &direction,
+				     float max_range) const;
+
+	/**
+	 * Returns true if the occupancy map holds an obstacle at position (local frame)
+	 */
+	bool isMapOccupied(const matrix::Vector3f &position) const { return _occupancy_map.isOccupied(position); }
+
 protected:
 
 	obstacle_distance_s _obstacle_map_body_frame {};
 	uint64_t _data_timestamps[sizeof(_obstacle_map_body_frame.distances) / sizeof(_obstacle_map_body_frame.distances[0])];
 	uint16_t _data_maxranges[sizeof(_obstacle_map_body_frame.distances) / sizeof(
 										    _obstacle_map_body_frame.distances[0])]; /**< in cm */
+	float _bin_cos[sizeof(_obstacle_map_body_frame.distances) / sizeof(_obstacle_map_body_frame.distances[0])]; /**< direction of each bin in body frame */
+	float _bin_sin[sizeof(_obstacle_map_body_frame.distances) / sizeof(_obstacle_map_body_frame.distances[0])];
 
 	void _addDistanceSensorData(distance_sensor_s &distance_sensor, const matrix::Quatf &vehicle_attitude);
 
@@ -114,6 +134,25 @@ protected:
 	bool _enterData(int map_index, float sensor_range, float sensor_reading);
 
 
+	/**
+	 * Adds a range measurement to the occupancy map
+	 * @param position, sensor position in local frame
+	 * @param direction, unit vector of the measurement direction in local frame
+	 * @param distance, measured distance in meters
+	 * @param max_distance, maximum range of the sensor in meters
+	 */
+	void _addOccupancyMapData(const matrix::Vector3f &position, const matrix::Vector3f &direction, float distance,
+				  float max_distance);
+
+	/**
+	 * Fills the bins without current range data with obstacles from the occupancy map
+	 * @param position, vehicle position in local frame
+	 * @param vehicle_yaw_angle_rad, vehicle orientation
+	 */
+	void _fillFromOccupancyMap(const matrix::Vector3f &position, float vehicle_yaw_angle_rad);
+
+	OccupancyMap _occupancy_map; /**< onboard 3D map, only allocated if MPC_COL_PREV_MAP is set */
+
 	//Timing functions. Necessary to mock time in the tests
 	virtual hrt_abstime getTime();
 	virtual hrt_abstime getElapsedTime(const hrt_abstime *ptr);
@@ -132,10 +171,16 @@ private:
 	uORB::SubscriptionData<obstacle_distance_s> _sub_obstacle_distance{ORB_ID(obstacle_distance)}; /**< obstacle distances received form a range sensor */
 	uORB::Subscription _sub_distance_sensor[ORB_MULTI_MAX_INSTANCES] {{ORB_ID(distance_sensor), 0}, {ORB_ID(distance_sensor), 1}, {ORB_ID(distance_sensor), 2}, {ORB_ID(distance_sensor), 3}}; /**< distance data received from onboard rangefinders */
 	uORB::SubscriptionData<vehicle_attitude_s> _sub_vehicle_attitude{ORB_ID(vehicle_attitude)};
+	uORB::SubscriptionData<vehicle_local_position_s> _sub_vehicle_local_position{ORB_ID(vehicle_local_position)};
 
 	static constexpr uint64_t RANGE_STREAM_TIMEOUT_US{500_ms};
+	static constexpr uint64_t MAP_DECAY_INTERVAL_US{1_s}; /**< a saturated voxel that is not observed anymore is free after 30 intervals */
 
 	hrt_abstime	_last_collision_warning{0};
+	hrt_abstime	_last_map_decay{0};
+
+	uint8_t _xy_reset_counter{0};	/**< local position reset counters the occupancy map belongs to */
+	uint8_t _z_reset_counter{0};
 
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::MPC_COL_PREV_D>) _param_mpc_col_prev_d, /**< collision prevention keep minimum distance */
@@ -143,7 +188,8 @@ private:
 		(ParamFloat<px4::params::MPC_XY_P>) _param_mpc_xy_p, /**< p gain from position controller*/
 		(ParamFloat<px4::params::MPC_COL_PREV_DLY>) _param_mpc_col_prev_dly, /**< delay of the range measurement data*/
 		(ParamFloat<px4::params::MPC_JERK_MAX>) _param_mpc_jerk_max, /**< vehicle maximum jerk*/
-		(ParamFloat<px4::params::MPC_ACC_HOR>) _param_mpc_acc_hor /**< vehicle maximum horizontal acceleration*/
+		(ParamFloat<px4::params::MPC_ACC_HOR>) _param_mpc_acc_hor, /**< vehicle maximum horizontal acceleration*/
+		(ParamInt<px4::params::MPC_COL_PREV_MAP>) _param_mpc_col_prev_map /**< memory of the occupancy map in KB*/
 	)
 
 	/**
@@ -153,6 +199,29 @@ private:
 	 */
 	float _sensorOrientationToYawOffset(const distance_sensor_s &distance_sensor, float angle_offset) const;
 
+	/**
+	 * Rotates the direction of a bin from body frame into the local frame
+	 * @param bin, index of the bin in the internal map
+	 * @param cos_yaw, cosine of the vehicle yaw
+	 * @param sin_yaw, sine of the vehicle yaw
+	 */
+	matrix::Vector2f _binDirection(int bin, float cos_yaw, float sin_yaw) const
+	{
+		return {cos_yaw * _bin_cos[bin] - sin_yaw * _bin_sin[bin], sin_yaw * _bin_cos[bin] + cos_yaw * _bin_sin[bin]};
+	}
+
+	/**
+	 * Removes the measurements that were not refreshed within RANGE_STREAM_TIMEOUT_US
+	 * @param now, current time
+	 */
+	void _purgeStaleData(const hrt_abstime now);
+
+	/**
+	 * Clears the occupancy map on local position resets and lets unobserved voxels fade out
+	 * @param local_position, current local position
+	 */
+	void _maintainOccupancyMap(const vehicle_local_position_s &local_position);
+
 	/**
 	 * Computes collision free setpoints
 	 * @param setpoint, setpoint before collision prevention intervention
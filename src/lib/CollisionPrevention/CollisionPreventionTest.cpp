@@ -1060,3 +1060,74 @@ TEST_F(CollisionPreventionTest, enterData)
 	EXPECT_TRUE(cp.test_enterData(8, 30.f, 1.5f)); //longer range, reading in range
 	EXPECT_TRUE(cp.test_enterData(8, 30.f, 31.f)); //longer range, reading out of range
 }
+
+TEST_F(CollisionPreventionTest, occupancyMapPositionReset)
+{
+	// GIVEN: collision prevention with an occupancy map
+	param_t param = param_handle(px4::params::MPC_COL_PREV_D);
+	float value = 2.f;
+	param_set(param, &value);
+	param = param_handle(px4::params::MPC_COL_PREV_MAP);
+	int32_t map_kb = 16;
+	param_set(param, &map_kb);
+	TestCollisionPrevention cp;
+	matrix::Vector2f setpoint(1, 0);
+	matrix::Vector2f curr_pos(0, 0);
+	matrix::Vector2f curr_vel(0, 0);
+
+	vehicle_attitude_s attitude{};
+	attitude.timestamp = hrt_absolute_time();
+	attitude.q[0] = 1.0f;
+
+	vehicle_local_position_s local_position{};
+	local_position.timestamp = hrt_absolute_time();
+	local_position.xy_valid = true;
+	local_position.z_valid = true;
+	local_position.x = 0.1f;
+	local_position.y = 0.1f;
+	local_position.z = -2.1f;
+
+	// AND: an obstacle 5m north
+	obstacle_distance_s message{};
+	message.frame = message.MAV_FRAME_LOCAL_NED;
+	message.min_distance = 20;
+	message.max_distance = 1000;
+	message.increment = 5.f;
+	message.timestamp = hrt_absolute_time();
+
+	const int distances_array_size = sizeof(message.distances) / sizeof(message.distances[0]);
+
+	for (int i = 0; i < distances_array_size; i++) {
+		message.distances[i] = (i == 0) ? 500 : UINT16_MAX;
+	}
+
+	orb_advert_t attitude_pub = orb_advertise(ORB_ID(vehicle_attitude), &attitude);
+	orb_advert_t local_position_pub = orb_advertise(ORB_ID(vehicle_local_position), &local_position);
+	orb_advert_t obstacle_distance_pub = orb_advertise(ORB_ID(obstacle_distance), &message);
+
+	// WHEN: the obstacle was measured
+	matrix::Vector2f modified_setpoint = setpoint;
+	cp.modifySetpoint(modified_setpoint, 1.f, curr_pos, curr_vel);
+
+	// THEN: the occupancy map has it, also for a query from slightly above
+	const matrix::Vector3f position(local_position.x, local_position.y, local_position.z);
+	EXPECT_TRUE(cp.isMapOccupied(matrix::Vector3f(5.1f, 0.1f, -2.1f)));
+	EXPECT_NEAR(cp.getMapObstacleDistance(position, matrix::Vector2f(1.f, 0.f), 10.f), 4.9f, 0.01f);
+	EXPECT_TRUE(PX4_ISFINITE(cp.getMapObstacleDistance(position + matrix::Vector3f(0.f, 0.f, -1.f),
+				 matrix::Vector2f(1.f, 0.f), 10.f)));
+
+	// WHEN: the estimator resets the horizontal position
+	local_position.xy_reset_counter++;
+	local_position.timestamp = hrt_absolute_time();
+	orb_publish(ORB_ID(vehicle_local_position), local_position_pub, &local_position);
+	modified_setpoint = setpoint;
+	cp.modifySetpoint(modified_setpoint, 1.f, curr_pos, curr_vel);
+
+	// THEN: the map is cleared, its obstacles are not where they were anymore
+	EXPECT_FALSE(cp.isMapOccupied(matrix::Vector3f(5.1f, 0.1f, -2.1f)));
+	EXPECT_FALSE(PX4_ISFINITE(cp.getMapObstacleDistance(position, matrix::Vector2f(1.f, 0.f), 10.f)));
+
+	orb_unadvertise(attitude_pub);
+	orb_unadvertise(local_position_pub);
+	orb_unadvertise(obstacle_distance_pub);
+}
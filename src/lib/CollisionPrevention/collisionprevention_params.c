@@ -74,3 +74,20 @@ PARAM_DEFINE_FLOAT(MPC_COL_PREV_DLY, 0.4f);
  * @group Multicopter Position Control
  */
 PARAM_DEFINE_FLOAT(MPC_COL_PREV_CNG, 30.f);
+
+/**
+ * Memory of the onboard 3D occupancy map
+ *
+ * Range measurements are also accumulated in a voxel map in the local frame, which keeps
+ * obstacles that are outside of the current sensor field of view. Directions without
+ * current range data are filled from this map. Set to 0 to disable the map.
+ *
+ * Only used in Position mode. Requires a valid local position.
+ *
+ * @min 0
+ * @max 256
+ * @unit KB
+ * @reboot_required true
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_INT32(MPC_COL_PREV_MAP, 0);
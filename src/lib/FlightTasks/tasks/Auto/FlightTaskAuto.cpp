@@ -67,6 +67,7 @@ bool FlightTaskAuto::updateInitialize()
 	_sub_manual_control_setpoint.update();
 	_sub_vehicle_status.update();
 	_sub_triplet_setpoint.update();
+	_horizon_updated = _sub_horizon.update();
 
 	// require valid reference and valid target
 	ret = ret && _evaluateGlobalReference() && _evaluateTriplets();
@@ -269,6 +270,11 @@ bool FlightTaskAuto::_evaluateTriplets()
 	if (triplet_update || (_current_state != previous_state)) {
 		_updateInternalWaypoints();
 		_mission_gear = _sub_triplet_setpoint.get().current.landing_gear;
+		_horizon_updated = true;
+	}
+
+	if (_horizon_updated) {
+		_updateHorizon();
 	}
 
 	if (_param_com_obs_avoid.get()
@@ -284,6 +290,34 @@ bool FlightTaskAuto::_evaluateTriplets()
 	return true;
 }
 
+void FlightTaskAuto::_updateHorizon()
+{
+	const position_setpoint_horizon_s &horizon = _sub_horizon.get();
+	const position_setpoint_s &next = _sub_triplet_setpoint.get().next;
+
+	_horizon_count = 0;
+
+	// The horizon can only be used if it starts at the next waypoint we are flying to. Navigator publishes
+	// it before the triplet, so it might not match yet.
+	const bool horizon_continues_triplet = (horizon.count > 0) && next.valid && (_type != WaypointType::loiter)
+					       && (fabs(horizon.lat[0] - next.lat) < 1e-7) && (fabs(horizon.lon[0] - next.lon) < 1e-7)
+					       && ((_current_state == State::none) || (_current_state == State::target_behind));
+
+	if (!horizon_continues_triplet) {
+		return;
+	}
+
+	const int count = math::min((int)horizon.count, (int)position_setpoint_horizon_s::HORIZON_LENGTH);
+
+	for (int i = 0; i < count; i++) {
+		map_projection_project(&_reference_position, horizon.lat[i], horizon.lon[i], &_horizon_wp[i](0), &_horizon_wp[i](1));
+		_horizon_wp[i](2) = -(horizon.alt[i] - _reference_altitude);
+		_horizon_acceptance_radius[i] = horizon.acceptance_radius[i];
+	}
+
+	_horizon_count = count;
+}
+
 void FlightTaskAuto::_set_heading_from_mode()
 {
 
@@ -40,6 +40,7 @@
 #pragma once
 
 #include "FlightTask.hpp"
+#include <uORB/topics/position_setpoint_horizon.h>
 #include <uORB/topics/position_setpoint_triplet.h>
 #include <uORB/topics/position_setpoint.h>
 #include <uORB/topics/home_position.h>
@@ -96,6 +97,10 @@ protected:
 	matrix::Vector3f _prev_wp{}; /**< Previous waypoint  (local frame). If no previous triplet is available, the prev_wp is set to current position. */
 	matrix::Vector3f _target{}; /**< Target waypoint  (local frame).*/
 	matrix::Vector3f _next_wp{}; /**< The next waypoint after target (local frame). If no next setpoint is available, next is set to target. */
+	matrix::Vector3f _horizon_wp[position_setpoint_horizon_s::HORIZON_LENGTH] {}; /**< Upcoming waypoints (local frame), the first one is _next_wp. */
+	float _horizon_acceptance_radius[position_setpoint_horizon_s::HORIZON_LENGTH] {}; /**< Acceptance radii of the upcoming waypoints */
+	int _horizon_count{0}; /**< Number of valid upcoming waypoints, 0 if the horizon does not continue the current waypoints. */
+	bool _horizon_updated{false}; /**< True in the update in which the waypoints or the horizon changed. */
 	float _mc_cruise_speed{0.0f}; /**< Requested cruise speed. If not valid, default cruise speed is used. */
 	WaypointType _type{WaypointType::idle}; /**< Type of current target triplet. */
 
@@ -129,6 +134,7 @@ private:
 	bool _yaw_lock{false}; /**< if within acceptance radius, lock yaw to current yaw */
 
 	uORB::SubscriptionData<position_setpoint_triplet_s> _sub_triplet_setpoint{ORB_ID(position_setpoint_triplet)};
+	uORB::SubscriptionData<position_setpoint_horizon_s> _sub_horizon{ORB_ID(position_setpoint_horizon)};
 
 	matrix::Vector3f
 	_triplet_target; /**< current triplet from navigator which may differ from the intenal one (_target) depending on the vehicle state. */
@@ -147,6 +153,7 @@ private:
 
 	void _limitYawRate(); /**< Limits the rate of change of the yaw setpoint. */
 	bool _evaluateTriplets(); /**< Checks and sets triplets. */
+	void _updateHorizon(); /**< Projects the upcoming waypoints if they continue the current triplet. */
 	bool _isFinite(const position_setpoint_s &sp); /**< Checks if all waypoint triplets are finite. */
 	bool _evaluateGlobalReference(); /**< Check is global reference is available. */
 	State _getCurrentState(); /**< Computes the current vehicle state based on the vehicle position and navigator triplets. */
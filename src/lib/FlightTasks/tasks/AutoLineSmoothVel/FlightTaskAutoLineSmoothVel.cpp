@@ -130,6 +130,10 @@ void FlightTaskAutoLineSmoothVel::_ekfResetHandlerHeading(float delta_psi)
 
 void FlightTaskAutoLineSmoothVel::_generateSetpoints()
 {
+	if (_horizon_updated) {
+		_planSpeedAtTarget();
+	}
+
 	_prepareSetpoints();
 	_generateTrajectory();
 
@@ -199,7 +203,14 @@ float FlightTaskAutoLineSmoothVel::_getSpeedAtTarget()
 
 	if (distance_current_next > 0.001f &&
 	    !waypoint_overlap &&
-	    yaw_align_check_pass) {
+	    yaw_align_check_pass &&
+	    PX4_ISFINITE(_planned_speed_at_target)) {
+		// The waypoints after next are known, use the speed planned over all of them
+		speed_at_target = _planned_speed_at_target;
+
+	} else if (distance_current_next > 0.001f &&
+		   !waypoint_overlap &&
+		   yaw_align_check_pass) {
 		// Max speed between current and next
 		const float max_speed_current_next = _getMaxSpeedFromDistance(distance_current_next);
 		const float alpha = acos(Vector2f(&(_target - _prev_wp)(0)).unit_or_zero() *
@@ -229,6 +240,88 @@ float FlightTaskAutoLineSmoothVel::_getMaxSpeedFromDistance(float braking_distan
 	return max_speed;
 }
 
+float FlightTaskAutoLineSmoothVel::_getMaxSpeedFromDistance(float distance, float final_speed)
+{
+	float max_speed = math::trajectory::computeMaxSpeedFromDistance(_param_mpc_jerk_auto.get(),
+			  _param_mpc_acc_hor.get(),
+			  distance,
+			  final_speed);
+	// Same linear limit as above, shifted by the speed required at the end
+	max_speed = math::min(max_speed, final_speed + distance * _param_mpc_xy_traj_p.get());
+
+	// Keeping the speed is always possible, the delay term of the profile could make it smaller
+	return math::max(max_speed, final_speed);
+}
+
+void FlightTaskAutoLineSmoothVel::_planSpeedAtTarget()
+{
+	// _getSpeedAtTarget() only looks one waypoint ahead and has to assume that the drone stops at the next one.
+	// With the horizon from Navigator, the corner speeds of all known waypoints are limited by their turn
+	// and then propagated backwards from the last one (where the drone stops) so that each corner can be
+	// reached from the previous one with the available deceleration. A forward pass from the current trajectory
+	// speed limits the corners that cannot be reached anyway. This only runs when the waypoints change.
+	_planned_speed_at_target = NAN;
+
+	if (_horizon_count < 2) {
+		// Only the next waypoint is known, this is what _getSpeedAtTarget() does anyway
+		return;
+	}
+
+	static constexpr int max_corners = position_setpoint_horizon_s::HORIZON_LENGTH;
+	Vector2f points[max_corners + 2]; // previous waypoint, target and the horizon
+	float acceptance_radius[max_corners + 2];
+	float speed[max_corners + 2];
+
+	points[0] = Vector2f(_prev_wp);
+	points[1] = Vector2f(_target);
+	acceptance_radius[1] = _target_acceptance_radius;
+
+	for (int i = 0; i < _horizon_count; i++) {
+		points[i + 2] = Vector2f(_horizon_wp[i]);
+		acceptance_radius[i + 2] = _horizon_acceptance_radius[i];
+	}
+
+	const int last = _horizon_count + 1;
+	const float accel_turn = _param_mpc_xy_traj_p.get() * _param_mpc_acc_hor.get();
+
+	// Maximum speed in each corner given by the turn angle
+	for (int k = 1; k < last; k++) {
+		const Vector2f to_prev = points[k] - points[k - 1];
+		const Vector2f to_next = points[k] - points[k + 1];
+
+		if ((to_prev.length() < acceptance_radius[k]) || (to_next.length() < 0.001f)) {
+			// Overlapping waypoints, stop as the non-horizon logic does
+			speed[k] = 0.f;
+
+		} else {
+			const float alpha = acosf(math::constrain(to_prev.unit_or_zero() * to_next.unit_or_zero(), -1.f, 1.f));
+			speed[k] = math::min(math::trajectory::computeMaxSpeedInWaypoint(alpha, accel_turn, acceptance_radius[k]),
+					     _mc_cruise_speed);
+		}
+	}
+
+	speed[last] = 0.f;
+
+	// Backward pass: make sure that the drone can slow down in time for each corner
+	for (int k = last - 1; k >= 1; k--) {
+		const float distance = (points[k + 1] - points[k]).length();
+		speed[k] = math::min(speed[k], _getMaxSpeedFromDistance(distance, speed[k + 1]));
+	}
+
+	// Forward pass: the drone cannot go faster than what it can accelerate to from its current speed
+	const Vector2f position_trajectory(_trajectory[0].getCurrentPosition(), _trajectory[1].getCurrentPosition());
+	const Vector2f velocity_trajectory(_trajectory[0].getCurrentVelocity(), _trajectory[1].getCurrentVelocity());
+	const float current_speed = velocity_trajectory.length();
+	speed[1] = math::min(speed[1], _getMaxSpeedFromDistance((points[1] - position_trajectory).length(), current_speed));
+
+	for (int k = 2; k < last; k++) {
+		const float distance = (points[k] - points[k - 1]).length();
+		speed[k] = math::min(speed[k], _getMaxSpeedFromDistance(distance, speed[k - 1]));
+	}
+
+	_planned_speed_at_target = speed[1];
+}
+
 void FlightTaskAutoLineSmoothVel::_prepareSetpoints()
 {
 	// Interface: A valid position setpoint generates a velocity target using a P controller. If a velocity is specified
@@ -368,11 +461,16 @@ void FlightTaskAutoLineSmoothVel::_generateTrajectory()
 
 	_updateTrajConstraints();
 
-	for (int i = 0; i < 3; ++i) {
-		_trajectory[i].updateDurations(_velocity_setpoint(i));
+	// Plan new segments only if the targets changed, otherwise keep sampling the current ones
+	if (_trajectory[0].needsReplan(_velocity_setpoint(0)) || _trajectory[1].needsReplan(_velocity_setpoint(1))) {
+		_trajectory[0].updateDurations(_velocity_setpoint(0));
+		_trajectory[1].updateDurations(_velocity_setpoint(1));
+		VelocitySmoothing::timeSynchronization(_trajectory, 2); // Synchronize x and y only
 	}
 
-	VelocitySmoothing::timeSynchronization(_trajectory, 2); // Synchronize x and y only
+	if (_trajectory[2].needsReplan(_velocity_setpoint(2))) {
+		_trajectory[2].updateDurations(_velocity_setpoint(2));
+	}
 
 	_jerk_setpoint = jerk_sp_smooth;
 	_acceleration_setpoint = accel_sp_smooth;
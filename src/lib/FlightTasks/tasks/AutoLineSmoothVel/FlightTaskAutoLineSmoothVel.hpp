@@ -82,6 +82,8 @@ protected:
 
 	float _getSpeedAtTarget();
 	float _getMaxSpeedFromDistance(float braking_distance);
+	float _getMaxSpeedFromDistance(float distance, float final_speed);
+	void _planSpeedAtTarget(); /**< Plan the speed at the target over the whole waypoint horizon. */
 
 	void _prepareSetpoints(); /**< Generate velocity target points for the trajectory generator. */
 	void _updateTrajConstraints();
@@ -92,4 +94,6 @@ protected:
 	bool _want_takeoff{false};
 
 	VelocitySmoothing _trajectory[3]; ///< Trajectories in x, y and z directions
+
+	float _planned_speed_at_target{NAN}; ///< Speed at the target from the horizon pass, NAN if no horizon is available
 };
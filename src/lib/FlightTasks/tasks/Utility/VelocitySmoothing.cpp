@@ -50,6 +50,10 @@ void VelocitySmoothing::reset(float accel, float vel, float pos)
 	_state.x = pos;
 
 	_state_init = _state;
+	_direction = 0;
+	_local_time = 0.f;
+	_T1 = _T2 = _T3 = 0.f;
+	_replan_required = true;
 }
 
 float VelocitySmoothing::saturateT1ForAccel(float a0, float j_max, float T1, float a_max)
@@ -174,6 +178,23 @@ void VelocitySmoothing::updateDurations(float vel_setpoint)
 	} else {
 		_T1 = _T2 = _T3 = 0.f;
 	}
+
+	_planned_max_jerk = _max_jerk;
+	_planned_max_accel = _max_accel;
+	_planned_max_vel = _max_vel;
+	_replan_required = false;
+}
+
+bool VelocitySmoothing::needsReplan(float vel_setpoint) const
+{
+	// Setpoint changes below this threshold do not justify a new segment
+	static constexpr float vel_sp_tolerance = 0.01f;
+
+	return _replan_required
+	       || fabsf(math::constrain(vel_setpoint, -_max_vel, _max_vel) - _vel_sp) > vel_sp_tolerance
+	       || fabsf(_max_jerk - _planned_max_jerk) > FLT_EPSILON
+	       || fabsf(_max_accel - _planned_max_accel) > FLT_EPSILON
+	       || fabsf(_max_vel - _planned_max_vel) > FLT_EPSILON;
 }
 
 int VelocitySmoothing::computeDirection()
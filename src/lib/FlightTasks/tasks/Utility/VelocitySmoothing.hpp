@@ -79,6 +79,15 @@ public:
 	 */
 	void updateDurations(float vel_setpoint);
 
+	/**
+	 * Check if the current segment has to be planned again with updateDurations(). As long as the
+	 * velocity setpoint, the constraints and the state stay the same, the planned segment can be
+	 * sampled with updateTraj() without recomputing T1, T2, T3.
+	 * @param vel_setpoint velocity setpoint input
+	 * @return true if the segment was planned for a different setpoint, constraints or initial velocity/acceleration
+	 */
+	bool needsReplan(float vel_setpoint) const;
+
 	/**
 	 * Generate the trajectory (acceleration, velocity and position) by integrating the current jerk
 	 * @param dt integration period
@@ -100,11 +109,32 @@ public:
 	void setMaxVel(float max_vel) { _max_vel = max_vel; }
 
 	float getCurrentJerk() const { return _state.j; }
-	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; }
+
+	/**
+	 * Setters for the current state (e.g.: EKF reset). The planned segment is shifted
+	 * along with the state. A new acceleration or velocity requires a new segment.
+	 */
+	void setCurrentAcceleration(const float accel)
+	{
+		_state_init.a += accel - _state.a;
+		_state.a = accel;
+		_replan_required = true;
+	}
 	float getCurrentAcceleration() const { return _state.a; }
-	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; }
+
+	void setCurrentVelocity(const float vel)
+	{
+		_state_init.v += vel - _state.v;
+		_state.v = vel;
+		_replan_required = true;
+	}
 	float getCurrentVelocity() const { return _state.v; }
-	void setCurrentPosition(const float pos) { _state.x = _state_init.x = pos; }
+
+	void setCurrentPosition(const float pos)
+	{
+		_state_init.x += pos - _state.x;
+		_state.x = pos;
+	}
 	float getCurrentPosition() const { return _state.x; }
 
 	float getVelSp() const { return _vel_sp; }
@@ -212,4 +242,10 @@ private:
 	float _T3 = 0.f; ///< Decreasing acceleration [s]
 
 	float _local_time = 0.f; ///< Current local time
+
+	/* Constraints the current segment was planned with */
+	float _planned_max_jerk{0.f};
+	float _planned_max_accel{0.f};
+	float _planned_max_vel{0.f};
+	bool _replan_required{true}; ///< Velocity or acceleration modified since the last plan
 };
@@ -178,3 +178,67 @@ TEST_F(VelocitySmoothingTest, testZeroSetpoint)
 		EXPECT_EQ(_trajectories[i].getCurrentPosition(), 0.f);
 	}
 }
+
+TEST_F(VelocitySmoothingTest, testCachedSegment)
+{
+	// GIVEN: A set of constraints and null initial conditions
+	const float j_max = 55.2f;
+	const float a_max = 6.f;
+	const float v_max = 6.f;
+
+	setConstraints(j_max, a_max, v_max);
+	setInitialConditions(Vector3f(), Vector3f(), Vector3f());
+
+	// AND: A reference trajectory evaluated in one step from the initial state
+	VelocitySmoothing reference;
+	reference.setMaxJerk(j_max);
+	reference.setMaxAccel(a_max);
+	reference.setMaxVel(v_max);
+
+	// WHEN: We plan the segment once and only sample it afterwards
+	const float velocity_setpoint = 4.f;
+	const float dt = 0.01f;
+	_trajectories[0].updateDurations(velocity_setpoint);
+
+	for (int i = 1; i <= 200; i++) {
+		_trajectories[0].updateTraj(dt);
+
+		reference.reset(0.f, 0.f, 0.f);
+		reference.updateDurations(velocity_setpoint);
+		reference.updateTraj(i * dt);
+
+		// THEN: The segment does not need to be planned again for the same setpoint
+		EXPECT_FALSE(_trajectories[0].needsReplan(velocity_setpoint));
+
+		// AND: Sampling the cached segment follows the planned trajectory
+		EXPECT_NEAR(_trajectories[0].getCurrentAcceleration(), reference.getCurrentAcceleration(), 1e-3f);
+		EXPECT_NEAR(_trajectories[0].getCurrentVelocity(), reference.getCurrentVelocity(), 1e-3f);
+		EXPECT_NEAR(_trajectories[0].getCurrentPosition(), reference.getCurrentPosition(), 1e-3f);
+	}
+
+	EXPECT_NEAR(_trajectories[0].getCurrentVelocity(), velocity_setpoint, 0.01f);
+
+	// BUT: A new setpoint, new constraints or an external state change require a new segment
+	EXPECT_TRUE(_trajectories[0].needsReplan(velocity_setpoint + 1.f));
+
+	_trajectories[0].setMaxAccel(a_max + 1.f);
+	EXPECT_TRUE(_trajectories[0].needsReplan(velocity_setpoint));
+	_trajectories[0].updateDurations(velocity_setpoint);
+	EXPECT_FALSE(_trajectories[0].needsReplan(velocity_setpoint));
+
+	_trajectories[0].setCurrentVelocity(0.f);
+	EXPECT_TRUE(_trajectories[0].needsReplan(velocity_setpoint));
+
+	// AND: A position reset only shifts the segment
+	_trajectories[0].updateDurations(velocity_setpoint);
+	_trajectories[0].updateTraj(dt);
+	const float position_before_reset = _trajectories[0].getCurrentPosition();
+	_trajectories[0].setCurrentPosition(position_before_reset + 10.f);
+	EXPECT_FALSE(_trajectories[0].needsReplan(velocity_setpoint));
+
+	reference = _trajectories[0];
+	_trajectories[0].updateTraj(dt);
+	reference.setCurrentPosition(position_before_reset);
+	reference.updateTraj(dt);
+	EXPECT_NEAR(_trajectories[0].getCurrentPosition() - reference.getCurrentPosition(), 10.f, 1e-3f);
+}
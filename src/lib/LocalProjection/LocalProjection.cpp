@@ -0,0 +1,161 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file LocalProjection.cpp
+ */
+
+#include "LocalProjection.hpp"
+
+#include <math.h>
+
+// same spherical earth as lib/ecl/geo
+static constexpr double RADIUS_OF_EARTH = 6371000.0;
+static constexpr float RADIUS_OF_EARTH_F = (float)RADIUS_OF_EARTH;
+static constexpr double DEG_TO_RAD = M_PI / 180.0;
+static constexpr double RAD_TO_DEG = 180.0 / M_PI;
+
+void LocalProjection::init(double lat_0, double lon_0)
+{
+	_lat_0 = lat_0;
+	_lon_0 = lon_0;
+	_sin_lat_0 = (float)sin(lat_0 * DEG_TO_RAD);
+	_cos_lat_0 = (float)cos(lat_0 * DEG_TO_RAD);
+	_initialized = true;
+}
+
+void LocalProjection::_offset(double lat, double lon, float &dlat, float &dlon) const
+{
+	// difference in double, the small result fits a float
+	double delta_lon = lon - _lon_0;
+
+	if (delta_lon > 180.0) {
+		delta_lon -= 360.0;
+
+	} else if (delta_lon < -180.0) {
+		delta_lon += 360.0;
+	}
+
+	dlat = (float)((lat - _lat_0) * DEG_TO_RAD);
+	dlon = (float)(delta_lon * DEG_TO_RAD);
+}
+
+matrix::Vector2f LocalProjection::project(double lat, double lon) const
+{
+	float dlat;
+	float dlon;
+	_offset(lat, lon, dlat, dlon);
+
+	return matrix::Vector2f(RADIUS_OF_EARTH_F * dlat, RADIUS_OF_EARTH_F * dlon * _cosLat(0.5f * dlat));
+}
+
+void LocalProjection::project(const double lat[], const double lon[], matrix::Vector2f north_east[], int count) const
+{
+	for (int i = 0; i < count; i++) {
+		north_east[i] = project(lat[i], lon[i]);
+	}
+}
+
+void LocalProjection::reproject(const matrix::Vector2f &north_east, double &lat, double &lon) const
+{
+	const float dlat = north_east(0) / RADIUS_OF_EARTH_F;
+	const float dlon = north_east(1) / (RADIUS_OF_EARTH_F * _cosLat(0.5f * dlat));
+
+	lat = _lat_0 + (double)dlat * RAD_TO_DEG;
+	lon = _lon_0 + (double)dlon * RAD_TO_DEG;
+
+	if (lon > 180.0) {
+		lon -= 360.0;
+
+	} else if (lon < -180.0) {
+		lon += 360.0;
+	}
+}
+
+void LocalProjection::_delta(double lat_from, double lon_from, double lat_to, double lon_to,
+			     float &dlat, float &dlon, float &dlat_mid) const
+{
+	float dlat_from;
+	float dlon_from;
+	float dlat_to;
+	float dlon_to;
+	_offset(lat_from, lon_from, dlat_from, dlon_from);
+	_offset(lat_to, lon_to, dlat_to, dlon_to);
+
+	dlat = dlat_to - dlat_from;
+	dlon = dlon_to - dlon_from;
+
+	// both offsets are wrapped separately, the difference might still cross the date line
+	if (dlon > (float)M_PI) {
+		dlon -= 2.f * (float)M_PI;
+
+	} else if (dlon < -(float)M_PI) {
+		dlon += 2.f * (float)M_PI;
+	}
+
+	dlat_mid = 0.5f * (dlat_from + dlat_to);
+}
+
+matrix::Vector2f LocalProjection::vector(double lat_from, double lon_from, double lat_to, double lon_to) const
+{
+	float dlat;
+	float dlon;
+	float dlat_mid;
+	_delta(lat_from, lon_from, lat_to, lon_to, dlat, dlon, dlat_mid);
+
+	// east scale at the mid latitude of the two points
+	return matrix::Vector2f(RADIUS_OF_EARTH_F * dlat, RADIUS_OF_EARTH_F * dlon * _cosLat(dlat_mid));
+}
+
+float LocalProjection::bearing(double lat_from, double lon_from, double lat_to, double lon_to) const
+{
+	float dlat;
+	float dlon;
+	float dlat_mid;
+	_delta(lat_from, lon_from, lat_to, lon_to, dlat, dlon, dlat_mid);
+
+	// This is the direction at the middle of the way. A great circle turns by dlon * sin(lat)
+	// between its ends, half of that is the difference to the initial bearing.
+	const float sin_lat = _sin_lat_0 + _cos_lat_0 * dlat_mid;
+	float bearing = atan2f(dlon * _cosLat(dlat_mid), dlat) - 0.5f * dlon * sin_lat;
+
+	if (bearing > (float)M_PI) {
+		bearing -= 2.f * (float)M_PI;
+
+	} else if (bearing < -(float)M_PI) {
+		bearing += 2.f * (float)M_PI;
+	}
+
+	return bearing;
+}
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file LocalProjection.hpp
+ *
+ * Projection of global positions into a local north/east frame around a reference,
+ * for geometry that is evaluated many times per cycle.
+ *
+ * The trigonometry of the reference latitude is done once in init(). Projecting a point,
+ * the distance and the bearing between two points are then a few float multiplications:
+ * the east scale at the mid latitude of the two points is a second order series around the
+ * reference. Within 20 km of the reference distances agree with the great circle
+ * functions of lib/ecl/geo to a few decimeters and bearings to 1e-3 rad.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+
+class LocalProjection
+{
+public:
+	LocalProjection() = default;
+	~LocalProjection() = default;
+
+	/**
+	 * Set the reference
+	 * @param lat_0 latitude [deg]
+	 * @param lon_0 longitude [deg]
+	 */
+	void init(double lat_0, double lon_0);
+
+	bool isInitialized() const { return _initialized; }
+
+	double getLatReference() const { return _lat_0; }
+	double getLonReference() const { return _lon_0; }
+
+	/**
+	 * @return north/east position of the point relative to the reference [m]
+	 */
+	matrix::Vector2f project(double lat, double lon) const;
+
+	/**
+	 * Project an array of points, same as calling project() for each of them
+	 */
+	void project(const double lat[], const double lon[], matrix::Vector2f north_east[], int count) const;
+
+	/**
+	 * Inverse of project()
+	 */
+	void reproject(const matrix::Vector2f &north_east, double &lat, double &lon) const;
+
+	/**
+	 * @return north/east vector from the first to the second point [m]
+	 */
+	matrix::Vector2f vector(double lat_from, double lon_from, double lat_to, double lon_to) const;
+
+	/**
+	 * @return horizontal distance between two points [m]
+	 */
+	float distance(double lat_from, double lon_from, double lat_to, double lon_to) const
+	{
+		return vector(lat_from, lon_from, lat_to, lon_to).norm();
+	}
+
+	/**
+	 * @return bearing from the first to the second point [rad], -pi..pi
+	 */
+	float bearing(double lat_from, double lon_from, double lat_to, double lon_to) const;
+
+private:
+	/**
+	 * Offset of a point from the reference in radians
+	 */
+	void _offset(double lat, double lon, float &dlat, float &dlon) const;
+
+	/**
+	 * Latitude and longitude difference between two points and their mid latitude as offset from the reference [rad]
+	 */
+	void _delta(double lat_from, double lon_from, double lat_to, double lon_to,
+		    float &dlat, float &dlon, float &dlat_mid) const;
+
+	/**
+	 * cos() of a latitude close to the reference, given as offset from the reference [rad]
+	 */
+	float _cosLat(float dlat) const { return _cos_lat_0 - dlat * (_sin_lat_0 + 0.5f * dlat * _cos_lat_0); }
+
+	double _lat_0{0.0};
+	double _lon_0{0.0};
+	float _sin_lat_0{0.f};
+	float _cos_lat_0{1.f};
+	bool _initialized{false};
+};
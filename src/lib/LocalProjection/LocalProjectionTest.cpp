@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the local projection, validated against the great circle functions of lib/ecl/geo
+ * Run this test only using make tests TESTFILTER=LocalProjection
+ */
+
+#include <gtest/gtest.h>
+#include <lib/ecl/geo/geo.h>
+#include <cmath>
+#include <random>
+
+#include <LocalProjection.hpp>
+
+using namespace matrix;
+
+static constexpr int NUM_RANDOM_POINTS = 2000;
+
+// offset a position by up to range meters, roughly
+static void randomOffset(std::mt19937 &gen, double lat_0, double lon_0, float range, double &lat, double &lon)
+{
+	std::uniform_real_distribution<double> offset(-1.0, 1.0);
+	const double range_deg = range / 111000.0;
+	lat = lat_0 + offset(gen) * range_deg;
+	lon = lon_0 + offset(gen) * range_deg / cos(lat_0 * M_PI / 180.0);
+}
+
+static float wrapPi(float angle)
+{
+	return std::remainder(angle, 2.f * (float)M_PI);
+}
+
+TEST(LocalProjectionTest, NotInitialized)
+{
+	LocalProjection projection;
+	EXPECT_FALSE(projection.isInitialized());
+
+	projection.init(47.3977, 8.5456);
+	EXPECT_TRUE(projection.isInitialized());
+	EXPECT_DOUBLE_EQ(projection.getLatReference(), 47.3977);
+	EXPECT_DOUBLE_EQ(projection.getLonReference(), 8.5456);
+}
+
+TEST(LocalProjectionTest, DistanceAndBearing)
+{
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> lat_distribution(-70.0, 70.0);
+	std::uniform_real_distribution<double> lon_distribution(-180.0, 180.0);
+
+	for (int i = 0; i < NUM_RANDOM_POINTS; i++) {
+		const double lat_0 = lat_distribution(gen);
+		const double lon_0 = lon_distribution(gen);
+
+		LocalProjection projection;
+		projection.init(lat_0, lon_0);
+
+		// two points up to 20 km from the reference
+		double lat_a, lon_a, lat_b, lon_b;
+		randomOffset(gen, lat_0, lon_0, 20000.f, lat_a, lon_a);
+		randomOffset(gen, lat_0, lon_0, 20000.f, lat_b, lon_b);
+
+		const float distance = get_distance_to_next_waypoint(lat_a, lon_a, lat_b, lon_b);
+		EXPECT_NEAR(projection.distance(lat_a, lon_a, lat_b, lon_b), distance, 0.05f + 2e-5f * distance);
+
+		if (distance > 10.f) {
+			const float bearing = get_bearing_to_next_waypoint(lat_a, lon_a, lat_b, lon_b);
+			EXPECT_NEAR(wrapPi(projection.bearing(lat_a, lon_a, lat_b, lon_b) - bearing), 0.f, 1e-3f);
+		}
+
+		// distance to the reference
+		EXPECT_NEAR(projection.project(lat_a, lon_a).norm(), get_distance_to_next_waypoint(lat_0, lon_0, lat_a, lon_a), 0.2f);
+	}
+}
+
+TEST(LocalProjectionTest, ShortDistances)
+{
+	// acceptance radius checks: meters, close to the reference and 10 km away from it
+	LocalProjection projection;
+	projection.init(47.3977, 8.5456);
+
+	const double lat = 47.3977 + 0.09;
+	const double lon = 8.5456 - 0.05;
+
+	for (int i = 1; i < 100; i++) {
+		const double d = i * 1e-6;
+		EXPECT_NEAR(projection.distance(lat, lon, lat + d, lon + d), get_distance_to_next_waypoint(lat, lon, lat + d, lon + d),
+			    0.01f);
+		EXPECT_NEAR(projection.distance(47.3977, 8.5456, 47.3977 - d, 8.5456 + d),
+			    get_distance_to_next_waypoint(47.3977, 8.5456, 47.3977 - d, 8.5456 + d), 0.01f);
+	}
+}
+
+TEST(LocalProjectionTest, Reproject)
+{
+	std::mt19937 gen(1);
+	LocalProjection projection;
+	projection.init(-33.8688, 151.2093);
+
+	for (int i = 0; i < NUM_RANDOM_POINTS; i++) {
+		double lat, lon;
+		randomOffset(gen, -33.8688, 151.2093, 50000.f, lat, lon);
+
+		double lat_back, lon_back;
+		projection.reproject(projection.project(lat, lon), lat_back, lon_back);
+
+		// about a centimeter
+		EXPECT_NEAR(lat_back, lat, 1e-7);
+		EXPECT_NEAR(lon_back, lon, 1e-7);
+	}
+}
+
+TEST(LocalProjectionTest, Batch)
+{
+	std::mt19937 gen(2);
+	LocalProjection projection;
+	projection.init(47.3977, 8.5456);
+
+	static constexpr int COUNT = 32;
+	double lat[COUNT];
+	double lon[COUNT];
+	Vector2f north_east[COUNT];
+
+	for (int i = 0; i < COUNT; i++) {
+		randomOffset(gen, 47.3977, 8.5456, 5000.f, lat[i], lon[i]);
+	}
+
+	projection.project(lat, lon, north_east, COUNT);
+
+	for (int i = 0; i < COUNT; i++) {
+		const Vector2f single = projection.project(lat[i], lon[i]);
+		EXPECT_FLOAT_EQ(north_east[i](0), single(0));
+		EXPECT_FLOAT_EQ(north_east[i](1), single(1));
+	}
+}
+
+TEST(LocalProjectionTest, DateLine)
+{
+	LocalProjection projection;
+	projection.init(10.0, 179.999);
+
+	EXPECT_NEAR(projection.distance(10.0, 179.999, 10.0, -179.999), get_distance_to_next_waypoint(10.0, 179.999, 10.0, -179.999),
+		    0.01f);
+	EXPECT_NEAR(projection.bearing(10.0, 179.999, 10.0, -179.999), (float)M_PI_2, 1e-3f);
+	EXPECT_NEAR(projection.project(10.0, -179.999)(1), 219.f, 1.f);
+
+	double lat, lon;
+	projection.reproject(Vector2f(0.f, 219.f), lat, lon);
+	EXPECT_LT(lon, -179.99);
+}
@@ -0,0 +1,373 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file OccupancyMap.cpp
+ */
+
+#include "OccupancyMap.hpp"
+
+#include <float.h>
+#include <math.h>
+
+using namespace matrix;
+
+OccupancyMap::~OccupancyMap()
+{
+	delete[] _cells;
+}
+
+bool OccupancyMap::init(size_t memory_bytes, float resolution)
+{
+	delete[] _cells;
+	_cells = nullptr;
+	_capacity = 0;
+	_num_cells = 0;
+	_dropped = 0;
+	_resolution = resolution;
+
+	// the table size is a power of two to replace the modulo by a mask
+	size_t capacity = 64;
+	int bits = 6;
+
+	if (memory_bytes < capacity * sizeof(uint64_t) || !(resolution > 0.f)) {
+		return false;
+	}
+
+	while (capacity * 2 * sizeof(uint64_t) <= memory_bytes) {
+		capacity *= 2;
+		bits++;
+	}
+
+	_cells = new uint64_t[capacity];
+
+	if (_cells == nullptr) {
+		return false;
+	}
+
+	_capacity = capacity;
+	_mask = capacity - 1;
+	_hash_shift = 64 - bits;
+	clear();
+	return true;
+}
+
+void OccupancyMap::clear()
+{
+	for (size_t i = 0; i < _capacity; i++) {
+		_cells[i] = 0;
+	}
+
+	_num_cells = 0;
+}
+
+void OccupancyMap::_toVoxel(const float position[3], int32_t voxel[3]) const
+{
+	for (int i = 0; i < 3; i++) {
+		voxel[i] = (int32_t)floorf(position[i] / _resolution);
+	}
+}
+
+bool OccupancyMap::_validVoxel(const int32_t voxel[3])
+{
+	static constexpr int32_t limit = 1 << (COORDINATE_BITS - 1);
+
+	return (voxel[0] >= -limit) && (voxel[0] < limit)
+	       && (voxel[1] >= -limit) && (voxel[1] < limit)
+	       && (voxel[2] >= -limit) && (voxel[2] < limit);
+}
+
+uint64_t OccupancyMap::_key(const int32_t voxel[3])
+{
+	static constexpr int32_t offset = 1 << (COORDINATE_BITS - 1);
+	static constexpr uint64_t coordinate_mask = (1u << COORDINATE_BITS) - 1;
+
+	return ((uint64_t)(voxel[0] + offset) & coordinate_mask)
+	       | (((uint64_t)(voxel[1] + offset) & coordinate_mask) << COORDINATE_BITS)
+	       | (((uint64_t)(voxel[2] + offset) & coordinate_mask) << (2 * COORDINATE_BITS));
+}
+
+size_t OccupancyMap::_home(uint64_t key) const
+{
+	// Fibonacci hashing, the upper bits are the best mixed ones
+	return (size_t)((key * 0x9E3779B97F4A7C15ull) >> _hash_shift);
+}
+
+int32_t OccupancyMap::_find(uint64_t key) const
+{
+	size_t index = _home(key);
+
+	// linear probing, the table is never full so an empty slot terminates the search
+	while (_cells[index] & USED_FLAG) {
+		if (_keyOf(_cells[index]) == key) {
+			return (int32_t)index;
+		}
+
+		index = (index + 1) & _mask;
+	}
+
+	return -1;
+}
+
+bool OccupancyMap::_occupied(const int32_t voxel[3]) const
+{
+	if (!_validVoxel(voxel)) {
+		return false;
+	}
+
+	const int32_t index = _find(_key(voxel));
+	return index >= 0 && _logOddsOf(_cells[index]) > LOG_ODDS_OCCUPIED;
+}
+
+void OccupancyMap::_erase(size_t index)
+{
+	// backward shift deletion keeps the probe sequences intact without tombstones
+	size_t next = (index + 1) & _mask;
+
+	while (_cells[next] & USED_FLAG) {
+		const size_t home = _home(_keyOf(_cells[next]));
+
+		// move the entry if its home is not cyclically in (index, next]
+		const bool in_range = (index <= next) ? (home > index && home <= next) : (home > index || home <= next);
+
+		if (!in_range) {
+			_cells[index] = _cells[next];
+			index = next;
+		}
+
+		next = (next + 1) & _mask;
+	}
+
+	_cells[index] = 0;
+	_num_cells--;
+}
+
+void OccupancyMap::_update(const int32_t voxel[3], int8_t delta)
+{
+	if (!_validVoxel(voxel)) {
+		return;
+	}
+
+	const uint64_t key = _key(voxel);
+	const int32_t index = _find(key);
+
+	if (index >= 0) {
+		int log_odds = _logOddsOf(_cells[index]) + delta;
+
+		if (log_odds <= 0) {
+			// no evidence of an obstacle left, free the slot
+			_erase(index);
+
+		} else {
+			log_odds = (log_odds > LOG_ODDS_MAX) ? LOG_ODDS_MAX : log_odds;
+			_cells[index] = _makeCell(key, (int8_t)log_odds);
+		}
+
+	} else if (delta > 0) {
+		// keep the load below 7/8 such that the probe sequences stay short
+		if (_num_cells >= _capacity - _capacity / 8) {
+			_dropped++;
+			return;
+		}
+
+		size_t slot = _home(key);
+
+		while (_cells[slot] & USED_FLAG) {
+			slot = (slot + 1) & _mask;
+		}
+
+		_cells[slot] = _makeCell(key, delta);
+		_num_cells++;
+	}
+}
+
+void OccupancyMap::decay(int8_t amount)
+{
+	if (_cells == nullptr || _num_cells == 0 || amount <= 0) {
+		return;
+	}
+
+	// Start behind an empty slot: no probe sequence wraps around the start then, and the
+	// backward shift of _erase() only moves entries that were not visited yet into the current slot.
+	size_t start = 0;
+
+	while (_cells[start] & USED_FLAG) {
+		start++;
+	}
+
+	size_t visited = 0;
+
+	while (visited < _capacity) {
+		const size_t index = (start + visited) & _mask;
+
+		if (_cells[index] & USED_FLAG) {
+			const int log_odds = _logOddsOf(_cells[index]) - amount;
+
+			if (log_odds <= 0) {
+				// the next entry of the probe sequence may have moved here, visit the slot again
+				_erase(index);
+				continue;
+			}
+
+			_cells[index] = _makeCell(_keyOf(_cells[index]), (int8_t)log_odds);
+		}
+
+		visited++;
+	}
+}
+
+OccupancyMap::RayIterator::RayIterator(const float origin[3], const float direction[3], float resolution)
+{
+	for (int i = 0; i < 3; i++) {
+		_voxel[i] = (int32_t)floorf(origin[i] / resolution);
+
+		if (direction[i] > FLT_EPSILON) {
+			_step[i] = 1;
+			_t_max[i] = ((_voxel[i] + 1) * resolution - origin[i]) / direction[i];
+			_t_delta[i] = resolution / direction[i];
+
+		} else if (direction[i] < -FLT_EPSILON) {
+			_step[i] = -1;
+			_t_max[i] = (_voxel[i] * resolution - origin[i]) / direction[i];
+			_t_delta[i] = -resolution / direction[i];
+
+		} else {
+			_step[i] = 0;
+			_t_max[i] = FLT_MAX;
+			_t_delta[i] = FLT_MAX;
+		}
+	}
+}
+
+void OccupancyMap::RayIterator::next()
+{
+	// step into the neighbour across the closest voxel boundary
+	int axis = 0;
+
+	if (_t_max[1] < _t_max[axis]) { axis = 1; }
+
+	if (_t_max[2] < _t_max[axis]) { axis = 2; }
+
+	_voxel[axis] += _step[axis];
+	_distance = _t_max[axis];
+	_t_max[axis] += _t_delta[axis];
+}
+
+void OccupancyMap::insertRay(const Vector3f &origin, const Vector3f &end, bool hit)
+{
+	if (_cells == nullptr) {
+		return;
+	}
+
+	const float start[3] = {origin(0), origin(1), origin(2)};
+	float direction[3] = {end(0) - origin(0), end(1) - origin(1), end(2) - origin(2)};
+	const float length = sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+
+	if (!(length > FLT_EPSILON) || !(length < MAX_RAY_VOXELS * _resolution)) {
+		return;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		direction[i] /= length;
+	}
+
+	const float end_position[3] = {end(0), end(1), end(2)};
+	int32_t end_voxel[3];
+	_toVoxel(end_position, end_voxel);
+
+	RayIterator ray(start, direction, _resolution);
+
+	for (int i = 0; i < MAX_RAY_VOXELS; i++) {
+		const int32_t *voxel = ray.voxel();
+
+		if ((voxel[0] == end_voxel[0] && voxel[1] == end_voxel[1] && voxel[2] == end_voxel[2])
+		    || ray.distance() >= length) {
+			break;
+		}
+
+		// the ray passed through this voxel, so it is likely free
+		_update(voxel, LOG_ODDS_MISS);
+		ray.next();
+	}
+
+	if (hit) {
+		_update(end_voxel, LOG_ODDS_HIT);
+	}
+}
+
+float OccupancyMap::raycast(const Vector3f &origin, const Vector3f &direction, float max_range,
+			    float half_height) const
+{
+	if (_cells == nullptr || _num_cells == 0) {
+		return NAN;
+	}
+
+	const float start[3] = {origin(0), origin(1), origin(2)};
+	const float dir[3] = {direction(0), direction(1), direction(2)};
+	RayIterator ray(start, dir, _resolution);
+
+	// vertical extent of the slab in voxels, relative to the voxel the ray passes
+	const int32_t z_origin = (int32_t)floorf(origin(2) / _resolution);
+	const int32_t z_below = (int32_t)floorf((origin(2) - fabsf(half_height)) / _resolution) - z_origin;
+	const int32_t z_above = (int32_t)floorf((origin(2) + fabsf(half_height)) / _resolution) - z_origin;
+
+	for (int i = 0; i < MAX_RAY_VOXELS && ray.distance() <= max_range; i++) {
+		int32_t voxel[3] = {ray.voxel()[0], ray.voxel()[1], 0};
+
+		for (int32_t dz = z_below; dz <= z_above; dz++) {
+			voxel[2] = ray.voxel()[2] + dz;
+
+			if (_occupied(voxel)) {
+				return ray.distance();
+			}
+		}
+
+		ray.next();
+	}
+
+	return NAN;
+}
+
+bool OccupancyMap::isOccupied(const Vector3f &position) const
+{
+	if (_cells == nullptr) {
+		return false;
+	}
+
+	const float p[3] = {position(0), position(1), position(2)};
+	int32_t voxel[3];
+	_toVoxel(p, voxel);
+
+	return _occupied(voxel);
+}
@@ -0,0 +1,171 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file OccupancyMap.hpp
+ *
+ * Compact 3D occupancy map in the local frame, stored as a hashed voxel grid.
+ *
+ * Each voxel holds a log-odds occupancy value, updated from range measurements:
+ * the voxel at the end of a ray gets a hit, all voxels the ray passes through a miss.
+ * Only voxels with evidence of being occupied are stored. A voxel whose value drops to
+ * zero is removed again, so the memory is spent on obstacles and not on free space.
+ * Voxels that are not observed anymore fade out with decay().
+ * The table has a fixed capacity that is allocated once in init().
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <matrix/matrix/math.hpp>
+
+class OccupancyMap
+{
+public:
+	OccupancyMap() = default;
+	~OccupancyMap();
+
+	// no copy, the map owns its table
+	OccupancyMap(const OccupancyMap &) = delete;
+	OccupancyMap &operator=(const OccupancyMap &) = delete;
+
+	/**
+	 * Allocate the map and clear it
+	 * @param memory_bytes memory budget for the voxel table, 0 frees the map
+	 * @param resolution edge length of a voxel [m]
+	 * @return true if the map is usable
+	 */
+	bool init(size_t memory_bytes, float resolution = 0.5f);
+
+	bool isInitialized() const { return _cells != nullptr; }
+
+	/**
+	 * Remove all voxels
+	 */
+	void clear();
+
+	/**
+	 * Update the map with a range measurement
+	 * @param origin sensor position in local frame [m]
+	 * @param end measured point in local frame [m]
+	 * @param hit true if an obstacle was measured at end, false if the measurement was out of range
+	 */
+	void insertRay(const matrix::Vector3f &origin, const matrix::Vector3f &end, bool hit);
+
+	/**
+	 * Lower the log-odds of all voxels, such that obstacles which are not observed anymore
+	 * (moved away, or a wrong measurement) are forgotten after a while
+	 * @param amount log-odds to subtract, a voxel dropping to zero is removed
+	 */
+	void decay(int8_t amount);
+
+	/**
+	 * Find the closest occupied voxel along a ray
+	 * @param origin start of the ray in local frame [m]
+	 * @param direction unit vector of the ray direction
+	 * @param max_range maximum distance to search [m]
+	 * @param half_height also search the voxels up to this distance above and below the ray [m],
+	 * which turns the ray into a vertical slab
+	 * @return distance to the boundary of the first occupied voxel [m], NAN if there is none within max_range
+	 */
+	float raycast(const matrix::Vector3f &origin, const matrix::Vector3f &direction, float max_range,
+		      float half_height = 0.f) const;
+
+	/**
+	 * @return true if the voxel containing position is occupied
+	 */
+	bool isOccupied(const matrix::Vector3f &position) const;
+
+	float getResolution() const { return _resolution; }
+	size_t getCapacity() const { return _capacity; }
+	size_t getNumVoxels() const { return _num_cells; }
+	uint32_t getDroppedVoxels() const { return _dropped; } ///< voxels not stored because the map was full
+
+	static constexpr int8_t LOG_ODDS_HIT = 9; ///< log-odds of a hit (p = 0.7), scaled by 10
+	static constexpr int8_t LOG_ODDS_MISS = -4; ///< log-odds of a miss (p = 0.4), scaled by 10
+	static constexpr int8_t LOG_ODDS_MAX = 35; ///< clamping keeps the map able to change
+	static constexpr int8_t LOG_ODDS_OCCUPIED = 5; ///< threshold above which a voxel is occupied
+	static constexpr int MAX_RAY_VOXELS = 512; ///< longest ray that is traversed
+
+private:
+	/**
+	 * Voxel traversal of a ray (Amanatides & Woo)
+	 */
+	class RayIterator
+	{
+	public:
+		RayIterator(const float origin[3], const float direction[3], float resolution);
+
+		const int32_t *voxel() const { return _voxel; }
+		float distance() const { return _distance; } ///< distance at which the ray enters the current voxel
+		void next();
+
+	private:
+		int32_t _voxel[3];
+		int32_t _step[3];
+		float _t_max[3];
+		float _t_delta[3];
+		float _distance{0.f};
+	};
+
+	// A voxel is a single 64 bit word: used flag | 3 x 18 bit coordinates | 8 bit log-odds
+	static constexpr int COORDINATE_BITS = 18;
+	static constexpr uint64_t USED_FLAG = 1ull << 63;
+	static constexpr uint64_t KEY_MASK = (1ull << (3 * COORDINATE_BITS)) - 1;
+
+	void _toVoxel(const float position[3], int32_t voxel[3]) const;
+	static bool _validVoxel(const int32_t voxel[3]);
+	static uint64_t _key(const int32_t voxel[3]);
+	static uint64_t _keyOf(uint64_t cell) { return (cell >> 8) & KEY_MASK; }
+	static int8_t _logOddsOf(uint64_t cell) { return (int8_t)(cell & 0xff); }
+	static uint64_t _makeCell(uint64_t key, int8_t log_odds) { return USED_FLAG | (key << 8) | (uint8_t)log_odds; }
+	size_t _home(uint64_t key) const;
+
+	/**
+	 * @return index of the voxel in the table or -1 if it is not stored
+	 */
+	int32_t _find(uint64_t key) const;
+	bool _occupied(const int32_t voxel[3]) const;
+	void _update(const int32_t voxel[3], int8_t delta);
+	void _erase(size_t index);
+
+	uint64_t *_cells{nullptr};
+	size_t _capacity{0};
+	size_t _mask{0};
+	int _hash_shift{64};
+	size_t _num_cells{0};
+	uint32_t _dropped{0};
+	float _resolution{0.5f};
+};
@@ -0,0 +1,262 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the occupancy map
+ * Run this test only using make tests TESTFILTER=OccupancyMap
+ */
+
+#include <gtest/gtest.h>
+#include <matrix/matrix/math.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+
+#include "OccupancyMap.hpp"
+
+using namespace matrix;
+
+TEST(OccupancyMapTest, NotInitialized)
+{
+	OccupancyMap map;
+	map.insertRay(Vector3f(0.f, 0.f, 0.f), Vector3f(5.f, 0.f, 0.f), true);
+	EXPECT_FALSE(map.isInitialized());
+	EXPECT_FALSE(std::isfinite(map.raycast(Vector3f(0.f, 0.f, 0.f), Vector3f(1.f, 0.f, 0.f), 10.f)));
+	EXPECT_FALSE(map.init(0));
+}
+
+TEST(OccupancyMapTest, HitAndRaycast)
+{
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(4096, 0.5f));
+	EXPECT_EQ(map.getCapacity(), 512u);
+
+	// WHEN: an obstacle is measured 5.2m in front
+	map.insertRay(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(5.3f, 0.1f, -2.1f), true);
+
+	// THEN: it is found by a ray cast in that direction but not in others
+	EXPECT_TRUE(map.isOccupied(Vector3f(5.4f, 0.2f, -2.2f)));
+	EXPECT_NEAR(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(1.f, 0.f, 0.f), 10.f), 4.9f, 1e-4f);
+	EXPECT_FALSE(std::isfinite(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(0.f, 1.f, 0.f), 10.f)));
+	EXPECT_FALSE(std::isfinite(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(1.f, 0.f, 0.f), 4.f)));
+
+	// WHEN: the obstacle is not seen anymore
+	for (int i = 0; i < 3; i++) {
+		map.insertRay(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(8.f, 0.1f, -2.1f), false);
+	}
+
+	// THEN: the voxel is removed
+	EXPECT_FALSE(map.isOccupied(Vector3f(5.4f, 0.2f, -2.2f)));
+	EXPECT_EQ(map.getNumVoxels(), 0u);
+}
+
+TEST(OccupancyMapTest, MemoryLimit)
+{
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(64 * sizeof(uint64_t), 1.f));
+
+	for (int i = 0; i < 100; i++) {
+		map.insertRay(Vector3f(i + 0.5f, 0.5f, 0.4f), Vector3f(i + 0.5f, 0.5f, 0.6f), true);
+	}
+
+	EXPECT_EQ(map.getNumVoxels(), 56u);
+	EXPECT_EQ(map.getDroppedVoxels(), 44u);
+}
+
+TEST(OccupancyMapTest, RandomUpdates)
+{
+	// Compare against a reference to check that removing voxels keeps the others reachable
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(1024 * sizeof(uint64_t), 1.f));
+	std::map<std::pair<int, int>, int> reference;
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<int> coordinate(-12, 12);
+
+	for (int i = 0; i < 20000; i++) {
+		const int x = coordinate(generator);
+		const int y = coordinate(generator);
+		const Vector3f center(x + 0.5f, y + 0.5f, 0.5f);
+		int &log_odds = reference[std::make_pair(x, y)];
+
+		if (generator() % 3 != 0) {
+			// hit inside a single voxel
+			map.insertRay(Vector3f(center(0), center(1), 0.2f), center, true);
+			log_odds = std::min(log_odds + OccupancyMap::LOG_ODDS_HIT, (int)OccupancyMap::LOG_ODDS_MAX);
+
+		} else {
+			// the first voxel of a ray is a miss
+			map.insertRay(center, Vector3f(center(0), center(1), 0.5f + 0.9f), false);
+			log_odds = std::max(log_odds + OccupancyMap::LOG_ODDS_MISS, 0);
+		}
+	}
+
+	size_t occupied = 0;
+
+	for (const auto &voxel : reference) {
+		const Vector3f center(voxel.first.first + 0.5f, voxel.first.second + 0.5f, 0.5f);
+		const bool expected = voxel.second > OccupancyMap::LOG_ODDS_OCCUPIED;
+		EXPECT_EQ(map.isOccupied(center), expected) << voxel.first.first << "," << voxel.first.second;
+		occupied += voxel.second > 0 ? 1 : 0;
+	}
+
+	EXPECT_EQ(map.getNumVoxels(), occupied);
+	EXPECT_EQ(map.getDroppedVoxels(), 0u);
+}
+
+TEST(OccupancyMapTest, Decay)
+{
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(64 * sizeof(uint64_t), 1.f));
+
+	// GIVEN: a saturated voxel and a voxel seen once
+	for (int i = 0; i < 5; i++) {
+		map.insertRay(Vector3f(0.5f, 0.5f, 0.2f), Vector3f(0.5f, 0.5f, 0.5f), true);
+	}
+
+	map.insertRay(Vector3f(3.5f, 0.5f, 0.2f), Vector3f(3.5f, 0.5f, 0.5f), true);
+	EXPECT_EQ(map.getNumVoxels(), 2u);
+
+	// WHEN: the map decays until the single hit drops below the threshold
+	for (int i = 0; i < OccupancyMap::LOG_ODDS_HIT - OccupancyMap::LOG_ODDS_OCCUPIED; i++) {
+		map.decay(1);
+	}
+
+	// THEN: it is free, the saturated voxel is kept
+	EXPECT_FALSE(map.isOccupied(Vector3f(3.5f, 0.5f, 0.5f)));
+	EXPECT_TRUE(map.isOccupied(Vector3f(0.5f, 0.5f, 0.5f)));
+
+	// WHEN: it decays long enough
+	for (int i = 0; i < OccupancyMap::LOG_ODDS_MAX; i++) {
+		map.decay(1);
+	}
+
+	// THEN: all voxels are removed
+	EXPECT_EQ(map.getNumVoxels(), 0u);
+}
+
+TEST(OccupancyMapTest, DecayFullTable)
+{
+	// Removing many voxels at once must keep the remaining ones reachable
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(128 * sizeof(uint64_t), 1.f));
+	std::mt19937 generator(3);
+	std::uniform_int_distribution<int> coordinate(-20, 20);
+	std::map<std::pair<int, int>, int> reference;
+
+	while (map.getNumVoxels() < 100) {
+		const int x = coordinate(generator);
+		const int y = coordinate(generator);
+		const int hits = 1 + generator() % 3;
+
+		for (int i = 0; i < hits; i++) {
+			map.insertRay(Vector3f(x + 0.5f, y + 0.5f, 0.2f), Vector3f(x + 0.5f, y + 0.5f, 0.5f), true);
+		}
+
+		int &log_odds = reference[std::make_pair(x, y)];
+		log_odds = std::min(log_odds + hits * OccupancyMap::LOG_ODDS_HIT, (int)OccupancyMap::LOG_ODDS_MAX);
+	}
+
+	map.decay(OccupancyMap::LOG_ODDS_HIT);
+
+	size_t remaining = 0;
+
+	for (const auto &voxel : reference) {
+		const int log_odds = voxel.second - OccupancyMap::LOG_ODDS_HIT;
+		const Vector3f center(voxel.first.first + 0.5f, voxel.first.second + 0.5f, 0.5f);
+		EXPECT_EQ(map.isOccupied(center), log_odds > OccupancyMap::LOG_ODDS_OCCUPIED);
+		remaining += log_odds > 0 ? 1 : 0;
+	}
+
+	EXPECT_EQ(map.getNumVoxels(), remaining);
+}
+
+TEST(OccupancyMapTest, RaycastSlab)
+{
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(4096, 0.5f));
+
+	// GIVEN: an obstacle 1.1m below the vehicle altitude, seen by a tilted sensor
+	map.insertRay(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(4.1f, 0.1f, -1.0f), true);
+
+	// THEN: a horizontal ray misses it, a slab covering it finds it
+	EXPECT_FALSE(std::isfinite(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(1.f, 0.f, 0.f), 10.f)));
+	EXPECT_FALSE(std::isfinite(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(1.f, 0.f, 0.f), 10.f, 0.5f)));
+	EXPECT_NEAR(map.raycast(Vector3f(0.1f, 0.1f, -2.1f), Vector3f(1.f, 0.f, 0.f), 10.f, 1.5f), 3.9f, 1e-4f);
+}
+
+TEST(OccupancyMapTest, InsertionBenchmark)
+{
+	// A rangefinder ring around the vehicle with 10m rays at 0.5m resolution
+	static constexpr int N = 100000;
+	OccupancyMap map;
+	ASSERT_TRUE(map.init(32 * 1024, 0.5f));
+	std::mt19937 generator(2);
+	std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+	std::uniform_real_distribution<float> range(1.f, 12.f);
+
+	const Vector3f origin(0.2f, 0.3f, -3.f);
+	Vector3f end[256];
+	bool hit[256];
+
+	for (int i = 0; i < 256; i++) {
+		const float a = angle(generator);
+		const float r = range(generator);
+		hit[i] = r < 10.f;
+		end[i] = Vector3f(origin(0) + cosf(a) * fminf(r, 10.f), origin(1) + sinf(a) * fminf(r, 10.f), origin(2));
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < N; i++) {
+		map.insertRay(origin, end[i % 256], hit[i % 256]);
+	}
+
+	const double insert_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	float sum = 0.f;
+	start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < N; i++) {
+		const float a = 2.f * 3.14159f * (i % 360) / 360.f;
+		const float distance = map.raycast(origin, Vector3f(cosf(a), sinf(a), 0.f), 10.f);
+		sum += std::isfinite(distance) ? distance : 0.f;
+	}
+
+	const double raycast_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	printf("insertion: %.3f us per 10m ray, ray cast: %.3f us, %zu voxels (%.1f)\n",
+	       insert_us / N, raycast_us / N, map.getNumVoxels(), (double)sum);
+	EXPECT_GT(map.getNumVoxels(), 0u);
+}
@@ -39,6 +39,9 @@
 
 #include "BezierQuad.hpp"
 
+#include <float.h>
+#include <mathlib/mathlib.h>
+
 namespace bezier
 {
 static constexpr double GOLDEN_RATIO = 1.6180339887; //(sqrt(5)+1)/2
@@ -52,7 +55,16 @@ void BezierQuad<Tp>::setBezier(const Vector3_t &pt0, const Vector3_t &ctrl, cons
 	_ctrl = ctrl;
 	_pt1 = pt1;
 	_duration = duration;
+	_updateCoefficients();
+}
+
+template<typename Tp>
+void BezierQuad<Tp>::_updateCoefficients()
+{
+	_a = (_pt0 - _ctrl * (Tp)2 + _pt1) / (_duration * _duration);
+	_b = (_ctrl - _pt0) * (Tp)2 / _duration;
 	_cached_resolution = (Tp)(-1);
+	_arc_length_table_valid = false;
 }
 
 template<typename Tp>
@@ -66,21 +78,19 @@ void BezierQuad<Tp>::getBezier(Vector3_t &pt0, Vector3_t &ctrl, Vector3_t &pt1)
 template<typename Tp>
 matrix::Vector<Tp, 3> BezierQuad<Tp>::getPoint(const Tp t)
 {
-	return (_pt0 * ((Tp)1 - t / _duration) * ((Tp)1 - t / _duration) + _ctrl * (Tp)2 * ((
-				Tp)1 - t / _duration) * t / _duration +   _pt1 *
-		t / _duration * t / _duration);
+	return (_a * t + _b) * t + _pt0;
 }
 
 template<typename Tp>
 matrix::Vector<Tp, 3> BezierQuad<Tp>::getVelocity(const Tp t)
 {
-	return (((_ctrl - _pt0) * _duration + (_pt0 - _ctrl * (Tp)2 + _pt1) * t) * (Tp)2 / (_duration * _duration));
+	return _a * ((Tp)2 * t) + _b;
 }
 
 template<typename Tp>
 matrix::Vector<Tp, 3> BezierQuad<Tp>::getAcceleration()
 {
-	return ((_pt0 - _ctrl * (Tp)2 + _pt1) * (Tp)2 / (_duration * _duration));
+	return _a * (Tp)2;
 }
 
 template<typename Tp>
@@ -103,6 +113,26 @@ void BezierQuad<Tp>::getStatesClosest(Vector3_t &point, Vector3_t &vel, Vector3_
 
 }
 
+template<typename Tp>
+void BezierQuad<Tp>::getStates(const Tp t[], Vector3_t point[], Vector3_t vel[], Vector3_t acc[], const int n)
+{
+	const Vector3_t acceleration = _a * (Tp)2;
+
+	for (int i = 0; i < n; i++) {
+		if (point) {
+			point[i] = (_a * t[i] + _b) * t[i] + _pt0;
+		}
+
+		if (vel) {
+			vel[i] = acceleration * t[i] + _b;
+		}
+
+		if (acc) {
+			acc[i] = acceleration;
+		}
+	}
+}
+
 template<typename Tp>
 void BezierQuad<Tp>::setBezFromVel(const Vector3_t &ctrl, const Vector3_t &vel0, const Vector3_t &vel1,
 				   const Tp duration)
@@ -112,7 +142,7 @@ void BezierQuad<Tp>::setBezFromVel(const Vector3_t &ctrl, const Vector3_t &vel0,
 	_duration = duration;
 	_pt0 = _ctrl - vel0 * _duration / (Tp)2;
 	_pt1 = _ctrl + vel1 * _duration / (Tp)2;
-	_cached_resolution = (Tp)(-1);
+	_updateCoefficients();
 }
 
 template<typename Tp>
@@ -164,6 +194,118 @@ Tp BezierQuad<Tp>::getArcLength(const Tp resolution)
 	return _cached_arc_length;
 }
 
+template<typename Tp>
+Tp BezierQuad<Tp>::_integrateSpeed(const Tp t0, const Tp t1)
+{
+	// nodes and weights of the 3 point Gauss-Legendre rule on [-1, 1]
+	static constexpr double NODE = 0.7745966692414834; // sqrt(3/5)
+	static constexpr double WEIGHT_OUTER = 5.0 / 9.0;
+	static constexpr double WEIGHT_CENTER = 8.0 / 9.0;
+
+	const Tp half = (t1 - t0) / (Tp)2;
+	const Tp mid = (t0 + t1) / (Tp)2;
+
+	return half * ((Tp)WEIGHT_OUTER * getVelocity(mid - half * (Tp)NODE).length()
+		       + (Tp)WEIGHT_CENTER * getVelocity(mid).length()
+		       + (Tp)WEIGHT_OUTER * getVelocity(mid + half * (Tp)NODE).length());
+}
+
+template<typename Tp>
+void BezierQuad<Tp>::_updateArcLengthTable()
+{
+	const Tp dt = _duration / (Tp)(ARC_LENGTH_TABLE_SIZE - 1);
+
+	_arc_length_table[0] = (Tp)0;
+
+	for (int i = 1; i < ARC_LENGTH_TABLE_SIZE; i++) {
+		_arc_length_table[i] = _arc_length_table[i - 1] + _integrateSpeed(dt * (i - 1), dt * i);
+	}
+
+	_arc_length_table_valid = true;
+}
+
+template<typename Tp>
+Tp BezierQuad<Tp>::getArcLengthAtTime(const Tp t)
+{
+	if (!_arc_length_table_valid) {
+		_updateArcLengthTable();
+	}
+
+	const Tp dt = _duration / (Tp)(ARC_LENGTH_TABLE_SIZE - 1);
+	const Tp t_constrained = math::constrain(t, (Tp)0, _duration);
+	const int i = math::min((int)(t_constrained / dt), ARC_LENGTH_TABLE_SIZE - 2);
+
+	return _arc_length_table[i] + _integrateSpeed(dt * i, t_constrained);
+}
+
+template<typename Tp>
+Tp BezierQuad<Tp>::getTimeAtArcLength(const Tp s)
+{
+	if (!_arc_length_table_valid) {
+		_updateArcLengthTable();
+	}
+
+	if (s <= (Tp)0) {
+		return (Tp)0;
+	}
+
+	if (s >= _arc_length_table[ARC_LENGTH_TABLE_SIZE - 1]) {
+		return _duration;
+	}
+
+	// find the table interval containing s
+	int low = 0;
+	int high = ARC_LENGTH_TABLE_SIZE - 1;
+
+	while (high - low > 1) {
+		const int mid = (low + high) / 2;
+
+		if (_arc_length_table[mid] <= s) {
+			low = mid;
+
+		} else {
+			high = mid;
+		}
+	}
+
+	// interpolate in the interval and refine with a Newton step on s(t) = s
+	const Tp dt = _duration / (Tp)(ARC_LENGTH_TABLE_SIZE - 1);
+	const Tp t_low = dt * low;
+	const Tp interval = _arc_length_table[high] - _arc_length_table[low];
+	Tp t = t_low + dt * (s - _arc_length_table[low]) / math::max(interval, (Tp)FLT_EPSILON);
+
+	const Tp speed = getVelocity(t).length();
+
+	if (speed > (Tp)FLT_EPSILON) {
+		t -= (_arc_length_table[low] + _integrateSpeed(t_low, t) - s) / speed;
+	}
+
+	return math::constrain(t, t_low, t_low + dt);
+}
+
+template<typename Tp>
+void BezierQuad<Tp>::getPointsEquidistant(Vector3_t point[], Tp t[], const int n)
+{
+	if (n < 2) {
+		return;
+	}
+
+	if (!_arc_length_table_valid) {
+		_updateArcLengthTable();
+	}
+
+	const Tp step = _arc_length_table[ARC_LENGTH_TABLE_SIZE - 1] / (Tp)(n - 1);
+
+	for (int i = 0; i < n; i++) {
+		const Tp time = getTimeAtArcLength(step * i);
+		point[i] = getPoint(time);
+
+		if (t) {
+			t[i] = time;
+		}
+	}
+}
+
 template<typename Tp>
 Tp BezierQuad<Tp>::getDistToClosestPoint(const Vector3_t &pose)
 {
@@ -42,6 +42,10 @@
  * pt1.
  * A bezier spline is a continuous function from which position, velocity and acceleration can be extracted. For a given spline,
  * acceleration stays constant.
+ *
+ * The spline is kept in polynomial form in time, point(t) = a * t^2 + b * t + pt0, which is updated whenever the
+ * points or the duration change. For sampling at constant speed, the arc length over time is stored in a lookup table
+ * the first time it is needed.
  */
 
 
@@ -62,20 +66,20 @@ public:
 	 * Empty constructor
 	 */
 	BezierQuad() :
-		_pt0(Vector3_t()), _ctrl(Vector3_t()), _pt1(Vector3_t()), _duration(1.0f) {}
+		_pt0(Vector3_t()), _ctrl(Vector3_t()), _pt1(Vector3_t()), _duration(1.0f) { _updateCoefficients(); }
 
 	/**
 	 * Constructor from array
 	 */
 	BezierQuad(const Tp pt0[3], const Tp ctrl[3], const Tp pt1[3], Tp duration = 1.0f) :
-		_pt0(Vector3_t(pt0)), _ctrl(Vector3_t(ctrl)), _pt1(Vector3_t(pt1)), _duration(duration) {}
+		_pt0(Vector3_t(pt0)), _ctrl(Vector3_t(ctrl)), _pt1(Vector3_t(pt1)), _duration(duration) { _updateCoefficients(); }
 
 	/**
 	 * Constructor from vector
 	 */
 	BezierQuad(const Vector3_t &pt0, const Vector3_t &ctrl, const Vector3_t &pt1,
 		   Tp duration = 1.0f):
-		_pt0(pt0), _ctrl(ctrl), _pt1(pt1), _duration(duration) {}
+		_pt0(pt0), _ctrl(ctrl), _pt1(pt1), _duration(duration) { _updateCoefficients(); }
 
 
 	/*
@@ -109,7 +113,7 @@ public:
 	 *
 	 * @param time is the total time it takes to travel along the bezier spline.
 	 */
-	void setDuration(const Tp time) {_duration = time;}
+	void setDuration(const Tp time) {_duration = time; _updateCoefficients();}
 
 	/**
 	 * Return point on bezier point corresponding to time t
@@ -147,6 +151,14 @@ public:
 	 */
 	void getStates(Vector3_t &point, Vector3_t &vel, Vector3_t &acc, const Tp t);
 
+	/*
+	 * Get the states on bezier at n times in one call
+	 *
+	 * @param t are n times in seconds in between [0, duration]
+	 * @param point, vel, acc are arrays of n states to fill, each of them can be nullptr if not needed
+	 */
+	void getStates(const Tp t[], Vector3_t point[], Vector3_t vel[], Vector3_t acc[], const int n);
+
 	/*
 	 * Get states on bezier which are closest to pose in space
 	 *
@@ -175,6 +187,33 @@ public:
 	 */
 	Tp getArcLength(const Tp resolution);
 
+	/*
+	 * Return the arc length from pt0 to the point at time t
+	 *
+	 * @param t is a time in seconds in between [0, duration]
+	 */
+	Tp getArcLengthAtTime(const Tp t);
+
+	/*
+	 * Return the time at which the arc length from pt0 reaches s
+	 *
+	 * This is the reparameterization of the spline by arc length.
+	 * @param s is an arc length in between [0, total arc length]
+	 * @return time in seconds in between [0, duration]
+	 */
+	Tp getTimeAtArcLength(const Tp s);
+
+	/*
+	 * Sample n points at equal arc length distances from pt0 to pt1, as if the spline was traveled at constant speed
+	 *
+	 * @param point is an array of n points to fill
+	 * @param t is an array of the n corresponding times, can be nullptr if not needed
+	 * @param n number of points, at least 2
+	 */
+	void getPointsEquidistant(Vector3_t point[], Tp t[], const int n);
+
+	static constexpr int ARC_LENGTH_TABLE_SIZE = 17; /**< number of samples of the arc length lookup table */
+
 private:
 
 	Vector3_t _pt0; /**< Bezier starting point */
@@ -182,6 +221,12 @@ private:
 	Vector3_t _pt1; /**< bezier end point */
 	Tp _duration = (Tp)1; /**< Total time to travle along spline */
 
+	Vector3_t _a; /**< polynomial form: point(t) = _a * t^2 + _b * t + _pt0 */
+	Vector3_t _b;
+
+	Tp _arc_length_table[ARC_LENGTH_TABLE_SIZE] {}; /**< arc length at times i * duration / (ARC_LENGTH_TABLE_SIZE - 1) */
+	bool _arc_length_table_valid = false;
+
 	Tp _cached_arc_length = (Tp)0; /**< The saved arc length of the spline */
 	Tp _cached_resolution = (Tp)(-1); /**< The resolution used to compute the arc length.
 									Negative number means that cache is not up to date. */
@@ -199,6 +244,21 @@ private:
 	 */
 	Tp _getDistanceSquared(const Tp t, const Vector3_t &pose);
 
+	/*
+	 * Update the polynomial form from the bezier points and the duration, invalidates the arc length caches
+	 */
+	void _updateCoefficients();
+
+	/*
+	 * Compute the arc length lookup table
+	 */
+	void _updateArcLengthTable();
+
+	/*
+	 * Arc length in between t0 and t1, 3 point Gauss-Legendre integration of the speed
+	 */
+	Tp _integrateSpeed(const Tp t0, const Tp t1);
+
 
 };
 
@@ -0,0 +1,253 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SpscRingBuffer.hpp
+ *
+ * Lock-free single-producer/single-consumer ring buffer.
+ *
+ * One context (e.g. an interrupt handler or a driver work item) puts items,
+ * another one (e.g. a reader in a cdev read()) gets them. Neither side blocks
+ * or disables interrupts. The indices are free running and only masked when
+ * the storage is accessed, so the capacity has to be a power of two.
+ *
+ * force() allows the producer to discard the oldest item. This is the only
+ * case in which the producer modifies the tail index, the consumer detects it
+ * with a compare-and-swap and retries its read.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <px4_atomic.h>
+
+namespace ringbuffer
+{
+
+template<typename T, size_t N>
+class SpscRingBuffer
+{
+public:
+	static_assert(N > 0 && (N & (N - 1)) == 0, "capacity must be a power of two");
+	static_assert(N <= (1u << 31), "capacity too large");
+
+	SpscRingBuffer() = default;
+	~SpscRingBuffer() = default;
+
+	// no copy, assignment, move, move assignment
+	SpscRingBuffer(const SpscRingBuffer &) = delete;
+	SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+	SpscRingBuffer(SpscRingBuffer &&) = delete;
+	SpscRingBuffer &operator=(SpscRingBuffer &&) = delete;
+
+	/**
+	 * Put an item into the buffer (producer).
+	 *
+	 * @param item		Item to put
+	 * @return		true if the item was put, false if the buffer is full
+	 */
+	bool put(const T &item)
+	{
+		const uint32_t head = _head.value.load();
+
+		if (head - _tail.value.load() >= N) {
+			return false;
+		}
+
+		_buf[head & MASK] = item;
+		_head.value.store(head + 1);
+		return true;
+	}
+
+	/**
+	 * Put up to num items into the buffer (producer).
+	 *
+	 * @param items		Items to put
+	 * @param num		Number of items
+	 * @return		Number of items that were put
+	 */
+	size_t put(const T items[], size_t num)
+	{
+		const uint32_t head = _head.value.load();
+		const size_t free_space = N - (head - _tail.value.load());
+
+		if (num > free_space) {
+			num = free_space;
+		}
+
+		copy_in(head, items, num);
+		_head.value.store(head + num);
+		return num;
+	}
+
+	/**
+	 * Put an item into the buffer, discarding the oldest item if there is no space (producer).
+	 *
+	 * @param item		Item to put
+	 * @return		true if an item was discarded to make space
+	 */
+	bool force(const T &item)
+	{
+		const uint32_t head = _head.value.load();
+		uint32_t tail = _tail.value.load();
+		bool discarded = false;
+
+		// if the consumer advanced the tail concurrently there is space again
+		while (head - tail >= N) {
+			if (_tail.value.compare_exchange(&tail, tail + 1)) {
+				discarded = true;
+				break;
+			}
+		}
+
+		_buf[head & MASK] = item;
+		_head.value.store(head + 1);
+		return discarded;
+	}
+
+	/**
+	 * Get an item from the buffer (consumer).
+	 *
+	 * @param item		Item that was got
+	 * @return		true if an item was got, false if the buffer was empty
+	 */
+	bool get(T &item)
+	{
+		return get(&item, 1) == 1;
+	}
+
+	/**
+	 * Get up to num items from the buffer (consumer).
+	 *
+	 * @param items		Storage for the items, may be nullptr to discard them
+	 * @param num		Maximum number of items to get
+	 * @return		Number of items that were got
+	 */
+	size_t get(T items[], size_t num)
+	{
+		uint32_t tail = _tail.value.load();
+
+		for (;;) {
+			const uint32_t available = _head.value.load() - tail;
+			const size_t n = (num < available) ? num : available;
+
+			if (n == 0) {
+				return 0;
+			}
+
+			if (items != nullptr) {
+				copy_out(tail, items, n);
+			}
+
+			// if the producer discarded items while we were copying, the copy may be torn: retry
+			if (_tail.value.compare_exchange(&tail, tail + n)) {
+				return n;
+			}
+		}
+	}
+
+	/**
+	 * Number of items in the buffer.
+	 */
+	size_t count() const
+	{
+		// load the tail first, it can never overtake a head loaded after it
+		const uint32_t tail = _tail.value.load();
+		return _head.value.load() - tail;
+	}
+
+	/**
+	 * Number of items that can be put before the buffer is full.
+	 */
+	size_t space() const { return N - count(); }
+
+	bool empty() const { return count() == 0; }
+	bool full() const { return count() >= N; }
+
+	static constexpr size_t size() { return N; }
+
+	/**
+	 * Empty the buffer (consumer).
+	 */
+	void flush() { get(nullptr, N); }
+
+	void print_info(const char *name) const
+	{
+		printf("%s\t%u/%u (%u/%u @ %p)\n", name, (unsigned)count(), (unsigned)N,
+		       (unsigned)_head.value.load(), (unsigned)_tail.value.load(), _buf);
+	}
+
+private:
+	static constexpr uint32_t MASK = N - 1;
+
+#if defined(__PX4_NUTTX)
+	static constexpr size_t CACHE_LINE_SIZE = 32;
+#else
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+#endif
+
+	void copy_in(uint32_t index, const T items[], size_t num)
+	{
+		const size_t first = index & MASK;
+		const size_t chunk = (num < N - first) ? num : N - first;
+
+		memcpy(&_buf[first], items, chunk * sizeof(T));
+		memcpy(&_buf[0], &items[chunk], (num - chunk) * sizeof(T));
+	}
+
+	void copy_out(uint32_t index, T items[], size_t num) const
+	{
+		const size_t first = index & MASK;
+		const size_t chunk = (num < N - first) ? num : N - first;
+
+		memcpy(items, &_buf[first], chunk * sizeof(T));
+		memcpy(&items[chunk], &_buf[0], (num - chunk) * sizeof(T));
+	}
+
+	// the indices are padded apart so that producer and consumer do not share a cache line
+	struct PaddedIndex {
+		px4::atomic<uint32_t> value{0};
+		uint8_t padding[CACHE_LINE_SIZE - sizeof(px4::atomic<uint32_t>)];
+	};
+
+	PaddedIndex _head{};	///< insertion index, written by the producer
+	PaddedIndex _tail{};	///< removal index, written by the consumer (and by force())
+
+	T _buf[N];
+};
+
+} // namespace ringbuffer
@@ -169,7 +169,14 @@ out:
 int
 I2C::transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len)
 {
-	px4_i2c_msg_t msgv[2];
+	const Transfer xfer{send, send_len, recv, recv_len};
+	return transfer_multi(&xfer, 1);
+}
+
+int
+I2C::transfer_multi(const Transfer transfers[], unsigned count)
+{
+	px4_i2c_msg_t msgv[2 * MAX_TRANSFERS];
 	unsigned msgs;
 	int ret = PX4_ERROR;
 	unsigned retry_count = 0;
@@ -179,26 +186,38 @@ I2C::transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const
 		return 1;
 	}
 
+	if (count > MAX_TRANSFERS) {
+		return -EINVAL;
+	}
+
 	do {
-		DEVICE_DEBUG("transfer out %p/%u  in %p/%u", send, send_len, recv, recv_len);
 		msgs = 0;
 
-		if (send_len > 0) {
-			msgv[msgs].frequency = _bus_clocks[get_device_bus() - 1];
-			msgv[msgs].addr = get_device_address();
-			msgv[msgs].flags = 0;
-			msgv[msgs].buffer = const_cast<uint8_t *>(send);
-			msgv[msgs].length = send_len;
-			msgs++;
-		}
-
-		if (recv_len > 0) {
-			msgv[msgs].frequency = _bus_clocks[get_device_bus() - 1];
-			msgv[msgs].addr = get_device_address();
-			msgv[msgs].flags = I2C_M_READ;
-			msgv[msgs].buffer = recv;
-			msgv[msgs].length = recv_len;
-			msgs++;
+		for (unsigned i = 0; i < count; i++) {
+			DEVICE_DEBUG("transfer out %p/%u  in %p/%u", transfers[i].send, transfers[i].send_len,
+				     transfers[i].recv, transfers[i].recv_len);
+
+			if ((transfers[i].send_len == 0) && (transfers[i].recv_len == 0)) {
+				return -EINVAL;
+			}
+
+			if (transfers[i].send_len > 0) {
+				msgv[msgs].frequency = _bus_clocks[get_device_bus() - 1];
+				msgv[msgs].addr = get_device_address();
+				msgv[msgs].flags = 0;
+				msgv[msgs].buffer = const_cast<uint8_t *>(transfers[i].send);
+				msgv[msgs].length = transfers[i].send_len;
+				msgs++;
+			}
+
+			if (transfers[i].recv_len > 0) {
+				msgv[msgs].frequency = _bus_clocks[get_device_bus() - 1];
+				msgv[msgs].addr = get_device_address();
+				msgv[msgs].flags = I2C_M_READ;
+				msgv[msgs].buffer = transfers[i].recv;
+				msgv[msgs].length = transfers[i].recv_len;
+				msgs++;
+			}
 		}
 
 		if (msgs == 0) {
@@ -103,6 +103,31 @@ protected:
 	 */
 	int		transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len);
 
+	/**
+	 * A single transaction of a batch, see transfer_multi().
+	 */
+	struct Transfer {
+		const uint8_t	*send;		///< bytes to send
+		unsigned	send_len;	///< number of bytes to send, may be 0
+		uint8_t		*recv;		///< buffer for received bytes
+		unsigned	recv_len;	///< number of bytes to receive, may be 0
+	};
+
+	static constexpr unsigned MAX_TRANSFERS = 4;	///< maximum number of transactions in a batch
+
+	/**
+	 * Perform several I2C transactions to the device in one go.
+	 *
+	 * The transactions are chained with repeated starts. All messages are handed to the bus driver in a single I2C_TRANSFER.
+	 *
+	 * @param transfers	Transactions to perform, at least one of send_len and
+	 *			recv_len must be non-zero for each.
+	 * @param count		Number of transactions, at most MAX_TRANSFERS.
+	 * @return		OK if the transfer was successful, -errno
+	 *			otherwise.
+	 */
+	int		transfer_multi(const Transfer transfers[], unsigned count);
+
 	bool		external() { return px4_i2c_bus_external(_device_id.devid_s.bus); }
 
 private:
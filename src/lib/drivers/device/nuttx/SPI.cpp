@@ -225,4 +225,61 @@ SPI::_transferhword(uint16_t *send, uint16_t *recv, unsigned len)
 	return PX4_OK;
 }
 
+int
+SPI::transfer_multi(const Transfer transfers[], unsigned count)
+{
+	int result;
+
+	if ((count == 0) || (count > MAX_TRANSFERS)) {
+		return -EINVAL;
+	}
+
+	for (unsigned i = 0; i < count; i++) {
+		if ((transfers[i].send == nullptr) && (transfers[i].recv == nullptr)) {
+			return -EINVAL;
+		}
+	}
+
+	LockMode mode = up_interrupt_context() ? LOCK_NONE : _locking_mode;
+
+	/* lock the bus once for the whole batch */
+	switch (mode) {
+	default:
+	case LOCK_PREEMPTION: {
+			irqstate_t state = px4_enter_critical_section();
+			result = _transfer_multi(transfers, count);
+			px4_leave_critical_section(state);
+		}
+		break;
+
+	case LOCK_THREADS:
+		SPI_LOCK(_dev, true);
+		result = _transfer_multi(transfers, count);
+		SPI_LOCK(_dev, false);
+		break;
+
+	case LOCK_NONE:
+		result = _transfer_multi(transfers, count);
+		break;
+	}
+
+	return result;
+}
+
+int
+SPI::_transfer_multi(const Transfer transfers[], unsigned count)
+{
+	SPI_SETFREQUENCY(_dev, _frequency);
+	SPI_SETMODE(_dev, _mode);
+	SPI_SETBITS(_dev, 8);
+
+	for (unsigned i = 0; i < count; i++) {
+		SPI_SELECT(_dev, _device, true);
+		SPI_EXCHANGE(_dev, transfers[i].send, transfers[i].recv, transfers[i].len);
+		SPI_SELECT(_dev, _device, false);
+	}
+
+	return PX4_OK;
+}
+
 } // namespace device
@@ -122,6 +122,32 @@ protected:
 	 */
 	int		transferhword(uint16_t *send, uint16_t *recv, unsigned len);
 
+	/**
+	 * A single transfer of a batch, see transfer_multi().
+	 */
+	struct Transfer {
+		uint8_t		*send;	///< bytes to send, or nullptr
+		uint8_t		*recv;	///< buffer for received bytes, or nullptr
+		unsigned	len;	///< number of bytes to transfer
+	};
+
+	static constexpr unsigned MAX_TRANSFERS = 8;	///< maximum number of transfers in a batch
+
+	/**
+	 * Perform several SPI transfers in one go.
+	 *
+	 * Chip select is released between the individual transfers, so each
+	 * transfer is seen as a separate transaction by the device. The bus is
+	 * locked once for the whole batch.
+	 *
+	 * @param transfers	Transfers to perform, at least one of send or recv must
+	 *			be non-null for each.
+	 * @param count		Number of transfers, at most MAX_TRANSFERS.
+	 * @return		OK if all exchanges were successful, -errno
+	 *			otherwise.
+	 */
+	int		transfer_multi(const Transfer transfers[], unsigned count);
+
 	/**
 	 * Set the SPI bus frequency
 	 * This is used to change frequency on the fly. Some sensors
@@ -161,6 +187,8 @@ protected:
 
 	int	_transferhword(uint16_t *send, uint16_t *recv, unsigned len);
 
+	int	_transfer_multi(const Transfer transfers[], unsigned count);
+
 	bool	external() { return px4_spi_bus_external(get_device_bus()); }
 
 };
@@ -120,65 +120,59 @@ I2C::init()
 
 int
 I2C::transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len)
+{
+	const Transfer xfer{send, send_len, recv, recv_len};
+	return transfer_multi(&xfer, 1);
+}
+
+int
+I2C::transfer_multi(const Transfer transfers[], unsigned count)
 {
 #ifndef __PX4_LINUX
 	return PX4_ERROR;
 #else
-	struct i2c_msg msgv[2];
+	struct i2c_msg msgv[2 * MAX_TRANSFERS];
 	unsigned msgs;
 	int ret = PX4_ERROR;
 	unsigned retry_count = 0;
 
-	if (_fd < 0) {
-		PX4_ERR("I2C device not opened");
-		return 1;
+	if (count > MAX_TRANSFERS) {
+		return -EINVAL;
 	}
 
 	do {
-		DEVICE_DEBUG("transfer out %p/%u  in %p/%u", send, send_len, recv, recv_len);
 		msgs = 0;
 
-		if (send_len > 0) {
-			msgv[msgs].addr = get_device_address();
-			msgv[msgs].flags = 0;
-			msgv[msgs].buf = const_cast<uint8_t *>(send);
-			msgv[msgs].len = send_len;
-			msgs++;
-		}
+		for (unsigned i = 0; i < count; i++) {
+			DEVICE_DEBUG("transfer out %p/%u  in %p/%u", transfers[i].send, transfers[i].send_len,
+				     transfers[i].recv, transfers[i].recv_len);
 
-		if (recv_len > 0) {
-			msgv[msgs].addr = get_device_address();
-			msgv[msgs].flags = I2C_M_READ;
-			msgv[msgs].buf = recv;
-			msgv[msgs].len = recv_len;
-			msgs++;
+			if ((transfers[i].send_len == 0) && (transfers[i].recv_len == 0)) {
+				return -EINVAL;
+			}
+
+			if (transfers[i].send_len > 0) {
+				msgv[msgs].addr = get_device_address();
+				msgv[msgs].flags = 0;
+				msgv[msgs].buf = const_cast<uint8_t *>(transfers[i].send);
+				msgv[msgs].len = transfers[i].send_len;
+				msgs++;
+			}
+
+			if (transfers[i].recv_len > 0) {
+				msgv[msgs].addr = get_device_address();
+				msgv[msgs].flags = I2C_M_READ;
+				msgv[msgs].buf = transfers[i].recv;
+				msgv[msgs].len = transfers[i].recv_len;
+				msgs++;
+			}
 		}
 
 		if (msgs == 0) {
 			return -EINVAL;
 		}
 
-		struct i2c_rdwr_ioctl_data packets;
-
-		packets.msgs  = msgv;
-
-		packets.nmsgs = msgs;
-
-		if (simulate) {
-			DEVICE_DEBUG("I2C SIM: transfer_4 on %s", get_devname());
-			ret = PX4_OK;
-
-		} else {
-			ret = ::ioctl(_fd, I2C_RDWR, (unsigned long)&packets);
-
-			if (ret == -1) {
-				DEVICE_DEBUG("I2C transfer failed");
-				ret = PX4_ERROR;
-
-			} else {
-				ret = PX4_OK;
-			}
-		}
+		ret = i2c_rdwr(msgv, msgs);
 
 		/* success */
 		if (ret == PX4_OK) {
@@ -191,4 +185,33 @@ I2C::transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const
 #endif
 }
 
+#ifdef __PX4_LINUX
+int
+I2C::i2c_rdwr(struct i2c_msg msgs[], unsigned count)
+{
+	if (simulate) {
+		DEVICE_DEBUG("I2C SIM: transfer_4 on %s", get_devname());
+		return PX4_OK;
+	}
+
+	if (_fd < 0) {
+		PX4_ERR("I2C device not opened");
+		return PX4_ERROR;
+	}
+
+	struct i2c_rdwr_ioctl_data packets;
+
+	packets.msgs  = msgs;
+
+	packets.nmsgs = count;
+
+	if (::ioctl(_fd, I2C_RDWR, (unsigned long)&packets) == -1) {
+		DEVICE_DEBUG("I2C transfer failed");
+		return PX4_ERROR;
+	}
+
+	return PX4_OK;
+}
+#endif
+
 } // namespace device
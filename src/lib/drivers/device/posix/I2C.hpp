@@ -100,8 +100,46 @@ protected:
 	 */
 	int		transfer(const uint8_t *send, const unsigned send_len, uint8_t *recv, const unsigned recv_len);
 
+	/**
+	 * A single transaction of a batch, see transfer_multi().
+	 */
+	struct Transfer {
+		const uint8_t	*send;		///< bytes to send
+		unsigned	send_len;	///< number of bytes to send, may be 0
+		uint8_t		*recv;		///< buffer for received bytes
+		unsigned	recv_len;	///< number of bytes to receive, may be 0
+	};
+
+	static constexpr unsigned MAX_TRANSFERS = 4;	///< maximum number of transactions in a batch
+
+	/**
+	 * Perform several I2C transactions to the device in one go.
+	 *
+	 * The transactions are chained with repeated starts. All messages are handed to i2c-dev in a single I2C_RDWR ioctl.
+	 *
+	 * @param transfers	Transactions to perform, at least one of send_len and
+	 *			recv_len must be non-zero for each.
+	 * @param count		Number of transactions, at most MAX_TRANSFERS.
+	 * @return		OK if the transfer was successful, -errno
+	 *			otherwise.
+	 */
+	int		transfer_multi(const Transfer transfers[], unsigned count);
+
 	bool		external() { return px4_i2c_bus_external(_device_id.devid_s.bus); }
 
+#ifdef __PX4_LINUX
+	/**
+	 * Hand a batch of messages to i2c-dev in a single I2C_RDWR ioctl.
+	 *
+	 * Used by transfer_multi(), stand-in devices in tests override it.
+	 *
+	 * @param msgs		Messages to transfer.
+	 * @param count		Number of messages.
+	 * @return		PX4_OK on success, PX4_ERROR otherwise.
+	 */
+	virtual int	i2c_rdwr(struct i2c_msg msgs[], unsigned count);
+#endif
+
 private:
 	int 			_fd{-1};
 
@@ -91,6 +91,12 @@ SPI::init()
 		return PX4_ERROR;
 	}
 
+	// set write mode of SPI once, it persists for the file descriptor
+	if (::ioctl(_fd, SPI_IOC_WR_MODE, &_mode) == -1) {
+		PX4_ERR("can’t set spi mode");
+		return PX4_ERROR;
+	}
+
 	/* call the probe function to check whether the device is present */
 	int ret = probe();
 
@@ -120,14 +126,6 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 		return -EINVAL;
 	}
 
-	// set write mode of SPI
-	int result = ::ioctl(_fd, SPI_IOC_WR_MODE, &_mode);
-
-	if (result == -1) {
-		PX4_ERR("can’t set spi mode");
-		return PX4_ERROR;
-	}
-
 	spi_ioc_transfer spi_transfer[1] {}; // datastructures for linux spi interface
 
 	spi_transfer[0].tx_buf = (uint64_t)send;
@@ -138,7 +136,7 @@ SPI::transfer(uint8_t *send, uint8_t *recv, unsigned len)
 	//spi_transfer[0].delay_usecs = 10;
 	spi_transfer[0].cs_change = true;
 
-	result = ::ioctl(_fd, SPI_IOC_MESSAGE(1), &spi_transfer);
+	int result = spi_message(spi_transfer, 1);
 
 	if (result != (int)len) {
 		PX4_ERR("write failed. Reported %d bytes written (%s)", result, strerror(errno));
@@ -155,16 +153,8 @@ SPI::transferhword(uint16_t *send, uint16_t *recv, unsigned len)
 		return -EINVAL;
 	}
 
-	// set write mode of SPI
-	int result = ::ioctl(_fd, SPI_IOC_WR_MODE, &_mode);
-
-	if (result == -1) {
-		PX4_ERR("can’t set spi mode");
-		return PX4_ERROR;
-	}
-
 	int bits = 16;
-	result = ::ioctl(_fd, SPI_IOC_WR_BITS_PER_WORD, &bits);
+	int result = ::ioctl(_fd, SPI_IOC_WR_BITS_PER_WORD, &bits);
 
 	if (result == -1) {
 		PX4_ERR("can’t set 16 bit spi mode");
@@ -191,6 +181,49 @@ SPI::transferhword(uint16_t *send, uint16_t *recv, unsigned len)
 	return 0;
 }
 
+int
+SPI::transfer_multi(const Transfer transfers[], unsigned count)
+{
+	if ((count == 0) || (count > MAX_TRANSFERS)) {
+		return -EINVAL;
+	}
+
+	spi_ioc_transfer spi_transfer[MAX_TRANSFERS] {}; // datastructures for linux spi interface
+	int total_len = 0;
+
+	for (unsigned i = 0; i < count; i++) {
+		if ((transfers[i].send == nullptr) && (transfers[i].recv == nullptr)) {
+			return -EINVAL;
+		}
+
+		spi_transfer[i].tx_buf = (uint64_t)transfers[i].send;
+		spi_transfer[i].rx_buf = (uint64_t)transfers[i].recv;
+		spi_transfer[i].len = transfers[i].len;
+		spi_transfer[i].speed_hz = _frequency;
+		spi_transfer[i].bits_per_word = 8;
+		// deselect between transfers (same setting as a single transfer() for the last one)
+		spi_transfer[i].cs_change = true;
+
+		total_len += transfers[i].len;
+	}
+
+	// all transfers of the batch in a single system call
+	int result = spi_message(spi_transfer, count);
+
+	if (result != total_len) {
+		PX4_ERR("write failed. Reported %d of %d bytes written (%s)", result, total_len, strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+int
+SPI::spi_message(spi_ioc_transfer transfers[], unsigned count)
+{
+	return ::ioctl(_fd, SPI_IOC_MESSAGE(count), transfers);
+}
+
 } // namespace device
 
 #endif // __PX4_LINUX
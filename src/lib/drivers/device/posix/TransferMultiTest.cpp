@@ -0,0 +1,357 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file TransferMultiTest.cpp
+ * Tests for batched SPI and I2C transfers against loopback stand-in devices.
+ */
+
+#include <gtest/gtest.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "I2C.hpp"
+#include "SPI.hpp"
+
+using namespace device;
+
+static constexpr uint16_t I2C_ADDRESS = 0x77;
+
+/**
+ * SPI device with MISO wired to MOSI: every byte sent is received back, an
+ * idle MOSI line reads 0xff.
+ */
+class SPILoopback : public SPI
+{
+public:
+	SPILoopback() : SPI("SPILoopback", nullptr, 1, 0, SPIDEV_MODE3, 10 * 1000 * 1000) {}
+
+	using SPI::Transfer;
+	using SPI::MAX_TRANSFERS;
+	using SPI::get_frequency;
+	using SPI::transfer;
+	using SPI::transfer_multi;
+
+	unsigned calls{0};				///< number of messages handed to the bus
+	std::vector<spi_ioc_transfer> last;		///< transfers of the last message
+	int short_by{0};				///< number of bytes to drop from the reported length
+
+protected:
+	int spi_message(spi_ioc_transfer transfers[], unsigned count) override
+	{
+		calls++;
+		last.assign(transfers, transfers + count);
+
+		int len = 0;
+
+		for (unsigned i = 0; i < count; i++) {
+			const uint8_t *tx = (const uint8_t *)(uintptr_t)transfers[i].tx_buf;
+			uint8_t *rx = (uint8_t *)(uintptr_t)transfers[i].rx_buf;
+
+			if (rx != nullptr) {
+				if (tx != nullptr) {
+					memmove(rx, tx, transfers[i].len);
+
+				} else {
+					memset(rx, 0xff, transfers[i].len);
+				}
+			}
+
+			len += transfers[i].len;
+		}
+
+		return len - short_by;
+	}
+};
+
+/**
+ * I2C device with a register file: a write sets the register pointer with its
+ * first byte and stores the rest, a read returns registers from the pointer
+ * on. The pointer auto-increments.
+ */
+class I2CRegisterFile : public I2C
+{
+public:
+	I2CRegisterFile() : I2C("I2CRegisterFile", nullptr, 1, I2C_ADDRESS) {}
+
+	using I2C::Transfer;
+	using I2C::MAX_TRANSFERS;
+	using I2C::transfer;
+	using I2C::transfer_multi;
+
+	void set_retries(uint8_t retries) { _retries = retries; }
+
+	uint8_t regs[256] {};
+	unsigned calls{0};				///< number of I2C_RDWR requests
+	std::vector<i2c_msg> last;			///< messages of the last request
+	unsigned fail{0};				///< number of requests to fail before succeeding
+
+protected:
+	int i2c_rdwr(struct i2c_msg msgs[], unsigned count) override
+	{
+		calls++;
+		last.assign(msgs, msgs + count);
+
+		if (fail > 0) {
+			fail--;
+			return PX4_ERROR;
+		}
+
+		for (unsigned i = 0; i < count; i++) {
+			if (msgs[i].addr != I2C_ADDRESS) {
+				return PX4_ERROR;
+			}
+
+			if (msgs[i].flags & I2C_M_READ) {
+				for (unsigned j = 0; j < msgs[i].len; j++) {
+					msgs[i].buf[j] = regs[_pointer++];
+				}
+
+			} else if (msgs[i].len > 0) {
+				_pointer = msgs[i].buf[0];
+
+				for (unsigned j = 1; j < msgs[i].len; j++) {
+					regs[_pointer++] = msgs[i].buf[j];
+				}
+			}
+		}
+
+		return PX4_OK;
+	}
+
+private:
+	uint8_t _pointer{0};
+};
+
+TEST(SPITransferMultiTest, BatchIsOneMessage)
+{
+	SPILoopback dev;
+
+	uint8_t tx0[3] {0x81, 0x02, 0x03};
+	uint8_t rx0[3] {};
+	uint8_t rx1[2] {};
+	uint8_t tx2[1] {0x48};
+
+	const SPILoopback::Transfer transfers[] {
+		{tx0, rx0, sizeof(tx0)},
+		{nullptr, rx1, sizeof(rx1)},
+		{tx2, nullptr, sizeof(tx2)},
+	};
+
+	EXPECT_EQ(dev.transfer_multi(transfers, 3), 0);
+
+	// all three transfers in a single message, each deselecting the device
+	EXPECT_EQ(dev.calls, 1u);
+	ASSERT_EQ(dev.last.size(), 3u);
+
+	for (unsigned i = 0; i < 3; i++) {
+		EXPECT_EQ(dev.last[i].len, transfers[i].len);
+		EXPECT_TRUE(dev.last[i].cs_change);
+		EXPECT_EQ(dev.last[i].bits_per_word, 8);
+		EXPECT_EQ(dev.last[i].speed_hz, dev.get_frequency());
+	}
+
+	// loopback data
+	EXPECT_EQ(memcmp(rx0, tx0, sizeof(tx0)), 0);
+	EXPECT_EQ(rx1[0], 0xff);
+	EXPECT_EQ(rx1[1], 0xff);
+}
+
+TEST(SPITransferMultiTest, InPlaceTransfers)
+{
+	SPILoopback dev;
+
+	// the ms5611 PROM read: command and reply share a buffer per transaction
+	uint8_t buf[SPILoopback::MAX_TRANSFERS][3] {};
+	SPILoopback::Transfer transfers[SPILoopback::MAX_TRANSFERS];
+
+	for (unsigned i = 0; i < SPILoopback::MAX_TRANSFERS; i++) {
+		buf[i][0] = 0xa0 + 2 * i;
+		buf[i][1] = i;
+		transfers[i] = SPILoopback::Transfer{&buf[i][0], &buf[i][0], sizeof(buf[i])};
+	}
+
+	EXPECT_EQ(dev.transfer_multi(transfers, SPILoopback::MAX_TRANSFERS), 0);
+	EXPECT_EQ(dev.calls, 1u);
+	EXPECT_EQ(dev.last.size(), (size_t)SPILoopback::MAX_TRANSFERS);
+
+	for (unsigned i = 0; i < SPILoopback::MAX_TRANSFERS; i++) {
+		EXPECT_EQ(buf[i][0], 0xa0 + 2 * i);
+		EXPECT_EQ(buf[i][1], i);
+		EXPECT_EQ(buf[i][2], 0);
+	}
+}
+
+TEST(SPITransferMultiTest, SingleTransfer)
+{
+	SPILoopback dev;
+
+	uint8_t tx[4] {0x00, 0x11, 0x22, 0x33};
+	uint8_t rx[4] {};
+
+	EXPECT_EQ(dev.transfer(tx, rx, sizeof(tx)), 0);
+	EXPECT_EQ(dev.calls, 1u);
+	ASSERT_EQ(dev.last.size(), 1u);
+	EXPECT_TRUE(dev.last[0].cs_change);
+	EXPECT_EQ(memcmp(rx, tx, sizeof(tx)), 0);
+}
+
+TEST(SPITransferMultiTest, InvalidBatch)
+{
+	SPILoopback dev;
+
+	uint8_t buf[1] {};
+	SPILoopback::Transfer transfers[SPILoopback::MAX_TRANSFERS + 1];
+
+	for (auto &t : transfers) {
+		t = SPILoopback::Transfer{buf, buf, sizeof(buf)};
+	}
+
+	EXPECT_EQ(dev.transfer_multi(transfers, 0), -EINVAL);
+	EXPECT_EQ(dev.transfer_multi(transfers, SPILoopback::MAX_TRANSFERS + 1), -EINVAL);
+
+	transfers[1] = SPILoopback::Transfer{nullptr, nullptr, 1};
+	EXPECT_EQ(dev.transfer_multi(transfers, 2), -EINVAL);
+
+	// nothing reached the bus
+	EXPECT_EQ(dev.calls, 0u);
+}
+
+TEST(SPITransferMultiTest, ShortMessageFails)
+{
+	SPILoopback dev;
+	dev.short_by = 1;
+
+	uint8_t buf[2][2] {};
+	const SPILoopback::Transfer transfers[] {
+		{buf[0], buf[0], sizeof(buf[0])},
+		{buf[1], buf[1], sizeof(buf[1])},
+	};
+
+	EXPECT_NE(dev.transfer_multi(transfers, 2), 0);
+	EXPECT_EQ(dev.calls, 1u);
+}
+
+TEST(I2CTransferMultiTest, BatchIsOneRequest)
+{
+	I2CRegisterFile dev;
+
+	// write two registers, then read them back with a repeated start
+	const uint8_t write[] {0x10, 0xab, 0xcd};
+	const uint8_t reg = 0x10;
+	uint8_t read[2] {};
+
+	const I2CRegisterFile::Transfer transfers[] {
+		{write, sizeof(write), nullptr, 0},
+		{&reg, 1, read, sizeof(read)},
+	};
+
+	EXPECT_EQ(dev.transfer_multi(transfers, 2), PX4_OK);
+
+	EXPECT_EQ(dev.calls, 1u);
+	ASSERT_EQ(dev.last.size(), 3u);
+	EXPECT_EQ(dev.last[0].flags, 0);
+	EXPECT_EQ(dev.last[0].len, sizeof(write));
+	EXPECT_EQ(dev.last[1].flags, 0);
+	EXPECT_EQ(dev.last[1].len, 1);
+	EXPECT_EQ(dev.last[2].flags, I2C_M_READ);
+	EXPECT_EQ(dev.last[2].len, sizeof(read));
+
+	for (const auto &msg : dev.last) {
+		EXPECT_EQ(msg.addr, I2C_ADDRESS);
+	}
+
+	EXPECT_EQ(read[0], 0xab);
+	EXPECT_EQ(read[1], 0xcd);
+}
+
+TEST(I2CTransferMultiTest, SingleTransfer)
+{
+	I2CRegisterFile dev;
+	dev.regs[0x20] = 0x5a;
+
+	const uint8_t reg = 0x20;
+	uint8_t value = 0;
+
+	EXPECT_EQ(dev.transfer(&reg, 1, &value, 1), PX4_OK);
+	EXPECT_EQ(dev.calls, 1u);
+	EXPECT_EQ(dev.last.size(), 2u);
+	EXPECT_EQ(value, 0x5a);
+}
+
+TEST(I2CTransferMultiTest, RetriesWholeBatch)
+{
+	I2CRegisterFile dev;
+	dev.set_retries(2);
+	dev.regs[0] = 0x42;
+
+	const uint8_t reg = 0;
+	uint8_t value = 0;
+	const I2CRegisterFile::Transfer transfers[] {{&reg, 1, &value, 1}};
+
+	// succeeds on the last retry
+	dev.fail = 2;
+	EXPECT_EQ(dev.transfer_multi(transfers, 1), PX4_OK);
+	EXPECT_EQ(dev.calls, 3u);
+	EXPECT_EQ(value, 0x42);
+
+	// gives up after the retries
+	dev.calls = 0;
+	dev.fail = 3;
+	EXPECT_EQ(dev.transfer_multi(transfers, 1), PX4_ERROR);
+	EXPECT_EQ(dev.calls, 3u);
+}
+
+TEST(I2CTransferMultiTest, InvalidBatch)
+{
+	I2CRegisterFile dev;
+
+	uint8_t buf[1] {};
+	I2CRegisterFile::Transfer transfers[I2CRegisterFile::MAX_TRANSFERS + 1];
+
+	for (auto &t : transfers) {
+		t = I2CRegisterFile::Transfer{buf, sizeof(buf), nullptr, 0};
+	}
+
+	EXPECT_EQ(dev.transfer_multi(transfers, 0), -EINVAL);
+	EXPECT_EQ(dev.transfer_multi(transfers, I2CRegisterFile::MAX_TRANSFERS + 1), -EINVAL);
+
+	transfers[1] = I2CRegisterFile::Transfer{buf, 0, buf, 0};
+	EXPECT_EQ(dev.transfer_multi(transfers, 2), -EINVAL);
+
+	EXPECT_EQ(dev.calls, 0u);
+}
@@ -66,6 +66,28 @@ inline float computeMaxSpeedFromBrakingDistance(const float jerk, const float ac
 	return max_speed;
 }
 
+/* Compute the maximum possible speed on the track given the remaining distance and the speed
+ * that has to be reached at its end, with the same constant acceleration profile and delay as
+ * computeMaxSpeedFromBrakingDistance().
+ * Equation to solve: 0 = vel^2 - final_speed^2 - 2*accel*(x - vel*2*accel/jerk)
+ *
+ * @param jerk maximum jerk
+ * @param accel maximum acceleration
+ * @param distance distance to the point where final_speed is desired
+ * @param final_speed desired speed at the end of the distance
+ *
+ * @return maximum speed
+ */
+inline float computeMaxSpeedFromDistance(const float jerk, const float accel, const float distance,
+		const float final_speed)
+{
+	float b =  4.0f * accel * accel / jerk;
+	float c = - 2.0f * accel * distance - final_speed * final_speed;
+	float max_speed = 0.5f * (-b + sqrtf(b * b - 4.0f * c));
+
+	return max_speed;
+}
+
 /* Compute the maximum tangential speed in a circle defined by two line segments of length "d"
  * forming a V shape, opened by an angle "alpha". The circle is tangent to the end of the
  * two segments as shown below:
@@ -0,0 +1,453 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file PX4IOBatchTest.cpp
+ * Tests for batched PX4IO register transactions against a host-side IO stand-in.
+ */
+
+#include <gtest/gtest.h>
+
+#include <errno.h>
+#include <map>
+#include <random>
+#include <string.h>
+#include <vector>
+
+#include "px4io_batch.h"
+
+/**
+ * Register file with the packet handling of the IO serial interface.
+ */
+class IOStandIn
+{
+public:
+	IOStandIn()
+	{
+		_pages[PX4IO_PAGE_STATUS] = std::vector<uint16_t>(10);
+		_pages[PX4IO_PAGE_SERVOS] = std::vector<uint16_t>(8);
+		_pages[PX4IO_PAGE_RAW_RC_INPUT] = std::vector<uint16_t>(PX4IO_P_RAW_RC_BASE + 18);
+		_pages[PX4IO_PAGE_SETUP] = std::vector<uint16_t>(29);
+		_pages[PX4IO_PAGE_CONTROLS] = std::vector<uint16_t>(PX4IO_P_CONTROLS_GROUP_VALID + 1);
+
+		for (auto &page : _pages) {
+			for (size_t i = 0; i < page.second.size(); i++) {
+				page.second[i] = (page.first << 8) | i;
+			}
+		}
+	}
+
+	/** Handle a request like the IO serial interface does, replacing it with the reply */
+	void exchange(IOPacket &packet)
+	{
+		const uint8_t crc = packet.crc;
+		packet.crc = 0;
+		ASSERT_EQ(crc, crc_packet(&packet));
+
+		instance = this;
+		transactions++;
+
+		if (PKT_CODE(packet) == PKT_CODE_BATCH) {
+			px4io_batch_handle(&packet, registers_set, registers_get);
+
+		} else if (PKT_CODE(packet) == PKT_CODE_WRITE) {
+			packet.count_code = registers_set(packet.page, packet.offset, &packet.regs[0], PKT_COUNT(packet)) ?
+					    PKT_CODE_ERROR : PKT_CODE_SUCCESS;
+
+		} else {
+			uint16_t *regs;
+			unsigned count;
+
+			if (registers_get(packet.page, packet.offset, &regs, &count) < 0) {
+				packet.count_code = PKT_CODE_ERROR;
+
+			} else {
+				count = std::min(count, (unsigned)PKT_COUNT(packet));
+				memcpy(&packet.regs[0], regs, count * 2);
+				packet.count_code = count | PKT_CODE_SUCCESS;
+			}
+		}
+
+		packet.crc = 0;
+		packet.crc = crc_packet(&packet);
+	}
+
+	std::map<uint8_t, std::vector<uint16_t>> _pages;
+	unsigned transactions{0};
+
+	static IOStandIn *instance;
+
+	static int registers_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+	{
+		auto it = instance->_pages.find(page);
+
+		if (it == instance->_pages.end() || offset + num_values > it->second.size()) {
+			return -1;
+		}
+
+		memcpy(&it->second[offset], values, num_values * 2);
+		return 0;
+	}
+
+	static int registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_values)
+	{
+		auto it = instance->_pages.find(page);
+
+		if (it == instance->_pages.end() || offset >= it->second.size()) {
+			return -1;
+		}
+
+		*values = &it->second[offset];
+		*num_values = it->second.size() - offset;
+		return 0;
+	}
+};
+
+IOStandIn *IOStandIn::instance = nullptr;
+
+/** FMU side of a batched transaction, like PX4IO_serial::batch() without retries */
+static int transfer(IOStandIn &io, PX4IOBatch &batch)
+{
+	IOPacket packet{};
+	batch.encode(packet);
+	packet.crc = 0;
+	packet.crc = crc_packet(&packet);
+
+	io.exchange(packet);
+
+	const uint8_t crc = packet.crc;
+	packet.crc = 0;
+	EXPECT_EQ(crc, crc_packet(&packet));
+
+	return batch.decode(packet);
+}
+
+/** FMU side of a single register transaction, like PX4IO_serial::read()/write() */
+static int transfer_single(IOStandIn &io, bool write, uint8_t page, uint8_t offset, uint16_t *values, unsigned count)
+{
+	IOPacket packet{};
+	packet.count_code = count | (write ? PKT_CODE_WRITE : PKT_CODE_READ);
+	packet.page = page;
+	packet.offset = offset;
+
+	if (write) {
+		memcpy(&packet.regs[0], values, count * 2);
+	}
+
+	packet.crc = 0;
+	packet.crc = crc_packet(&packet);
+
+	io.exchange(packet);
+
+	if (PKT_CODE(packet) == PKT_CODE_ERROR) {
+		return -EINVAL;
+	}
+
+	if (!write) {
+		if (PKT_COUNT(packet) != count) {
+			return -EIO;
+		}
+
+		memcpy(values, &packet.regs[0], count * 2);
+	}
+
+	return 0;
+}
+
+TEST(PX4IOBatch, WriteThenRead)
+{
+	IOStandIn io;
+	PX4IOBatch batch;
+
+	uint16_t controls[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	uint16_t status[6] {};
+	uint16_t controls_back[8] {};
+
+	EXPECT_TRUE(batch.add_write(PX4IO_PAGE_CONTROLS, PX4IO_P_CONTROLS_GROUP_0, controls, 8));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status, 6));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_CONTROLS, PX4IO_P_CONTROLS_GROUP_0, controls_back, 8));
+	EXPECT_EQ(batch.reply_count(), 14u);
+
+	EXPECT_EQ(transfer(io, batch), 0);
+	EXPECT_EQ(io.transactions, 1u);
+
+	for (unsigned i = 0; i < 6; i++) {
+		EXPECT_EQ(status[i], (PX4IO_PAGE_STATUS << 8) | (PX4IO_P_STATUS_FLAGS + i));
+	}
+
+	EXPECT_EQ(memcmp(controls, controls_back, sizeof(controls)), 0);
+}
+
+TEST(PX4IOBatch, Modify)
+{
+	IOStandIn io;
+	PX4IOBatch batch;
+
+	io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_ARMING] = PX4IO_P_SETUP_ARMING_IO_ARM_OK | PX4IO_P_SETUP_ARMING_LOCKDOWN;
+
+	EXPECT_TRUE(batch.add_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, PX4IO_P_SETUP_ARMING_LOCKDOWN,
+				     PX4IO_P_SETUP_ARMING_FMU_ARMED));
+	EXPECT_EQ(transfer(io, batch), 0);
+	EXPECT_EQ(batch.reply_count(), 0u);
+
+	EXPECT_EQ(io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_ARMING],
+		  PX4IO_P_SETUP_ARMING_IO_ARM_OK | PX4IO_P_SETUP_ARMING_FMU_ARMED);
+
+	// a retried modify must not change the result
+	EXPECT_EQ(transfer(io, batch), 0);
+	EXPECT_EQ(io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_ARMING],
+		  PX4IO_P_SETUP_ARMING_IO_ARM_OK | PX4IO_P_SETUP_ARMING_FMU_ARMED);
+}
+
+TEST(PX4IOBatch, PollCycleInOnePacket)
+{
+	// the per-cycle exchange of the px4io driver: controls out, status, RC, outputs and mixer status in
+	IOStandIn io;
+	PX4IOBatch batch;
+
+	uint16_t controls[PX4IO_PROTOCOL_MAX_CONTROL_COUNT] {};
+	uint16_t status[6];
+	uint16_t raw_rc[PX4IO_P_RAW_RC_BASE + 9];
+	uint16_t servos[8];
+	uint16_t mixer;
+
+	EXPECT_TRUE(batch.add_write(PX4IO_PAGE_CONTROLS, PX4IO_P_CONTROLS_GROUP_0, controls, PX4IO_PROTOCOL_MAX_CONTROL_COUNT));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status, 6));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, raw_rc, PX4IO_P_RAW_RC_BASE + 9));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_SERVOS, 0, servos, 8));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &mixer, 1));
+	EXPECT_TRUE(batch.add_modify(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, 0, PX4IO_P_SETUP_ARMING_FMU_PREARMED));
+
+	EXPECT_EQ(transfer(io, batch), 0);
+	EXPECT_EQ(io.transactions, 1u);
+	EXPECT_EQ(servos[7], (PX4IO_PAGE_SERVOS << 8) | 7);
+	EXPECT_EQ(mixer, (PX4IO_PAGE_STATUS << 8) | PX4IO_P_STATUS_MIXER);
+}
+
+TEST(PX4IOBatch, MatchesSingleTransactions)
+{
+	std::mt19937 gen(42);
+	const uint8_t pages[] = {PX4IO_PAGE_STATUS, PX4IO_PAGE_SERVOS, PX4IO_PAGE_SETUP, PX4IO_PAGE_CONTROLS};
+
+	for (int run = 0; run < 1000; run++) {
+		IOStandIn io_batch;
+		IOStandIn io_single;
+		PX4IOBatch batch;
+
+		struct Op {
+			bool write;
+			uint8_t page;
+			uint8_t offset;
+			unsigned count;
+			uint16_t values[PKT_MAX_REGS];
+		};
+
+		std::vector<Op> ops;
+		uint16_t batch_results[PKT_MAX_REGS * 2] {};
+		unsigned results_used = 0;
+
+		for (;;) {
+			Op op{};
+			op.write = gen() & 1;
+			op.page = pages[gen() % sizeof(pages)];
+			const unsigned size = io_batch._pages[op.page].size();
+			op.offset = gen() % size;
+			op.count = 1 + gen() % std::min(size - op.offset, 10u);
+
+			for (unsigned i = 0; i < op.count; i++) {
+				op.values[i] = gen();
+			}
+
+			const bool added = op.write ? batch.add_write(op.page, op.offset, op.values, op.count) :
+					   batch.add_read(op.page, op.offset, &batch_results[results_used], op.count);
+
+			if (!added) {
+				break;
+			}
+
+			if (!op.write) {
+				results_used += op.count;
+			}
+
+			ops.push_back(op);
+		}
+
+		ASSERT_LE(batch.request_count(), (unsigned)PKT_MAX_REGS);
+		ASSERT_LE(batch.reply_count(), (unsigned)PKT_MAX_REGS);
+		ASSERT_EQ(transfer(io_batch, batch), 0);
+
+		unsigned result_index = 0;
+
+		for (Op &op : ops) {
+			ASSERT_EQ(transfer_single(io_single, op.write, op.page, op.offset, op.values, op.count), 0);
+
+			if (!op.write) {
+				ASSERT_EQ(memcmp(op.values, &batch_results[result_index], op.count * 2), 0);
+				result_index += op.count;
+			}
+		}
+
+		EXPECT_EQ(io_batch._pages, io_single._pages);
+		EXPECT_EQ(io_batch.transactions, 1u);
+		EXPECT_EQ(io_single.transactions, ops.size());
+	}
+}
+
+TEST(PX4IOBatch, Capacity)
+{
+	PX4IOBatch batch;
+	uint16_t values[PKT_MAX_REGS] {};
+
+	// request: header plus values must fit
+	EXPECT_FALSE(batch.add_write(PX4IO_PAGE_SETUP, 0, values, PKT_MAX_REGS - 1));
+	EXPECT_TRUE(batch.add_write(PX4IO_PAGE_SETUP, 0, values, PKT_MAX_REGS - PKT_BATCH_HEADER_REGS));
+	EXPECT_FALSE(batch.add_read(PX4IO_PAGE_STATUS, 0, values, 1));
+	EXPECT_EQ(batch.request_count(), (unsigned)PKT_MAX_REGS);
+
+	// reply: read registers must fit
+	batch.reset();
+	EXPECT_TRUE(batch.empty());
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, 0, values, PKT_MAX_REGS - 1));
+	EXPECT_FALSE(batch.add_read(PX4IO_PAGE_STATUS, 0, values, 2));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, 0, values, 1));
+	EXPECT_EQ(batch.reply_count(), (unsigned)PKT_MAX_REGS);
+
+	EXPECT_FALSE(batch.add_write(PX4IO_PAGE_SETUP, 0, values, 0));
+}
+
+TEST(PX4IOBatch, FailedEntry)
+{
+	IOStandIn io;
+	PX4IOBatch batch;
+
+	uint16_t value = 1234;
+	uint16_t unknown[2] {};
+	uint16_t status = 0;
+
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_TEST, 0, unknown, 2));
+	EXPECT_TRUE(batch.add_write(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_REVERSE, &value, 1));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &status, 1));
+
+	EXPECT_EQ(transfer(io, batch), -EINVAL);
+	EXPECT_EQ(batch.failed_entries(), 1u << 0);
+	EXPECT_FALSE(batch.reads_valid());
+
+	// entries are independent, like separate transactions
+	EXPECT_EQ(io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_PWM_REVERSE], value);
+	EXPECT_EQ(status, io._pages[PX4IO_PAGE_STATUS][PX4IO_P_STATUS_FLAGS]);
+	EXPECT_EQ(unknown[0], 0);
+}
+
+TEST(PX4IOBatch, FailedWriteKeepsReads)
+{
+	IOStandIn io;
+	PX4IOBatch batch;
+
+	// a rejected write must not starve the poll reads queued with it
+	uint16_t values[4] {1, 2, 3, 4};
+	uint16_t status[6] {};
+	uint16_t rc[4] {};
+
+	EXPECT_TRUE(batch.add_write(PX4IO_PAGE_SETUP, 27, values, 4));
+	EXPECT_TRUE(batch.add_modify(PX4IO_PAGE_TEST, 0, 0, 1));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status, 6));
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, rc, 4));
+
+	EXPECT_EQ(transfer(io, batch), -EINVAL);
+	EXPECT_EQ(batch.failed_entries(), (1u << 0) | (1u << 1));
+	EXPECT_TRUE(batch.reads_valid());
+
+	EXPECT_EQ(memcmp(status, &io._pages[PX4IO_PAGE_STATUS][PX4IO_P_STATUS_FLAGS], sizeof(status)), 0);
+	EXPECT_EQ(memcmp(rc, &io._pages[PX4IO_PAGE_RAW_RC_INPUT][PX4IO_P_RAW_RC_COUNT], sizeof(rc)), 0);
+}
+
+TEST(PX4IOBatch, MalformedRequest)
+{
+	IOStandIn io;
+	const uint16_t reverse = io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_PWM_REVERSE];
+
+	// write entry claiming more values than the packet carries
+	IOPacket packet{};
+	packet.count_code = 3 | PKT_CODE_BATCH;
+	packet.regs[0] = PKT_BATCH_ADDRESS(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_REVERSE);
+	packet.regs[1] = PKT_BATCH_OP_WRITE | 2;
+	packet.regs[2] = 0xffff;
+	packet.crc = 0;
+	packet.crc = crc_packet(&packet);
+
+	io.exchange(packet);
+	EXPECT_EQ(PKT_CODE(packet), PKT_CODE_ERROR);
+	EXPECT_EQ(io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_PWM_REVERSE], reverse);
+
+	// truncated entry header
+	packet = IOPacket{};
+	packet.count_code = 1 | PKT_CODE_BATCH;
+	packet.regs[0] = PKT_BATCH_ADDRESS(PX4IO_PAGE_STATUS, 0);
+	packet.crc = 0;
+	packet.crc = crc_packet(&packet);
+
+	io.exchange(packet);
+	EXPECT_EQ(PKT_CODE(packet), PKT_CODE_ERROR);
+
+	// register count beyond the packet size, handled directly as the CRC would cover it
+	struct {
+		IOPacket packet;
+		uint16_t beyond[PKT_COUNT_MASK - PKT_MAX_REGS];
+	} oversized{};
+
+	oversized.packet.count_code = PKT_COUNT_MASK | PKT_CODE_BATCH;
+	oversized.packet.regs[0] = PKT_BATCH_ADDRESS(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_REVERSE);
+	oversized.packet.regs[1] = PKT_BATCH_OP_WRITE | 1;
+	oversized.packet.regs[2] = 0xffff;
+
+	IOStandIn::instance = &io;
+	EXPECT_EQ(px4io_batch_handle(&oversized.packet, IOStandIn::registers_set, IOStandIn::registers_get), -1);
+	EXPECT_EQ(PKT_CODE(oversized.packet), PKT_CODE_ERROR);
+	EXPECT_EQ(io._pages[PX4IO_PAGE_SETUP][PX4IO_P_SETUP_PWM_REVERSE], reverse);
+}
+
+TEST(PX4IOBatch, ReplyCountMismatch)
+{
+	PX4IOBatch batch;
+	uint16_t values[4] {};
+
+	EXPECT_TRUE(batch.add_read(PX4IO_PAGE_STATUS, 0, values, 4));
+
+	IOPacket reply{};
+	reply.count_code = 3 | PKT_CODE_SUCCESS;
+	EXPECT_EQ(batch.decode(reply), -EIO);
+
+	reply.count_code = 4 | PKT_CODE_CORRUPT;
+	EXPECT_EQ(batch.decode(reply), -EIO);
+}
@@ -0,0 +1,260 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file px4io_batch.cpp
+ *
+ * Batched multi-page register transactions between FMU and PX4IO.
+ */
+
+#include "px4io_batch.h"
+
+#include <errno.h>
+#include <string.h>
+
+int
+px4io_batch_handle(struct IOPacket *packet, px4io_registers_set_t set, px4io_registers_get_t get)
+{
+	const unsigned request_count = PKT_COUNT(*packet);
+
+	if (request_count > PKT_MAX_REGS) {
+		packet->count_code = PKT_CODE_ERROR;
+		return -1;
+	}
+
+	/* the reply overwrites the request, keep a copy of the entries */
+	uint16_t request[PKT_MAX_REGS];
+	memcpy(request, &packet->regs[0], request_count * sizeof(request[0]));
+
+	unsigned in = 0;
+	unsigned out = 0;
+	unsigned entry = 0;
+	uint16_t failed = 0;
+
+	for (; in < request_count; entry++) {
+		if (in + PKT_BATCH_HEADER_REGS > request_count) {
+			/* truncated entry header */
+			packet->count_code = PKT_CODE_ERROR;
+			return -1;
+		}
+
+		const uint8_t page = request[in] >> 8;
+		const uint8_t offset = request[in] & 0xff;
+		const uint16_t control = request[in + 1];
+		const unsigned count = control & PKT_BATCH_COUNT_MASK;
+		in += PKT_BATCH_HEADER_REGS;
+
+		switch (control & PKT_BATCH_OP_MASK) {
+		case PKT_BATCH_OP_WRITE:
+			if (in + count > request_count) {
+				packet->count_code = PKT_CODE_ERROR;
+				return -1;
+			}
+
+			if (set(page, offset, &request[in], count) != 0) {
+				failed |= 1 << entry;
+			}
+
+			in += count;
+			break;
+
+		case PKT_BATCH_OP_MODIFY: {
+				if (count != 2 || in + count > request_count) {
+					packet->count_code = PKT_CODE_ERROR;
+					return -1;
+				}
+
+				uint16_t *regs;
+				unsigned num_regs;
+
+				if (get(page, offset, &regs, &num_regs) < 0 || num_regs < 1) {
+					failed |= 1 << entry;
+
+				} else {
+					uint16_t value = (regs[0] & ~request[in]) | request[in + 1];
+
+					if (set(page, offset, &value, 1) != 0) {
+						failed |= 1 << entry;
+					}
+				}
+
+				in += count;
+			}
+			break;
+
+		case PKT_BATCH_OP_READ: {
+				if (out + count > PKT_MAX_REGS) {
+					packet->count_code = PKT_CODE_ERROR;
+					return -1;
+				}
+
+				uint16_t *regs;
+				unsigned num_regs;
+
+				if (get(page, offset, &regs, &num_regs) < 0 || num_regs < count) {
+					/* keep the following reads in place */
+					memset(&packet->regs[out], 0, count * sizeof(packet->regs[0]));
+					failed |= 1 << entry;
+
+				} else {
+					memcpy(&packet->regs[out], regs, count * sizeof(packet->regs[0]));
+				}
+
+				out += count;
+			}
+			break;
+
+		default:
+			packet->count_code = PKT_CODE_ERROR;
+			return -1;
+		}
+	}
+
+	/* rejected entries do not invalidate the others, the reads are still delivered */
+	packet->count_code = out | PKT_CODE_SUCCESS;
+	packet->page = failed >> 8;
+	packet->offset = failed & 0xff;
+
+	return (failed != 0) ? -1 : 0;
+}
+
+void
+PX4IOBatch::reset()
+{
+	_request_count = 0;
+	_num_entries = 0;
+	_num_reads = 0;
+	_reply_count = 0;
+	_failed = 0;
+	_reads_valid = false;
+}
+
+bool
+PX4IOBatch::add_entry(uint8_t page, uint8_t offset, uint16_t control, const uint16_t *values, unsigned num_values)
+{
+	if (_request_count + PKT_BATCH_HEADER_REGS + num_values > PKT_MAX_REGS) {
+		return false;
+	}
+
+	_num_entries++;
+	_request[_request_count++] = PKT_BATCH_ADDRESS(page, offset);
+	_request[_request_count++] = control;
+
+	if (num_values > 0) {
+		memcpy(&_request[_request_count], values, num_values * sizeof(_request[0]));
+		_request_count += num_values;
+	}
+
+	return true;
+}
+
+bool
+PX4IOBatch::add_write(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	if (num_values == 0 || num_values > PKT_BATCH_COUNT_MASK) {
+		return false;
+	}
+
+	return add_entry(page, offset, PKT_BATCH_OP_WRITE | num_values, values, num_values);
+}
+
+bool
+PX4IOBatch::add_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits)
+{
+	const uint16_t masks[2] = { clearbits, setbits };
+
+	return add_entry(page, offset, PKT_BATCH_OP_MODIFY | 2, masks, 2);
+}
+
+bool
+PX4IOBatch::add_read(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
+{
+	if (num_values == 0 || _reply_count + num_values > PKT_MAX_REGS) {
+		return false;
+	}
+
+	const unsigned entry = _num_entries;
+
+	if (!add_entry(page, offset, PKT_BATCH_OP_READ | num_values, nullptr, 0)) {
+		return false;
+	}
+
+	_reads[_num_reads].values = values;
+	_reads[_num_reads].entry = entry;
+	_reads[_num_reads].num_values = num_values;
+	_num_reads++;
+	_reply_count += num_values;
+
+	return true;
+}
+
+void
+PX4IOBatch::encode(IOPacket &packet) const
+{
+	packet.count_code = _request_count | PKT_CODE_BATCH;
+	packet.page = 0;
+	packet.offset = 0;
+	memcpy(&packet.regs[0], _request, _request_count * sizeof(_request[0]));
+}
+
+int
+PX4IOBatch::decode(const IOPacket &packet)
+{
+	if (PKT_CODE(packet) == PKT_CODE_ERROR) {
+		return -EINVAL;
+	}
+
+	if (PKT_CODE(packet) != PKT_CODE_SUCCESS || PKT_COUNT(packet) != _reply_count) {
+		return -EIO;
+	}
+
+	_failed = PKT_BATCH_FAILED(packet);
+	_reads_valid = true;
+
+	unsigned in = 0;
+
+	for (unsigned i = 0; i < _num_reads; i++) {
+		if (_failed & (1 << _reads[i].entry)) {
+			/* leave the destination of a rejected read untouched */
+			_reads_valid = false;
+
+		} else {
+			memcpy(_reads[i].values, &packet.regs[in], _reads[i].num_values * sizeof(packet.regs[0]));
+		}
+
+		in += _reads[i].num_values;
+	}
+
+	return (_failed != 0) ? -EINVAL : 0;
+}
@@ -0,0 +1,160 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file px4io_batch.h
+ *
+ * Batched multi-page register transactions between FMU and PX4IO.
+ *
+ * A batch carries several register reads, writes and bit modifications
+ * in one IOPacket (PKT_CODE_BATCH), so the FMU needs a single serial round
+ * trip where it would otherwise need one per register range. See protocol.h
+ * for the packet layout.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <modules/px4iofirmware/protocol.h>
+
+__BEGIN_DECLS
+
+typedef int (*px4io_registers_set_t)(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+typedef int (*px4io_registers_get_t)(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_values);
+
+/**
+ * Handle a batched transaction on IO and build the reply in place.
+ *
+ * Entries are applied in order and independently of each other, like separate
+ * transactions. A failed entry does not stop the following ones and is flagged
+ * in the failed-entry bitmap of the reply, the reads are delivered regardless.
+ * A malformed request is rejected as a whole with PKT_CODE_ERROR.
+ *
+ * @param packet	received packet with a PKT_CODE_BATCH request, replaced by the reply
+ * @param set		register write accessor
+ * @param get		register read accessor
+ * @return		0 if all entries succeeded, -1 otherwise
+ */
+__EXPORT int px4io_batch_handle(struct IOPacket *packet, px4io_registers_set_t set, px4io_registers_get_t get);
+
+__END_DECLS
+
+#ifdef __cplusplus
+
+/**
+ * FMU side of a batched transaction: collects the entries, encodes the
+ * request and distributes the read registers of the reply.
+ */
+class PX4IOBatch
+{
+public:
+	PX4IOBatch() = default;
+	~PX4IOBatch() = default;
+
+	/**
+	 * Remove all entries.
+	 */
+	void reset();
+
+	/**
+	 * Queue a write of one or more registers.
+	 * @return false if the batch has no room left, nothing is queued then
+	 */
+	bool add_write(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+	bool add_write(uint8_t page, uint8_t offset, uint16_t value) { return add_write(page, offset, &value, 1); }
+
+	/**
+	 * Queue a read-modify-write of a single register, executed on IO.
+	 * @return false if the batch has no room left, nothing is queued then
+	 */
+	bool add_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits);
+
+	/**
+	 * Queue a read of one or more registers. values must stay valid until decode().
+	 * @return false if the request or the reply has no room left, nothing is queued then
+	 */
+	bool add_read(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values);
+
+	bool empty() const { return _request_count == 0; }
+
+	unsigned request_count() const { return _request_count; }
+	unsigned reply_count() const { return _reply_count; }
+
+	/**
+	 * Fill in the request packet, except for the CRC.
+	 */
+	void encode(IOPacket &packet) const;
+
+	/**
+	 * Check the reply and copy the read registers to their destinations.
+	 *
+	 * The registers of reads IO accepted are copied even if other entries were
+	 * rejected, the destinations of rejected reads are left untouched.
+	 * @return 0 on success, -EINVAL if IO rejected the request or an entry, -EIO on a malformed reply
+	 */
+	int decode(const IOPacket &packet);
+
+	/**
+	 * Bitmap of the entries IO rejected in the last decoded reply, bit n for the n-th queued entry.
+	 */
+	uint16_t failed_entries() const { return _failed; }
+
+	/**
+	 * @return true if the last decoded reply delivered the registers of all queued reads
+	 */
+	bool reads_valid() const { return _num_reads == 0 || _reads_valid; }
+
+private:
+	struct Read {
+		uint16_t *values;
+		uint8_t num_values;
+		uint8_t entry;
+	};
+
+	uint16_t _request[PKT_MAX_REGS] {};
+	unsigned _request_count{0};
+	unsigned _num_entries{0};
+
+	Read _reads[PKT_BATCH_MAX_ENTRIES] {};
+	unsigned _num_reads{0};
+	unsigned _reply_count{0};
+
+	uint16_t _failed{0};
+	bool _reads_valid{false};
+
+	bool add_entry(uint8_t page, uint8_t offset, uint16_t control, const uint16_t *values, unsigned num_values);
+};
+
+#endif /* __cplusplus */
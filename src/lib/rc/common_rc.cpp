@@ -2,3 +2,34 @@
 #include "common_rc.h"
 
 __EXPORT rc_decode_buf_t rc_decode_buf;
+
+/*
+ * Byte offset and right shift of each 11 bit channel in a packed frame.
+ * A channel spans a third byte only if its shift is larger than 5.
+ */
+static const struct {
+	uint8_t byte;
+	uint8_t shift;
+} rc_11bit_layout[RC_PACKED_11BIT_CHANNELS] = {
+	{ 0, 0}, { 1, 3}, { 2, 6}, { 4, 1}, { 5, 4}, { 6, 7}, { 8, 2}, { 9, 5},
+	{11, 0}, {12, 3}, {13, 6}, {15, 1}, {16, 4}, {17, 7}, {19, 2}, {20, 5}
+};
+
+void rc_unpack_11bit(const uint8_t *data, uint16_t *values, unsigned num_values)
+{
+	if (num_values > RC_PACKED_11BIT_CHANNELS) {
+		num_values = RC_PACKED_11BIT_CHANNELS;
+	}
+
+	for (unsigned i = 0; i < num_values; i++) {
+		const uint8_t *p = &data[rc_11bit_layout[i].byte];
+		const unsigned shift = rc_11bit_layout[i].shift;
+		uint32_t word = p[0] | (p[1] << 8);
+
+		if (shift > 5) {
+			word |= (uint32_t)p[2] << 16;
+		}
+
+		values[i] = (word >> shift) & 0x7ff;
+	}
+}
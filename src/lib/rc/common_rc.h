@@ -22,3 +22,15 @@ typedef  struct rc_decode_buf_ {
 #pragma pack(pop)
 
 extern rc_decode_buf_t rc_decode_buf;
+
+#define RC_PACKED_11BIT_CHANNELS	16
+
+/**
+ * Unpack channels stored as consecutive 11 bit little-endian fields
+ * (S.BUS and CRSF both use this layout for 16 channels in 22 bytes).
+ *
+ * @param data start of the packed channel data
+ * @param values output raw channel values in [0, 2047]
+ * @param num_values number of channels to unpack, at most RC_PACKED_11BIT_CHANNELS
+ */
+void rc_unpack_11bit(const uint8_t *data, uint16_t *values, unsigned num_values);
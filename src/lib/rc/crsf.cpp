@@ -101,29 +101,6 @@ enum class crsf_address_t : uint8_t {
 	crsf_transmitter = 0xEE
 };
 
-#pragma pack(push, 1)
-struct crsf_payload_RC_channels_packed_t {
-	// 176 bits of data (11 bits per channel * 16 channels) = 22 bytes
-	unsigned chan0 : 11;
-	unsigned chan1 : 11;
-	unsigned chan2 : 11;
-	unsigned chan3 : 11;
-	unsigned chan4 : 11;
-	unsigned chan5 : 11;
-	unsigned chan6 : 11;
-	unsigned chan7 : 11;
-	unsigned chan8 : 11;
-	unsigned chan9 : 11;
-	unsigned chan10 : 11;
-	unsigned chan11 : 11;
-	unsigned chan12 : 11;
-	unsigned chan13 : 11;
-	unsigned chan14 : 11;
-	unsigned chan15 : 11;
-};
-
-#pragma pack(pop)
-
 enum class crsf_parser_state_t : uint8_t {
 	unsynced = 0,
 	synced
@@ -202,20 +179,29 @@ bool crsf_parse(const uint64_t now, const uint8_t *frame, unsigned len, uint16_t
 	return ret;
 }
 
+/** CRC8 DVB-S2 (polynomial 0xD5) lookup table */
+static const uint8_t crc8_dvb_s2_table[256] = {
+	0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54, 0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
+	0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06, 0x7B, 0xAE, 0x04, 0xD1, 0x85, 0x50, 0xFA, 0x2F,
+	0xA4, 0x71, 0xDB, 0x0E, 0x5A, 0x8F, 0x25, 0xF0, 0x8D, 0x58, 0xF2, 0x27, 0x73, 0xA6, 0x0C, 0xD9,
+	0xF6, 0x23, 0x89, 0x5C, 0x08, 0xDD, 0x77, 0xA2, 0xDF, 0x0A, 0xA0, 0x75, 0x21, 0xF4, 0x5E, 0x8B,
+	0x9D, 0x48, 0xE2, 0x37, 0x63, 0xB6, 0x1C, 0xC9, 0xB4, 0x61, 0xCB, 0x1E, 0x4A, 0x9F, 0x35, 0xE0,
+	0xCF, 0x1A, 0xB0, 0x65, 0x31, 0xE4, 0x4E, 0x9B, 0xE6, 0x33, 0x99, 0x4C, 0x18, 0xCD, 0x67, 0xB2,
+	0x39, 0xEC, 0x46, 0x93, 0xC7, 0x12, 0xB8, 0x6D, 0x10, 0xC5, 0x6F, 0xBA, 0xEE, 0x3B, 0x91, 0x44,
+	0x6B, 0xBE, 0x14, 0xC1, 0x95, 0x40, 0xEA, 0x3F, 0x42, 0x97, 0x3D, 0xE8, 0xBC, 0x69, 0xC3, 0x16,
+	0xEF, 0x3A, 0x90, 0x45, 0x11, 0xC4, 0x6E, 0xBB, 0xC6, 0x13, 0xB9, 0x6C, 0x38, 0xED, 0x47, 0x92,
+	0xBD, 0x68, 0xC2, 0x17, 0x43, 0x96, 0x3C, 0xE9, 0x94, 0x41, 0xEB, 0x3E, 0x6A, 0xBF, 0x15, 0xC0,
+	0x4B, 0x9E, 0x34, 0xE1, 0xB5, 0x60, 0xCA, 0x1F, 0x62, 0xB7, 0x1D, 0xC8, 0x9C, 0x49, 0xE3, 0x36,
+	0x19, 0xCC, 0x66, 0xB3, 0xE7, 0x32, 0x98, 0x4D, 0x30, 0xE5, 0x4F, 0x9A, 0xCE, 0x1B, 0xB1, 0x64,
+	0x72, 0xA7, 0x0D, 0xD8, 0x8C, 0x59, 0xF3, 0x26, 0x5B, 0x8E, 0x24, 0xF1, 0xA5, 0x70, 0xDA, 0x0F,
+	0x20, 0xF5, 0x5F, 0x8A, 0xDE, 0x0B, 0xA1, 0x74, 0x09, 0xDC, 0x76, 0xA3, 0xF7, 0x22, 0x88, 0x5D,
+	0xD6, 0x03, 0xA9, 0x7C, 0x28, 0xFD, 0x57, 0x82, 0xFF, 0x2A, 0x80, 0x55, 0x01, 0xD4, 0x7E, 0xAB,
+	0x84, 0x51, 0xFB, 0x2E, 0x7A, 0xAF, 0x05, 0xD0, 0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9,
+};
+
 static uint8_t crc8_dvb_s2(uint8_t crc, uint8_t a)
 {
-	crc ^= a;
-
-	for (int i = 0; i < 8; ++i) {
-		if (crc & 0x80) {
-			crc = (crc << 1) ^ 0xD5;
-
-		} else {
-			crc = crc << 1;
-		}
-	}
-
-	return crc;
+	return crc8_dvb_s2_table[crc ^ a];
 }
 
 static uint8_t crc8_dvb_s2_buf(uint8_t *buf, int len)
@@ -326,41 +312,12 @@ static bool crsf_parse_buffer(uint16_t *values, uint16_t *num_values, uint16_t m
 		const uint8_t crc = crsf_frame.payload[crsf_frame.header.length - 2];
 
 		if (crc == crsf_frame_CRC(crsf_frame)) {
-			const crsf_payload_RC_channels_packed_t *const rc_channels =
-				(crsf_payload_RC_channels_packed_t *)&crsf_frame.payload;
-			*num_values = MIN(max_channels, 16);
-
-			if (max_channels > 0) { values[0] = convert_channel_value(rc_channels->chan0); }
-
-			if (max_channels > 1) { values[1] = convert_channel_value(rc_channels->chan1); }
+			*num_values = MIN(max_channels, RC_PACKED_11BIT_CHANNELS);
+			rc_unpack_11bit(crsf_frame.payload, values, *num_values);
 
-			if (max_channels > 2) { values[2] = convert_channel_value(rc_channels->chan2); }
-
-			if (max_channels > 3) { values[3] = convert_channel_value(rc_channels->chan3); }
-
-			if (max_channels > 4) { values[4] = convert_channel_value(rc_channels->chan4); }
-
-			if (max_channels > 5) { values[5] = convert_channel_value(rc_channels->chan5); }
-
-			if (max_channels > 6) { values[6] = convert_channel_value(rc_channels->chan6); }
-
-			if (max_channels > 7) { values[7] = convert_channel_value(rc_channels->chan7); }
-
-			if (max_channels > 8) { values[8] = convert_channel_value(rc_channels->chan8); }
-
-			if (max_channels > 9) { values[9] = convert_channel_value(rc_channels->chan9); }
-
-			if (max_channels > 10) { values[10] = convert_channel_value(rc_channels->chan10); }
-
-			if (max_channels > 11) { values[11] = convert_channel_value(rc_channels->chan11); }
-
-			if (max_channels > 12) { values[12] = convert_channel_value(rc_channels->chan12); }
-
-			if (max_channels > 13) { values[13] = convert_channel_value(rc_channels->chan13); }
-
-			if (max_channels > 14) { values[14] = convert_channel_value(rc_channels->chan14); }
-
-			if (max_channels > 15) { values[15] = convert_channel_value(rc_channels->chan15); }
+			for (unsigned i = 0; i < *num_values; ++i) {
+				values[i] = convert_channel_value(values[i]);
+			}
 
 			CRSF_VERBOSE("Got Channels");
 
@@ -83,6 +83,9 @@ static bool
 dsm_decode(hrt_abstime frame_time, uint16_t *values, uint16_t *num_values, bool *dsm_11_bit, unsigned max_values,
 	   int8_t *rssi_percent);
 
+/** DSM receiver channel order (throttle, roll, pitch, ...) to R/C input order (roll, pitch, throttle, ...) */
+static const uint8_t dsm_channel_map[] = { 2, 0, 1 };
+
 /**
  * Attempt to decode a single channel raw channel datum
  *
@@ -509,20 +512,8 @@ dsm_decode(hrt_abstime frame_time, uint16_t *values, uint16_t *num_values, bool
 		 * Specifically, the first four channels in rc_channel_data are roll, pitch, thrust, yaw,
 		 * but the first four channels from the DSM receiver are thrust, roll, pitch, yaw.
 		 */
-		switch (channel) {
-		case 0:
-			channel = 2;
-			break;
-
-		case 1:
-			channel = 0;
-			break;
-
-		case 2:
-			channel = 1;
-
-		default:
-			break;
+		if (channel < sizeof(dsm_channel_map)) {
+			channel = dsm_channel_map[channel];
 		}
 
 		values[channel] = value;
@@ -684,8 +675,12 @@ dsm_parse(const uint64_t now, const uint8_t *frame, const unsigned len, uint16_t
 		switch (dsm_decode_state) {
 		case DSM_DECODE_STATE_DESYNC:
 
-			/* we are de-synced and only interested in the frame marker */
-			if ((now - dsm_last_rx_time) > 5000) {
+			/*
+			 * We are de-synced and only interested in the frame marker, which is the
+			 * inter-frame gap. Bytes after the first one in a buffer arrived back to
+			 * back, so only the first can start a frame.
+			 */
+			if ((d == 0) && (now - dsm_last_rx_time) > 5000) {
 				dsm_decode_state = DSM_DECODE_STATE_SYNC;
 				dsm_partial_frame_count = 0;
 				dsm_chan_count = 0;
@@ -695,7 +690,16 @@ dsm_parse(const uint64_t now, const uint8_t *frame, const unsigned len, uint16_t
 			break;
 
 		case DSM_DECODE_STATE_SYNC: {
-				dsm_frame[dsm_partial_frame_count++] = frame[d];
+				/* take as much of the frame as the buffer holds instead of going byte by byte */
+				unsigned chunk = DSM_FRAME_SIZE - dsm_partial_frame_count;
+
+				if (chunk > len - d) {
+					chunk = len - d;
+				}
+
+				memcpy(&dsm_frame[dsm_partial_frame_count], &frame[d], chunk);
+				dsm_partial_frame_count += chunk;
+				d += chunk - 1;
 
 				/* decode whatever we got and expect */
 				if (dsm_partial_frame_count < DSM_FRAME_SIZE) {
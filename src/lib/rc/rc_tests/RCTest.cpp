@@ -36,8 +36,54 @@ private:
 	bool sbus2Test();
 	bool st24Test();
 	bool sumdTest();
+	bool parserBenchmark();
+
+	typedef bool (*parse_fn)(hrt_abstime now, const uint8_t *bytes, unsigned len, uint16_t *values,
+				 uint16_t *num_values);
+
+	bool loadRecordedStream(const char *filepath);
+	bool loadCrsfStream(const char *filepath);
+	bool benchmarkStream(const char *name, parse_fn parse);
 };
 
+/*
+ * Recorded receiver byte stream, split into the bursts a UART driver would
+ * hand to the parser (bytes separated by more than an idle gap start a new chunk).
+ */
+static constexpr unsigned stream_max_bytes = 8192;
+static constexpr hrt_abstime stream_idle_gap_us = 500;
+static constexpr unsigned benchmark_repetitions = 200;
+
+static struct {
+	uint8_t bytes[stream_max_bytes];
+	uint16_t chunk_start[stream_max_bytes + 1];
+	hrt_abstime chunk_time[stream_max_bytes];
+	unsigned num_bytes;
+	unsigned num_chunks;
+} _stream;
+
+static bool sbus_parse_wrapper(hrt_abstime now, const uint8_t *bytes, unsigned len, uint16_t *values,
+			       uint16_t *num_values)
+{
+	bool sbus_failsafe;
+	bool sbus_frame_drop;
+	return sbus_parse(now, const_cast<uint8_t *>(bytes), len, values, num_values, &sbus_failsafe, &sbus_frame_drop,
+			  nullptr, 18);
+}
+
+static bool dsm_parse_wrapper(hrt_abstime now, const uint8_t *bytes, unsigned len, uint16_t *values,
+			      uint16_t *num_values)
+{
+	bool dsm_11_bit;
+	return dsm_parse(now, bytes, len, values, num_values, &dsm_11_bit, nullptr, nullptr, 18);
+}
+
+static bool crsf_parse_wrapper(hrt_abstime now, const uint8_t *bytes, unsigned len, uint16_t *values,
+			       uint16_t *num_values)
+{
+	return crsf_parse(now, bytes, len, values, num_values, 16);
+}
+
 bool RCTest::run_tests()
 {
 	ut_run_test(crsfTest);
@@ -46,6 +92,7 @@ bool RCTest::run_tests()
 	ut_run_test(sbus2Test);
 	ut_run_test(st24Test);
 	ut_run_test(sumdTest);
+	ut_run_test(parserBenchmark);
 
 	return (_tests_failed == 0);
 }
@@ -414,7 +461,172 @@ bool RCTest::sumdTest()
 	return true;
 }
 
+bool RCTest::loadRecordedStream(const char *filepath)
+{
+	FILE *fp = fopen(filepath, "rt");
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	// Trash the first 20 lines
+	for (unsigned i = 0; i < 20; i++) {
+		char buf[200];
+		(void)fgets(buf, sizeof(buf), fp);
+	}
+
+	float f;
+	unsigned x;
+	hrt_abstime last_time = 0;
+
+	_stream.num_bytes = 0;
+	_stream.num_chunks = 0;
+
+	while (_stream.num_bytes < stream_max_bytes && fscanf(fp, "%f,%x,,", &f, &x) == 2) {
+		const hrt_abstime t = f * 1e6f;
+
+		if (_stream.num_chunks == 0 || t - last_time > stream_idle_gap_us) {
+			_stream.chunk_start[_stream.num_chunks] = _stream.num_bytes;
+			_stream.chunk_time[_stream.num_chunks] = t;
+			_stream.num_chunks++;
+		}
+
+		_stream.bytes[_stream.num_bytes++] = x;
+		last_time = t;
+	}
+
+	_stream.chunk_start[_stream.num_chunks] = _stream.num_bytes;
+
+	fclose(fp);
+	return _stream.num_chunks > 0;
+}
+
+bool RCTest::loadCrsfStream(const char *filepath)
+{
+	FILE *fp = fopen(filepath, "rt");
+
+	if (fp == nullptr) {
+		return false;
+	}
+
+	const int line_size = 500;
+	char line[line_size];
+	hrt_abstime t = 0;
+
+	_stream.num_bytes = 0;
+	_stream.num_chunks = 0;
+
+	// every INPUT line is what a single UART read returned
+	while (fgets(line, line_size, fp) != nullptr) {
+		if (strncmp(line, "INPUT ", 6) != 0) {
+			continue;
+		}
+
+		const char *file_buffer = line + 6;
+		int offset;
+		int number;
+
+		_stream.chunk_start[_stream.num_chunks] = _stream.num_bytes;
+		_stream.chunk_time[_stream.num_chunks] = t;
+		t += 4000;
+
+		while (_stream.num_bytes < stream_max_bytes && sscanf(file_buffer, "%x, %n", &number, &offset) > 0) {
+			_stream.bytes[_stream.num_bytes++] = number;
+			file_buffer += offset;
+		}
+
+		_stream.num_chunks++;
+
+		if (_stream.num_bytes == stream_max_bytes) {
+			break;
+		}
+	}
+
+	_stream.chunk_start[_stream.num_chunks] = _stream.num_bytes;
+
+	fclose(fp);
+	return _stream.num_chunks > 0;
+}
+
+bool RCTest::benchmarkStream(const char *name, parse_fn parse)
+{
+	uint16_t values[18];
+	uint16_t num_values = 0;
+
+	// one pass to bring the parser into a synced state
+	for (unsigned c = 0; c < _stream.num_chunks; c++) {
+		parse(_stream.chunk_time[c], &_stream.bytes[_stream.chunk_start[c]],
+		      _stream.chunk_start[c + 1] - _stream.chunk_start[c], values, &num_values);
+	}
+
+	// feeding byte by byte and whole chunks has to decode the same frames
+	unsigned decoded_bytewise = 0;
+	unsigned decoded_chunked = 0;
+	uint32_t sum_bytewise = 0;
+	uint32_t sum_chunked = 0;
+
+	for (unsigned c = 0; c < _stream.num_chunks; c++) {
+		bool decoded = false;
+
+		for (unsigned i = _stream.chunk_start[c]; i < _stream.chunk_start[c + 1]; i++) {
+			if (parse(_stream.chunk_time[c], &_stream.bytes[i], 1, values, &num_values)) {
+				decoded = true;
+			}
+		}
+
+		if (decoded) {
+			decoded_bytewise++;
+
+			for (unsigned i = 0; i < num_values; i++) {
+				sum_bytewise += values[i] * (i + 1);
+			}
+		}
+	}
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned r = 0; r < benchmark_repetitions; r++) {
+		for (unsigned c = 0; c < _stream.num_chunks; c++) {
+			if (parse(_stream.chunk_time[c], &_stream.bytes[_stream.chunk_start[c]],
+				  _stream.chunk_start[c + 1] - _stream.chunk_start[c], values, &num_values)
+			    && r == 0) {
+				decoded_chunked++;
+
+				for (unsigned i = 0; i < num_values; i++) {
+					sum_chunked += values[i] * (i + 1);
+				}
+			}
+		}
+	}
+
+	const hrt_abstime elapsed = hrt_elapsed_time(&start);
+
+	ut_test(decoded_chunked > 0);
+	ut_compare("decoded frames", decoded_bytewise, decoded_chunked);
+	ut_compare("decoded values", sum_bytewise, sum_chunked);
+
+	const unsigned total_bytes = _stream.num_bytes * benchmark_repetitions;
+	const unsigned total_frames = decoded_chunked * benchmark_repetitions;
+	PX4_INFO("%s: %u bytes, %u frames in %llu us (%.3f us/frame)", name, total_bytes, total_frames,
+		 (unsigned long long)elapsed, (double)elapsed / total_frames);
+
+	return true;
+}
+
+bool RCTest::parserBenchmark()
+{
+	ut_test(loadRecordedStream(TEST_DATA_PATH "sbus2_r7008SB.txt"));
+	ut_test(benchmarkStream("sbus", sbus_parse_wrapper));
+
+	dsm_proto_init();
+	ut_test(loadRecordedStream(TEST_DATA_PATH "dsm_x_dx9_data.txt"));
+	ut_test(benchmarkStream("dsm", dsm_parse_wrapper));
 
+	ut_test(loadCrsfStream(TEST_DATA_PATH "crsf_rc_channels.txt"));
+	ut_test(benchmarkStream("crsf", crsf_parse_wrapper));
+
+	return true;
+}
 
 ut_declare_test_c(rc_tests_main, RCTest)
 
@@ -612,6 +612,10 @@ Commander::Commander() :
 Commander::~Commander()
 {
 	delete[] _airspeed_fault_type;
+
+	perf_free(_cycle_perf);
+	perf_free(_event_perf);
+	perf_free(_event_latency_perf);
 }
 
 bool
@@ -1276,9 +1280,6 @@ Commander::run()
 	/* armed topic */
 	hrt_abstime last_disarmed_timestamp = 0;
 
-	/* command ack */
-	uORB::PublicationQueued<vehicle_command_ack_s> command_ack_pub{ORB_ID(vehicle_command_ack)};
-
 	/* init mission state, do it here to allow navigator to use stored mission even if mavlink failed to start */
 	mission_init();
 
@@ -1291,12 +1292,10 @@ Commander::run()
 	bool param_init_forced = true;
 
 	uORB::Subscription actuator_controls_sub{ORB_ID_VEHICLE_ATTITUDE_CONTROLS};
-	uORB::Subscription cmd_sub{ORB_ID(vehicle_command)};
 	uORB::Subscription cpuload_sub{ORB_ID(cpuload)};
 	uORB::Subscription geofence_result_sub{ORB_ID(geofence_result)};
 	uORB::Subscription land_detector_sub{ORB_ID(vehicle_land_detected)};
 	uORB::Subscription safety_sub{ORB_ID(safety)};
-	uORB::Subscription sp_man_sub{ORB_ID(manual_control_setpoint)};
 	uORB::Subscription subsys_sub{ORB_ID(subsystem_info)};
 	uORB::Subscription system_power_sub{ORB_ID(system_power)};
 	uORB::Subscription vtol_vehicle_status_sub{ORB_ID(vtol_vehicle_status)};
@@ -1382,9 +1381,6 @@ Commander::run()
 	float ef_time_thres = 1000.0f;
 	uint64_t timestamp_engine_healthy = 0; /**< absolute time when engine was healty */
 
-	/* check which state machines for changes, clear "changed" flag */
-	bool failsafe_old = false;
-
 	bool have_taken_off_since_arming = false;
 
 	/* initialize low priority thread */
@@ -1410,8 +1406,53 @@ Commander::run()
 	// run preflight immediately to find all relevant parameters, but don't report
 	preflight_check(false);
 
+	/* wakeup sources that need a reaction before the next watchdog tick */
+	/* poll the subscriptions themselves, so waking up and consuming share one cursor */
+	_event_fds[EVENT_COMMAND].fd = _cmd_sub.getHandle();
+	_event_fds[EVENT_BATTERY].fd = _battery_sub.getHandle();
+	_event_fds[EVENT_ESTIMATOR].fd = _estimator_status_sub.getHandle();
+	_event_fds[EVENT_RC].fd = _sp_man_sub.getHandle();
+	_event_fds[EVENT_TELEMETRY].fd = _telemetry_status_sub.getHandle();
+
+	for (auto &event_fd : _event_fds) {
+		event_fd.events = POLLIN;
+	}
+
+	hrt_abstime next_tick = 0;
+
 	while (!should_exit()) {
 
+		const hrt_abstime now_wait = hrt_absolute_time();
+
+		if (now_wait < next_tick) {
+			/* sleep until the next watchdog tick or RC or data link loss, unless an event topic gets published */
+			const hrt_abstime loss_deadline = next_loss_deadline();
+			hrt_abstime wakeup = next_tick;
+
+			if (loss_deadline > now_wait && loss_deadline < next_tick) {
+				// the loss checks compare strictly against the timeout
+				wakeup = loss_deadline + 1;
+			}
+
+			int pret = px4_poll(_event_fds, EVENT_COUNT, (int)((wakeup - now_wait + 999) / 1000));
+
+			if (pret < 0) {
+				/* this is undesirable but not much we can do - the watchdog tick still runs */
+				PX4_ERR("poll error %d, %d", pret, errno);
+				px4_usleep(next_tick - now_wait);
+
+			} else if (pret > 0 || wakeup != next_tick) {
+				handle_events(status_changed);
+			}
+
+			continue;
+		}
+
+		/* the watchdog tick evaluates all checks, timeouts and hysteresis counters */
+		next_tick = now_wait + COMMANDER_MONITORING_INTERVAL;
+
+		perf_begin(_cycle_perf);
+
 		transition_result_t arming_ret = TRANSITION_NOT_CHANGED;
 
 		/* update parameters */
@@ -1529,7 +1570,7 @@ Commander::run()
 			}
 		}
 
-		sp_man_sub.update(&sp_man);
+		_sp_man_sub.update(&sp_man);
 
 		offboard_control_update(status_changed);
 
@@ -1734,6 +1775,8 @@ Commander::run()
 
 		battery_status_check();
 
+		rtl_time_estimate_check();
+
 		/* update subsystem info which arrives from outside of commander*/
 		subsystem_info_s info;
 		while (subsys_sub.update(&info))  {
@@ -1930,27 +1973,7 @@ Commander::run()
 		}
 
 		/* RC input check */
-		if (!status_flags.rc_input_blocked && sp_man.timestamp != 0 &&
-		    (hrt_elapsed_time(&sp_man.timestamp) < (_param_com_rc_loss_t.get() * 1_s))) {
-
-			/* handle the case where RC signal was regained */
-			if (!status_flags.rc_signal_found_once) {
-				status_flags.rc_signal_found_once = true;
-				set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, true
-						 && status_flags.rc_calibration_valid, status);
-				status_changed = true;
-
-			} else {
-				if (status.rc_signal_lost) {
-					mavlink_log_info(&mavlink_log_pub, "Manual control regained after %llums",
-							 hrt_elapsed_time(&rc_signal_lost_timestamp) / 1000);
-					set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, true
-							 && status_flags.rc_calibration_valid, status);
-					status_changed = true;
-				}
-			}
-
-			status.rc_signal_lost = false;
+		if (rc_signal_check(status_changed)) {
 
 			const bool in_armed_state = (status.arming_state == vehicle_status_s::ARMING_STATE_ARMED);
 			const bool arm_switch_or_button_mapped = sp_man.arm_switch != manual_control_setpoint_s::SWITCH_POS_NONE;
@@ -2098,15 +2121,6 @@ Commander::run()
 			}
 
 			/* no else case: do not change lockdown flag in unconfigured case */
-
-		} else {
-			if (!status_flags.rc_input_blocked && !status.rc_signal_lost) {
-				mavlink_log_critical(&mavlink_log_pub, "Manual control lost");
-				status.rc_signal_lost = true;
-				rc_signal_lost_timestamp = sp_man.timestamp;
-				set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, false, status);
-				status_changed = true;
-			}
 		}
 
 		// data link checks which update the status
@@ -2189,17 +2203,7 @@ Commander::run()
 		}
 
 		/* handle commands last, as the system needs to be updated to handle them */
-		if (cmd_sub.updated()) {
-			vehicle_command_s cmd{};
-
-			/* got command */
-			cmd_sub.copy(&cmd);
-
-			/* handle it */
-			if (handle_command(&status, cmd, &armed, command_ack_pub, &status_changed)) {
-				status_changed = true;
-			}
-		}
+		handle_pending_command(&status_changed);
 
 		/* Check for failure detector status */
 		const bool failure_detector_updated = _failure_detector.update(status);
@@ -2292,81 +2296,11 @@ Commander::run()
 		was_armed = armed.armed;
 
 		/* now set navigation state according to failsafe and main state */
-		bool nav_state_changed = set_nav_state(&status,
-						       &armed,
-						       &internal_state,
-						       &mavlink_log_pub,
-						       (link_loss_actions_t)_param_nav_dll_act.get(),
-						       _mission_result_sub.get().finished,
-						       _mission_result_sub.get().stay_in_failsafe,
-						       status_flags,
-						       land_detector.landed,
-						       (link_loss_actions_t)_param_nav_rcl_act.get(),
-						       (offboard_loss_actions_t)_param_com_obl_act.get(),
-						       (offboard_loss_rc_actions_t)_param_com_obl_rc_act.get(),
-						       (position_nav_loss_actions_t)_param_com_posctl_navl.get());
-
-		if (status.failsafe != failsafe_old) {
-			status_changed = true;
-
-			if (status.failsafe) {
-				mavlink_log_info(&mavlink_log_pub, "Failsafe mode activated");
-
-			} else {
-				mavlink_log_info(&mavlink_log_pub, "Failsafe mode deactivated");
-			}
-
-			failsafe_old = status.failsafe;
-		}
+		const bool nav_state_changed = update_nav_state(&status_changed);
 
 		/* publish states (armed, control_mode, vehicle_status, commander_state, vehicle_status_flags) at 1 Hz or immediately when changed */
 		if (hrt_elapsed_time(&status.timestamp) >= 1_s || status_changed || nav_state_changed) {
-
-			update_control_mode();
-
-			status.timestamp = hrt_absolute_time();
-			_status_pub.publish(status);
-
-			switch ((PrearmedMode)_param_com_prearm_mode.get()) {
-			case PrearmedMode::DISABLED:
-				/* skip prearmed state  */
-				armed.prearmed = false;
-				break;
-
-			case PrearmedMode::ALWAYS:
-				/* safety is not present, go into prearmed
-				* (all output drivers should be started / unlocked last in the boot process
-				* when the rest of the system is fully initialized)
-				*/
-				armed.prearmed = (hrt_elapsed_time(&commander_boot_timestamp) > 5_s);
-				break;
-
-			case PrearmedMode::SAFETY_BUTTON:
-				if (safety.safety_switch_available) {
-					/* safety switch is present, go into prearmed if safety is off */
-					armed.prearmed = safety.safety_off;
-
-				} else {
-					/* safety switch is not present, do not go into prearmed */
-					armed.prearmed = false;
-				}
-				break;
-
-			default:
-				armed.prearmed = false;
-				break;
-			}
-
-			armed.timestamp = hrt_absolute_time();
-			_armed_pub.publish(armed);
-
-			/* publish internal state for logging purposes */
-			internal_state.timestamp = hrt_absolute_time();
-			_commander_state_pub.publish(internal_state);
-
-			/* publish vehicle_status_flags */
-			status_flags.timestamp = hrt_absolute_time();
-			_vehicle_status_flags_pub.publish(status_flags);
+			publish_states();
 		}
 
 		/* play arming and battery warning tunes */
@@ -2441,7 +2375,7 @@ Commander::run()
 
 		arm_auth_update(now, params_updated || param_init_forced);
 
-		px4_usleep(COMMANDER_MONITORING_INTERVAL);
+		perf_end(_cycle_perf);
 	}
 
 	thread_should_exit = true;
@@ -2462,6 +2396,186 @@ Commander::run()
 	thread_running = false;
 }
 
+bool
+Commander::handle_pending_command(bool *status_changed, hrt_abstime *timestamp)
+{
+	vehicle_command_s cmd{};
+
+	if (!_cmd_sub.update(&cmd)) {
+		return false;
+	}
+
+	if (timestamp != nullptr) {
+		*timestamp = cmd.timestamp;
+	}
+
+	if (handle_command(&status, cmd, &armed, _command_ack_pub, status_changed)) {
+		*status_changed = true;
+	}
+
+	return true;
+}
+
+void
+Commander::handle_events(bool &status_changed)
+{
+	perf_begin(_event_perf);
+
+	hrt_abstime event_timestamp = 0;
+
+	// set if any check changed the state, only then the navigation state is evaluated and published
+	bool changed = false;
+
+	if (_event_fds[EVENT_COMMAND].revents & POLLIN) {
+		hrt_abstime timestamp = 0;
+
+		/* handle everything that is queued, the latency is taken from the oldest command */
+		while (handle_pending_command(&changed, &timestamp)) {
+			if (event_timestamp == 0) {
+				event_timestamp = timestamp;
+			}
+		}
+
+		// a command can switch the main state without changing the status
+		changed = true;
+	}
+
+	if (_event_fds[EVENT_BATTERY].revents & POLLIN) {
+		const uint8_t battery_warning_prev = _battery_warning;
+		battery_status_check();
+		changed |= (_battery_warning != battery_warning_prev);
+	}
+
+	if (_event_fds[EVENT_ESTIMATOR].revents & POLLIN) {
+		// the position validity flags are the estimator conditions the failsafe depends on
+		estimator_check(&changed);
+	}
+
+	const hrt_abstime loss_deadline = next_loss_deadline();
+	const bool loss_due = (loss_deadline != 0) && (hrt_absolute_time() > loss_deadline);
+
+	if (_event_fds[EVENT_RC].revents & POLLIN) {
+		_sp_man_sub.update(&sp_man);
+	}
+
+	// only the RC loss and regain transitions, the arming and mode switch logic runs on the tick
+	if (loss_due || (status.rc_signal_lost && (_event_fds[EVENT_RC].revents & POLLIN))) {
+		rc_signal_check(changed);
+	}
+
+	if (loss_due || (_event_fds[EVENT_TELEMETRY].revents & POLLIN)) {
+		data_link_check(changed);
+	}
+
+	if (loss_due && changed && event_timestamp == 0) {
+		event_timestamp = loss_deadline;
+	}
+
+	if (changed) {
+		status_changed = true;
+
+		// status_changed stays set, the next watchdog tick updates the LEDs and publishes once more
+		update_nav_state(&status_changed);
+		publish_states();
+
+		if (event_timestamp != 0) {
+			perf_set_elapsed(_event_latency_perf, hrt_elapsed_time(&event_timestamp));
+		}
+	}
+
+	perf_end(_event_perf);
+}
+
+bool
+Commander::update_nav_state(bool *status_changed)
+{
+	const link_loss_actions_t data_link_loss_act = (link_loss_actions_t)_param_nav_dll_act.get();
+	const link_loss_actions_t rc_loss_act = (link_loss_actions_t)_param_nav_rcl_act.get();
+
+	// evaluate the transition conditions once, the nav state rules are matched against the bitmask
+	const uint32_t conditions = nav_state_conditions(status, status_flags, data_link_loss_act, rc_loss_act,
+				    (position_nav_loss_actions_t)_param_com_posctl_navl.get(),
+				    _mission_result_sub.get().finished,
+				    _mission_result_sub.get().stay_in_failsafe,
+				    land_detector.landed);
+
+	const bool nav_state_changed = set_nav_state(&status,
+				       &armed,
+				       &internal_state,
+				       &mavlink_log_pub,
+				       conditions,
+				       status_flags,
+				       data_link_loss_act,
+				       rc_loss_act,
+				       (offboard_loss_actions_t)_param_com_obl_act.get(),
+				       (offboard_loss_rc_actions_t)_param_com_obl_rc_act.get());
+
+	if (status.failsafe != _failsafe_old) {
+		*status_changed = true;
+
+		if (status.failsafe) {
+			mavlink_log_info(&mavlink_log_pub, "Failsafe mode activated");
+
+		} else {
+			mavlink_log_info(&mavlink_log_pub, "Failsafe mode deactivated");
+		}
+
+		_failsafe_old = status.failsafe;
+	}
+
+	return nav_state_changed;
+}
+
+void
+Commander::publish_states()
+{
+	update_control_mode();
+
+	status.timestamp = hrt_absolute_time();
+	_status_pub.publish(status);
+
+	switch ((PrearmedMode)_param_com_prearm_mode.get()) {
+	case PrearmedMode::DISABLED:
+		/* skip prearmed state  */
+		armed.prearmed = false;
+		break;
+
+	case PrearmedMode::ALWAYS:
+		/* safety is not present, go into prearmed
+		* (all output drivers should be started / unlocked last in the boot process
+		* when the rest of the system is fully initialized)
+		*/
+		armed.prearmed = (hrt_elapsed_time(&commander_boot_timestamp) > 5_s);
+		break;
+
+	case PrearmedMode::SAFETY_BUTTON:
+		if (safety.safety_switch_available) {
+			/* safety switch is present, go into prearmed if safety is off */
+			armed.prearmed = safety.safety_off;
+
+		} else {
+			/* safety switch is not present, do not go into prearmed */
+			armed.prearmed = false;
+		}
+		break;
+
+	default:
+		armed.prearmed = false;
+		break;
+	}
+
+	armed.timestamp = hrt_absolute_time();
+	_armed_pub.publish(armed);
+
+	/* publish internal state for logging purposes */
+	internal_state.timestamp = hrt_absolute_time();
+	_commander_state_pub.publish(internal_state);
+
+	/* publish vehicle_status_flags */
+	status_flags.timestamp = hrt_absolute_time();
+	_vehicle_status_flags_pub.publish(status_flags);
+}
+
 void
 Commander::get_circuit_breaker_params()
 {
@@ -3527,6 +3641,8 @@ void *commander_low_prio_loop(void *arg)
 					if (calib_ret == OK) {
 						tune_positive(true);
 
+						// the calibration parameters might not have been announced yet
+						Preflight::invalidateCache();
 						Commander::preflight_check(false);
 
 						arming_state_transition(&status, safety, vehicle_status_s::ARMING_STATE_STANDBY, &armed,
@@ -3717,7 +3833,7 @@ void Commander::data_link_check(bool &status_changed)
 
 		telemetry_status_s telemetry;
 
-		if (_telemetry_status_sub.copy(&telemetry)) {
+		if (_telemetry_status_sub.update(&telemetry)) {
 
 			// handle different radio types
 			switch (telemetry.type) {
@@ -3895,7 +4011,7 @@ void Commander::battery_status_check()
 	if (_battery_sub.updated()) {
 		battery_status_s battery{};
 
-		if (_battery_sub.copy(&battery)) {
+		if (_battery_sub.update(&battery)) {
 
 			if ((hrt_elapsed_time(&battery.timestamp) < 5_s)
 			    && battery.connected
@@ -3940,6 +4056,85 @@ void Commander::battery_status_check()
 	}
 }
 
+bool Commander::rc_signal_check(bool &status_changed)
+{
+	if (!status_flags.rc_input_blocked && sp_man.timestamp != 0 &&
+	    (hrt_elapsed_time(&sp_man.timestamp) < (_param_com_rc_loss_t.get() * 1_s))) {
+
+		/* handle the case where RC signal was regained */
+		if (!status_flags.rc_signal_found_once) {
+			status_flags.rc_signal_found_once = true;
+			set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, true
+					 && status_flags.rc_calibration_valid, status);
+			status_changed = true;
+
+		} else {
+			if (status.rc_signal_lost) {
+				mavlink_log_info(&mavlink_log_pub, "Manual control regained after %llums",
+						 hrt_elapsed_time(&rc_signal_lost_timestamp) / 1000);
+				set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, true
+						 && status_flags.rc_calibration_valid, status);
+				status_changed = true;
+			}
+		}
+
+		status.rc_signal_lost = false;
+		return true;
+	}
+
+	if (!status_flags.rc_input_blocked && !status.rc_signal_lost) {
+		mavlink_log_critical(&mavlink_log_pub, "Manual control lost");
+		status.rc_signal_lost = true;
+		rc_signal_lost_timestamp = sp_man.timestamp;
+		set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, true, true, false, status);
+		status_changed = true;
+	}
+
+	return false;
+}
+
+hrt_abstime Commander::next_loss_deadline() const
+{
+	hrt_abstime deadline = 0;
+
+	if (!status_flags.rc_input_blocked && !status.rc_signal_lost && sp_man.timestamp != 0) {
+		deadline = sp_man.timestamp + (hrt_abstime)(_param_com_rc_loss_t.get() * 1_s);
+	}
+
+	if (!status.data_link_lost && _datalink_last_heartbeat_gcs != 0) {
+		const hrt_abstime data_link_deadline = _datalink_last_heartbeat_gcs + (hrt_abstime)(_param_com_dl_loss_t.get() * 1_s);
+
+		if (deadline == 0 || data_link_deadline < deadline) {
+			deadline = data_link_deadline;
+		}
+	}
+
+	return deadline;
+}
+
+void Commander::rtl_time_estimate_check()
+{
+	if (!armed.armed) {
+		_rtl_time_warning_sent = false;
+		return;
+	}
+
+	rtl_time_estimate_s rtl_time_estimate;
+
+	if (_rtl_time_estimate_sub.update(&rtl_time_estimate)) {
+		const bool returning = internal_state.main_state == commander_state_s::MAIN_STATE_AUTO_RTL
+				       || internal_state.main_state == commander_state_s::MAIN_STATE_AUTO_LAND;
+
+		if (rtl_time_estimate.valid && !land_detector.landed && !returning && !_rtl_time_warning_sent
+		    && (rtl_time_estimate.time_to_must_return < FLT_EPSILON)) {
+
+			mavlink_log_critical(&mavlink_log_pub, "Return energy limit reached, return now (%d s to return)",
+					     (int)rtl_time_estimate.time_estimate);
+			_rtl_time_warning_sent = true;
+		}
+	}
+}
+
 void Commander::airspeed_use_check()
 {
 	if (_airspeed_fail_action.get() < 1 || _airspeed_fail_action.get() > 4) {
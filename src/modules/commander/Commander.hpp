@@ -42,6 +42,8 @@
 #include <px4_module.h>
 #include <px4_module_params.h>
 #include <lib/hysteresis/hysteresis.h>
+#include <perf/perf_counter.h>
+#include <px4_posix.h>
 
 // publications
 #include <uORB/Publication.hpp>
@@ -55,12 +57,15 @@
 
 // subscriptions
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionPollable.hpp>
 #include <uORB/topics/airspeed.h>
 #include <uORB/topics/estimator_status.h>
 #include <uORB/topics/iridiumsbd_status.h>
+#include <uORB/topics/manual_control_setpoint.h>
 #include <uORB/topics/mission_result.h>
 #include <uORB/topics/offboard_control_mode.h>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/rtl_time_estimate.h>
 #include <uORB/topics/telemetry_status.h>
 #include <uORB/topics/vehicle_acceleration.h>
 #include <uORB/topics/vehicle_command.h>
@@ -205,6 +210,32 @@ private:
 	bool handle_command(vehicle_status_s *status, const vehicle_command_s &cmd, actuator_armed_s *armed,
 			    uORB::PublicationQueued<vehicle_command_ack_s> &command_ack_pub, bool *changed);
 
+	/**
+	 * Handle the next queued vehicle_command, if any.
+	 * @param status_changed set if the command changed the vehicle status
+	 * @param timestamp if not null, set to the publication time of the command
+	 * @return true if a command was handled
+	 */
+	bool handle_pending_command(bool *status_changed, hrt_abstime *timestamp = nullptr);
+
+	/**
+	 * Handle the publications that woke up the main loop between two watchdog ticks.
+	 * The queued commands are handled, followed by the navigation state update and
+	 * the state publication if something changed. All other checks wait for the tick.
+	 */
+	void handle_events(bool &status_changed);
+
+	/**
+	 * Set the navigation state from the failsafe and main state.
+	 * @return true if the navigation or failsafe state changed
+	 */
+	bool update_nav_state(bool *status_changed);
+
+	/**
+	 * Publish vehicle_control_mode, vehicle_status, actuator_armed, commander_state and vehicle_status_flags.
+	 */
+	void publish_states();
+
 	bool set_home_position();
 	bool set_home_position_alt_only();
 
@@ -238,6 +269,23 @@ private:
 
 	void battery_status_check();
 
+	/**
+	 * Update the RC signal lost and regained state from the age of the last manual control setpoint.
+	 * @return true if the RC signal is present
+	 */
+	bool rc_signal_check(bool &status_changed);
+
+	/**
+	 * @return the time at which the RC or GCS data link is declared lost if nothing arrives until then,
+	 * 0 if no loss is pending
+	 */
+	hrt_abstime next_loss_deadline() const;
+
+	/**
+	 * Warn once per flight when the return energy estimate says the return is due.
+	 */
+	void rtl_time_estimate_check();
+
 	void esc_status_check(const esc_status_s &esc_status);
 
 	/**
@@ -245,7 +293,7 @@ private:
 	 */
 	void		data_link_check(bool &status_changed);
 
-	uORB::Subscription _telemetry_status_sub{ORB_ID(telemetry_status)};
+	uORB::SubscriptionPollableTiny _telemetry_status_sub{ORB_ID(telemetry_status)};	///< also a wakeup source
 
 	hrt_abstime	_datalink_last_heartbeat_gcs{0};
 
@@ -265,27 +313,52 @@ private:
 
 	int  _last_esc_online_flags{-1};
 
-	uORB::Subscription _battery_sub{ORB_ID(battery_status)};
+	uORB::SubscriptionPollableTiny _battery_sub{ORB_ID(battery_status)};	///< also a wakeup source
 	uint8_t _battery_warning{battery_status_s::BATTERY_WARNING_NONE};
 	float _battery_current{0.0f};
 
+	uORB::Subscription _rtl_time_estimate_sub{ORB_ID(rtl_time_estimate)};
+	bool _rtl_time_warning_sent{false};
+
 	systemlib::Hysteresis	_auto_disarm_landed{false};
 	systemlib::Hysteresis	_auto_disarm_killed{false};
 
 	bool _print_avoidance_msg_once{false};
 
+	bool _failsafe_old{false};
+
+	// Topics that wake up the main loop before the next watchdog tick
+	enum EventSource {
+		EVENT_COMMAND = 0,	///< vehicle_command
+		EVENT_BATTERY,		///< battery_status, acted on if the warning level changes
+		EVENT_ESTIMATOR,	///< estimator_status, acted on if a position validity changes
+		EVENT_RC,		///< manual_control_setpoint, acted on if the RC signal was lost
+		EVENT_TELEMETRY,	///< telemetry_status, acted on if a data link was lost
+		EVENT_COUNT
+	};
+
+	px4_pollfd_struct_t _event_fds[EVENT_COUNT] {};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, "commander: cycle")};			///< watchdog tick
+	perf_counter_t _event_perf{perf_alloc(PC_ELAPSED, "commander: event")};			///< event wakeup
+	perf_counter_t _event_latency_perf{perf_alloc(PC_ELAPSED, "commander: event latency")};	///< publication to vehicle_status
+
 	// Subscriptions
+	// the pollable subscriptions are also the wakeup sources, see _event_fds
+	uORB::SubscriptionPollableTiny				_cmd_sub{ORB_ID(vehicle_command)};
+	uORB::SubscriptionPollableTiny				_sp_man_sub{ORB_ID(manual_control_setpoint)};
+	uORB::SubscriptionPollable<estimator_status_s>		_estimator_status_sub{ORB_ID(estimator_status)};
 	uORB::Subscription					_parameter_update_sub{ORB_ID(parameter_update)};
 	uORB::Subscription					_vehicle_acceleration_sub{ORB_ID(vehicle_acceleration)};
 
 	uORB::SubscriptionData<airspeed_s>			_airspeed_sub{ORB_ID(airspeed)};
-	uORB::SubscriptionData<estimator_status_s>		_estimator_status_sub{ORB_ID(estimator_status)};
 	uORB::SubscriptionData<mission_result_s>		_mission_result_sub{ORB_ID(mission_result)};
 	uORB::SubscriptionData<offboard_control_mode_s>		_offboard_control_mode_sub{ORB_ID(offboard_control_mode)};
 	uORB::SubscriptionData<vehicle_global_position_s>	_global_position_sub{ORB_ID(vehicle_global_position)};
 	uORB::SubscriptionData<vehicle_local_position_s>	_local_position_sub{ORB_ID(vehicle_local_position)};
 
 	// Publications
+	uORB::PublicationQueued<vehicle_command_ack_s>		_command_ack_pub{ORB_ID(vehicle_command_ack)};
 	uORB::Publication<vehicle_control_mode_s>		_control_mode_pub{ORB_ID(vehicle_control_mode)};
 	uORB::Publication<vehicle_status_s>			_status_pub{ORB_ID(vehicle_status)};
 	uORB::Publication<actuator_armed_s>			_armed_pub{ORB_ID(actuator_armed)};
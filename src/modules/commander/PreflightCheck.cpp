@@ -45,14 +45,17 @@
 #include "rc_check.h"
 
 #include <math.h>
+#include <pthread.h>
 #include <mathlib/mathlib.h>
 
 #include <parameters/param.h>
+#include <perf/perf_counter.h>
 #include <systemlib/mavlink_log.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/airspeed.h>
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/estimator_status.h>
+#include <uORB/topics/parameter_update.h>
 #include <uORB/topics/sensor_accel.h>
 #include <uORB/topics/sensor_baro.h>
 #include <uORB/topics/sensor_gyro.h>
@@ -66,16 +69,106 @@ using namespace time_literals;
 namespace Preflight
 {
 
-static bool check_calibration(const char *param_template, const int32_t device_id)
+static constexpr unsigned max_calibration_count = 4; ///< CAL_xxxN_ID parameters looked up per sensor type
+
+struct CalibrationIds {
+	int32_t device_id[max_calibration_count];
+	unsigned count;
+};
+
+/**
+ * Parameters, subscriptions and parameter-only check results kept between check runs.
+ *
+ * Parameter lookups and topic subscriptions dominated the cost of a check run. The
+ * parameters are reloaded on the next run after a parameter change (calibrations store
+ * their results in parameters) or after invalidateCache().
+ */
+struct Cache {
+	bool params_valid{false};
+
+	CalibrationIds cal_mag{};
+	CalibrationIds cal_acc{};
+	CalibrationIds cal_gyro{};
+
+	int32_t mag_prime{-1};
+	int32_t acc_prime{-1};
+	int32_t gyro_prime{-1};
+	int32_t baro_prime{-1};
+	int32_t sys_has_mag{1};
+	int32_t sys_has_baro{1};
+
+	float arm_imu_acc{1.0f};
+	float arm_imu_gyr{1.0f};
+	int32_t arm_mag_ang{-1};
+
+	float arm_ekf_hgt{1.0f};
+	float arm_ekf_vel{1.0f};
+	float arm_ekf_pos{1.0f};
+	float arm_ekf_yaw{1.0f};
+	float arm_ekf_ab{1.0f};
+	float arm_ekf_gb{1.0f};
+
+	int32_t fw_arsp_mode{0};
+	int32_t mc_est_group{-1};
+
+	// the RC calibration check only depends on parameters and the vehicle type
+	bool rc_result_valid{false};
+	bool rc_result_vtol{false};
+	int rc_result{OK};
+
+	uORB::Subscription parameter_update_sub{ORB_ID(parameter_update)};
+
+	uORB::SubscriptionData<sensor_mag_s> mag[max_optional_mag_count] {
+		{ORB_ID(sensor_mag), 0}, {ORB_ID(sensor_mag), 1}, {ORB_ID(sensor_mag), 2}, {ORB_ID(sensor_mag), 3}
+	};
+	uORB::SubscriptionData<sensor_accel_s> accel[max_optional_accel_count] {
+		{ORB_ID(sensor_accel), 0}, {ORB_ID(sensor_accel), 1}, {ORB_ID(sensor_accel), 2}
+	};
+	uORB::SubscriptionData<sensor_gyro_s> gyro[max_optional_gyro_count] {
+		{ORB_ID(sensor_gyro), 0}, {ORB_ID(sensor_gyro), 1}, {ORB_ID(sensor_gyro), 2}
+	};
+	uORB::SubscriptionData<sensor_baro_s> baro[max_optional_baro_count] {
+		{ORB_ID(sensor_baro), 0}
+	};
+	uORB::SubscriptionData<sensor_preflight_s> sensor_preflight{ORB_ID(sensor_preflight)};
+	uORB::SubscriptionData<airspeed_s> airspeed{ORB_ID(airspeed)};
+	uORB::SubscriptionData<system_power_s> system_power{ORB_ID(system_power)};
+	uORB::SubscriptionData<estimator_status_s> estimator_status{ORB_ID(estimator_status)};
+
+	// per check timing
+	perf_counter_t perf_total{perf_alloc(PC_ELAPSED, "preflight")};
+	perf_counter_t perf_mag{perf_alloc(PC_ELAPSED, "preflight: mag")};
+	perf_counter_t perf_accel{perf_alloc(PC_ELAPSED, "preflight: accel")};
+	perf_counter_t perf_gyro{perf_alloc(PC_ELAPSED, "preflight: gyro")};
+	perf_counter_t perf_baro{perf_alloc(PC_ELAPSED, "preflight: baro")};
+	perf_counter_t perf_imu{perf_alloc(PC_ELAPSED, "preflight: imu consistency")};
+	perf_counter_t perf_airspeed{perf_alloc(PC_ELAPSED, "preflight: airspeed")};
+	perf_counter_t perf_rc{perf_alloc(PC_ELAPSED, "preflight: rc")};
+	perf_counter_t perf_power{perf_alloc(PC_ELAPSED, "preflight: power")};
+	perf_counter_t perf_ekf2{perf_alloc(PC_ELAPSED, "preflight: ekf2")};
+};
+
+static_assert(max_optional_mag_count == 4, "update Cache::mag");
+static_assert(max_optional_accel_count == 3, "update Cache::accel");
+static_assert(max_optional_gyro_count == 3, "update Cache::gyro");
+static_assert(max_optional_baro_count == 1, "update Cache::baro");
+
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER; ///< serializes check runs from the commander threads
+
+static Cache &get_cache()
 {
-	bool calibration_found = false;
+	// constructed on the first check run, after uORB is up
+	static Cache cache;
+	return cache;
+}
 
+static void load_calibration_ids(const char *param_template, CalibrationIds &ids)
+{
 	char s[20];
-	int instance = 0;
 
 	/* old style transition: check param values */
-	while (!calibration_found) {
-		sprintf(s, param_template, instance);
+	for (ids.count = 0; ids.count < max_calibration_count; ids.count++) {
+		sprintf(s, param_template, ids.count);
 		const param_t parm = param_find_no_notification(s);
 
 		/* if the calibration param is not present, abort */
@@ -83,26 +176,81 @@ static bool check_calibration(const char *param_template, const int32_t device_i
 			break;
 		}
 
-		/* if param get succeeds */
-		int32_t calibration_devid = -1;
+		ids.device_id[ids.count] = -1;
+		param_get(parm, &ids.device_id[ids.count]);
+	}
+}
 
-		if (param_get(parm, &calibration_devid) == PX4_OK) {
+static void update_cache(Cache &cache)
+{
+	if (cache.parameter_update_sub.updated()) {
+		parameter_update_s update;
+		cache.parameter_update_sub.copy(&update);
+		cache.params_valid = false;
+	}
 
-			/* if the devid matches, exit early */
-			if (device_id == calibration_devid) {
-				calibration_found = true;
-				break;
-			}
-		}
+	if (cache.params_valid) {
+		return;
+	}
+
+	load_calibration_ids("CAL_MAG%u_ID", cache.cal_mag);
+	load_calibration_ids("CAL_ACC%u_ID", cache.cal_acc);
+	load_calibration_ids("CAL_GYRO%u_ID", cache.cal_gyro);
+
+	cache.mag_prime = -1;
+	param_get(param_find("CAL_MAG_PRIME"), &cache.mag_prime);
+	cache.acc_prime = -1;
+	param_get(param_find("CAL_ACC_PRIME"), &cache.acc_prime);
+	cache.gyro_prime = -1;
+	param_get(param_find("CAL_GYRO_PRIME"), &cache.gyro_prime);
+	cache.baro_prime = -1;
+	param_get(param_find("CAL_BARO_PRIME"), &cache.baro_prime);
+	cache.sys_has_mag = 1;
+	param_get(param_find("SYS_HAS_MAG"), &cache.sys_has_mag);
+	cache.sys_has_baro = 1;
+	param_get(param_find("SYS_HAS_BARO"), &cache.sys_has_baro);
+
+	param_get(param_find("COM_ARM_IMU_ACC"), &cache.arm_imu_acc);
+	param_get(param_find("COM_ARM_IMU_GYR"), &cache.arm_imu_gyr);
+	param_get(param_find("COM_ARM_MAG_ANG"), &cache.arm_mag_ang);
+
+	param_get(param_find("COM_ARM_EKF_HGT"), &cache.arm_ekf_hgt);
+	param_get(param_find("COM_ARM_EKF_VEL"), &cache.arm_ekf_vel);
+	param_get(param_find("COM_ARM_EKF_POS"), &cache.arm_ekf_pos);
+	param_get(param_find("COM_ARM_EKF_YAW"), &cache.arm_ekf_yaw);
+	param_get(param_find("COM_ARM_EKF_AB"), &cache.arm_ekf_ab);
+	param_get(param_find("COM_ARM_EKF_GB"), &cache.arm_ekf_gb);
+
+	cache.fw_arsp_mode = 0;
+	param_get(param_find("FW_ARSP_MODE"), &cache.fw_arsp_mode);
+	cache.mc_est_group = -1;
+	param_get(param_find("SYS_MC_EST_GROUP"), &cache.mc_est_group);
+
+	cache.rc_result_valid = false;
+	cache.params_valid = true;
+}
 
-		instance++;
+static bool check_calibration(const CalibrationIds &ids, const int32_t device_id)
+{
+	for (unsigned i = 0; i < ids.count; i++) {
+		/* if the devid matches, exit early */
+		if (device_id == ids.device_id[i]) {
+			return true;
+		}
 	}
 
-	return calibration_found;
+	return false;
 }
 
-static bool magnometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const uint8_t instance,
-			    const bool optional, int32_t &device_id, const bool report_fail)
+void invalidateCache()
+{
+	pthread_mutex_lock(&cache_mutex);
+	get_cache().params_valid = false;
+	pthread_mutex_unlock(&cache_mutex);
+}
+
+static bool magnometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache,
+			    const uint8_t instance, const bool optional, int32_t &device_id, const bool report_fail)
 {
 	const bool exists = (orb_exists(ORB_ID(sensor_mag), instance) == PX4_OK);
 	bool calibration_valid = false;
@@ -110,7 +258,8 @@ static bool magnometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &sta
 
 	if (exists) {
 
-		uORB::SubscriptionData<sensor_mag_s> magnetometer{ORB_ID(sensor_mag), instance};
+		uORB::SubscriptionData<sensor_mag_s> &magnetometer = cache.mag[instance];
+		magnetometer.update();
 
 		mag_valid = (hrt_elapsed_time(&magnetometer.get().timestamp) < 1_s);
 
@@ -122,7 +271,7 @@ static bool magnometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &sta
 
 		device_id = magnetometer.get().device_id;
 
-		calibration_valid = check_calibration("CAL_MAG%u_ID", device_id);
+		calibration_valid = check_calibration(cache.cal_mag, device_id);
 
 		if (!calibration_valid) {
 			if (report_fail) {
@@ -148,18 +297,16 @@ static bool magnometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &sta
 	return success;
 }
 
-static bool imuConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const bool report_status)
+static bool imuConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache,
+				const bool report_status)
 {
-	float test_limit = 1.0f; // pass limit re-used for each test
-
 	// Get sensor_preflight data if available and exit with a fail recorded if not
-	uORB::SubscriptionData<sensor_preflight_s> sensors_sub{ORB_ID(sensor_preflight)};
-	sensors_sub.update();
-	const sensor_preflight_s &sensors = sensors_sub.get();
+	cache.sensor_preflight.update();
+	const sensor_preflight_s &sensors = cache.sensor_preflight.get();
 
 	// Use the difference between IMU's to detect a bad calibration.
 	// If a single IMU is fitted, the value being checked will be zero so this check will always pass.
-	param_get(param_find("COM_ARM_IMU_ACC"), &test_limit);
+	float test_limit = cache.arm_imu_acc;
 
 	if (sensors.accel_inconsistency_m_s_s > test_limit) {
 		if (report_status) {
@@ -177,7 +324,7 @@ static bool imuConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s
 	}
 
 	// Fail if gyro difference greater than 5 deg/sec and notify if greater than 2.5 deg/sec
-	param_get(param_find("COM_ARM_IMU_GYR"), &test_limit);
+	test_limit = cache.arm_imu_gyr;
 
 	if (sensors.gyro_inconsistency_rad_s > test_limit) {
 		if (report_status) {
@@ -198,14 +345,14 @@ static bool imuConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s
 }
 
 // return false if the magnetomer measurements are inconsistent
-static bool magConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const bool report_status)
+static bool magConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache,
+				const bool report_status)
 {
 	bool pass = false; // flag for result of checks
 
 	// get the sensor preflight data
-	uORB::SubscriptionData<sensor_preflight_s> sensors_sub{ORB_ID(sensor_preflight)};
-	sensors_sub.update();
-	const sensor_preflight_s &sensors = sensors_sub.get();
+	cache.sensor_preflight.update();
+	const sensor_preflight_s &sensors = cache.sensor_preflight.get();
 
 	if (sensors.timestamp == 0) {
 		// can happen if not advertised (yet)
@@ -214,8 +361,7 @@ static bool magConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s
 
 	// Use the difference between sensors to detect a bad calibration, orientation or magnetic interference.
 	// If a single sensor is fitted, the value being checked will be zero so this check will always pass.
-	int32_t angle_difference_limit_deg;
-	param_get(param_find("COM_ARM_MAG_ANG"), &angle_difference_limit_deg);
+	const int32_t angle_difference_limit_deg = cache.arm_mag_ang;
 
 	pass = pass || angle_difference_limit_deg < 0; // disabled, pass check
 	pass = pass || sensors.mag_inconsistency_angle < math::radians<float>(angle_difference_limit_deg);
@@ -231,8 +377,8 @@ static bool magConsistencyCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s
 	return pass;
 }
 
-static bool accelerometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const uint8_t instance,
-			       const bool optional, const bool dynamic, int32_t &device_id, const bool report_fail)
+static bool accelerometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache,
+			       const uint8_t instance, const bool optional, const bool dynamic, int32_t &device_id, const bool report_fail)
 {
 	const bool exists = (orb_exists(ORB_ID(sensor_accel), instance) == PX4_OK);
 	bool calibration_valid = false;
@@ -240,7 +386,8 @@ static bool accelerometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &
 
 	if (exists) {
 
-		uORB::SubscriptionData<sensor_accel_s> accel{ORB_ID(sensor_accel), instance};
+		uORB::SubscriptionData<sensor_accel_s> &accel = cache.accel[instance];
+		accel.update();
 
 		accel_valid = (hrt_elapsed_time(&accel.get().timestamp) < 1_s);
 
@@ -252,7 +399,7 @@ static bool accelerometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &
 
 		device_id = accel.get().device_id;
 
-		calibration_valid = check_calibration("CAL_ACC%u_ID", device_id);
+		calibration_valid = check_calibration(cache.cal_acc, device_id);
 
 		if (!calibration_valid) {
 			if (report_fail) {
@@ -295,7 +442,7 @@ static bool accelerometerCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &
 	return success;
 }
 
-static bool gyroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const uint8_t instance,
+static bool gyroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache, const uint8_t instance,
 		      const bool optional, int32_t &device_id, const bool report_fail)
 {
 	const bool exists = (orb_exists(ORB_ID(sensor_gyro), instance) == PX4_OK);
@@ -304,7 +451,8 @@ static bool gyroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, c
 
 	if (exists) {
 
-		uORB::SubscriptionData<sensor_gyro_s> gyro{ORB_ID(sensor_gyro), instance};
+		uORB::SubscriptionData<sensor_gyro_s> &gyro = cache.gyro[instance];
+		gyro.update();
 
 		gyro_valid = (hrt_elapsed_time(&gyro.get().timestamp) < 1_s);
 
@@ -316,7 +464,7 @@ static bool gyroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, c
 
 		device_id = gyro.get().device_id;
 
-		calibration_valid = check_calibration("CAL_GYRO%u_ID", device_id);
+		calibration_valid = check_calibration(cache.cal_gyro, device_id);
 
 		if (!calibration_valid) {
 			if (report_fail) {
@@ -340,14 +488,15 @@ static bool gyroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, c
 	return calibration_valid && gyro_valid;
 }
 
-static bool baroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const uint8_t instance,
+static bool baroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache, const uint8_t instance,
 		      const bool optional, int32_t &device_id, const bool report_fail)
 {
 	const bool exists = (orb_exists(ORB_ID(sensor_baro), instance) == PX4_OK);
 	bool baro_valid = false;
 
 	if (exists) {
-		uORB::SubscriptionData<sensor_baro_s> baro{ORB_ID(sensor_baro), instance};
+		uORB::SubscriptionData<sensor_baro_s> &baro = cache.baro[instance];
+		baro.update();
 
 		baro_valid = (hrt_elapsed_time(&baro.get().timestamp) < 1_s);
 
@@ -371,15 +520,14 @@ static bool baroCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, c
 	return baro_valid;
 }
 
-static bool airspeedCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, const bool optional,
+static bool airspeedCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, Cache &cache, const bool optional,
 			  const bool report_fail, const bool prearm)
 {
 	bool present = true;
 	bool success = true;
 
-	uORB::SubscriptionData<airspeed_s> airspeed_sub{ORB_ID(airspeed)};
-	airspeed_sub.update();
-	const airspeed_s &airspeed = airspeed_sub.get();
+	cache.airspeed.update();
+	const airspeed_s &airspeed = cache.airspeed.get();
 
 	if (hrt_elapsed_time(&airspeed.timestamp) > 1_s) {
 		if (report_fail && !optional) {
@@ -428,8 +576,8 @@ out:
 	return success;
 }
 
-static bool powerCheck(orb_advert_t *mavlink_log_pub, const vehicle_status_s &status, const bool report_fail,
-		       const bool prearm)
+static bool powerCheck(orb_advert_t *mavlink_log_pub, const vehicle_status_s &status, Cache &cache,
+		       const bool report_fail, const bool prearm)
 {
 	bool success = true;
 
@@ -438,9 +586,8 @@ static bool powerCheck(orb_advert_t *mavlink_log_pub, const vehicle_status_s &st
 		return true;
 
 	} else {
-		uORB::SubscriptionData<system_power_s> system_power_sub{ORB_ID(system_power)};
-		system_power_sub.update();
-		const system_power_s &system_power = system_power_sub.get();
+		cache.system_power.update();
+		const system_power_s &system_power = cache.system_power.get();
 
 		if (hrt_elapsed_time(&system_power.timestamp) < 200_ms) {
 
@@ -473,7 +620,7 @@ static bool powerCheck(orb_advert_t *mavlink_log_pub, const vehicle_status_s &st
 	return success;
 }
 
-static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_status, const bool optional,
+static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_status, Cache &cache, const bool optional,
 		      const bool report_fail, const bool enforce_gps_required)
 {
 	bool success = true; // start with a pass and change to a fail if any test fails
@@ -484,9 +631,8 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	bool gps_present = true;
 
 	// Get estimator status data if available and exit with a fail recorded if not
-	uORB::SubscriptionData<estimator_status_s> status_sub{ORB_ID(estimator_status)};
-	status_sub.update();
-	const estimator_status_s &status = status_sub.get();
+	cache.estimator_status.update();
+	const estimator_status_s &status = cache.estimator_status.get();
 
 	if (status.timestamp == 0) {
 		present = false;
@@ -504,7 +650,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check vertical position innovation test ratio
-	param_get(param_find("COM_ARM_EKF_HGT"), &test_limit);
+	test_limit = cache.arm_ekf_hgt;
 
 	if (status.hgt_test_ratio > test_limit) {
 		if (report_fail) {
@@ -516,7 +662,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check velocity innovation test ratio
-	param_get(param_find("COM_ARM_EKF_VEL"), &test_limit);
+	test_limit = cache.arm_ekf_vel;
 
 	if (status.vel_test_ratio > test_limit) {
 		if (report_fail) {
@@ -528,7 +674,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check horizontal position innovation test ratio
-	param_get(param_find("COM_ARM_EKF_POS"), &test_limit);
+	test_limit = cache.arm_ekf_pos;
 
 	if (status.pos_test_ratio > test_limit) {
 		if (report_fail) {
@@ -540,7 +686,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check magnetometer innovation test ratio
-	param_get(param_find("COM_ARM_EKF_YAW"), &test_limit);
+	test_limit = cache.arm_ekf_yaw;
 
 	if (status.mag_test_ratio > test_limit) {
 		if (report_fail) {
@@ -552,7 +698,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check accelerometer delta velocity bias estimates
-	param_get(param_find("COM_ARM_EKF_AB"), &test_limit);
+	test_limit = cache.arm_ekf_ab;
 
 	for (uint8_t index = 13; index < 16; index++) {
 		// allow for higher uncertainty in estimates for axes that are less observable to prevent false positives
@@ -570,7 +716,7 @@ static bool ekf2Check(orb_advert_t *mavlink_log_pub, vehicle_status_s &vehicle_s
 	}
 
 	// check gyro delta angle bias estimates
-	param_get(param_find("COM_ARM_EKF_GB"), &test_limit);
+	test_limit = cache.arm_ekf_gb;
 
 	if (fabsf(status.states[10]) > test_limit || fabsf(status.states[11]) > test_limit
 	    || fabsf(status.states[12]) > test_limit) {
@@ -691,8 +837,8 @@ static bool failureDetectorCheck(orb_advert_t *mavlink_log_pub, const vehicle_st
 	return true;
 }
 
-bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, vehicle_status_flags_s &status_flags,
-		    const bool checkGNSS, bool reportFailures, const bool prearm, const hrt_abstime &time_since_boot)
+static bool runChecks(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, vehicle_status_flags_s &status_flags,
+		      Cache &cache, const bool checkGNSS, bool reportFailures, const bool prearm, const hrt_abstime &time_since_boot)
 {
 	if (time_since_boot < 2_s) {
 		// the airspeed driver filter doesn't deliver the actual value yet
@@ -723,13 +869,11 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 
 	/* ---- MAG ---- */
 	if (checkSensors) {
+		perf_begin(cache.perf_mag);
 		bool prime_found = false;
 
-		int32_t prime_id = -1;
-		param_get(param_find("CAL_MAG_PRIME"), &prime_id);
-
-		int32_t sys_has_mag = 1;
-		param_get(param_find("SYS_HAS_MAG"), &sys_has_mag);
+		const int32_t prime_id = cache.mag_prime;
+		const int32_t sys_has_mag = cache.sys_has_mag;
 
 		bool mag_fail_reported = false;
 
@@ -740,7 +884,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 
 			int32_t device_id = -1;
 
-			if (magnometerCheck(mavlink_log_pub, status, i, !required, device_id, report_fail)) {
+			if (magnometerCheck(mavlink_log_pub, status, cache, i, !required, device_id, report_fail)) {
 
 				if ((prime_id > 0) && (device_id == prime_id)) {
 					prime_found = true;
@@ -766,17 +910,19 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 			}
 
 			/* mag consistency checks (need to be performed after the individual checks) */
-			if (!magConsistencyCheck(mavlink_log_pub, status, (reportFailures && !failed))) {
+			if (!magConsistencyCheck(mavlink_log_pub, status, cache, (reportFailures && !failed))) {
 				failed = true;
 			}
 		}
+
+		perf_end(cache.perf_mag);
 	}
 
 	/* ---- ACCEL ---- */
 	if (checkSensors) {
+		perf_begin(cache.perf_accel);
 		bool prime_found = false;
-		int32_t prime_id = -1;
-		param_get(param_find("CAL_ACC_PRIME"), &prime_id);
+		const int32_t prime_id = cache.acc_prime;
 
 		bool accel_fail_reported = false;
 
@@ -787,7 +933,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 
 			int32_t device_id = -1;
 
-			if (accelerometerCheck(mavlink_log_pub, status, i, !required, checkDynamic, device_id, report_fail)) {
+			if (accelerometerCheck(mavlink_log_pub, status, cache, i, !required, checkDynamic, device_id, report_fail)) {
 
 				if ((prime_id > 0) && (device_id == prime_id)) {
 					prime_found = true;
@@ -810,13 +956,15 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 			set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_ACC, false, true, false, status);
 			failed = true;
 		}
+
+		perf_end(cache.perf_accel);
 	}
 
 	/* ---- GYRO ---- */
 	if (checkSensors) {
+		perf_begin(cache.perf_gyro);
 		bool prime_found = false;
-		int32_t prime_id = -1;
-		param_get(param_find("CAL_GYRO_PRIME"), &prime_id);
+		const int32_t prime_id = cache.gyro_prime;
 
 		bool gyro_fail_reported = false;
 
@@ -827,7 +975,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 
 			int32_t device_id = -1;
 
-			if (gyroCheck(mavlink_log_pub, status, i, !required, device_id, report_fail)) {
+			if (gyroCheck(mavlink_log_pub, status, cache, i, !required, device_id, report_fail)) {
 
 				if ((prime_id > 0) && (device_id == prime_id)) {
 					prime_found = true;
@@ -850,17 +998,17 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 			set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_GYRO, false, true, false, status);
 			failed = true;
 		}
+
+		perf_end(cache.perf_gyro);
 	}
 
 	/* ---- BARO ---- */
 	if (checkSensors) {
+		perf_begin(cache.perf_baro);
 		bool prime_found = false;
 
-		int32_t prime_id = -1;
-		param_get(param_find("CAL_BARO_PRIME"), &prime_id);
-
-		int32_t sys_has_baro = 1;
-		param_get(param_find("SYS_HAS_BARO"), &sys_has_baro);
+		const int32_t prime_id = cache.baro_prime;
+		const int32_t sys_has_baro = cache.sys_has_baro;
 
 		bool baro_fail_reported = false;
 
@@ -871,7 +1019,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 
 			int32_t device_id = -1;
 
-			if (baroCheck(mavlink_log_pub, status, i, !required, device_id, report_fail)) {
+			if (baroCheck(mavlink_log_pub, status, cache, i, !required, device_id, report_fail)) {
 				if ((prime_id > 0) && (device_id == prime_id)) {
 					prime_found = true;
 				}
@@ -894,29 +1042,49 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 			set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_ABSPRESSURE, false, true, false, status);
 			failed = true;
 		}
+
+		perf_end(cache.perf_baro);
 	}
 
 	/* ---- IMU CONSISTENCY ---- */
 	// To be performed after the individual sensor checks have completed
 	if (checkSensors) {
-		if (!imuConsistencyCheck(mavlink_log_pub, status, (reportFailures && !failed))) {
+		perf_begin(cache.perf_imu);
+
+		if (!imuConsistencyCheck(mavlink_log_pub, status, cache, (reportFailures && !failed))) {
 			failed = true;
 		}
+
+		perf_end(cache.perf_imu);
 	}
 
 	/* ---- AIRSPEED ---- */
 	if (checkAirspeed) {
-		int32_t optional = 0;
-		param_get(param_find("FW_ARSP_MODE"), &optional);
+		perf_begin(cache.perf_airspeed);
+		const bool optional = cache.fw_arsp_mode;
 
-		if (!airspeedCheck(mavlink_log_pub, status, (bool)optional, reportFailures && !failed, prearm) && !(bool)optional) {
+		if (!airspeedCheck(mavlink_log_pub, status, cache, optional, reportFailures && !failed, prearm) && !optional) {
 			failed = true;
 		}
+
+		perf_end(cache.perf_airspeed);
 	}
 
 	/* ---- RC CALIBRATION ---- */
 	if (checkRC) {
-		if (rc_calibration_check(mavlink_log_pub, reportFailures && !failed, status.is_vtol) != OK) {
+		perf_begin(cache.perf_rc);
+		const bool report_rc_fail = reportFailures && !failed;
+
+		// re-run a failed check when reporting, the cached result has no messages
+		if (!cache.rc_result_valid || (cache.rc_result_vtol != status.is_vtol)
+		    || (report_rc_fail && cache.rc_result != OK)) {
+
+			cache.rc_result = rc_calibration_check(mavlink_log_pub, report_rc_fail, status.is_vtol);
+			cache.rc_result_vtol = status.is_vtol;
+			cache.rc_result_valid = true;
+		}
+
+		if (cache.rc_result != OK) {
 			if (reportFailures) {
 				mavlink_log_critical(mavlink_log_pub, "RC calibration check failed");
 			}
@@ -932,13 +1100,19 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 			set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_RCRECEIVER, status_flags.rc_signal_found_once, true,
 					 !status.rc_signal_lost, status);
 		}
+
+		perf_end(cache.perf_rc);
 	}
 
 	/* ---- SYSTEM POWER ---- */
 	if (checkPower) {
-		if (!powerCheck(mavlink_log_pub, status, (reportFailures && !failed), prearm)) {
+		perf_begin(cache.perf_power);
+
+		if (!powerCheck(mavlink_log_pub, status, cache, (reportFailures && !failed), prearm)) {
 			failed = true;
 		}
+
+		perf_end(cache.perf_power);
 	}
 
 	/* ---- Navigation EKF ---- */
@@ -946,7 +1120,7 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 	int32_t estimator_type = -1;
 
 	if (status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING && !status.is_vtol) {
-		param_get(param_find("SYS_MC_EST_GROUP"), &estimator_type);
+		estimator_type = cache.mc_est_group;
 
 	} else {
 		// EKF2 is currently the only supported option for FW & VTOL
@@ -957,9 +1131,13 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 		// don't report ekf failures for the first 10 seconds to allow time for the filter to start
 		bool report_ekf_fail = (time_since_boot > 10_s);
 
-		if (!ekf2Check(mavlink_log_pub, status, false, reportFailures && report_ekf_fail && !failed, checkGNSS)) {
+		perf_begin(cache.perf_ekf2);
+
+		if (!ekf2Check(mavlink_log_pub, status, cache, false, reportFailures && report_ekf_fail && !failed, checkGNSS)) {
 			failed = true;
 		}
+
+		perf_end(cache.perf_ekf2);
 	}
 
 	/* ---- Failure Detector ---- */
@@ -973,4 +1151,22 @@ bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, veh
 	return !failed;
 }
 
+bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status, vehicle_status_flags_s &status_flags,
+		    const bool checkGNSS, bool reportFailures, const bool prearm, const hrt_abstime &time_since_boot)
+{
+	pthread_mutex_lock(&cache_mutex);
+
+	Cache &cache = get_cache();
+	update_cache(cache);
+
+	perf_begin(cache.perf_total);
+	const bool success = runChecks(mavlink_log_pub, status, status_flags, cache, checkGNSS, reportFailures, prearm,
+				       time_since_boot);
+	perf_end(cache.perf_total);
+
+	pthread_mutex_unlock(&cache_mutex);
+
+	return success;
+}
+
 }
@@ -71,11 +71,23 @@ namespace Preflight
 *   true if the GNSS receiver should be checked
 * @param checkPower
 *   true if the system power should be checked
+*
+* Parameters, topic subscriptions and the RC calibration result are cached between
+* runs and reloaded after a parameter change. Each check group is timed with a
+* "preflight: <check>" perf counter.
 **/
 bool preflightCheck(orb_advert_t *mavlink_log_pub, vehicle_status_s &status,
 		    vehicle_status_flags_s &status_flags, const bool checkGNSS, bool reportFailures, const bool prearm,
 		    const hrt_abstime &time_since_boot);
 
+/**
+* Drop the cached parameters and check results, so the next check run reloads them.
+*
+* Parameter changes are picked up automatically, this is for changes that are
+* not announced by a parameter_update, such as a calibration in progress.
+**/
+void invalidateCache();
+
 static constexpr unsigned max_mandatory_gyro_count = 1;
 static constexpr unsigned max_optional_gyro_count = 3;
 
@@ -62,66 +62,62 @@
 #include "calibration_messages.h"
 #include "commander_helper.h"
 
-int sphere_fit_least_squares(const float x[], const float y[], const float z[],
-			     unsigned int size, unsigned int max_iterations, float delta, float *sphere_x, float *sphere_y, float *sphere_z,
-			     float *sphere_radius)
+void sphere_fit_add_sample(sphere_fit_sums_s &sums, float x, float y, float z)
 {
+	const float x2 = x * x;
+	const float y2 = y * y;
+	const float z2 = z * z;
 
-	float x_sumplain = 0.0f;
-	float x_sumsq = 0.0f;
-	float x_sumcube = 0.0f;
+	sums.x_sumplain += x;
+	sums.x_sumsq += x2;
+	sums.x_sumcube += x2 * x;
 
-	float y_sumplain = 0.0f;
-	float y_sumsq = 0.0f;
-	float y_sumcube = 0.0f;
+	sums.y_sumplain += y;
+	sums.y_sumsq += y2;
+	sums.y_sumcube += y2 * y;
 
-	float z_sumplain = 0.0f;
-	float z_sumsq = 0.0f;
-	float z_sumcube = 0.0f;
+	sums.z_sumplain += z;
+	sums.z_sumsq += z2;
+	sums.z_sumcube += z2 * z;
 
-	float xy_sum = 0.0f;
-	float xz_sum = 0.0f;
-	float yz_sum = 0.0f;
+	sums.xy_sum += x * y;
+	sums.xz_sum += x * z;
+	sums.yz_sum += y * z;
 
-	float x2y_sum = 0.0f;
-	float x2z_sum = 0.0f;
-	float y2x_sum = 0.0f;
-	float y2z_sum = 0.0f;
-	float z2x_sum = 0.0f;
-	float z2y_sum = 0.0f;
+	sums.x2y_sum += x2 * y;
+	sums.x2z_sum += x2 * z;
 
-	for (unsigned int i = 0; i < size; i++) {
+	sums.y2x_sum += y2 * x;
+	sums.y2z_sum += y2 * z;
 
-		float x2 = x[i] * x[i];
-		float y2 = y[i] * y[i];
-		float z2 = z[i] * z[i];
+	sums.z2x_sum += z2 * x;
+	sums.z2y_sum += z2 * y;
 
-		x_sumplain += x[i];
-		x_sumsq += x2;
-		x_sumcube += x2 * x[i];
-
-		y_sumplain += y[i];
-		y_sumsq += y2;
-		y_sumcube += y2 * y[i];
-
-		z_sumplain += z[i];
-		z_sumsq += z2;
-		z_sumcube += z2 * z[i];
+	sums.count++;
+}
 
-		xy_sum += x[i] * y[i];
-		xz_sum += x[i] * z[i];
-		yz_sum += y[i] * z[i];
+int sphere_fit_least_squares(const float x[], const float y[], const float z[],
+			     unsigned int size, unsigned int max_iterations, float delta, float *sphere_x, float *sphere_y, float *sphere_z,
+			     float *sphere_radius)
+{
+	sphere_fit_sums_s sums{};
 
-		x2y_sum += x2 * y[i];
-		x2z_sum += x2 * z[i];
+	for (unsigned int i = 0; i < size; i++) {
+		sphere_fit_add_sample(sums, x[i], y[i], z[i]);
+	}
 
-		y2x_sum += y2 * x[i];
-		y2z_sum += y2 * z[i];
+	return sphere_fit_least_squares(sums, max_iterations, delta, sphere_x, sphere_y, sphere_z, sphere_radius);
+}
 
-		z2x_sum += z2 * x[i];
-		z2y_sum += z2 * y[i];
+int sphere_fit_least_squares(const sphere_fit_sums_s &sums, unsigned int max_iterations, float delta,
+			     float *sphere_x, float *sphere_y, float *sphere_z, float *sphere_radius)
+{
+	if (sums.count == 0) {
+		return 1;
 	}
 
+	const float size = sums.count;
+
 	//
 	//Least Squares Fit a sphere A,B,C with radius squared Rsq to 3D data
 	//
@@ -140,25 +136,25 @@ int sphere_fit_least_squares(const float x[], const float y[], const float z[],
 	//
 	//This method should converge; maybe 5-100 iterations or more.
 	//
-	float x_sum = x_sumplain / size;        //sum( X[n] )
-	float x_sum2 = x_sumsq / size;    //sum( X[n]^2 )
-	float x_sum3 = x_sumcube / size;    //sum( X[n]^3 )
-	float y_sum = y_sumplain / size;        //sum( Y[n] )
-	float y_sum2 = y_sumsq / size;    //sum( Y[n]^2 )
-	float y_sum3 = y_sumcube / size;    //sum( Y[n]^3 )
-	float z_sum = z_sumplain / size;        //sum( Z[n] )
-	float z_sum2 = z_sumsq / size;    //sum( Z[n]^2 )
-	float z_sum3 = z_sumcube / size;    //sum( Z[n]^3 )
-
-	float XY = xy_sum / size;        //sum( X[n] * Y[n] )
-	float XZ = xz_sum / size;        //sum( X[n] * Z[n] )
-	float YZ = yz_sum / size;        //sum( Y[n] * Z[n] )
-	float X2Y = x2y_sum / size;    //sum( X[n]^2 * Y[n] )
-	float X2Z = x2z_sum / size;    //sum( X[n]^2 * Z[n] )
-	float Y2X = y2x_sum / size;    //sum( Y[n]^2 * X[n] )
-	float Y2Z = y2z_sum / size;    //sum( Y[n]^2 * Z[n] )
-	float Z2X = z2x_sum / size;    //sum( Z[n]^2 * X[n] )
-	float Z2Y = z2y_sum / size;    //sum( Z[n]^2 * Y[n] )
+	float x_sum = sums.x_sumplain / size;        //sum( X[n] )
+	float x_sum2 = sums.x_sumsq / size;    //sum( X[n]^2 )
+	float x_sum3 = sums.x_sumcube / size;    //sum( X[n]^3 )
+	float y_sum = sums.y_sumplain / size;        //sum( Y[n] )
+	float y_sum2 = sums.y_sumsq / size;    //sum( Y[n]^2 )
+	float y_sum3 = sums.y_sumcube / size;    //sum( Y[n]^3 )
+	float z_sum = sums.z_sumplain / size;        //sum( Z[n] )
+	float z_sum2 = sums.z_sumsq / size;    //sum( Z[n]^2 )
+	float z_sum3 = sums.z_sumcube / size;    //sum( Z[n]^3 )
+
+	float XY = sums.xy_sum / size;        //sum( X[n] * Y[n] )
+	float XZ = sums.xz_sum / size;        //sum( X[n] * Z[n] )
+	float YZ = sums.yz_sum / size;        //sum( Y[n] * Z[n] )
+	float X2Y = sums.x2y_sum / size;    //sum( X[n]^2 * Y[n] )
+	float X2Z = sums.x2z_sum / size;    //sum( X[n]^2 * Z[n] )
+	float Y2X = sums.y2x_sum / size;    //sum( Y[n]^2 * X[n] )
+	float Y2Z = sums.y2z_sum / size;    //sum( Y[n]^2 * Z[n] )
+	float Z2X = sums.z2x_sum / size;    //sum( Z[n]^2 * X[n] )
+	float Z2Y = sums.z2y_sum / size;    //sum( Z[n]^2 * Y[n] )
 
 	//Reduction of multiplications
 	float F0 = x_sum2 + y_sum2 + z_sum2;
@@ -244,23 +240,147 @@ int ellipsoid_fit_least_squares(const float x[], const float y[], const float z[
 	float _fitness = 1.0e30f, _sphere_lambda = 1.0f, _ellipsoid_lambda = 1.0f;
 
 	for (int i = 0; i < max_iterations; i++) {
-		run_lm_sphere_fit(x, y, z, _fitness, _sphere_lambda,
-				  size, offset_x, offset_y, offset_z,
-				  sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z);
+		const float prev_fitness = _fitness;
 
+		if (run_lm_sphere_fit(x, y, z, _fitness, _sphere_lambda,
+				      size, offset_x, offset_y, offset_z,
+				      sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z) == 0
+		    && (prev_fitness - _fitness) < delta) {
+			// converged, the remaining iterations would not change the result noticeably
+			break;
+		}
 	}
 
 	_fitness = 1.0e30f;
 
 	for (int i = 0; i < max_iterations; i++) {
-		run_lm_ellipsoid_fit(x, y, z, _fitness, _ellipsoid_lambda,
-				     size, offset_x, offset_y, offset_z,
-				     sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z);
+		const float prev_fitness = _fitness;
+
+		if (run_lm_ellipsoid_fit(x, y, z, _fitness, _ellipsoid_lambda,
+					 size, offset_x, offset_y, offset_z,
+					 sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z) == 0
+		    && (prev_fitness - _fitness) < delta) {
+			break;
+		}
 	}
 
 	return 0;
 }
 
+unsigned int calibration_bin_samples(const float x[], const float y[], const float z[], unsigned int size,
+				     float center_x, float center_y, float center_z,
+				     float out_x[], float out_y[], float out_z[])
+{
+	static constexpr unsigned int n = calibration_bins_per_face_side;
+	static constexpr unsigned int none = UINT32_MAX;
+
+	float sum_x[calibration_bin_count] = {};
+	float sum_y[calibration_bin_count] = {};
+	float sum_z[calibration_bin_count] = {};
+	uint16_t count[calibration_bin_count] = {};
+
+	// project the direction of a sample onto the face of the unit cube it points at
+	auto sample_bin = [&](unsigned int k) {
+		const float dx = x[k] - center_x;
+		const float dy = y[k] - center_y;
+		const float dz = z[k] - center_z;
+		const float ax = fabsf(dx);
+		const float ay = fabsf(dy);
+		const float az = fabsf(dz);
+
+		unsigned int face;
+		float u;
+		float v;
+
+		if (ax >= ay && ax >= az) {
+			face = (dx >= 0.0f) ? 0 : 1;
+			u = dy / ax;
+			v = dz / ax;
+
+		} else if (ay >= az) {
+			face = (dy >= 0.0f) ? 2 : 3;
+			u = dx / ay;
+			v = dz / ay;
+
+		} else {
+			face = (dz >= 0.0f) ? 4 : 5;
+			u = dx / az;
+			v = dy / az;
+		}
+
+		if (!PX4_ISFINITE(u) || !PX4_ISFINITE(v)) {
+			// sample coincides with the center
+			return none;
+		}
+
+		// u, v are in [-1, 1]
+		const unsigned int iu = math::min((unsigned int)((u + 1.0f) * 0.5f * n), n - 1);
+		const unsigned int iv = math::min((unsigned int)((v + 1.0f) * 0.5f * n), n - 1);
+		return (face * n + iu) * n + iv;
+	};
+
+	for (unsigned int k = 0; k < size; k++) {
+		const unsigned int bin = sample_bin(k);
+
+		if (bin != none) {
+			sum_x[bin] += x[k];
+			sum_y[bin] += y[k];
+			sum_z[bin] += z[k];
+			count[bin]++;
+		}
+	}
+
+	// The average of a bin lies inside the curved surface and would bias the fit towards a
+	// smaller radius. Keep the sample closest to the average instead, it is a real measurement
+	// on the surface and, like a medoid, robust against single outliers.
+	unsigned int best_index[calibration_bin_count];
+	float best_dist[calibration_bin_count];
+
+	for (unsigned int bin = 0; bin < calibration_bin_count; bin++) {
+		if (count[bin] > 0) {
+			sum_x[bin] /= count[bin];
+			sum_y[bin] /= count[bin];
+			sum_z[bin] /= count[bin];
+		}
+
+		best_index[bin] = none;
+		best_dist[bin] = FLT_MAX;
+	}
+
+	for (unsigned int k = 0; k < size; k++) {
+		const unsigned int bin = sample_bin(k);
+
+		if (bin != none) {
+			const float dx = x[k] - sum_x[bin];
+			const float dy = y[k] - sum_y[bin];
+			const float dz = z[k] - sum_z[bin];
+			const float dist = dx * dx + dy * dy + dz * dz;
+
+			if (dist < best_dist[bin]) {
+				best_dist[bin] = dist;
+				best_index[bin] = k;
+			}
+		}
+	}
+
+	// Output in ascending sample order: the output may be the input buffer, and the n-th kept
+	// sample never has an index below n, so no sample is overwritten before it is copied.
+	unsigned int out_size = 0;
+
+	for (unsigned int k = 0; k < size && out_size < calibration_bin_count; k++) {
+		const unsigned int bin = sample_bin(k);
+
+		if (bin != none && best_index[bin] == k) {
+			out_x[out_size] = x[k];
+			out_y[out_size] = y[k];
+			out_z[out_size] = z[k];
+			out_size++;
+		}
+	}
+
+	return out_size;
+}
+
 int run_lm_sphere_fit(const float x[], const float y[], const float z[], float &_fitness, float &_sphere_lambda,
 		      unsigned int size, float *offset_x, float *offset_y, float *offset_z,
 		      float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z)
@@ -36,6 +36,54 @@
 
 #pragma once
 
+/**
+ * Running sums of the sample moments used by the least-squares sphere fit.
+ *
+ * Samples are added in constant time while they are collected, so the sphere
+ * can be solved at any point without another pass over the raw samples.
+ */
+struct sphere_fit_sums_s {
+	unsigned int count;
+
+	float x_sumplain;
+	float x_sumsq;
+	float x_sumcube;
+
+	float y_sumplain;
+	float y_sumsq;
+	float y_sumcube;
+
+	float z_sumplain;
+	float z_sumsq;
+	float z_sumcube;
+
+	float xy_sum;
+	float xz_sum;
+	float yz_sum;
+
+	float x2y_sum;
+	float x2z_sum;
+	float y2x_sum;
+	float y2z_sum;
+	float z2x_sum;
+	float z2y_sum;
+};
+
+/**
+ * Add a single point to the sphere fit sums.
+ */
+void sphere_fit_add_sample(sphere_fit_sums_s &sums, float x, float y, float z);
+
+/**
+ * Least-squares fit of a sphere to points accumulated with sphere_fit_add_sample().
+ *
+ * @see sphere_fit_least_squares() for the parameters
+ *
+ * @return 0 on success, 1 on failure
+ */
+int sphere_fit_least_squares(const sphere_fit_sums_s &sums, unsigned int max_iterations, float delta,
+			     float *sphere_x, float *sphere_y, float *sphere_z, float *sphere_radius);
+
 /**
  * Least-squares fit of a sphere to a set of points.
  *
@@ -57,6 +105,16 @@
 int sphere_fit_least_squares(const float x[], const float y[], const float z[],
 			     unsigned int size, unsigned int max_iterations, float delta, float *sphere_x, float *sphere_y, float *sphere_z,
 			     float *sphere_radius);
+
+/**
+ * Levenberg-Marquardt fit of an ellipsoid to a set of points.
+ *
+ * The offsets, radius and scale factors passed in are used as the initial guess.
+ *
+ * @param delta stop iterating once the fitness improves by less than delta. Set to 0 to run max_iterations times.
+ *
+ * @return 0 on success
+ */
 int ellipsoid_fit_least_squares(const float x[], const float y[], const float z[],
 				unsigned int size, int max_iterations, float delta, float *offset_x, float *offset_y, float *offset_z,
 				float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y,
@@ -69,6 +127,25 @@ int run_lm_ellipsoid_fit(const float x[], const float y[], const float z[], floa
 			 unsigned int size, float *offset_x, float *offset_y, float *offset_z,
 			 float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y,
 			 float *offdiag_z);
+
+static constexpr unsigned calibration_bins_per_face_side = 3;
+static constexpr unsigned calibration_bin_count = 6 * calibration_bins_per_face_side * calibration_bins_per_face_side;
+
+/**
+ * Reduce a set of points to one representative point per direction bin.
+ *
+ * The direction of every point as seen from the given center is projected onto the faces
+ * of a cube, each face being split into calibration_bins_per_face_side^2 bins. Each bin is
+ * represented by its sample closest to the bin average, so the points stay on the measured
+ * surface. Empty bins are skipped, so the output holds at most calibration_bin_count points
+ * with even coverage. The output may be the input buffers.
+ *
+ * @return number of points written to out_x, out_y and out_z
+ */
+unsigned int calibration_bin_samples(const float x[], const float y[], const float z[], unsigned int size,
+				     float center_x, float center_y, float center_z,
+				     float out_x[], float out_y[], float out_z[]);
+
 bool inverse4x4(float m[], float invOut[]);
 bool mat_inverse(float *A, float *inv, uint8_t n);
 
@@ -0,0 +1,225 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file calibration_routines_test.cpp
+ * Magnetometer calibration fit unit test.
+ *
+ */
+
+#include "calibration_routines_test.h"
+
+#include <uORB/uORB.h>
+#include "../calibration_routines.h"
+#include <unit_test.h>
+
+#include <math.h>
+
+class CalibrationRoutinesTest : public UnitTest
+{
+public:
+	CalibrationRoutinesTest() = default;
+	virtual ~CalibrationRoutinesTest() = default;
+
+	virtual bool run_tests();
+
+private:
+	bool binnedSamplesOnSurfaceTest();
+	bool ellipsoidRecoveryTest();
+
+	/**
+	 * Fill the buffers with samples of a known ellipsoid. Most samples cover one
+	 * cap only, like a vehicle that was mostly held upright during the calibration.
+	 */
+	void generateSamples();
+
+	/** Distance of a point from the known ellipsoid, scaled to the calibrated radius */
+	float surfaceError(float x, float y, float z) const;
+
+	float uniform();
+
+	static constexpr unsigned _num_samples = 1000;
+	static constexpr unsigned _num_cap_samples = 800;
+
+	// calibrated = W * (raw - offset), on a sphere with radius _radius
+	const float _offset[3] {0.12f, -0.21f, 0.33f};
+	const float _diag[3] {1.1f, 0.9f, 1.0f};
+	const float _offdiag[3] {0.05f, -0.03f, 0.02f};
+	const float _radius{0.5f};
+
+	float _x[_num_samples] {};
+	float _y[_num_samples] {};
+	float _z[_num_samples] {};
+
+	uint32_t _seed{1};
+};
+
+float CalibrationRoutinesTest::uniform()
+{
+	// uniform in [-1, 1], deterministic
+	_seed = _seed * 1664525u + 1013904223u;
+	return (float)(_seed >> 8) / (float)(1u << 23) - 1.0f;
+}
+
+void CalibrationRoutinesTest::generateSamples()
+{
+	const float w[3][3] {
+		{_diag[0], _offdiag[0], _offdiag[1]},
+		{_offdiag[0], _diag[1], _offdiag[2]},
+		{_offdiag[1], _offdiag[2], _diag[2]}
+	};
+
+	// inverse of W by cofactors
+	const float det = w[0][0] * (w[1][1] * w[2][2] - w[1][2] * w[2][1])
+			  - w[0][1] * (w[1][0] * w[2][2] - w[1][2] * w[2][0])
+			  + w[0][2] * (w[1][0] * w[2][1] - w[1][1] * w[2][0]);
+
+	float w_inv[3][3];
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			const int r0 = (j + 1) % 3, r1 = (j + 2) % 3;
+			const int c0 = (i + 1) % 3, c1 = (i + 2) % 3;
+			w_inv[i][j] = (w[r0][c0] * w[r1][c1] - w[r0][c1] * w[r1][c0]) / det;
+		}
+	}
+
+	_seed = 1;
+
+	for (unsigned k = 0; k < _num_samples; k++) {
+		float u[3];
+		float norm;
+
+		do {
+			u[0] = uniform();
+			u[1] = uniform();
+			u[2] = uniform();
+
+			if (k < _num_cap_samples) {
+				u[2] = fabsf(u[2]) + 1.5f;
+			}
+
+			norm = sqrtf(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+
+		} while (norm < 0.1f || (k >= _num_cap_samples && norm > 1.0f));
+
+		for (int i = 0; i < 3; i++) {
+			u[i] *= _radius / norm;
+		}
+
+		float *out[3] {&_x[k], &_y[k], &_z[k]};
+
+		for (int i = 0; i < 3; i++) {
+			*out[i] = _offset[i] + w_inv[i][0] * u[0] + w_inv[i][1] * u[1] + w_inv[i][2] * u[2] + 0.003f * uniform();
+		}
+	}
+}
+
+float CalibrationRoutinesTest::surfaceError(float x, float y, float z) const
+{
+	const float d[3] {x - _offset[0], y - _offset[1], z - _offset[2]};
+	const float c[3] {
+		_diag[0] * d[0] + _offdiag[0] * d[1] + _offdiag[1] * d[2],
+		_offdiag[0] * d[0] + _diag[1] * d[1] + _offdiag[2] * d[2],
+		_offdiag[1] * d[0] + _offdiag[2] * d[1] + _diag[2] * d[2]
+	};
+
+	return fabsf(sqrtf(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]) - _radius);
+}
+
+bool CalibrationRoutinesTest::binnedSamplesOnSurfaceTest()
+{
+	generateSamples();
+
+	// binning in place, like the magnetometer calibration does
+	const unsigned count = calibration_bin_samples(_x, _y, _z, _num_samples, _offset[0], _offset[1], _offset[2],
+			       _x, _y, _z);
+
+	ut_assert("bins are populated", count > calibration_bin_count / 2 && count <= calibration_bin_count);
+
+	// averaging would move the points of the sparsely sampled bins into the ellipsoid
+	for (unsigned k = 0; k < count; k++) {
+		ut_assert("binned sample on the surface", surfaceError(_x[k], _y[k], _z[k]) < 0.01f);
+	}
+
+	return true;
+}
+
+bool CalibrationRoutinesTest::ellipsoidRecoveryTest()
+{
+	generateSamples();
+
+	float offset_x = 0.0f;
+	float offset_y = 0.0f;
+	float offset_z = 0.0f;
+	float radius = 0.0f;
+	ut_compare("sphere fit", sphere_fit_least_squares(_x, _y, _z, _num_samples, 100, 0.0f,
+			&offset_x, &offset_y, &offset_z, &radius), 0);
+
+	const unsigned count = calibration_bin_samples(_x, _y, _z, _num_samples, offset_x, offset_y, offset_z,
+			       _x, _y, _z);
+
+	float diag_x = 1.0f;
+	float diag_y = 1.0f;
+	float diag_z = 1.0f;
+	float offdiag_x = 0.0f;
+	float offdiag_y = 0.0f;
+	float offdiag_z = 0.0f;
+	ellipsoid_fit_least_squares(_x, _y, _z, count, 100, 1e-6f, &offset_x, &offset_y, &offset_z, &radius,
+				    &diag_x, &diag_y, &diag_z, &offdiag_x, &offdiag_y, &offdiag_z);
+
+	ut_assert("offset x", fabsf(offset_x - _offset[0]) < 0.005f);
+	ut_assert("offset y", fabsf(offset_y - _offset[1]) < 0.005f);
+	ut_assert("offset z", fabsf(offset_z - _offset[2]) < 0.005f);
+
+	// W and the radius can be scaled together, only their ratio is observable
+	ut_assert("scale x", fabsf(diag_x / radius - _diag[0] / _radius) < 0.01f);
+	ut_assert("scale y", fabsf(diag_y / radius - _diag[1] / _radius) < 0.01f);
+	ut_assert("scale z", fabsf(diag_z / radius - _diag[2] / _radius) < 0.01f);
+	ut_assert("off-diagonal x", fabsf(offdiag_x / radius - _offdiag[0] / _radius) < 0.01f);
+	ut_assert("off-diagonal y", fabsf(offdiag_y / radius - _offdiag[1] / _radius) < 0.01f);
+	ut_assert("off-diagonal z", fabsf(offdiag_z / radius - _offdiag[2] / _radius) < 0.01f);
+
+	return true;
+}
+
+bool CalibrationRoutinesTest::run_tests()
+{
+	ut_run_test(binnedSamplesOnSurfaceTest);
+	ut_run_test(ellipsoidRecoveryTest);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test(calibrationRoutinesTest, CalibrationRoutinesTest)
@@ -42,11 +42,15 @@
 #include <systemlib/err.h>
 
 #include "state_machine_helper_test.h"
+#include "calibration_routines_test.h"
 
 extern "C" __EXPORT int commander_tests_main(int argc, char *argv[]);
 
 
 int commander_tests_main(int argc, char *argv[])
 {
-	return stateMachineHelperTest() ? 0 : -1;
+	bool success = stateMachineHelperTest();
+	success = calibrationRoutinesTest() && success;
+
+	return success ? 0 : -1;
 }
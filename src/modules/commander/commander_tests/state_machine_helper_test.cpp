@@ -54,7 +54,60 @@ public:
 private:
 	bool armingStateTransitionTest();
 	bool mainStateTransitionTest();
+	bool mainStateTransitionTableTest();
+	bool navStateTableTest();
 	bool isSafeTest();
+
+	/**
+	 * Vehicle and parameter configuration of a navigation state test case.
+	 */
+	struct NavStateConfig {
+		uint8_t main_state;
+		uint8_t vehicle_type;
+		bool is_vtol;
+		link_loss_actions_t data_link_loss_act;
+		link_loss_actions_t rc_loss_act;
+		offboard_loss_actions_t offb_loss_act;
+		offboard_loss_rc_actions_t offb_loss_rc_act;
+		position_nav_loss_actions_t posctl_nav_loss_act;
+	};
+
+	/**
+	 * Status bits of a navigation state test case, see navStateMatches().
+	 */
+	enum NavStateBit : uint8_t {
+		NAV_ARMED,
+		NAV_RC_SIGNAL_LOST,
+		NAV_DATA_LINK_LOST,
+		NAV_ENGINE_FAILURE,
+		NAV_MISSION_FAILURE,
+		NAV_VTOL_TRANSITION_FAILURE,
+		NAV_OFFBOARD_SIGNAL_LOST,
+		NAV_OFFBOARD_LOSS_TIMEOUT,
+		NAV_LOCAL_ALTITUDE_VALID,
+		NAV_LOCAL_POSITION_VALID,
+		NAV_LOCAL_VELOCITY_VALID,
+		NAV_GLOBAL_POSITION_VALID,
+		NAV_HOME_POSITION_VALID,
+		NAV_LANDED,
+		NAV_MISSION_FINISHED,
+		NAV_STAY_IN_FAILSAFE,
+		NAV_BIT_COUNT
+	};
+
+	/**
+	 * Run the table driven and the legacy navigation state selection on the same input
+	 * and compare the results.
+	 *
+	 * @param config	vehicle and parameter configuration
+	 * @param bits		status bits, a mask of (1 << NavStateBit)
+	 */
+	bool navStateMatches(const NavStateConfig &config, unsigned bits);
+
+	/**
+	 * Check every combination of the given status bits, the others stay cleared.
+	 */
+	bool navStateSweep(const NavStateConfig &config, const NavStateBit sweep_bits[], unsigned count);
 };
 
 bool StateMachineHelperTest::armingStateTransitionTest()
@@ -535,6 +588,726 @@ bool StateMachineHelperTest::mainStateTransitionTest()
 	return true;
 }
 
+// Reference implementation of main_state_transition() and set_nav_state() before they were made
+// table-driven. The tables must reproduce them for every combination of conditions.
+
+static constexpr const char reason_no_rc[] = "no RC";
+static constexpr const char reason_no_offboard[] = "no offboard";
+static constexpr const char reason_no_rc_and_no_offboard[] = "no RC and no offboard";
+static constexpr const char reason_no_datalink[] = "no datalink";
+
+static transition_result_t
+legacy_main_state_transition(const vehicle_status_s &status, const main_state_t new_main_state,
+			     const vehicle_status_flags_s &status_flags, commander_state_s *internal_state)
+{
+	transition_result_t ret = TRANSITION_DENIED;
+
+	/* transition may be denied even if the same state is requested because conditions may have changed */
+	switch (new_main_state) {
+	case commander_state_s::MAIN_STATE_MANUAL:
+	case commander_state_s::MAIN_STATE_STAB:
+	case commander_state_s::MAIN_STATE_ACRO:
+	case commander_state_s::MAIN_STATE_RATTITUDE:
+		ret = TRANSITION_CHANGED;
+		break;
+
+	case commander_state_s::MAIN_STATE_ALTCTL:
+
+		/* need at minimum altitude estimate */
+		if (status_flags.condition_local_altitude_valid ||
+		    status_flags.condition_global_position_valid) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_POSCTL:
+
+		/* need at minimum local position estimate */
+		if (status_flags.condition_local_position_valid ||
+		    status_flags.condition_global_position_valid) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_LOITER:
+
+		/* need global position estimate */
+		if (status_flags.condition_global_position_valid) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_FOLLOW_TARGET:
+	case commander_state_s::MAIN_STATE_ORBIT:
+
+		/* Follow and orbit only implemented for multicopter */
+		if (status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_MISSION:
+
+		/* need global position, home position, and a valid mission */
+		if (status_flags.condition_global_position_valid &&
+		    status_flags.condition_auto_mission_available) {
+
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_RTL:
+
+		/* need global position and home position */
+		if (status_flags.condition_global_position_valid && status_flags.condition_home_position_valid) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_TAKEOFF:
+	case commander_state_s::MAIN_STATE_AUTO_LAND:
+
+		/* need local position */
+		if (status_flags.condition_local_position_valid) {
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_PRECLAND:
+
+		/* need local and global position, and precision land only implemented for multicopters */
+		if (status_flags.condition_local_position_valid
+		    && status_flags.condition_global_position_valid
+		    && status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
+
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_OFFBOARD:
+
+		/* need offboard signal */
+		if (!status_flags.offboard_control_signal_lost) {
+
+			ret = TRANSITION_CHANGED;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_MAX:
+	default:
+		break;
+	}
+
+	if (ret == TRANSITION_CHANGED) {
+		if (internal_state->main_state != new_main_state) {
+			internal_state->main_state = new_main_state;
+			internal_state->timestamp = hrt_absolute_time();
+
+		} else {
+			ret = TRANSITION_NOT_CHANGED;
+		}
+	}
+
+	return ret;
+}
+
+static bool legacy_set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_state_s *internal_state,
+				 orb_advert_t *mavlink_log_pub, const link_loss_actions_t data_link_loss_act, const bool mission_finished,
+				 const bool stay_in_failsafe, const vehicle_status_flags_s &status_flags, bool landed,
+				 const link_loss_actions_t rc_loss_act, const offboard_loss_actions_t offb_loss_act,
+				 const offboard_loss_rc_actions_t offb_loss_rc_act,
+				 const position_nav_loss_actions_t posctl_nav_loss_act)
+{
+	navigation_state_t nav_state_old = status->nav_state;
+
+	const bool data_link_loss_act_configured = data_link_loss_act > link_loss_actions_t::DISABLED;
+	const bool rc_loss_act_configured = rc_loss_act > link_loss_actions_t::DISABLED;
+	const bool rc_lost = rc_loss_act_configured && (status->rc_signal_lost);
+
+	bool is_armed = (status->arming_state == vehicle_status_s::ARMING_STATE_ARMED);
+	bool old_failsafe = status->failsafe;
+	status->failsafe = false;
+
+	// Safe to do reset flags here, as if loss state persists flags will be restored in the code below
+	reset_link_loss_globals(armed, old_failsafe, rc_loss_act);
+	reset_link_loss_globals(armed, old_failsafe, data_link_loss_act);
+	reset_offboard_loss_globals(armed, old_failsafe, offb_loss_act, offb_loss_rc_act);
+
+	/* evaluate main state to decide in normal (non-failsafe) mode */
+	switch (internal_state->main_state) {
+	case commander_state_s::MAIN_STATE_ACRO:
+	case commander_state_s::MAIN_STATE_MANUAL:
+	case commander_state_s::MAIN_STATE_RATTITUDE:
+	case commander_state_s::MAIN_STATE_STAB:
+	case commander_state_s::MAIN_STATE_ALTCTL:
+
+		/* require RC for all manual modes */
+		if (rc_lost && is_armed) {
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
+
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+
+		} else {
+			switch (internal_state->main_state) {
+			case commander_state_s::MAIN_STATE_ACRO:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_ACRO;
+				break;
+
+			case commander_state_s::MAIN_STATE_MANUAL:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_MANUAL;
+				break;
+
+			case commander_state_s::MAIN_STATE_RATTITUDE:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_RATTITUDE;
+				break;
+
+			case commander_state_s::MAIN_STATE_STAB:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_STAB;
+				break;
+
+			case commander_state_s::MAIN_STATE_ALTCTL:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_ALTCTL;
+				break;
+
+			default:
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_MANUAL;
+				break;
+			}
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_POSCTL: {
+
+			if (rc_lost && is_armed) {
+				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
+
+				set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+							vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+
+				/* As long as there is RC, we can fallback to ALTCTL, or STAB. */
+				/* A local position estimate is enough for POSCTL for multirotors,
+				 * this enables POSCTL using e.g. flow.
+				 * For fixedwing, a global position is needed. */
+
+			} else if (is_armed
+				   && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags,
+						   !(posctl_nav_loss_act == position_nav_loss_actions_t::LAND_TERMINATE),
+						   status->vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING)) {
+				// nothing to do - everything done in check_invalid_pos_nav_state
+
+			} else {
+				status->nav_state = vehicle_status_s::NAVIGATION_STATE_POSCTL;
+			}
+		}
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_MISSION:
+
+		/* go into failsafe
+		 * - if commanded to do so
+		 * - if we have an engine failure
+		 * - if we have vtol transition failure
+		 * - depending on datalink, RC and if the mission is finished */
+
+		if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+		} else if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (status_flags.vtol_transition_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+
+		} else if (status->mission_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+
+		} else if (data_link_loss_act_configured && status->data_link_lost && is_armed) {
+			/* datalink loss enabled:
+			 * check for datalink lost: this should always trigger RTGS */
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
+
+		} else if (!data_link_loss_act_configured && status->rc_signal_lost && status->data_link_lost && !landed
+			   && mission_finished && is_armed) {
+			/* datalink loss DISABLED:
+			 * check if both, RC and datalink are lost during the mission
+			 * or all links are lost after the mission finishes in air: this should always trigger RCRECOVER */
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+
+		} else if (!stay_in_failsafe) {
+			/* stay where you are if you should stay in failsafe, otherwise everything is perfect */
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_LOITER:
+
+		/* go into failsafe on a engine failure */
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+		} else if (status->data_link_lost && data_link_loss_act_configured && !landed && is_armed) {
+			/* also go into failsafe if just datalink is lost, and we're actually in air */
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
+
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+
+		} else if (rc_lost && !data_link_loss_act_configured && is_armed) {
+			/* go into failsafe if RC is lost and datalink loss is not set up and rc loss is not DISABLED */
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
+
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+
+		} else if (status->rc_signal_lost) {
+			/* don't bother if RC is lost if datalink is connected */
+
+			/* this mode is ok, we don't need RC for LOITERing */
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER;
+
+		} else {
+			/* everything is perfect */
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_RTL:
+
+		/* require global position and home, also go into failsafe on an engine failure */
+
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_FOLLOW_TARGET:
+
+		/* require global position and home */
+
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_ORBIT:
+		if (status->engine_failure) {
+			// failsafe: on engine failure
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+			// Orbit can only be started via vehicle_command (mavlink). Recovery from failsafe into orbit
+			// is not possible and therefore the internal_state needs to be adjusted.
+			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
+			// failsafe: necessary position estimate lost; switching is done in check_invalid_pos_nav_state
+
+			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
+			// is not possible and therefore the internal_state needs to be adjusted.
+			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
+
+		} else if (status->data_link_lost && data_link_loss_act_configured && !landed && is_armed) {
+			// failsafe: just datalink is lost and we're in air
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
+
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+
+			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
+			// is not possible and therefore the internal_state needs to be adjusted.
+			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
+
+		} else if (rc_lost && !data_link_loss_act_configured && is_armed) {
+			// failsafe: RC is lost, datalink loss is not set up and rc loss is not disabled
+			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
+
+			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+
+			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
+			// is not possible and therefore the internal_state needs to be adjusted.
+			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
+
+		} else {
+			// no failsafe, RC is not mandatory for orbit
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_ORBIT;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_TAKEOFF:
+
+		/* require local position */
+
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_LAND:
+
+		/* require local position */
+
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LAND;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_AUTO_PRECLAND:
+
+		/* must be rotary wing plus same requirements as normal landing */
+
+		if (status->engine_failure) {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
+
+		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
+			// nothing to do - everything done in check_invalid_pos_nav_state
+
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND;
+		}
+
+		break;
+
+	case commander_state_s::MAIN_STATE_OFFBOARD:
+
+		/* require offboard control, otherwise stay where you are */
+		if (status_flags.offboard_control_signal_lost && status_flags.offboard_control_loss_timeout) {
+			if (status->rc_signal_lost) {
+				// Offboard and RC are lost
+				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc_and_no_offboard);
+				set_offboard_loss_nav_state(status, armed, status_flags, offb_loss_act);
+
+			} else {
+				// Offboard is lost, RC is ok
+				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_offboard);
+				set_offboard_loss_rc_nav_state(status, armed, status_flags, offb_loss_rc_act);
+			}
+
+		} else {
+			status->nav_state = vehicle_status_s::NAVIGATION_STATE_OFFBOARD;
+		}
+
+	default:
+		break;
+	}
+
+	return status->nav_state != nav_state_old;
+}
+
+
+bool StateMachineHelperTest::mainStateTransitionTableTest()
+{
+	static constexpr uint8_t vehicle_types[] = {
+		vehicle_status_s::VEHICLE_TYPE_ROTARY_WING,
+		vehicle_status_s::VEHICLE_TYPE_FIXED_WING,
+		vehicle_status_s::VEHICLE_TYPE_ROVER,
+	};
+
+	for (uint8_t vehicle_type : vehicle_types) {
+		for (unsigned bits = 0; bits < (1 << 7); bits++) {
+			struct vehicle_status_s status = {};
+			struct vehicle_status_flags_s status_flags = {};
+
+			status.vehicle_type = vehicle_type;
+			status_flags.condition_local_altitude_valid = bits & (1 << 0);
+			status_flags.condition_local_position_valid = bits & (1 << 1);
+			status_flags.condition_local_velocity_valid = bits & (1 << 2);
+			status_flags.condition_global_position_valid = bits & (1 << 3);
+			status_flags.condition_home_position_valid = bits & (1 << 4);
+			status_flags.condition_auto_mission_available = bits & (1 << 5);
+			status_flags.offboard_control_signal_lost = bits & (1 << 6);
+
+			const uint32_t conditions = transition_conditions(status, status_flags);
+
+			// include MAIN_STATE_MAX as invalid state
+			for (uint8_t from = 0; from <= commander_state_s::MAIN_STATE_MAX; from++) {
+				for (uint8_t to = 0; to <= commander_state_s::MAIN_STATE_MAX; to++) {
+					struct commander_state_s expected = {};
+					struct commander_state_s actual = {};
+					expected.main_state = from;
+					actual.main_state = from;
+
+					const transition_result_t expected_result = legacy_main_state_transition(status, to, status_flags, &expected);
+					const transition_result_t result = main_state_transition(to, conditions, &actual);
+
+					if (result != expected_result || actual.main_state != expected.main_state) {
+						PX4_ERR("main state %d -> %d, vehicle type %d, conditions 0x%x: %d (expected %d)",
+							from, to, vehicle_type, bits, result, expected_result);
+					}
+
+					ut_compare("main state transition result", result, expected_result);
+					ut_compare("main state", actual.main_state, expected.main_state);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool StateMachineHelperTest::navStateMatches(const NavStateConfig &config, unsigned bits)
+{
+	struct vehicle_status_s status = {};
+	struct vehicle_status_flags_s status_flags = {};
+
+	status.vehicle_type = config.vehicle_type;
+	status.is_vtol = config.is_vtol;
+	status.nav_state = vehicle_status_s::NAVIGATION_STATE_MAX;
+	status.failsafe = true;	// already in failsafe, avoids a log message per failsafe case
+	status.arming_state = (bits & (1 << NAV_ARMED)) ? vehicle_status_s::ARMING_STATE_ARMED :
+			      vehicle_status_s::ARMING_STATE_STANDBY;
+	status.rc_signal_lost = bits & (1 << NAV_RC_SIGNAL_LOST);
+	status.data_link_lost = bits & (1 << NAV_DATA_LINK_LOST);
+	status.engine_failure = bits & (1 << NAV_ENGINE_FAILURE);
+	status.mission_failure = bits & (1 << NAV_MISSION_FAILURE);
+	status_flags.vtol_transition_failure = bits & (1 << NAV_VTOL_TRANSITION_FAILURE);
+	status_flags.offboard_control_signal_lost = bits & (1 << NAV_OFFBOARD_SIGNAL_LOST);
+	status_flags.offboard_control_loss_timeout = bits & (1 << NAV_OFFBOARD_LOSS_TIMEOUT);
+	status_flags.condition_local_altitude_valid = bits & (1 << NAV_LOCAL_ALTITUDE_VALID);
+	status_flags.condition_local_position_valid = bits & (1 << NAV_LOCAL_POSITION_VALID);
+	status_flags.condition_local_velocity_valid = bits & (1 << NAV_LOCAL_VELOCITY_VALID);
+	status_flags.condition_global_position_valid = bits & (1 << NAV_GLOBAL_POSITION_VALID);
+	status_flags.condition_home_position_valid = bits & (1 << NAV_HOME_POSITION_VALID);
+	const bool landed = bits & (1 << NAV_LANDED);
+	const bool mission_finished = bits & (1 << NAV_MISSION_FINISHED);
+	const bool stay_in_failsafe = bits & (1 << NAV_STAY_IN_FAILSAFE);
+
+	struct vehicle_status_s expected_status = status;
+	struct actuator_armed_s expected_armed = {};
+	struct commander_state_s expected_state = {};
+	expected_state.main_state = config.main_state;
+
+	struct actuator_armed_s armed = {};
+	struct commander_state_s internal_state = {};
+	internal_state.main_state = config.main_state;
+
+	const bool expected_changed = legacy_set_nav_state(&expected_status, &expected_armed, &expected_state, nullptr,
+				      config.data_link_loss_act, mission_finished, stay_in_failsafe, status_flags, landed, config.rc_loss_act,
+				      config.offb_loss_act, config.offb_loss_rc_act, config.posctl_nav_loss_act);
+
+	const uint32_t conditions = nav_state_conditions(status, status_flags, config.data_link_loss_act, config.rc_loss_act,
+				    config.posctl_nav_loss_act, mission_finished, stay_in_failsafe, landed);
+
+	const bool changed = set_nav_state(&status, &armed, &internal_state, nullptr, conditions, status_flags,
+					   config.data_link_loss_act, config.rc_loss_act, config.offb_loss_act, config.offb_loss_rc_act);
+
+	if (status.nav_state != expected_status.nav_state || status.failsafe != expected_status.failsafe
+	    || internal_state.main_state != expected_state.main_state) {
+		PX4_ERR("main state %d, vehicle type %d%s, dll %d, rcl %d, offbl %d, offbrcl %d, posctl %d, bits 0x%x: nav state %d (expected %d)",
+			config.main_state, config.vehicle_type, config.is_vtol ? " (vtol)" : "", (int)config.data_link_loss_act,
+			(int)config.rc_loss_act, (int)config.offb_loss_act, (int)config.offb_loss_rc_act, (int)config.posctl_nav_loss_act,
+			bits, status.nav_state, expected_status.nav_state);
+	}
+
+	ut_compare("nav state changed", changed, expected_changed);
+	ut_compare("nav state", status.nav_state, expected_status.nav_state);
+	ut_compare("failsafe", status.failsafe, expected_status.failsafe);
+	ut_compare("main state", internal_state.main_state, expected_state.main_state);
+	ut_compare("force failsafe", armed.force_failsafe, expected_armed.force_failsafe);
+	ut_compare("lockdown", armed.lockdown, expected_armed.lockdown);
+
+	return true;
+}
+
+bool StateMachineHelperTest::navStateSweep(const NavStateConfig &config, const NavStateBit sweep_bits[], unsigned count)
+{
+	for (unsigned i = 0; i < (1u << count); i++) {
+		unsigned bits = 0;
+
+		for (unsigned b = 0; b < count; b++) {
+			if (i & (1 << b)) {
+				bits |= 1 << sweep_bits[b];
+			}
+		}
+
+		if (!navStateMatches(config, bits)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool StateMachineHelperTest::navStateTableTest()
+{
+	static constexpr link_loss_actions_t link_loss_acts[] = {
+		link_loss_actions_t::DISABLED,
+		link_loss_actions_t::AUTO_LOITER,
+		link_loss_actions_t::AUTO_RTL,
+		link_loss_actions_t::AUTO_LAND,
+		link_loss_actions_t::AUTO_RECOVER,
+		link_loss_actions_t::TERMINATE,
+		link_loss_actions_t::LOCKDOWN,
+	};
+
+	static constexpr offboard_loss_actions_t offb_loss_acts[] = {
+		offboard_loss_actions_t::DISABLED,
+		offboard_loss_actions_t::AUTO_LAND,
+		offboard_loss_actions_t::AUTO_LOITER,
+		offboard_loss_actions_t::AUTO_RTL,
+		offboard_loss_actions_t::TERMINATE,
+		offboard_loss_actions_t::LOCKDOWN,
+	};
+
+	static constexpr offboard_loss_rc_actions_t offb_loss_rc_acts[] = {
+		offboard_loss_rc_actions_t::DISABLED,
+		offboard_loss_rc_actions_t::MANUAL_POSITION,
+		offboard_loss_rc_actions_t::MANUAL_ALTITUDE,
+		offboard_loss_rc_actions_t::MANUAL_ATTITUDE,
+		offboard_loss_rc_actions_t::AUTO_RTL,
+		offboard_loss_rc_actions_t::AUTO_LAND,
+		offboard_loss_rc_actions_t::AUTO_LOITER,
+		offboard_loss_rc_actions_t::TERMINATE,
+		offboard_loss_rc_actions_t::LOCKDOWN,
+	};
+
+	// RC loss action together with the offboard loss actions
+	static constexpr link_loss_actions_t offboard_rc_loss_acts[] = {
+		link_loss_actions_t::DISABLED,
+		link_loss_actions_t::AUTO_RTL,
+	};
+
+	static constexpr position_nav_loss_actions_t posctl_nav_loss_acts[] = {
+		position_nav_loss_actions_t::ALTITUDE_MANUAL,
+		position_nav_loss_actions_t::LAND_TERMINATE,
+	};
+
+	static constexpr struct {
+		uint8_t type;
+		bool is_vtol;
+	} vehicles[] = {
+		{vehicle_status_s::VEHICLE_TYPE_ROTARY_WING, false},
+		{vehicle_status_s::VEHICLE_TYPE_FIXED_WING, false},
+		{vehicle_status_s::VEHICLE_TYPE_ROVER, false},
+		{vehicle_status_s::VEHICLE_TYPE_ROTARY_WING, true},
+		{vehicle_status_s::VEHICLE_TYPE_FIXED_WING, true},
+	};
+
+	// The full cross product of actions and status bits is too large to run, so there are three sweeps:
+	// every status bit with the failsafe actions disabled and configured, every link loss action
+	// combination and every offboard loss action combination with the status bits they depend on.
+	static constexpr NavStateBit all_bits[] = {
+		NAV_ARMED, NAV_RC_SIGNAL_LOST, NAV_DATA_LINK_LOST, NAV_ENGINE_FAILURE, NAV_MISSION_FAILURE,
+		NAV_VTOL_TRANSITION_FAILURE, NAV_OFFBOARD_SIGNAL_LOST, NAV_OFFBOARD_LOSS_TIMEOUT,
+		NAV_LOCAL_ALTITUDE_VALID, NAV_LOCAL_POSITION_VALID, NAV_LOCAL_VELOCITY_VALID,
+		NAV_GLOBAL_POSITION_VALID, NAV_HOME_POSITION_VALID, NAV_LANDED, NAV_MISSION_FINISHED, NAV_STAY_IN_FAILSAFE,
+	};
+	static_assert(sizeof(all_bits) / sizeof(all_bits[0]) == NAV_BIT_COUNT, "all status bits");
+
+	static constexpr NavStateBit link_loss_bits[] = {
+		NAV_ARMED, NAV_RC_SIGNAL_LOST, NAV_DATA_LINK_LOST, NAV_LOCAL_ALTITUDE_VALID, NAV_LOCAL_POSITION_VALID,
+		NAV_GLOBAL_POSITION_VALID, NAV_HOME_POSITION_VALID, NAV_LANDED, NAV_STAY_IN_FAILSAFE,
+	};
+
+	static constexpr NavStateBit offboard_loss_bits[] = {
+		NAV_ARMED, NAV_RC_SIGNAL_LOST, NAV_OFFBOARD_SIGNAL_LOST, NAV_OFFBOARD_LOSS_TIMEOUT, NAV_LOCAL_ALTITUDE_VALID,
+		NAV_LOCAL_POSITION_VALID, NAV_LOCAL_VELOCITY_VALID, NAV_GLOBAL_POSITION_VALID, NAV_HOME_POSITION_VALID, NAV_LANDED,
+	};
+
+	for (uint8_t main_state = 0; main_state <= commander_state_s::MAIN_STATE_MAX; main_state++) {
+		for (const auto &vehicle : vehicles) {
+			for (position_nav_loss_actions_t posctl_nav_loss_act : posctl_nav_loss_acts) {
+				NavStateConfig config{main_state, vehicle.type, vehicle.is_vtol,
+						      link_loss_actions_t::DISABLED, link_loss_actions_t::DISABLED,
+						      offboard_loss_actions_t::DISABLED, offboard_loss_rc_actions_t::DISABLED,
+						      posctl_nav_loss_act};
+
+				// all status bits, failsafe actions disabled
+				if (!navStateSweep(config, all_bits, NAV_BIT_COUNT)) {
+					return false;
+				}
+
+				// all status bits, distinct failsafe actions configured
+				config.data_link_loss_act = link_loss_actions_t::AUTO_RTL;
+				config.rc_loss_act = link_loss_actions_t::AUTO_LOITER;
+				config.offb_loss_act = offboard_loss_actions_t::AUTO_LAND;
+				config.offb_loss_rc_act = offboard_loss_rc_actions_t::MANUAL_POSITION;
+
+				if (!navStateSweep(config, all_bits, NAV_BIT_COUNT)) {
+					return false;
+				}
+
+				// every link loss action combination
+				for (link_loss_actions_t data_link_loss_act : link_loss_acts) {
+					for (link_loss_actions_t rc_loss_act : link_loss_acts) {
+						config.data_link_loss_act = data_link_loss_act;
+						config.rc_loss_act = rc_loss_act;
+
+						if (!navStateSweep(config, link_loss_bits, sizeof(link_loss_bits) / sizeof(link_loss_bits[0]))) {
+							return false;
+						}
+					}
+				}
+
+				// every offboard loss action combination, with and without RC loss action
+				for (link_loss_actions_t rc_loss_act : offboard_rc_loss_acts) {
+					for (offboard_loss_actions_t offb_loss_act : offb_loss_acts) {
+						for (offboard_loss_rc_actions_t offb_loss_rc_act : offb_loss_rc_acts) {
+							config.data_link_loss_act = link_loss_actions_t::DISABLED;
+							config.rc_loss_act = rc_loss_act;
+							config.offb_loss_act = offb_loss_act;
+							config.offb_loss_rc_act = offb_loss_rc_act;
+
+							if (!navStateSweep(config, offboard_loss_bits, sizeof(offboard_loss_bits) / sizeof(offboard_loss_bits[0]))) {
+								return false;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
 bool StateMachineHelperTest::isSafeTest()
 {
 	struct safety_s safety = {};
@@ -577,6 +1350,8 @@ bool StateMachineHelperTest::run_tests()
 {
 	ut_run_test(armingStateTransitionTest);
 	ut_run_test(mainStateTransitionTest);
+	ut_run_test(mainStateTransitionTableTest);
+	ut_run_test(navStateTableTest);
 	ut_run_test(isSafeTest);
 
 	return (_tests_failed == 0);
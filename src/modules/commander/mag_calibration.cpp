@@ -93,6 +93,7 @@ typedef struct  {
 	float		*x[max_mags];
 	float		*y[max_mags];
 	float		*z[max_mags];
+	sphere_fit_sums_s	sphere_sums[max_mags];	///< Running sums of the accepted samples
 } mag_worker_data_t;
 
 
@@ -486,6 +487,14 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 				}
 
 			} else {
+				for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
+					if (worker_data->sub_mag[cur_mag] >= 0) {
+						const unsigned i = prev_count[cur_mag];
+						sphere_fit_add_sample(worker_data->sphere_sums[cur_mag],
+								      worker_data->x[cur_mag][i], worker_data->y[cur_mag][i], worker_data->z[cur_mag][i]);
+					}
+				}
+
 				calibration_counter_side++;
 
 				unsigned new_progress = progress_percentage(worker_data) +
@@ -572,6 +581,7 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 		worker_data.y[cur_mag] = nullptr;
 		worker_data.z[cur_mag] = nullptr;
 		worker_data.calibration_counter_total[cur_mag] = 0;
+		worker_data.sphere_sums[cur_mag] = sphere_fit_sums_s{};
 	}
 
 	const unsigned int calibration_points_maxcount = calibration_sides * worker_data.calibration_points_perside;
@@ -726,9 +736,32 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 			if (device_ids[cur_mag] != 0) {
 				// Mag in this slot is available and we should have values for it to calibrate
 
+				// The sphere was accumulated while collecting, start the refinement from there
+				float center_x = 0.0f;
+				float center_y = 0.0f;
+				float center_z = 0.0f;
+				float radius = 0.0f;
+
+				if (sphere_fit_least_squares(worker_data.sphere_sums[cur_mag], 100, 0.0f,
+							     &center_x, &center_y, &center_z, &radius) == 0
+				    && PX4_ISFINITE(center_x) && PX4_ISFINITE(center_y) && PX4_ISFINITE(center_z)
+				    && PX4_ISFINITE(radius) && radius > 0.0f) {
+					sphere_x[cur_mag] = center_x;
+					sphere_y[cur_mag] = center_y;
+					sphere_z[cur_mag] = center_z;
+					sphere_radius[cur_mag] = radius;
+				}
+
+				// Refine on an evenly distributed subset, the raw buffers are no longer needed and get overwritten
+				const unsigned binned_count = calibration_bin_samples(worker_data.x[cur_mag], worker_data.y[cur_mag],
+							      worker_data.z[cur_mag], worker_data.calibration_counter_total[cur_mag],
+							      sphere_x[cur_mag], sphere_y[cur_mag], sphere_z[cur_mag],
+							      worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag]);
+				worker_data.calibration_counter_total[cur_mag] = binned_count;
+
 				ellipsoid_fit_least_squares(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-							    worker_data.calibration_counter_total[cur_mag],
-							    100, 0.0f,
+							    binned_count,
+							    100, 1e-6f,
 							    &sphere_x[cur_mag], &sphere_y[cur_mag], &sphere_z[cur_mag],
 							    &sphere_radius[cur_mag],
 							    &diag_x[cur_mag], &diag_y[cur_mag], &diag_z[cur_mag],
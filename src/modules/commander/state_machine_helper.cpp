@@ -85,25 +85,177 @@ const char *const arming_state_names[vehicle_status_s::ARMING_STATE_MAX] = {
 	"IN_AIR_RESTORE",
 };
 
-static hrt_abstime last_preflight_check = 0;	///< initialize so it gets checked immediately
+// Requirements for a main state transition, indexed by the requested main state. The transition is
+// possible if all conditions of all_of and, unless it is empty, at least one condition of any_of hold.
+// The current main state only decides between TRANSITION_CHANGED and TRANSITION_NOT_CHANGED.
+struct main_state_requirement_t {
+	uint32_t all_of;
+	uint32_t any_of;
+};
 
-void set_link_loss_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
-			     const vehicle_status_flags_s &status_flags, commander_state_s *internal_state, const link_loss_actions_t link_loss_act,
-			     uint8_t auto_recovery_nav_state);
+static constexpr const main_state_requirement_t main_state_requirements[commander_state_s::MAIN_STATE_MAX] = {
+	/* MAIN_STATE_MANUAL */             { 0, 0 },
+	/* MAIN_STATE_ALTCTL */             { 0, COND_LOCAL_ALTITUDE_VALID | COND_GLOBAL_POSITION_VALID },
+	/* MAIN_STATE_POSCTL */             { 0, COND_LOCAL_POSITION_VALID | COND_GLOBAL_POSITION_VALID },
+	/* MAIN_STATE_AUTO_MISSION */       { COND_GLOBAL_POSITION_VALID | COND_MISSION_AVAILABLE, 0 },
+	/* MAIN_STATE_AUTO_LOITER */        { COND_GLOBAL_POSITION_VALID, 0 },
+	/* MAIN_STATE_AUTO_RTL */           { COND_GLOBAL_POSITION_VALID | COND_HOME_POSITION_VALID, 0 },
+	/* MAIN_STATE_ACRO */               { 0, 0 },
+	/* MAIN_STATE_OFFBOARD */           { COND_OFFBOARD_SIGNAL_VALID, 0 },
+	/* MAIN_STATE_STAB */               { 0, 0 },
+	/* MAIN_STATE_RATTITUDE */          { 0, 0 },
+	/* MAIN_STATE_AUTO_TAKEOFF */       { COND_LOCAL_POSITION_VALID, 0 },
+	/* MAIN_STATE_AUTO_LAND */          { COND_LOCAL_POSITION_VALID, 0 },
+	/* MAIN_STATE_AUTO_FOLLOW_TARGET */ { COND_ROTARY_WING, 0 },	// only implemented for multicopter
+	/* MAIN_STATE_AUTO_PRECLAND */      { COND_LOCAL_POSITION_VALID | COND_GLOBAL_POSITION_VALID | COND_ROTARY_WING, 0 },
+	/* MAIN_STATE_ORBIT */              { COND_ROTARY_WING, 0 },	// only implemented for multicopter
+};
 
-void reset_link_loss_globals(actuator_armed_s *armed, const bool old_failsafe, const link_loss_actions_t link_loss_act);
+// What set_nav_state() does once a rule matched
+enum class nav_state_action_t : uint8_t {
+	KEEP,			// leave the navigation state as it is
+	SET,			// switch to the navigation state of the rule
+	RC_LOSS,		// failsafe "no RC", RC loss action with RC recovery
+	DATA_LINK_LOSS,		// failsafe "no datalink", data link loss action with return to ground station
+	ALL_LINKS_LOSS,		// failsafe "no datalink", RC loss action with RC recovery
+	POSITION_LOSS,		// position fallback, see check_invalid_pos_nav_state()
+	OFFBOARD_LOSS,		// failsafe "no RC and no offboard", offboard loss action
+	OFFBOARD_RC_LOSS,	// failsafe "no offboard", offboard loss action with RC
+};
 
-void set_offboard_loss_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
-				 const vehicle_status_flags_s &status_flags,
-				 const offboard_loss_actions_t offboard_loss_act);
+// Rule options
+static constexpr uint8_t RULE_USE_RC = (1 << 0);	// POSITION_LOSS: fall back to a mode with stick control
+static constexpr uint8_t RULE_GLOBAL_POS = (1 << 1);	// POSITION_LOSS: the mode requires a global position
+static constexpr uint8_t RULE_EXIT_ORBIT = (1 << 2);	// leave the main state to POSCTL, orbit cannot be recovered into
+
+// A rule applies if all conditions of set hold and none of clear. The rules of a main state are
+// evaluated in order and the first matching one is applied, the last rule always matches.
+struct nav_state_rule_t {
+	uint32_t set;
+	uint32_t clear;
+	nav_state_action_t action;
+	uint8_t nav_state;
+	uint8_t options;
+};
 
-void set_offboard_loss_rc_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
-				    const vehicle_status_flags_s &status_flags,
-				    const offboard_loss_rc_actions_t offboard_loss_rc_act);
+static constexpr int NAV_STATE_RULES_MAX = 8;
 
-void reset_offboard_loss_globals(actuator_armed_s *armed, const bool old_failsafe,
-				 const offboard_loss_actions_t offboard_loss_act,
-				 const offboard_loss_rc_actions_t offboard_loss_rc_act);
+static constexpr nav_state_rule_t nav_state_keep = { 0, 0, nav_state_action_t::KEEP, 0, 0 };
+
+static constexpr nav_state_rule_t nav_state_set(uint8_t nav_state)
+{
+	return { 0, 0, nav_state_action_t::SET, nav_state, 0 };
+}
+
+// engine failure: land
+static constexpr nav_state_rule_t nav_state_engine_failure = { COND_ENGINE_FAILURE, 0, nav_state_action_t::SET, vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL, 0 };
+
+// RC required for all manual modes
+static constexpr nav_state_rule_t nav_state_rc_loss = { COND_ARMED | COND_RC_LOSS_FAILSAFE, 0, nav_state_action_t::RC_LOSS, 0, 0 };
+
+// navigation modes requiring a global position or a local position and velocity estimate
+static constexpr nav_state_rule_t nav_state_global_pos_loss = { COND_ARMED, COND_GLOBAL_POSITION_VALID, nav_state_action_t::POSITION_LOSS, 0, RULE_GLOBAL_POS };
+static constexpr nav_state_rule_t nav_state_local_pos_loss = { COND_ARMED, COND_LOCAL_NAV_VALID, nav_state_action_t::POSITION_LOSS, 0, 0 };
+
+// This array defines the navigation state rules for each main state, see set_nav_state()
+static constexpr const nav_state_rule_t nav_state_rules[commander_state_s::MAIN_STATE_MAX][NAV_STATE_RULES_MAX] = {
+	/* MAIN_STATE_MANUAL */ {
+		nav_state_rc_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_MANUAL),
+	},
+	/* MAIN_STATE_ALTCTL */ {
+		nav_state_rc_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_ALTCTL),
+	},
+	/* MAIN_STATE_POSCTL */ {
+		nav_state_rc_loss,
+		// A local position estimate is enough for POSCTL for multirotors, this enables POSCTL using e.g. flow.
+		// For fixedwing, a global position is needed. As long as there is RC, we can fallback to ALTCTL, or STAB.
+		{ COND_ARMED | COND_FIXED_WING | COND_POSCTL_NAV_LOSS_RC, COND_GLOBAL_POSITION_VALID, nav_state_action_t::POSITION_LOSS, 0, RULE_GLOBAL_POS | RULE_USE_RC },
+		{ COND_ARMED | COND_FIXED_WING, COND_GLOBAL_POSITION_VALID | COND_POSCTL_NAV_LOSS_RC, nav_state_action_t::POSITION_LOSS, 0, RULE_GLOBAL_POS },
+		{ COND_ARMED | COND_POSCTL_NAV_LOSS_RC, COND_FIXED_WING | COND_LOCAL_NAV_VALID, nav_state_action_t::POSITION_LOSS, 0, RULE_USE_RC },
+		{ COND_ARMED, COND_FIXED_WING | COND_LOCAL_NAV_VALID | COND_POSCTL_NAV_LOSS_RC, nav_state_action_t::POSITION_LOSS, 0, 0 },
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_POSCTL),
+	},
+	/* MAIN_STATE_AUTO_MISSION */ {
+		nav_state_global_pos_loss,
+		nav_state_engine_failure,
+		{ COND_VTOL_TRANSITION_FAILURE, 0, nav_state_action_t::SET, vehicle_status_s::NAVIGATION_STATE_AUTO_RTL, 0 },
+		{ COND_MISSION_FAILURE, 0, nav_state_action_t::SET, vehicle_status_s::NAVIGATION_STATE_AUTO_RTL, 0 },
+		// datalink loss enabled: datalink lost should always trigger RTGS
+		{ COND_ARMED | COND_DATA_LINK_LOST | COND_DATA_LINK_LOSS_ACT, 0, nav_state_action_t::DATA_LINK_LOSS, 0, 0 },
+		// datalink loss disabled: all links lost after the mission finished in air should trigger RCRECOVER
+		{ COND_ARMED | COND_RC_SIGNAL_LOST | COND_DATA_LINK_LOST | COND_MISSION_FINISHED, COND_DATA_LINK_LOSS_ACT | COND_LANDED, nav_state_action_t::ALL_LINKS_LOSS, 0, 0 },
+		{ 0, COND_STAY_IN_FAILSAFE, nav_state_action_t::SET, vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION, 0 },
+		nav_state_keep,
+	},
+	/* MAIN_STATE_AUTO_LOITER */ {
+		nav_state_engine_failure,
+		nav_state_global_pos_loss,
+		// datalink lost while in air
+		{ COND_ARMED | COND_DATA_LINK_LOST | COND_DATA_LINK_LOSS_ACT, COND_LANDED, nav_state_action_t::DATA_LINK_LOSS, 0, 0 },
+		// RC lost and datalink loss not set up, RC is not required while the datalink is configured
+		{ COND_ARMED | COND_RC_LOSS_FAILSAFE, COND_DATA_LINK_LOSS_ACT, nav_state_action_t::RC_LOSS, 0, 0 },
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER),
+	},
+	/* MAIN_STATE_AUTO_RTL */ {
+		nav_state_engine_failure,
+		nav_state_global_pos_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_RTL),
+	},
+	/* MAIN_STATE_ACRO */ {
+		nav_state_rc_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_ACRO),
+	},
+	/* MAIN_STATE_OFFBOARD */ {
+		// offboard control required, otherwise apply the offboard loss action depending on RC
+		{ COND_OFFBOARD_LOST | COND_RC_SIGNAL_LOST, 0, nav_state_action_t::OFFBOARD_LOSS, 0, 0 },
+		{ COND_OFFBOARD_LOST, 0, nav_state_action_t::OFFBOARD_RC_LOSS, 0, 0 },
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_OFFBOARD),
+	},
+	/* MAIN_STATE_STAB */ {
+		nav_state_rc_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_STAB),
+	},
+	/* MAIN_STATE_RATTITUDE */ {
+		nav_state_rc_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_RATTITUDE),
+	},
+	/* MAIN_STATE_AUTO_TAKEOFF */ {
+		nav_state_engine_failure,
+		nav_state_local_pos_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF),
+	},
+	/* MAIN_STATE_AUTO_LAND */ {
+		nav_state_engine_failure,
+		nav_state_local_pos_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_LAND),
+	},
+	/* MAIN_STATE_AUTO_FOLLOW_TARGET */ {
+		nav_state_engine_failure,
+		nav_state_global_pos_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET),
+	},
+	/* MAIN_STATE_AUTO_PRECLAND */ {
+		nav_state_engine_failure,
+		nav_state_local_pos_loss,
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND),
+	},
+	/* MAIN_STATE_ORBIT */ {
+		// Orbit can only be started via vehicle_command (mavlink). Recovery from failsafe into orbit
+		// is not possible and therefore all failsafes leave the main state to POSCTL.
+		{ COND_ENGINE_FAILURE, 0, nav_state_action_t::SET, vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL, RULE_EXIT_ORBIT },
+		{ COND_ARMED, COND_GLOBAL_POSITION_VALID, nav_state_action_t::POSITION_LOSS, 0, RULE_GLOBAL_POS | RULE_EXIT_ORBIT },
+		{ COND_ARMED | COND_DATA_LINK_LOST | COND_DATA_LINK_LOSS_ACT, COND_LANDED, nav_state_action_t::DATA_LINK_LOSS, 0, RULE_EXIT_ORBIT },
+		{ COND_ARMED | COND_RC_LOSS_FAILSAFE, COND_DATA_LINK_LOSS_ACT, nav_state_action_t::RC_LOSS, 0, RULE_EXIT_ORBIT },
+		// no failsafe, RC is not mandatory for orbit
+		nav_state_set(vehicle_status_s::NAVIGATION_STATE_ORBIT),
+	},
+};
+
+static_assert(commander_state_s::MAIN_STATE_MAX == 15, "update main_state_requirements and nav_state_rules");
+
+static hrt_abstime last_preflight_check = 0;	///< initialize so it gets checked immediately
 
 transition_result_t arming_state_transition(vehicle_status_s *status, const safety_s &safety,
 		const arming_state_t new_arming_state, actuator_armed_s *armed, const bool fRunPreArmChecks,
@@ -257,120 +409,93 @@ bool is_safe(const safety_s &safety, const actuator_armed_s &armed)
 	return !armed.armed || (armed.armed && lockdown) || (safety.safety_switch_available && !safety.safety_off);
 }
 
-transition_result_t
-main_state_transition(const vehicle_status_s &status, const main_state_t new_main_state,
-		      const vehicle_status_flags_s &status_flags, commander_state_s *internal_state)
+uint32_t transition_conditions(const vehicle_status_s &status, const vehicle_status_flags_s &status_flags)
 {
-	// IMPORTANT: The assumption of callers of this function is that the execution of
-	// this check is essentially "free". Therefore any runtime checking in here has to be
-	// kept super lightweight. No complex logic or calls on external function should be
-	// implemented here.
+	uint32_t conditions = 0;
 
-	transition_result_t ret = TRANSITION_DENIED;
+	if (status_flags.condition_local_altitude_valid) { conditions |= COND_LOCAL_ALTITUDE_VALID; }
 
-	/* transition may be denied even if the same state is requested because conditions may have changed */
-	switch (new_main_state) {
-	case commander_state_s::MAIN_STATE_MANUAL:
-	case commander_state_s::MAIN_STATE_STAB:
-	case commander_state_s::MAIN_STATE_ACRO:
-	case commander_state_s::MAIN_STATE_RATTITUDE:
-		ret = TRANSITION_CHANGED;
-		break;
+	if (status_flags.condition_local_position_valid) { conditions |= COND_LOCAL_POSITION_VALID; }
 
-	case commander_state_s::MAIN_STATE_ALTCTL:
+	if (status_flags.condition_local_position_valid && status_flags.condition_local_velocity_valid) { conditions |= COND_LOCAL_NAV_VALID; }
 
-		/* need at minimum altitude estimate */
-		if (status_flags.condition_local_altitude_valid ||
-		    status_flags.condition_global_position_valid) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (status_flags.condition_global_position_valid) { conditions |= COND_GLOBAL_POSITION_VALID; }
 
-		break;
+	if (status_flags.condition_home_position_valid) { conditions |= COND_HOME_POSITION_VALID; }
 
-	case commander_state_s::MAIN_STATE_POSCTL:
+	if (status_flags.condition_auto_mission_available) { conditions |= COND_MISSION_AVAILABLE; }
 
-		/* need at minimum local position estimate */
-		if (status_flags.condition_local_position_valid ||
-		    status_flags.condition_global_position_valid) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (!status_flags.offboard_control_signal_lost) { conditions |= COND_OFFBOARD_SIGNAL_VALID; }
 
-		break;
+	if (status_flags.offboard_control_signal_lost && status_flags.offboard_control_loss_timeout) { conditions |= COND_OFFBOARD_LOST; }
 
-	case commander_state_s::MAIN_STATE_AUTO_LOITER:
+	if (status_flags.vtol_transition_failure) { conditions |= COND_VTOL_TRANSITION_FAILURE; }
 
-		/* need global position estimate */
-		if (status_flags.condition_global_position_valid) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) { conditions |= COND_ROTARY_WING; }
 
-		break;
+	if (status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING) { conditions |= COND_FIXED_WING; }
 
-	case commander_state_s::MAIN_STATE_AUTO_FOLLOW_TARGET:
-	case commander_state_s::MAIN_STATE_ORBIT:
+	if (status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) { conditions |= COND_ARMED; }
 
-		/* Follow and orbit only implemented for multicopter */
-		if (status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (status.rc_signal_lost) { conditions |= COND_RC_SIGNAL_LOST; }
 
-		break;
+	if (status.data_link_lost) { conditions |= COND_DATA_LINK_LOST; }
 
-	case commander_state_s::MAIN_STATE_AUTO_MISSION:
+	if (status.engine_failure) { conditions |= COND_ENGINE_FAILURE; }
 
-		/* need global position, home position, and a valid mission */
-		if (status_flags.condition_global_position_valid &&
-		    status_flags.condition_auto_mission_available) {
+	if (status.mission_failure) { conditions |= COND_MISSION_FAILURE; }
 
-			ret = TRANSITION_CHANGED;
-		}
+	return conditions;
+}
 
-		break;
+uint32_t nav_state_conditions(const vehicle_status_s &status, const vehicle_status_flags_s &status_flags,
+			      const link_loss_actions_t data_link_loss_act, const link_loss_actions_t rc_loss_act,
+			      const position_nav_loss_actions_t posctl_nav_loss_act, const bool mission_finished,
+			      const bool stay_in_failsafe, const bool landed)
+{
+	uint32_t conditions = transition_conditions(status, status_flags);
 
-	case commander_state_s::MAIN_STATE_AUTO_RTL:
+	if (rc_loss_act > link_loss_actions_t::DISABLED && status.rc_signal_lost) { conditions |= COND_RC_LOSS_FAILSAFE; }
 
-		/* need global position and home position */
-		if (status_flags.condition_global_position_valid && status_flags.condition_home_position_valid) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (data_link_loss_act > link_loss_actions_t::DISABLED) { conditions |= COND_DATA_LINK_LOSS_ACT; }
 
-		break;
+	if (landed) { conditions |= COND_LANDED; }
 
-	case commander_state_s::MAIN_STATE_AUTO_TAKEOFF:
-	case commander_state_s::MAIN_STATE_AUTO_LAND:
+	if (mission_finished) { conditions |= COND_MISSION_FINISHED; }
 
-		/* need local position */
-		if (status_flags.condition_local_position_valid) {
-			ret = TRANSITION_CHANGED;
-		}
+	if (stay_in_failsafe) { conditions |= COND_STAY_IN_FAILSAFE; }
 
-		break;
+	if (posctl_nav_loss_act != position_nav_loss_actions_t::LAND_TERMINATE) { conditions |= COND_POSCTL_NAV_LOSS_RC; }
 
-	case commander_state_s::MAIN_STATE_AUTO_PRECLAND:
+	return conditions;
+}
 
-		/* need local and global position, and precision land only implemented for multicopters */
-		if (status_flags.condition_local_position_valid
-		    && status_flags.condition_global_position_valid
-		    && status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
+transition_result_t
+main_state_transition(const vehicle_status_s &status, const main_state_t new_main_state,
+		      const vehicle_status_flags_s &status_flags, commander_state_s *internal_state)
+{
+	return main_state_transition(new_main_state, transition_conditions(status, status_flags), internal_state);
+}
 
-			ret = TRANSITION_CHANGED;
-		}
+transition_result_t
+main_state_transition(const main_state_t new_main_state, const uint32_t conditions, commander_state_s *internal_state)
+{
+	// IMPORTANT: The assumption of callers of this function is that the execution of
+	// this check is essentially "free". Therefore any runtime checking in here has to be
+	// kept super lightweight. No complex logic or calls on external function should be
+	// implemented here.
 
-		break;
+	transition_result_t ret = TRANSITION_DENIED;
 
-	case commander_state_s::MAIN_STATE_OFFBOARD:
+	/* transition may be denied even if the same state is requested because conditions may have changed */
+	if (new_main_state < commander_state_s::MAIN_STATE_MAX) {
+		const main_state_requirement_t &requirement = main_state_requirements[new_main_state];
 
-		/* need offboard signal */
-		if (!status_flags.offboard_control_signal_lost) {
+		if (((conditions & requirement.all_of) == requirement.all_of)
+		    && (requirement.any_of == 0 || (conditions & requirement.any_of) != 0)) {
 
 			ret = TRANSITION_CHANGED;
 		}
-
-		break;
-
-	case commander_state_s::MAIN_STATE_MAX:
-	default:
-		break;
 	}
 
 	if (ret == TRANSITION_CHANGED) {
@@ -408,13 +533,20 @@ bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_
 		   const offboard_loss_rc_actions_t offb_loss_rc_act,
 		   const position_nav_loss_actions_t posctl_nav_loss_act)
 {
-	navigation_state_t nav_state_old = status->nav_state;
+	const uint32_t conditions = nav_state_conditions(*status, status_flags, data_link_loss_act, rc_loss_act,
+				    posctl_nav_loss_act, mission_finished, stay_in_failsafe, landed);
+
+	return set_nav_state(status, armed, internal_state, mavlink_log_pub, conditions, status_flags,
+			     data_link_loss_act, rc_loss_act, offb_loss_act, offb_loss_rc_act);
+}
 
-	const bool data_link_loss_act_configured = data_link_loss_act > link_loss_actions_t::DISABLED;
-	const bool rc_loss_act_configured = rc_loss_act > link_loss_actions_t::DISABLED;
-	const bool rc_lost = rc_loss_act_configured && (status->rc_signal_lost);
+bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_state_s *internal_state,
+		   orb_advert_t *mavlink_log_pub, const uint32_t conditions, const vehicle_status_flags_s &status_flags,
+		   const link_loss_actions_t data_link_loss_act, const link_loss_actions_t rc_loss_act,
+		   const offboard_loss_actions_t offb_loss_act, const offboard_loss_rc_actions_t offb_loss_rc_act)
+{
+	navigation_state_t nav_state_old = status->nav_state;
 
-	bool is_armed = (status->arming_state == vehicle_status_s::ARMING_STATE_ARMED);
 	bool old_failsafe = status->failsafe;
 	status->failsafe = false;
 
@@ -423,300 +555,61 @@ bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_
 	reset_link_loss_globals(armed, old_failsafe, data_link_loss_act);
 	reset_offboard_loss_globals(armed, old_failsafe, offb_loss_act, offb_loss_rc_act);
 
-	/* evaluate main state to decide in normal (non-failsafe) mode */
-	switch (internal_state->main_state) {
-	case commander_state_s::MAIN_STATE_ACRO:
-	case commander_state_s::MAIN_STATE_MANUAL:
-	case commander_state_s::MAIN_STATE_RATTITUDE:
-	case commander_state_s::MAIN_STATE_STAB:
-	case commander_state_s::MAIN_STATE_ALTCTL:
-
-		/* require RC for all manual modes */
-		if (rc_lost && is_armed) {
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
-
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
-
-		} else {
-			switch (internal_state->main_state) {
-			case commander_state_s::MAIN_STATE_ACRO:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_ACRO;
-				break;
-
-			case commander_state_s::MAIN_STATE_MANUAL:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_MANUAL;
-				break;
-
-			case commander_state_s::MAIN_STATE_RATTITUDE:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_RATTITUDE;
-				break;
-
-			case commander_state_s::MAIN_STATE_STAB:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_STAB;
-				break;
-
-			case commander_state_s::MAIN_STATE_ALTCTL:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_ALTCTL;
-				break;
-
-			default:
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_MANUAL;
-				break;
-			}
-		}
-
-		break;
-
-	case commander_state_s::MAIN_STATE_POSCTL: {
-
-			if (rc_lost && is_armed) {
-				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
-
-				set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
-							vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
-
-				/* As long as there is RC, we can fallback to ALTCTL, or STAB. */
-				/* A local position estimate is enough for POSCTL for multirotors,
-				 * this enables POSCTL using e.g. flow.
-				 * For fixedwing, a global position is needed. */
-
-			} else if (is_armed
-				   && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags,
-						   !(posctl_nav_loss_act == position_nav_loss_actions_t::LAND_TERMINATE),
-						   status->vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING)) {
-				// nothing to do - everything done in check_invalid_pos_nav_state
-
-			} else {
-				status->nav_state = vehicle_status_s::NAVIGATION_STATE_POSCTL;
-			}
-		}
-		break;
-
-	case commander_state_s::MAIN_STATE_AUTO_MISSION:
-
-		/* go into failsafe
-		 * - if commanded to do so
-		 * - if we have an engine failure
-		 * - if we have vtol transition failure
-		 * - depending on datalink, RC and if the mission is finished */
-
-		if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-		} else if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (status_flags.vtol_transition_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
-
-		} else if (status->mission_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
-
-		} else if (data_link_loss_act_configured && status->data_link_lost && is_armed) {
-			/* datalink loss enabled:
-			 * check for datalink lost: this should always trigger RTGS */
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
-
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
-
-		} else if (!data_link_loss_act_configured && status->rc_signal_lost && status->data_link_lost && !landed
-			   && mission_finished && is_armed) {
-			/* datalink loss DISABLED:
-			 * check if both, RC and datalink are lost during the mission
-			 * or all links are lost after the mission finishes in air: this should always trigger RCRECOVER */
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+	if (internal_state->main_state >= commander_state_s::MAIN_STATE_MAX) {
+		return false;
+	}
 
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
+	/* evaluate main state to decide in normal (non-failsafe) mode */
+	const nav_state_rule_t *rule = &nav_state_rules[internal_state->main_state][0];
 
-		} else if (!stay_in_failsafe) {
-			/* stay where you are if you should stay in failsafe, otherwise everything is perfect */
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION;
-		}
+	while (((conditions & rule->set) != rule->set) || ((conditions & rule->clear) != 0)) {
+		rule++;
+	}
 
+	switch (rule->action) {
+	case nav_state_action_t::KEEP:
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_LOITER:
-
-		/* go into failsafe on a engine failure */
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-		} else if (status->data_link_lost && data_link_loss_act_configured && !landed && is_armed) {
-			/* also go into failsafe if just datalink is lost, and we're actually in air */
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
-
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
-
-		} else if (rc_lost && !data_link_loss_act_configured && is_armed) {
-			/* go into failsafe if RC is lost and datalink loss is not set up and rc loss is not DISABLED */
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
-
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
-
-		} else if (status->rc_signal_lost) {
-			/* don't bother if RC is lost if datalink is connected */
-
-			/* this mode is ok, we don't need RC for LOITERing */
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER;
-
-		} else {
-			/* everything is perfect */
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER;
-		}
-
+	case nav_state_action_t::SET:
+		status->nav_state = rule->nav_state;
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_RTL:
-
-		/* require global position and home, also go into failsafe on an engine failure */
-
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
-		}
-
+	case nav_state_action_t::RC_LOSS:
+		enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
+		set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+					vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_FOLLOW_TARGET:
-
-		/* require global position and home */
-
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET;
-		}
-
+	case nav_state_action_t::DATA_LINK_LOSS:
+		enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+		set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
+					vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
 		break;
 
-	case commander_state_s::MAIN_STATE_ORBIT:
-		if (status->engine_failure) {
-			// failsafe: on engine failure
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-			// Orbit can only be started via vehicle_command (mavlink). Recovery from failsafe into orbit
-			// is not possible and therefore the internal_state needs to be adjusted.
-			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, true)) {
-			// failsafe: necessary position estimate lost; switching is done in check_invalid_pos_nav_state
-
-			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
-			// is not possible and therefore the internal_state needs to be adjusted.
-			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
-
-		} else if (status->data_link_lost && data_link_loss_act_configured && !landed && is_armed) {
-			// failsafe: just datalink is lost and we're in air
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, data_link_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS);
-
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
-
-			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
-			// is not possible and therefore the internal_state needs to be adjusted.
-			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
-
-		} else if (rc_lost && !data_link_loss_act_configured && is_armed) {
-			// failsafe: RC is lost, datalink loss is not set up and rc loss is not disabled
-			enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc);
-
-			set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
-						vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
-
-			// Orbit can only be started via vehicle_command (mavlink). Consequently, recovery from failsafe into orbit
-			// is not possible and therefore the internal_state needs to be adjusted.
-			internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
-
-		} else {
-			// no failsafe, RC is not mandatory for orbit
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_ORBIT;
-		}
-
+	case nav_state_action_t::ALL_LINKS_LOSS:
+		enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_datalink);
+		set_link_loss_nav_state(status, armed, status_flags, internal_state, rc_loss_act,
+					vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER);
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_TAKEOFF:
-
-		/* require local position */
-
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF;
-		}
-
+	case nav_state_action_t::POSITION_LOSS:
+		check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags,
+					    rule->options & RULE_USE_RC, rule->options & RULE_GLOBAL_POS);
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_LAND:
-
-		/* require local position */
-
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LAND;
-		}
-
+	case nav_state_action_t::OFFBOARD_LOSS:
+		enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc_and_no_offboard);
+		set_offboard_loss_nav_state(status, armed, status_flags, offb_loss_act);
 		break;
 
-	case commander_state_s::MAIN_STATE_AUTO_PRECLAND:
-
-		/* must be rotary wing plus same requirements as normal landing */
-
-		if (status->engine_failure) {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL;
-
-		} else if (is_armed && check_invalid_pos_nav_state(status, old_failsafe, mavlink_log_pub, status_flags, false, false)) {
-			// nothing to do - everything done in check_invalid_pos_nav_state
-
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND;
-		}
-
+	case nav_state_action_t::OFFBOARD_RC_LOSS:
+		enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_offboard);
+		set_offboard_loss_rc_nav_state(status, armed, status_flags, offb_loss_rc_act);
 		break;
+	}
 
-	case commander_state_s::MAIN_STATE_OFFBOARD:
-
-		/* require offboard control, otherwise stay where you are */
-		if (status_flags.offboard_control_signal_lost && status_flags.offboard_control_loss_timeout) {
-			if (status->rc_signal_lost) {
-				// Offboard and RC are lost
-				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_rc_and_no_offboard);
-				set_offboard_loss_nav_state(status, armed, status_flags, offb_loss_act);
-
-			} else {
-				// Offboard is lost, RC is ok
-				enable_failsafe(status, old_failsafe, mavlink_log_pub, reason_no_offboard);
-				set_offboard_loss_rc_nav_state(status, armed, status_flags, offb_loss_rc_act);
-			}
-
-		} else {
-			status->nav_state = vehicle_status_s::NAVIGATION_STATE_OFFBOARD;
-		}
-
-	default:
-		break;
+	if (rule->options & RULE_EXIT_ORBIT) {
+		internal_state->main_state = commander_state_s::MAIN_STATE_POSCTL;
 	}
 
 	return status->nav_state != nav_state_old;
@@ -94,6 +94,37 @@ enum class position_nav_loss_actions_t {
 	LAND_TERMINATE = 1,	// Land/Terminate.  Assume no use of remote control after fallback. Switch to Land mode if a height estimate is available, else switch to TERMINATION.
 };
 
+/**
+ * Conditions the main state and navigation state transitions depend on.
+ *
+ * They are evaluated once into a bitmask (see transition_conditions() and nav_state_conditions())
+ * which is then matched against the transition tables in state_machine_helper.cpp.
+ */
+typedef enum {
+	COND_LOCAL_ALTITUDE_VALID = (1 << 0),
+	COND_LOCAL_POSITION_VALID = (1 << 1),
+	COND_LOCAL_NAV_VALID = (1 << 2),		// local position and velocity valid
+	COND_GLOBAL_POSITION_VALID = (1 << 3),
+	COND_HOME_POSITION_VALID = (1 << 4),
+	COND_MISSION_AVAILABLE = (1 << 5),
+	COND_OFFBOARD_SIGNAL_VALID = (1 << 6),
+	COND_OFFBOARD_LOST = (1 << 7),			// offboard signal lost for longer than the loss timeout
+	COND_ROTARY_WING = (1 << 8),
+	COND_FIXED_WING = (1 << 9),
+	COND_ARMED = (1 << 10),
+	COND_RC_SIGNAL_LOST = (1 << 11),
+	COND_DATA_LINK_LOST = (1 << 12),
+	COND_ENGINE_FAILURE = (1 << 13),
+	COND_VTOL_TRANSITION_FAILURE = (1 << 14),
+	COND_MISSION_FAILURE = (1 << 15),
+	COND_RC_LOSS_FAILSAFE = (1 << 16),		// RC lost and RC loss action configured
+	COND_DATA_LINK_LOSS_ACT = (1 << 17),		// data link loss action configured
+	COND_LANDED = (1 << 18),
+	COND_MISSION_FINISHED = (1 << 19),
+	COND_STAY_IN_FAILSAFE = (1 << 20),
+	COND_POSCTL_NAV_LOSS_RC = (1 << 21)		// position loss in POSCTL falls back to a mode with stick control
+} transition_condition_t;
+
 typedef enum {
 	ARM_REQ_NONE = 0,
 	ARM_REQ_MISSION_BIT = (1 << 0),
@@ -111,10 +142,32 @@ arming_state_transition(vehicle_status_s *status, const safety_s &safety, const
 			actuator_armed_s *armed, const bool fRunPreArmChecks, orb_advert_t *mavlink_log_pub,
 			vehicle_status_flags_s *status_flags, const uint8_t arm_requirements, const hrt_abstime &time_since_boot);
 
+/**
+ * Evaluate the vehicle and estimator conditions required by main state transitions.
+ * @return bitmask of transition_condition_t
+ */
+uint32_t transition_conditions(const vehicle_status_s &status, const vehicle_status_flags_s &status_flags);
+
+/**
+ * Evaluate all conditions required by set_nav_state(), including the ones of transition_conditions().
+ * @return bitmask of transition_condition_t
+ */
+uint32_t nav_state_conditions(const vehicle_status_s &status, const vehicle_status_flags_s &status_flags,
+			      const link_loss_actions_t data_link_loss_act, const link_loss_actions_t rc_loss_act,
+			      const position_nav_loss_actions_t posctl_nav_loss_act, const bool mission_finished,
+			      const bool stay_in_failsafe, const bool landed);
+
 transition_result_t
 main_state_transition(const vehicle_status_s &status, const main_state_t new_main_state,
 		      const vehicle_status_flags_s &status_flags, commander_state_s *internal_state);
 
+/**
+ * Main state transition against already evaluated conditions
+ * @param conditions bitmask of transition_condition_t, see transition_conditions()
+ */
+transition_result_t
+main_state_transition(const main_state_t new_main_state, const uint32_t conditions, commander_state_s *internal_state);
+
 void enable_failsafe(vehicle_status_s *status, bool old_failsafe, orb_advert_t *mavlink_log_pub, const char *reason);
 
 bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_state_s *internal_state,
@@ -124,6 +177,15 @@ bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_
 		   const offboard_loss_rc_actions_t offb_loss_rc_act,
 		   const position_nav_loss_actions_t posctl_nav_loss_act);
 
+/**
+ * Check failsafe and main status and set navigation status against already evaluated conditions
+ * @param conditions bitmask of transition_condition_t, see nav_state_conditions()
+ */
+bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_state_s *internal_state,
+		   orb_advert_t *mavlink_log_pub, const uint32_t conditions, const vehicle_status_flags_s &status_flags,
+		   const link_loss_actions_t data_link_loss_act, const link_loss_actions_t rc_loss_act,
+		   const offboard_loss_actions_t offb_loss_act, const offboard_loss_rc_actions_t offb_loss_rc_act);
+
 /*
  * Checks the validty of position data aaainst the requirements of the current navigation
  * mode and switches mode if position data required is not available.
@@ -131,6 +193,24 @@ bool set_nav_state(vehicle_status_s *status, actuator_armed_s *armed, commander_
 bool check_invalid_pos_nav_state(vehicle_status_s *status, bool old_failsafe, orb_advert_t *mavlink_log_pub,
 				 const vehicle_status_flags_s &status_flags, const bool use_rc, const bool using_global_pos);
 
+void set_link_loss_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
+			     const vehicle_status_flags_s &status_flags, commander_state_s *internal_state, const link_loss_actions_t link_loss_act,
+			     uint8_t auto_recovery_nav_state);
+
+void reset_link_loss_globals(actuator_armed_s *armed, const bool old_failsafe, const link_loss_actions_t link_loss_act);
+
+void set_offboard_loss_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
+				 const vehicle_status_flags_s &status_flags,
+				 const offboard_loss_actions_t offboard_loss_act);
+
+void set_offboard_loss_rc_nav_state(vehicle_status_s *status, actuator_armed_s *armed,
+				    const vehicle_status_flags_s &status_flags,
+				    const offboard_loss_rc_actions_t offboard_loss_rc_act);
+
+void reset_offboard_loss_globals(actuator_armed_s *armed, const bool old_failsafe,
+				 const offboard_loss_actions_t offboard_loss_act,
+				 const offboard_loss_rc_actions_t offboard_loss_rc_act);
+
 bool prearm_check(orb_advert_t *mavlink_log_pub, const vehicle_status_flags_s &status_flags, const safety_s &safety,
 		  const uint8_t arm_requirements);
 
@@ -68,29 +68,36 @@ bool FixedwingLandDetector::_get_landed_state()
 
 	if (hrt_elapsed_time(&_vehicle_local_position.timestamp) < 500_ms) {
 
+		// The filter gains are tuned for LAND_DETECTOR_UPDATE_INTERVAL and scaled to the actual time step.
+
 		// Horizontal velocity complimentary filter.
-		float val = 0.97f * _velocity_xy_filtered + 0.03f * sqrtf(_vehicle_local_position.vx * _vehicle_local_position.vx +
-				_vehicle_local_position.vy * _vehicle_local_position.vy);
+		const float vel_xy_gain = _filter_gain(0.03f);
+		float val = (1.f - vel_xy_gain) * _velocity_xy_filtered + vel_xy_gain * sqrtf(_vehicle_local_position.vx *
+				_vehicle_local_position.vx + _vehicle_local_position.vy * _vehicle_local_position.vy);
 
 		if (PX4_ISFINITE(val)) {
 			_velocity_xy_filtered = val;
 		}
 
 		// Vertical velocity complimentary filter.
-		val = 0.99f * _velocity_z_filtered + 0.01f * fabsf(_vehicle_local_position.vz);
+		const float vel_z_gain = _filter_gain(0.01f);
+		val = (1.f - vel_z_gain) * _velocity_z_filtered + vel_z_gain * fabsf(_vehicle_local_position.vz);
 
 		if (PX4_ISFINITE(val)) {
 			_velocity_z_filtered = val;
 		}
 
-		_airspeed_filtered = 0.95f * _airspeed_filtered + 0.05f * _airspeed.true_airspeed_m_s;
+		const float airspeed_gain = _filter_gain(0.05f);
+		_airspeed_filtered = (1.f - airspeed_gain) * _airspeed_filtered + airspeed_gain * _airspeed.true_airspeed_m_s;
 
 		// A leaking lowpass prevents biases from building up, but
 		// gives a mostly correct response for short impulses.
+		// Steady state gain 0.9, like 0.8 * filtered + 0.18 * input per update.
 		const matrix::Vector3f accel{_vehicle_acceleration.xyz};
 		const float acc_hor = sqrtf(accel(0) * accel(0) + accel(1) * accel(1));
+		const float accel_gain = _filter_gain(0.2f);
 
-		_xy_accel_filtered = _xy_accel_filtered * 0.8f + acc_hor * 0.18f;
+		_xy_accel_filtered = (1.f - accel_gain) * _xy_accel_filtered + accel_gain * 0.9f * acc_hor;
 
 		// Crude land detector for fixedwing.
 		landDetected = _airspeed_filtered       < _param_lndfw_airspd.get()
@@ -40,6 +40,8 @@
 
 #include "LandDetector.h"
 
+#include <mathlib/mathlib.h>
+
 using namespace time_literals;
 
 namespace land_detector
@@ -48,25 +50,54 @@ namespace land_detector
 LandDetector::LandDetector() :
 	ModuleParams(nullptr),
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::att_pos_ctrl)
-{}
+{
+	// Drop to the cruise interval only once the vehicle has been cruising for a while, leave it immediately.
+	_cruise_hysteresis.set_hysteresis_time_from(false, CRUISE_TRIGGER_TIME_US);
+}
 
 LandDetector::~LandDetector()
 {
+	_actuator_armed_sub.unregisterCallback();
+	_vehicle_local_position_sub.unregisterCallback();
+
 	perf_free(_cycle_perf);
 }
 
 void LandDetector::start()
 {
 	_update_params(true);
-	ScheduleOnInterval(LAND_DETECTOR_UPDATE_INTERVAL);
+
+	// run on new local position (at most at the update interval) and immediately on arming changes
+	_vehicle_local_position_sub.set_interval_us(LAND_DETECTOR_UPDATE_INTERVAL);
+	_vehicle_local_position_sub.registerCallback();
+	_actuator_armed_sub.registerCallback();
+
+	// the timer covers the case of no position updates
+	_update_schedule();
 }
 
 void LandDetector::Run()
 {
+	if (should_exit()) {
+		ScheduleClear();
+		exit_and_cleanup();
+		return;
+	}
+
+	const bool armed_updated = _actuator_armed_sub.updated();
+	const bool position_updated = _vehicle_local_position_sub.updated();
+
+	// The timer only has to trigger an update when no position updates drive the loop.
+	// Skip it if an update happened recently anyway.
+	if (!armed_updated && !position_updated
+	    && (hrt_elapsed_time(&_vehicle_local_position.timestamp) < POSITION_TIMEOUT_US)
+	    && (hrt_elapsed_time(&_last_update) < LAND_DETECTOR_WATCHDOG_INTERVAL / 2)) {
+		return;
+	}
+
 	perf_begin(_cycle_perf);
 
 	_update_params();
-	_actuator_armed_sub.update(&_actuator_armed);
 	_update_topics();
 	_update_state();
 
@@ -123,12 +154,9 @@ void LandDetector::Run()
 
 	_previous_armed_state = _actuator_armed.armed;
 
-	perf_end(_cycle_perf);
+	_update_schedule();
 
-	if (should_exit()) {
-		ScheduleClear();
-		exit_and_cleanup();
-	}
+	perf_end(_cycle_perf);
 }
 
 void LandDetector::_update_params(const bool force)
@@ -148,11 +176,58 @@ void LandDetector::_update_state()
 	/* when we are landed we also have ground contact for sure but only one output state can be true at a particular time
 	 * with higher priority for landed */
 	const hrt_abstime now_us = hrt_absolute_time();
+
+	// the loop runs at a variable rate, filters in the state getters scale with the actual time step
+	if (_last_update != 0) {
+		_dt = math::constrain((now_us - _last_update) * 1e-6f, 0.001f, 1.f);
+	}
+
 	_freefall_hysteresis.set_state_and_update(_get_freefall_state(), now_us);
 	_landed_hysteresis.set_state_and_update(_get_landed_state(), now_us);
 	_maybe_landed_hysteresis.set_state_and_update(_get_maybe_landed_state(), now_us);
 	_ground_contact_hysteresis.set_state_and_update(_get_ground_contact_state(), now_us);
 	_ground_effect_hysteresis.set_state_and_update(_get_ground_effect_state(), now_us);
+	_cruise_hysteresis.set_state_and_update(_get_cruise_state(), now_us);
+
+	_last_update = now_us;
+}
+
+void LandDetector::_update_schedule()
+{
+	// Far from the ground only a low rate is needed to notice the vehicle starting to descend.
+	_vehicle_local_position_sub.set_interval_us(_cruise_hysteresis.get_state() ? LAND_DETECTOR_CRUISE_INTERVAL :
+			LAND_DETECTOR_UPDATE_INTERVAL);
+
+	// Without position updates the timer has to run the loop at the full rate.
+	const uint32_t interval = (hrt_elapsed_time(&_vehicle_local_position.timestamp) < POSITION_TIMEOUT_US) ?
+				  LAND_DETECTOR_WATCHDOG_INTERVAL : LAND_DETECTOR_UPDATE_INTERVAL;
+
+	if (interval != _schedule_interval) {
+		_schedule_interval = interval;
+		ScheduleOnInterval(interval);
+	}
+}
+
+bool LandDetector::_get_cruise_state()
+{
+	if (!_actuator_armed.armed || _land_detected.landed || _land_detected.maybe_landed
+	    || _land_detected.ground_contact || _land_detected.freefall) {
+		return false;
+	}
+
+	if (hrt_elapsed_time(&_vehicle_local_position.timestamp) > POSITION_TIMEOUT_US
+	    || !_vehicle_local_position.z_valid || !_vehicle_local_position.v_z_valid) {
+		return false;
+	}
+
+	// use the distance to the ground if available, the height above the local origin otherwise
+	if (_vehicle_local_position.dist_bottom_valid) {
+		return (_vehicle_local_position.dist_bottom > CRUISE_HEIGHT_MIN)
+		       && (_vehicle_local_position.vz < CRUISE_DESCENT_RATE_MAX);
+	}
+
+	return (-_vehicle_local_position.z > CRUISE_HEIGHT_MIN)
+	       && (_vehicle_local_position.vz <= 0.f);
 }
 
 void LandDetector::_update_topics()
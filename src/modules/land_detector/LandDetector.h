@@ -54,6 +54,7 @@
 #include <px4_module_params.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/Publication.hpp>
 #include <uORB/topics/actuator_armed.h>
 #include <uORB/topics/parameter_update.h>
@@ -137,9 +138,29 @@ protected:
 	 */
 	virtual bool _get_ground_effect_state() { return false; }
 
+	/**
+	 *  @return true if vehicle is flying well above the ground and not descending
+	 */
+	virtual bool _get_cruise_state();
+
+	/**
+	 * Gain of a first order lowpass filter over the time since the last update.
+	 * @param nominal_gain gain the filter was tuned with for one LAND_DETECTOR_UPDATE_INTERVAL
+	 */
+	float _filter_gain(float nominal_gain) const
+	{
+		return 1.f - powf(1.f - nominal_gain, _dt / (LAND_DETECTOR_UPDATE_INTERVAL * 1e-6f));
+	}
+
 	/** Run main land detector loop at this interval. */
 	static constexpr uint32_t LAND_DETECTOR_UPDATE_INTERVAL = 20_ms;
 
+	/** Run main land detector loop at this interval while cruising. */
+	static constexpr uint32_t LAND_DETECTOR_CRUISE_INTERVAL = 100_ms;
+
+	/** Watchdog interval of the work item while position updates are arriving. */
+	static constexpr uint32_t LAND_DETECTOR_WATCHDOG_INTERVAL = 200_ms;
+
 	systemlib::Hysteresis _freefall_hysteresis{false};
 	systemlib::Hysteresis _landed_hysteresis{true};
 	systemlib::Hysteresis _maybe_landed_hysteresis{true};
@@ -158,11 +179,13 @@ protected:
 	};
 	vehicle_local_position_s _vehicle_local_position{};
 
+	float _dt{LAND_DETECTOR_UPDATE_INTERVAL * 1e-6f};	///< time since the previous state update in seconds
+
 	uORB::Publication<vehicle_land_detected_s> _vehicle_land_detected_pub{ORB_ID(vehicle_land_detected)};
 
-	uORB::Subscription _actuator_armed_sub{ORB_ID(actuator_armed)};
+	uORB::SubscriptionCallbackWorkItem _actuator_armed_sub{this, ORB_ID(actuator_armed)};
 	uORB::Subscription _vehicle_acceleration_sub{ORB_ID(vehicle_acceleration)};
-	uORB::Subscription _vehicle_local_position_sub{ORB_ID(vehicle_local_position)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_local_position_sub{this, ORB_ID(vehicle_local_position)};
 
 private:
 
@@ -170,10 +193,33 @@ private:
 
 	void _update_state();
 
+	void _update_schedule();
+
 	void _update_total_flight_time();
 
+	/** Time in us that cruise conditions have to hold before dropping to the cruise interval. */
+	static constexpr hrt_abstime CRUISE_TRIGGER_TIME_US = 10_s;
+
+	/** Height above ground in meters below which the full update rate is always used. */
+	static constexpr float CRUISE_HEIGHT_MIN = 10.f;
+
+	/**
+	 * Descent rate in m/s above which the full update rate is always used with a distance sensor.
+	 * Without one, the height above the local origin says nothing about a raised landing spot,
+	 * so the full rate is used on any descent.
+	 */
+	static constexpr float CRUISE_DESCENT_RATE_MAX = 0.5f;
+
+	/** Age of the local position after which the work item falls back to the timer. */
+	static constexpr hrt_abstime POSITION_TIMEOUT_US = 500_ms;
+
 	bool _previous_armed_state{false};	///< stores the previous actuator_armed.armed state
 
+	systemlib::Hysteresis _cruise_hysteresis{false};
+
+	hrt_abstime _last_update{0};		///< time of the last state machine update
+	uint32_t _schedule_interval{0};		///< current interval of the work item timer
+
 	hrt_abstime _takeoff_time{0};
 	hrt_abstime _total_flight_time{0};	///< total vehicle flight time in microseconds
 
@@ -81,7 +81,8 @@ bool VtolLandDetector::_get_landed_state()
 	if (hrt_elapsed_time(&_airspeed.timestamp) < 500 * 1000 && _airspeed.confidence > 0.99f
 	    && PX4_ISFINITE(_airspeed.indicated_airspeed_m_s)) {
 
-		_airspeed_filtered = 0.95f * _airspeed_filtered + 0.05f * _airspeed.indicated_airspeed_m_s;
+		const float airspeed_gain = _filter_gain(0.05f);
+		_airspeed_filtered = (1.f - airspeed_gain) * _airspeed_filtered + airspeed_gain * _airspeed.indicated_airspeed_m_s;
 
 	} else {
 		// if airspeed does not update, set it to zero and rely on multicopter land detector
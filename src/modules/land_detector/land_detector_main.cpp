@@ -104,6 +104,9 @@ int LandDetector::task_spawn(int argc, char *argv[])
 int LandDetector::print_status()
 {
 	PX4_INFO("running (%s)", _currentMode);
+	PX4_INFO("update interval: %u ms", (unsigned)(_cruise_hysteresis.get_state() ? LAND_DETECTOR_CRUISE_INTERVAL :
+			LAND_DETECTOR_UPDATE_INTERVAL) / 1000);
+	perf_print_counter(_cycle_perf);
 	return 0;
 }
 int LandDetector::print_usage(const char *reason)
@@ -135,7 +138,10 @@ position controller sets the thrust setpoint to zero.
 
 **landed**: it requires maybe_landed to be true for time LAND_DETECTOR_TRIGGER_TIME_US.
 
-The module runs periodically on the HP work queue.
+The module runs on the HP work queue whenever a new local position or armed state is published, at most every
+LAND_DETECTOR_UPDATE_INTERVAL. Once the vehicle has been flying well above the ground without descending for
+CRUISE_TRIGGER_TIME_US, the local position is only sampled every LAND_DETECTOR_CRUISE_INTERVAL. A timer runs the
+loop at the full rate if no position updates arrive.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("land_detector", "system");
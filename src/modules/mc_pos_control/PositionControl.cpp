@@ -268,11 +268,15 @@ void PositionControl::_velocityController(const float &dt)
 	// make sure there's always enough thrust vector length to infer the attitude
 	uMax = math::min(uMax, -10e-4f);
 
+	// With MPC_THR_ALLOC the D-direction is saturated together with NE below and the
+	// D-integrator tracks the saturated output instead.
+	const bool thrust_qp = (_param_mpc_thr_alloc.get() == 1) && !(PX4_ISFINITE(_thr_sp(0)) && PX4_ISFINITE(_thr_sp(1)));
+
 	// Apply Anti-Windup in D-direction.
 	bool stop_integral_D = (thrust_desired_D >= uMax && vel_err(2) >= 0.0f) ||
 			       (thrust_desired_D <= uMin && vel_err(2) <= 0.0f);
 
-	if (!stop_integral_D) {
+	if (!thrust_qp && !stop_integral_D) {
 		_thr_int(2) += vel_err(2) * _param_mpc_z_vel_i.get() * dt;
 
 		// limit thrust integral
@@ -300,14 +304,30 @@ void PositionControl::_velocityController(const float &dt)
 		float thrust_max_NE = sqrtf(_param_mpc_thr_max.get() * _param_mpc_thr_max.get() - _thr_sp(2) * _thr_sp(2));
 		thrust_max_NE = math::min(thrust_max_NE_tilt, thrust_max_NE);
 
-		// Saturate thrust in NE-direction.
-		_thr_sp(0) = thrust_desired_NE(0);
-		_thr_sp(1) = thrust_desired_NE(1);
+		if (thrust_qp) {
+			// Saturate thrust in all directions at once, the D-direction is weighted higher to keep its priority.
+			_thrust_qp.setLimits(uMin, uMax, _param_mpc_thr_max.get(), _constraints.tilt);
+			_thr_sp = _thrust_qp.update(Vector3f(thrust_desired_NE(0), thrust_desired_NE(1), thrust_desired_D));
+
+			// The QP can move the D-thrust away from the desired one also within uMin and uMax, to give up
+			// upwards thrust for the thrust limit or to add some to make room for NE in the tilt cone.
+			// Use tracking Anti-Windup as for NE-direction such that the integrator follows the saturated output.
+			float arw_gain_D = 2.f / _param_mpc_z_vel_p.get();
+			_thr_int(2) += _param_mpc_z_vel_i.get() * (vel_err(2) - (thrust_desired_D - _thr_sp(2)) * arw_gain_D) * dt;
+
+			// limit thrust integral
+			_thr_int(2) = math::min(fabsf(_thr_int(2)), _param_mpc_thr_max.get()) * math::sign(_thr_int(2));
 
-		if (thrust_desired_NE * thrust_desired_NE > thrust_max_NE * thrust_max_NE) {
-			float mag = thrust_desired_NE.length();
-			_thr_sp(0) = thrust_desired_NE(0) / mag * thrust_max_NE;
-			_thr_sp(1) = thrust_desired_NE(1) / mag * thrust_max_NE;
+		} else {
+			// Saturate thrust in NE-direction.
+			_thr_sp(0) = thrust_desired_NE(0);
+			_thr_sp(1) = thrust_desired_NE(1);
+
+			if (thrust_desired_NE * thrust_desired_NE > thrust_max_NE * thrust_max_NE) {
+				float mag = thrust_desired_NE.length();
+				_thr_sp(0) = thrust_desired_NE(0) / mag * thrust_max_NE;
+				_thr_sp(1) = thrust_desired_NE(1) / mag * thrust_max_NE;
+			}
 		}
 
 		// Use tracking Anti-Windup for NE-direction: during saturation, the integrator is used to unsaturate the output
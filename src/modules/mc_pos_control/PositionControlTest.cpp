@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file PositionControlTest.cpp
+ *
+ * Run this test only using make tests TESTFILTER=PositionControl
+ */
+
+#include <gtest/gtest.h>
+#include <parameters/param.h>
+#include <PositionControl.hpp>
+
+using namespace matrix;
+
+class TestPositionControl : public PositionControl
+{
+public:
+	TestPositionControl() : PositionControl(nullptr) {}
+	void paramsChanged() { PositionControl::updateParams(); }
+};
+
+class PositionControlTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		param_reset_all();
+	}
+
+	/* Run one velocity control step with the vehicle at rest */
+	static Vector3f runVelocityControl(TestPositionControl &control, const Vector3f &vel_sp)
+	{
+		PositionControlStates states{};
+		states.position = Vector3f(0.f, 0.f, 0.f);
+		states.velocity = Vector3f(0.f, 0.f, 0.f);
+		states.acceleration = Vector3f(0.f, 0.f, 0.f);
+		states.yaw = 0.f;
+
+		vehicle_local_position_setpoint_s setpoint{};
+		setpoint.x = setpoint.y = setpoint.z = NAN;
+		setpoint.vx = vel_sp(0);
+		setpoint.vy = vel_sp(1);
+		setpoint.vz = vel_sp(2);
+		setpoint.acc_x = setpoint.acc_y = setpoint.acc_z = NAN;
+		setpoint.thrust[0] = setpoint.thrust[1] = setpoint.thrust[2] = NAN;
+		setpoint.yaw = 0.f;
+		setpoint.yawspeed = NAN;
+
+		control.updateState(states);
+		control.updateSetpoint(setpoint);
+		control.generateThrustYawSetpoint(0.02f);
+		return control.getThrustSetpoint();
+	}
+};
+
+TEST_F(PositionControlTest, ThrustQPAntiWindupD)
+{
+	// GIVEN: the QP thrust saturation
+	int32_t thr_alloc = 1;
+	param_set(param_handle(px4::params::MPC_THR_ALLOC), &thr_alloc);
+
+	float z_vel_p = 0.f;
+	float thr_hover = 0.f;
+	param_get(param_handle(px4::params::MPC_Z_VEL_P), &z_vel_p);
+	param_get(param_handle(px4::params::MPC_THR_HOVER), &thr_hover);
+
+	TestPositionControl control;
+	control.paramsChanged();
+
+	vehicle_constraints_s constraints{};
+	constraints.tilt = constraints.speed_up = constraints.speed_down = constraints.speed_xy = NAN;
+	control.updateConstraints(constraints);
+
+	// WHEN: climbing and accelerating horizontally such that the thrust vector exceeds its maximum length
+	const Vector3f vel_sp(10.f, 0.f, -2.f);
+	const float thrust_desired_D_initial = z_vel_p * vel_sp(2) - thr_hover;
+	Vector3f thrust = runVelocityControl(control, vel_sp);
+
+	// THEN: the QP gives up some of the upwards thrust although the D-direction is within its limits
+	EXPECT_GT(thrust_desired_D_initial, -1.f);
+	EXPECT_GT(thrust(2), thrust_desired_D_initial + 0.005f);
+
+	for (int i = 0; i < 2000; i++) {
+		thrust = runVelocityControl(control, vel_sp);
+	}
+
+	// WHEN: the velocity error is gone, the D-thrust is the integral minus the hover thrust
+	const Vector3f thrust_integral_check = runVelocityControl(control, Vector3f(0.f, 0.f, 0.f));
+	const float thr_int_D = thrust_integral_check(2) + thr_hover;
+
+	// THEN: the integrator settled where the tracking Anti-Windup balances the velocity error
+	// with the difference between the desired and the saturated D-thrust of the QP
+	const float thrust_desired_D = z_vel_p * vel_sp(2) + thr_int_D - thr_hover;
+	const float arw_gain_D = 2.f / z_vel_p;
+	EXPECT_NEAR(thrust_desired_D - thrust(2), vel_sp(2) / arw_gain_D, 0.01f);
+}
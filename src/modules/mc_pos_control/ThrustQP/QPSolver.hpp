@@ -0,0 +1,340 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file QPSolver.hpp
+ *
+ * Small fixed-size solver for weighted projections onto polyhedra:
+ *
+ * 	min (x - x_des)^T W (x - x_des)
+ * 	s.t. A x <= b
+ *
+ * with x in R^3 and a positive diagonal W. This is a dual active-set method
+ * (Goldfarb-Idnani) specialised to a diagonal Hessian: it starts at the
+ * unconstrained optimum x_des and adds the most violated constraint until all
+ * of them are satisfied, dropping constraints whose multiplier would become negative.
+ * In three dimensions at most three constraints are active, so all linear
+ * algebra is done on 3x3 matrices on the stack.
+ *
+ * The constraints that were active in the previous solve are checked first.
+ * If the constraint set keeps the same order from one call to the next, the
+ * solver then usually terminates after as many iterations as there are active constraints.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <float.h>
+
+template<int M>
+class QPSolver
+{
+public:
+	static constexpr int N = 3; ///< dimension of the decision variable
+
+	QPSolver() = default;
+	~QPSolver() = default;
+
+	/**
+	 * Remove all constraints. The warm start information is kept.
+	 */
+	void clearConstraints() { _num_constraints = 0; }
+
+	/**
+	 * Add the constraint a^T x <= b
+	 * @return false if the constraint does not fit or a is zero
+	 */
+	bool addConstraint(const float a[N], float b)
+	{
+		const float norm_sq = a[0] * a[0] + a[1] * a[1] + a[2] * a[2];
+
+		if (_num_constraints >= M || !(norm_sq > FLT_EPSILON)) {
+			return false;
+		}
+
+		for (int j = 0; j < N; j++) {
+			_a[_num_constraints][j] = a[j];
+		}
+
+		_b[_num_constraints] = b;
+		_num_constraints++;
+		return true;
+	}
+
+	int getNumConstraints() const { return _num_constraints; }
+
+	/**
+	 * Forget which constraints were active in the previous solve
+	 */
+	void resetWarmStart()
+	{
+		for (int i = 0; i < M; i++) {
+			_was_active[i] = false;
+		}
+	}
+
+	/**
+	 * Solve the problem for the current constraints.
+	 * @param x_des unconstrained optimum
+	 * @param weight diagonal of W, all elements need to be positive
+	 * @param x solution, only valid if true is returned
+	 * @return false if the constraints are infeasible or the iteration limit was hit
+	 */
+	bool solve(const float x_des[N], const float weight[N], float x[N])
+	{
+		// Scale the problem to an euclidean projection: y = W^(1/2) x, g_i = W^(-1/2) a_i
+		float scale[N];
+		float y[N];
+
+		for (int j = 0; j < N; j++) {
+			scale[j] = sqrtf(weight[j]);
+			y[j] = x_des[j] * scale[j];
+		}
+
+		for (int i = 0; i < _num_constraints; i++) {
+			for (int j = 0; j < N; j++) {
+				_g[i][j] = _a[i][j] / scale[j];
+			}
+
+			_g_norm[i] = sqrtf(_dot(_g[i], _g[i]));
+			_is_active[i] = false;
+		}
+
+		int active[N]; // indices of the active constraints
+		float lambda[N]; // multipliers of the active constraints
+		int num_active = 0;
+		bool success = false;
+		_iterations = 0;
+
+		while (_iterations < MAX_ITERATIONS) {
+			_iterations++;
+			const int p = _findMostViolated(y);
+
+			if (p < 0) {
+				success = true;
+				break;
+			}
+
+			// Add p, keeping the active constraints satisfied with equality
+			float lambda_p = 0.f;
+			bool added = false;
+
+			while (!added && _iterations < MAX_ITERATIONS) {
+				// r: change of the active multipliers per unit of lambda_p, z: primal step direction
+				float r[N] {};
+				float z[N];
+				_projectOnActive(active, num_active, _g[p], r, z);
+
+				const float z_sq = _dot(z, z);
+				const float violation = _dot(_g[p], y) - _b[p];
+				const bool full_step_possible = z_sq > 1e-10f;
+				const float t_full = full_step_possible ? violation / z_sq : FLT_MAX;
+
+				float t_partial = FLT_MAX;
+				int blocking = -1;
+
+				for (int k = 0; k < num_active; k++) {
+					if (r[k] > 0.f && lambda[k] / r[k] < t_partial) {
+						t_partial = lambda[k] / r[k];
+						blocking = k;
+					}
+				}
+
+				if (!full_step_possible && blocking < 0) {
+					// p is linearly dependent on the active constraints and cannot be satisfied
+					return false;
+				}
+
+				const float t = fminf(t_full, t_partial);
+
+				for (int j = 0; j < N; j++) {
+					y[j] -= t * z[j];
+				}
+
+				for (int k = 0; k < num_active; k++) {
+					lambda[k] -= t * r[k];
+				}
+
+				lambda_p += t;
+
+				if (full_step_possible && t_full <= t_partial) {
+					active[num_active] = p;
+					lambda[num_active] = lambda_p;
+					num_active++;
+					_is_active[p] = true;
+					added = true;
+
+				} else {
+					// Drop the blocking constraint and continue adding p
+					_is_active[active[blocking]] = false;
+
+					for (int k = blocking; k < num_active - 1; k++) {
+						active[k] = active[k + 1];
+						lambda[k] = lambda[k + 1];
+					}
+
+					num_active--;
+					_iterations++;
+				}
+			}
+		}
+
+		for (int j = 0; j < N; j++) {
+			x[j] = y[j] / scale[j];
+		}
+
+		for (int i = 0; i < M; i++) {
+			_was_active[i] = (i < _num_constraints) && _is_active[i];
+		}
+
+		return success;
+	}
+
+	/**
+	 * @return true if constraint i was active at the solution of the last solve
+	 */
+	bool isActive(int i) const { return (i >= 0) && (i < _num_constraints) && _was_active[i]; }
+
+	/**
+	 * @return number of iterations of the last solve
+	 */
+	int getIterations() const { return _iterations; }
+
+private:
+	static constexpr int MAX_ITERATIONS = 4 * M + 8;
+	static constexpr float TOLERANCE = 1e-5f; ///< accepted constraint violation (scaled by the norm of g)
+
+	static float _dot(const float u[N], const float v[N]) { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; }
+
+	/**
+	 * Find the constraint with the largest normalized violation. Constraints that were
+	 * active in the last solve are preferred.
+	 * @return its index or -1 if all constraints are satisfied
+	 */
+	int _findMostViolated(const float y[N]) const
+	{
+		int most_violated = -1;
+		bool most_violated_was_active = false;
+		float max_violation = TOLERANCE;
+
+		for (int i = 0; i < _num_constraints; i++) {
+			if (_is_active[i]) {
+				continue;
+			}
+
+			const float violation = (_dot(_g[i], y) - _b[i]) / _g_norm[i];
+
+			if (violation <= TOLERANCE) {
+				continue;
+			}
+
+			if ((_was_active[i] && !most_violated_was_active) ||
+			    ((_was_active[i] == most_violated_was_active) && violation > max_violation)) {
+				most_violated = i;
+				most_violated_was_active = _was_active[i];
+				max_violation = violation;
+			}
+		}
+
+		return most_violated;
+	}
+
+	/**
+	 * Split g into its component z orthogonal to the active constraint normals
+	 * and the coefficients r of the remainder: g = N r + z
+	 */
+	void _projectOnActive(const int active[N], int num_active, const float g[N], float r[N], float z[N]) const
+	{
+		for (int j = 0; j < N; j++) {
+			z[j] = g[j];
+		}
+
+		if (num_active == 0) {
+			return;
+		}
+
+		// Solve the normal equations (N^T N) r = N^T g by Gaussian elimination
+		float gram[N][N + 1];
+
+		for (int k = 0; k < num_active; k++) {
+			for (int l = 0; l < num_active; l++) {
+				gram[k][l] = _dot(_g[active[k]], _g[active[l]]);
+			}
+
+			gram[k][num_active] = _dot(_g[active[k]], g);
+		}
+
+		for (int k = 0; k < num_active; k++) {
+			const float pivot = gram[k][k];
+
+			if (fabsf(pivot) < 1e-12f) {
+				// Active normals are linearly independent by construction, bail out with z = g
+				return;
+			}
+
+			for (int l = k + 1; l < num_active; l++) {
+				const float factor = gram[l][k] / pivot;
+
+				for (int c = k; c <= num_active; c++) {
+					gram[l][c] -= factor * gram[k][c];
+				}
+			}
+		}
+
+		for (int k = num_active - 1; k >= 0; k--) {
+			float sum = gram[k][num_active];
+
+			for (int l = k + 1; l < num_active; l++) {
+				sum -= gram[k][l] * r[l];
+			}
+
+			r[k] = sum / gram[k][k];
+		}
+
+		for (int k = 0; k < num_active; k++) {
+			for (int j = 0; j < N; j++) {
+				z[j] -= r[k] * _g[active[k]][j];
+			}
+		}
+	}
+
+	float _a[M][N] {}; ///< constraint normals
+	float _b[M] {}; ///< constraint bounds
+	float _g[M][N] {}; ///< scaled constraint normals
+	float _g_norm[M] {};
+	bool _is_active[M] {};
+	bool _was_active[M] {}; ///< active set of the last solve, used as warm start
+	int _num_constraints{0};
+	int _iterations{0};
+};
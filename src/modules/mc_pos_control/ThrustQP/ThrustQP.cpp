@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ThrustQP.cpp
+ */
+
+#include "ThrustQP.hpp"
+#include <mathlib/mathlib.h>
+#include <px4_defines.h>
+
+using namespace matrix;
+
+void ThrustQP::setLimits(const float thr_d_min, const float thr_d_max, const float thr_max, const float tilt)
+{
+	if (fabsf(thr_max - _thr_max) > FLT_EPSILON) {
+		// The tangent planes only stay valid as long as the sphere does not change
+		_num_cuts = 0;
+		_next_cut = 0;
+	}
+
+	_thr_d_min = thr_d_min;
+	_thr_d_max = thr_d_max;
+	_thr_max = thr_max;
+	_tilt = tilt;
+}
+
+void ThrustQP::_setupConstraints()
+{
+	_solver.clearConstraints();
+
+	// thr_d_min <= thrust_D <= thr_d_max
+	const float up[3] = {0.f, 0.f, 1.f};
+	const float down[3] = {0.f, 0.f, -1.f};
+	_solver.addConstraint(up, _thr_d_max);
+	_solver.addConstraint(down, -_thr_d_min);
+
+	// |thrust_NE| <= -thrust_D * tan(tilt), linearized by the facets of an inscribed pyramid.
+	// Tilt angles close to 90 degrees are only limited by the maximum thrust.
+	if (_tilt < math::radians(89.f)) {
+		const float slope = tanf(_tilt) * cosf(M_PI_F / TILT_FACETS);
+
+		for (int k = 0; k < TILT_FACETS; k++) {
+			const float angle = 2.f * M_PI_F * k / TILT_FACETS;
+			const float facet[3] = {cosf(angle), sinf(angle), slope};
+			_solver.addConstraint(facet, 0.f);
+		}
+	}
+
+	// |thrust| <= thr_max, outer approximation by the tangent planes found so far
+	for (int k = 0; k < _num_cuts; k++) {
+		_solver.addConstraint(_cuts[k], _thr_max);
+	}
+}
+
+Vector3f ThrustQP::update(const Vector3f &thrust_desired)
+{
+	const float weight[3] = {1.f, 1.f, WEIGHT_D};
+	const float thrust_des[3] = {thrust_desired(0), thrust_desired(1), thrust_desired(2)};
+	float thrust[3] {};
+	_iterations = 0;
+
+	for (int i = 0; i <= MAX_CUTS; i++) {
+		_setupConstraints();
+
+		if (!_solver.solve(thrust_des, weight, thrust)) {
+			// Cannot happen with consistent limits, fall back to the minimum upwards thrust
+			_solver.resetWarmStart();
+			return Vector3f(0.f, 0.f, math::constrain(thrust_desired(2), _thr_d_min, _thr_d_max));
+		}
+
+		_iterations += _solver.getIterations();
+		const float norm = sqrtf(thrust[0] * thrust[0] + thrust[1] * thrust[1] + thrust[2] * thrust[2]);
+
+		if (norm <= _thr_max * 1.001f || i == MAX_CUTS) {
+			break;
+		}
+
+		// Cut off the solution with the tangent plane at its projection onto the sphere
+		for (int j = 0; j < 3; j++) {
+			_cuts[_next_cut][j] = thrust[j] / norm;
+		}
+
+		_num_cuts = math::min(_num_cuts + 1, (int)MAX_CUTS);
+		_next_cut = (_next_cut + 1) % MAX_CUTS;
+	}
+
+	Vector3f thrust_sp(thrust[0], thrust[1], thrust[2]);
+
+	// The tangent planes are an outer approximation: remove what is left of the violation by scaling
+	// the whole vector, which keeps the tilt and only moves the D-component towards zero
+	const float norm = thrust_sp.length();
+
+	if (norm > _thr_max) {
+		thrust_sp *= _thr_max / norm;
+
+		if (thrust_sp(2) > _thr_d_max) {
+			// Nearly horizontal thrust: scaling gave up too much upwards thrust. Restore the D-limit and
+			// shorten the NE-component instead, which keeps the norm at thr_max and reduces the tilt.
+			thrust_sp(2) = _thr_d_max;
+			const float thr_ne_max = sqrtf(math::max(_thr_max * _thr_max - _thr_d_max * _thr_d_max, 0.f));
+			const float thr_ne = Vector2f(thrust_sp(0), thrust_sp(1)).length();
+
+			if (thr_ne > thr_ne_max) {
+				thrust_sp(0) *= thr_ne_max / thr_ne;
+				thrust_sp(1) *= thr_ne_max / thr_ne;
+			}
+		}
+	}
+
+	return thrust_sp;
+}
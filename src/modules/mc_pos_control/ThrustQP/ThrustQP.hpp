@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ThrustQP.hpp
+ *
+ * Saturation of the multicopter thrust setpoint by solving one small QP
+ * over the thrust limits in D-direction, the maximum tilt and the maximum
+ * thrust instead of applying them one after the other.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+#include "QPSolver.hpp"
+
+class ThrustQP
+{
+public:
+	ThrustQP() = default;
+	~ThrustQP() = default;
+
+	/**
+	 * Set the limits of the thrust setpoint (NED frame, normalized thrust)
+	 * @param thr_d_min lowest allowed thrust in D-direction (maximum upwards thrust, negative)
+	 * @param thr_d_max highest allowed thrust in D-direction (minimum upwards thrust, negative)
+	 * @param thr_max maximum norm of the thrust vector
+	 * @param tilt maximum angle between the thrust vector and the upwards direction [rad]
+	 */
+	void setLimits(const float thr_d_min, const float thr_d_max, const float thr_max, const float tilt);
+
+	/**
+	 * Find the thrust setpoint closest to the desired one that satisfies all limits.
+	 * The D-direction is weighted much higher than the NE-directions such that,
+	 * as with the sequential saturation, altitude control has priority.
+	 * @param thrust_desired unsaturated thrust setpoint
+	 * @return saturated thrust setpoint
+	 */
+	matrix::Vector3f update(const matrix::Vector3f &thrust_desired);
+
+	/**
+	 * @return total number of active-set iterations used in the last update
+	 */
+	int getIterations() const { return _iterations; }
+
+private:
+	static constexpr int TILT_FACETS = 16; ///< the tilt cone is approximated by an inscribed pyramid
+	static constexpr int MAX_CUTS = 4; ///< tangent planes approximating the maximum thrust sphere
+	static constexpr float WEIGHT_D = 100.f; ///< weight of the D-direction relative to N and E
+
+	void _setupConstraints();
+
+	QPSolver<2 + TILT_FACETS + MAX_CUTS> _solver;
+
+	float _thr_d_min{-1.f};
+	float _thr_d_max{0.f};
+	float _thr_max{1.f};
+	float _tilt{0.f};
+
+	float _cuts[MAX_CUTS][3] {}; ///< normals of the tangent planes, kept from one update to the next
+	int _num_cuts{0};
+	int _next_cut{0}; ///< slot replaced by the next cut once all are in use
+	int _iterations{0};
+};
@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the thrust saturation QP
+ * Run this test only using make tests TESTFILTER=ThrustQP
+ */
+
+#include <gtest/gtest.h>
+#include <matrix/matrix/math.hpp>
+#include <mathlib/mathlib.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include <ThrustQP.hpp>
+
+using namespace matrix;
+
+static constexpr float THR_D_MIN = -0.9f; // MPC_THR_MAX
+static constexpr float THR_D_MAX = -0.12f; // MPC_THR_MIN
+static constexpr float THR_MAX = 0.9f;
+static constexpr float TILT = 0.785398f; // 45 degrees
+
+/* Sequential saturation as done in PositionControl::_velocityController() */
+static Vector3f saturateSequential(const Vector3f &thrust_desired)
+{
+	Vector3f thrust;
+	thrust(2) = math::constrain(thrust_desired(2), THR_D_MIN, THR_D_MAX);
+
+	const float thrust_max_NE = math::min(fabsf(thrust(2)) * tanf(TILT), sqrtf(THR_MAX * THR_MAX - thrust(2) * thrust(2)));
+	const Vector2f thrust_NE(thrust_desired(0), thrust_desired(1));
+	const Vector2f thrust_NE_sat = (thrust_NE.length() > thrust_max_NE) ? thrust_NE.normalized() * thrust_max_NE : thrust_NE;
+	thrust(0) = thrust_NE_sat(0);
+	thrust(1) = thrust_NE_sat(1);
+	return thrust;
+}
+
+static void expectWithinLimits(const Vector3f &thrust)
+{
+	EXPECT_GE(thrust(2), THR_D_MIN - 1e-4f);
+	EXPECT_LE(thrust(2), THR_D_MAX + 1e-4f);
+	EXPECT_LE(thrust.length(), THR_MAX + 1e-4f);
+	EXPECT_LE(Vector2f(thrust).length(), -thrust(2) * tanf(TILT) + 1e-4f);
+}
+
+class ThrustQPTest : public ::testing::Test
+{
+public:
+	void SetUp() override { _qp.setLimits(THR_D_MIN, THR_D_MAX, THR_MAX, TILT); }
+
+	ThrustQP _qp;
+};
+
+TEST_F(ThrustQPTest, InsideLimits)
+{
+	// GIVEN: a thrust setpoint that satisfies all limits
+	const Vector3f thrust_desired(0.1f, -0.05f, -0.5f);
+
+	// THEN: it is not modified
+	const Vector3f thrust = _qp.update(thrust_desired);
+	EXPECT_TRUE(isEqual(thrust, thrust_desired));
+	EXPECT_EQ(_qp.getIterations(), 1);
+}
+
+TEST_F(ThrustQPTest, SingleActiveLimit)
+{
+	// WHEN: only one of the limits is active
+	// THEN: the result matches the sequential saturation
+	const Vector3f desired[] = {
+		Vector3f(0.f, 0.f, 0.2f), // downwards thrust
+		Vector3f(0.f, 0.f, -1.5f), // more than the maximum thrust upwards
+		Vector3f(0.3f, 0.4f, -0.4f), // tilt
+	};
+
+	for (const Vector3f &thrust_desired : desired) {
+		const Vector3f thrust = _qp.update(thrust_desired);
+		const Vector3f thrust_sequential = saturateSequential(thrust_desired);
+		expectWithinLimits(thrust);
+		EXPECT_NEAR(thrust(2), thrust_sequential(2), 1e-3f);
+		// the tilt cone is approximated from the inside
+		EXPECT_NEAR(Vector2f(thrust).length(), Vector2f(thrust_sequential).length(), 0.02f * Vector2f(thrust_sequential).length());
+		EXPECT_GE(Vector2f(thrust) * Vector2f(thrust_sequential), 0.f);
+	}
+}
+
+TEST_F(ThrustQPTest, CombinedLimits)
+{
+	// GIVEN: full upwards thrust and a horizontal thrust demand
+	const Vector3f thrust_desired(0.3f, 0.f, -1.2f);
+
+	// WHEN: the D-direction is saturated at the maximum thrust
+	const Vector3f thrust_sequential = saturateSequential(thrust_desired);
+	const Vector3f thrust = _qp.update(thrust_desired);
+
+	// THEN: the sequential saturation removes all horizontal thrust
+	// while the QP trades a bit of vertical thrust to keep horizontal control
+	EXPECT_NEAR(Vector2f(thrust_sequential).length(), 0.f, 1e-6f);
+	EXPECT_GT(thrust(0), 0.01f);
+	EXPECT_LT(thrust(2), -0.85f);
+	expectWithinLimits(thrust);
+}
+
+TEST_F(ThrustQPTest, SphereOnly)
+{
+	// GIVEN: a tilt limit close to 90 degrees, only the tangent planes of the sphere limit NE
+	_qp.setLimits(THR_D_MIN, THR_D_MAX, THR_MAX, math::radians(89.5f));
+
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<float> distribution(-3.f, 3.f);
+
+	for (int i = 0; i < 1000; i++) {
+		// WHEN: the desired thrust is mostly horizontal with little upwards thrust
+		const Vector3f thrust_desired(distribution(generator), distribution(generator), THR_D_MAX);
+		const Vector3f thrust = _qp.update(thrust_desired);
+
+		// THEN: removing the remaining violation of the sphere keeps the D-limits
+		EXPECT_LE(thrust.length(), THR_MAX + 1e-5f);
+		EXPECT_LE(thrust(2), THR_D_MAX + 1e-5f);
+		EXPECT_GE(thrust(2), THR_D_MIN - 1e-5f);
+	}
+}
+
+TEST_F(ThrustQPTest, RandomSetpoints)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> distribution(-1.5f, 1.f);
+
+	int max_iterations = 0;
+
+	for (int i = 0; i < 10000; i++) {
+		const Vector3f thrust_desired(distribution(generator), distribution(generator), distribution(generator));
+		const Vector3f thrust = _qp.update(thrust_desired);
+		expectWithinLimits(thrust);
+		max_iterations = math::max(max_iterations, _qp.getIterations());
+	}
+
+	printf("maximum iterations: %d\n", max_iterations);
+	EXPECT_LE(max_iterations, 40);
+}
+
+TEST_F(ThrustQPTest, Benchmark)
+{
+	// Slowly varying setpoints like in flight, such that the warm start is effective
+	static constexpr int N = 100000;
+	Vector3f desired[64];
+
+	for (int i = 0; i < 64; i++) {
+		const float phase = 2.f * (float)M_PI * i / 64;
+		desired[i] = Vector3f(0.6f * cosf(phase), 0.6f * sinf(phase), -0.6f - 0.5f * sinf(2.f * phase));
+	}
+
+	float sum = 0.f;
+	int iterations = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < N; i++) {
+		sum += saturateSequential(desired[i % 64])(0);
+	}
+
+	const double sequential_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < N; i++) {
+		sum += _qp.update(desired[i % 64])(0);
+		iterations += _qp.getIterations();
+	}
+
+	const double qp_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+	printf("sequential saturation: %.3f us, QP: %.3f us (%.2f iterations) per call (%.1f)\n",
+	       sequential_us / N, qp_us / N, (double)iterations / N, (double)sum);
+	EXPECT_LT(qp_us / N, 50.);
+}
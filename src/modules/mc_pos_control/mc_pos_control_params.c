@@ -95,6 +95,24 @@ PARAM_DEFINE_FLOAT(MPC_THR_HOVER, 0.5f);
  */
 PARAM_DEFINE_INT32(MPC_THR_CURVE, 0);
 
+/**
+ * Thrust saturation method
+ *
+ * Defines how the thrust setpoint of the velocity controller is limited by
+ * MPC_THR_MIN, MPC_THR_MAX and the maximum tilt.
+ *
+ * With 'Sequential', the vertical thrust is saturated first and the horizontal
+ * thrust is limited by what is left. With 'Constrained optimization', the thrust
+ * closest to the desired one under all limits is computed at once, with a high
+ * priority on vertical thrust. At full throttle, this keeps some horizontal thrust
+ * by giving up a bit of vertical thrust.
+ *
+ * @value 0 Sequential
+ * @value 1 Constrained optimization
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_INT32(MPC_THR_ALLOC, 0);
+
 /**
  * Maximum thrust in auto thrust control
  *
@@ -0,0 +1,74 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file MissionItemCursor.cpp
+ */
+
+#include "MissionItemCursor.hpp"
+
+bool
+MissionItemCursor::advance(const mission_item_s &item)
+{
+	if (item.nav_cmd == NAV_CMD_DO_JUMP && _follow_jumps) {
+		Jump *jump = nullptr;
+
+		for (int i = 0; i < _num_jumps; i++) {
+			if (_jumps[i].index == _index) {
+				jump = &_jumps[i];
+				break;
+			}
+		}
+
+		if (jump == nullptr) {
+			if (_num_jumps >= MAX_JUMPS) {
+				return false;
+			}
+
+			/* first visit, continue from the repetitions already done */
+			jump = &_jumps[_num_jumps++];
+			jump->index = _index;
+			jump->count = item.do_jump_current_count;
+		}
+
+		if (jump->count < item.do_jump_repeat_count) {
+			jump->count++;
+			_index = item.do_jump_mission_index;
+			return true;
+		}
+	}
+
+	_index += _reverse ? -1 : 1;
+	return true;
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file MissionItemCursor.hpp
+ *
+ * Walks the items of a mission ahead of the current one, following DO_JUMPs
+ * like the mission execution will, without touching the stored jump counters.
+ */
+
+#pragma once
+
+#include <navigator/navigation.h>
+
+class MissionItemCursor
+{
+public:
+	/**
+	 * @param index		mission index to start from
+	 * @param reverse	walk the mission backwards
+	 * @param follow_jumps	execute DO_JUMPs, otherwise they are skipped like in reverse or fast forward mode
+	 */
+	MissionItemCursor(int index, bool reverse, bool follow_jumps) :
+		_index(index), _reverse(reverse), _follow_jumps(follow_jumps) {}
+	~MissionItemCursor() = default;
+
+	/**
+	 * @return mission index of the item to read next
+	 */
+	int index() const { return _index; }
+
+	/**
+	 * Move past the item read at index().
+	 *
+	 * A DO_JUMP that still has repetitions left moves the cursor to its target
+	 * and counts the repetition locally; any other item moves one step on.
+	 * @param item	the mission item stored at index()
+	 * @return false if the cursor cannot follow the item (too many distinct DO_JUMPs)
+	 */
+	bool advance(const mission_item_s &item);
+
+	static constexpr int MAX_JUMPS = 4; ///< distinct DO_JUMP items that are tracked
+
+private:
+	struct Jump {
+		int index;
+		uint16_t count;
+	};
+
+	int _index;
+	const bool _reverse;
+	const bool _follow_jumps;
+
+	Jump _jumps[MAX_JUMPS] {};
+	int _num_jumps{0};
+};
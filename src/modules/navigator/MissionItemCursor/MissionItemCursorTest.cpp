@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <MissionItemCursor.hpp>
+
+#include <vector>
+
+static mission_item_s waypoint()
+{
+	mission_item_s item{};
+	item.nav_cmd = NAV_CMD_WAYPOINT;
+	return item;
+}
+
+static mission_item_s do_jump(int16_t target, uint16_t repeat, uint16_t current = 0)
+{
+	mission_item_s item{};
+	item.nav_cmd = NAV_CMD_DO_JUMP;
+	item.do_jump_mission_index = target;
+	item.do_jump_repeat_count = repeat;
+	item.do_jump_current_count = current;
+	return item;
+}
+
+/** Indices of the non-jump items visited from start, at most max_reads items are read */
+static std::vector<int> walk(const std::vector<mission_item_s> &mission, int start, bool reverse, int max_reads = 30)
+{
+	std::vector<int> visited;
+	MissionItemCursor cursor(start, reverse, !reverse);
+
+	for (int i = 0; i < max_reads && cursor.index() >= 0 && cursor.index() < (int)mission.size(); i++) {
+		const mission_item_s &item = mission[cursor.index()];
+
+		if (item.nav_cmd != NAV_CMD_DO_JUMP) {
+			visited.push_back(cursor.index());
+		}
+
+		if (!cursor.advance(item)) {
+			break;
+		}
+	}
+
+	return visited;
+}
+
+TEST(MissionItemCursorTest, Sequential)
+{
+	const std::vector<mission_item_s> mission{waypoint(), waypoint(), waypoint()};
+
+	EXPECT_EQ(walk(mission, 0, false), (std::vector<int> {0, 1, 2}));
+	EXPECT_EQ(walk(mission, 2, true), (std::vector<int> {2, 1, 0}));
+}
+
+TEST(MissionItemCursorTest, DoJump)
+{
+	// 0 1 2 (3: jump to 1, twice) 4
+	const std::vector<mission_item_s> mission{waypoint(), waypoint(), waypoint(), do_jump(1, 2), waypoint()};
+
+	EXPECT_EQ(walk(mission, 0, false), (std::vector<int> {0, 1, 2, 1, 2, 1, 2, 4}));
+
+	// every look-ahead position follows the same path, not only the one landing on the jump
+	EXPECT_EQ(walk(mission, 2, false), (std::vector<int> {2, 1, 2, 1, 2, 4}));
+}
+
+TEST(MissionItemCursorTest, DoJumpPartlyDone)
+{
+	// the stored count of repetitions already flown is respected, but never modified
+	const std::vector<mission_item_s> mission{waypoint(), waypoint(), do_jump(0, 3, 2), waypoint()};
+
+	EXPECT_EQ(walk(mission, 1, false), (std::vector<int> {1, 0, 1, 3}));
+	EXPECT_EQ(mission[2].do_jump_current_count, 2);
+}
+
+TEST(MissionItemCursorTest, ReverseSkipsJumps)
+{
+	const std::vector<mission_item_s> mission{waypoint(), waypoint(), do_jump(0, 3), waypoint()};
+
+	EXPECT_EQ(walk(mission, 3, true), (std::vector<int> {3, 1, 0}));
+}
+
+TEST(MissionItemCursorTest, NestedJumps)
+{
+	// 0 (1: jump to 0 once) 2 (3: jump to 0 once) 4
+	const std::vector<mission_item_s> mission{waypoint(), do_jump(0, 1), waypoint(), do_jump(0, 1), waypoint()};
+
+	EXPECT_EQ(walk(mission, 0, false), (std::vector<int> {0, 0, 2, 0, 2, 4}));
+}
+
+TEST(MissionItemCursorTest, CyclingJumpsAreBounded)
+{
+	// a jump onto itself would cycle forever without the read limit
+	const std::vector<mission_item_s> mission{waypoint(), do_jump(1, 1000), waypoint()};
+
+	EXPECT_EQ(walk(mission, 0, false, 10), (std::vector<int> {0}));
+}
+
+TEST(MissionItemCursorTest, TooManyJumps)
+{
+	std::vector<mission_item_s> mission{waypoint()};
+
+	for (int i = 0; i <= MissionItemCursor::MAX_JUMPS; i++) {
+		mission.push_back(do_jump(mission.size() + 1, 1));
+		mission.push_back(waypoint());
+	}
+
+	const std::vector<int> visited = walk(mission, 0, false);
+
+	// the cursor stops at the first jump it cannot track
+	EXPECT_EQ(visited.size(), (size_t)MissionItemCursor::MAX_JUMPS + 1);
+}
@@ -94,7 +94,7 @@ void FollowTarget::on_activation()
 
 void FollowTarget::on_active()
 {
-	struct map_projection_reference_s target_ref;
+	const LocalProjection &projection = _navigator->get_home_projection();
 	follow_target_s target_motion_with_offset = {};
 	uint64_t current_time = hrt_absolute_time();
 	bool _radius_entered = false;
@@ -129,13 +129,14 @@ void FollowTarget::on_active()
 
 	// update distance to target
 
-	if (target_position_valid()) {
+	if (target_position_valid() && projection.isInitialized()) {
 
 		// get distance to target
 
-		map_projection_init(&target_ref, _navigator->get_global_position()->lat, _navigator->get_global_position()->lon);
-		map_projection_project(&target_ref, _current_target_motion.lat, _current_target_motion.lon, &_target_distance(0),
-				       &_target_distance(1));
+		const Vector2f target_distance = projection.vector(_navigator->get_global_position()->lat,
+						 _navigator->get_global_position()->lon, _current_target_motion.lat, _current_target_motion.lon);
+		_target_distance(0) = target_distance(0);
+		_target_distance(1) = target_distance(1);
 
 	}
 
@@ -146,13 +147,12 @@ void FollowTarget::on_active()
 		dt_ms = ((_current_target_motion.timestamp - _previous_target_motion.timestamp) / 1000);
 
 		// ignore a small dt
-		if (dt_ms > 10.0F) {
-			// get last gps known reference for target
-			map_projection_init(&target_ref, _previous_target_motion.lat, _previous_target_motion.lon);
-
+		if (dt_ms > 10.0F && projection.isInitialized()) {
 			// calculate distance the target has moved
-			map_projection_project(&target_ref, _current_target_motion.lat, _current_target_motion.lon,
-					       &(_target_position_delta(0)), &(_target_position_delta(1)));
+			const Vector2f target_position_delta = projection.vector(_previous_target_motion.lat, _previous_target_motion.lon,
+							       _current_target_motion.lat, _current_target_motion.lon);
+			_target_position_delta(0) = target_position_delta(0);
+			_target_position_delta(1) = target_position_delta(1);
 
 			// update the average velocity of the target based on the position
 			_est_target_vel = _target_position_delta / (dt_ms / 1000.0f);
@@ -216,13 +216,13 @@ void FollowTarget::on_active()
 //				(double) _yaw_rate);
 	}
 
-	if (target_position_valid()) {
+	if (target_position_valid() && projection.isInitialized()) {
 
 		// get the target position using the calculated offset
 
-		map_projection_init(&target_ref,  _current_target_motion.lat, _current_target_motion.lon);
-		map_projection_reproject(&target_ref, _target_position_offset(0), _target_position_offset(1),
-					 &target_motion_with_offset.lat, &target_motion_with_offset.lon);
+		const Vector2f target_position = projection.project(_current_target_motion.lat, _current_target_motion.lon);
+		projection.reproject(target_position + Vector2f(_target_position_offset(0), _target_position_offset(1)),
+				     target_motion_with_offset.lat, target_motion_with_offset.lon);
 	}
 
 	// clamp yaw rate smoothing if we are with in
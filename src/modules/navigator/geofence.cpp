@@ -218,6 +218,28 @@ bool Geofence::check(const struct mission_item_s &mission_item)
 	return checkAll(mission_item.lat, mission_item.lon, mission_item.altitude);
 }
 
+bool Geofence::checkPoint(double lat, double lon, float altitude)
+{
+	if (isHomeRequired() && _navigator->home_position_valid()) {
+		const float max_horizontal_distance = _param_gf_max_hor_dist.get();
+		const float max_vertical_distance = _param_gf_max_ver_dist.get();
+
+		const home_position_s *home = _navigator->get_home_position();
+
+		float dist_xy = -1.0f;
+		float dist_z = -1.0f;
+
+		_navigator->get_distance_global(lat, lon, altitude, home->lat, home->lon, home->alt, &dist_xy, &dist_z);
+
+		if ((max_vertical_distance > FLT_EPSILON && (dist_z > max_vertical_distance))
+		    || (max_horizontal_distance > FLT_EPSILON && (dist_xy > max_horizontal_distance))) {
+			return false;
+		}
+	}
+
+	return checkPolygons(lat, lon, altitude);
+}
+
 bool Geofence::checkAll(double lat, double lon, float altitude)
 {
 	bool inside_fence = true;
@@ -234,7 +256,7 @@ bool Geofence::checkAll(double lat, double lon, float altitude)
 		float dist_xy = -1.0f;
 		float dist_z = -1.0f;
 
-		get_distance_to_point_global_wgs84(lat, lon, altitude, home_lat, home_lon, home_alt, &dist_xy, &dist_z);
+		_navigator->get_distance_global(lat, lon, altitude, home_lat, home_lon, home_alt, &dist_xy, &dist_z);
 
 		if (max_vertical_distance > FLT_EPSILON && (dist_z > max_vertical_distance)) {
 			if (hrt_elapsed_time(&_last_vertical_range_warning) > GEOFENCE_RANGE_WARNING_LIMIT) {
@@ -415,15 +437,12 @@ bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon,
 		return false;
 	}
 
-	if (!map_projection_initialized(&_projection_reference)) {
-		map_projection_init(&_projection_reference, lat, lon);
+	if (!_projection_reference.isInitialized()) {
+		_projection_reference.init(lat, lon);
 	}
 
-	float x1, y1, x2, y2;
-	map_projection_project(&_projection_reference, lat, lon, &x1, &y1);
-	map_projection_project(&_projection_reference, circle_point.lat, circle_point.lon, &x2, &y2);
-	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	const matrix::Vector2f delta = _projection_reference.vector(lat, lon, circle_point.lat, circle_point.lon);
+	return delta.norm_squared() < circle_point.circle_radius * circle_point.circle_radius;
 }
 
 bool
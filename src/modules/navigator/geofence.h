@@ -45,6 +45,7 @@
 #include <px4_module_params.h>
 #include <drivers/drv_hrt.h>
 #include <lib/ecl/geo/geo.h>
+#include <lib/LocalProjection/LocalProjection.hpp>
 #include <px4_defines.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
@@ -97,6 +98,16 @@ public:
 	 */
 	bool check(const struct mission_item_s &mission_item);
 
+	/**
+	 * Return whether a fixed point, e.g. a return destination, is inside the geofence.
+	 * Unlike check() this has no GF_COUNT hysteresis and sends no warnings, so it can
+	 * be evaluated for candidate points without affecting the breach detection.
+	 *
+	 * @param altitude AMSL
+	 * @return true if the point is inside the fence
+	 */
+	bool checkPoint(double lat, double lon, float altitude);
+
 	int clearDm();
 
 	bool valid();
@@ -155,7 +166,7 @@ private:
 	PolygonInfo *_polygons{nullptr};
 	int _num_polygons{0};
 
-	map_projection_reference_s _projection_reference = {}; ///< reference to convert (lon, lat) to local [m]
+	LocalProjection _projection_reference; ///< reference to convert (lon, lat) to local [m]
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::GF_ACTION>) _param_gf_action,
@@ -47,6 +47,7 @@
 
 #include "mission.h"
 #include "navigator.h"
+#include "MissionItemCursor.hpp"
 
 #include <string.h>
 #include <drivers/drv_hrt.h>
@@ -143,6 +144,9 @@ Mission::on_inactivation()
 	cmd.param1 = -1.0f;
 	cmd.param3 = 1.0f;
 	_navigator->publish_vehicle_cmd(&cmd);
+
+	// the waypoint horizon is only valid while the mission is active
+	publish_waypoint_horizon(position_setpoint_s{});
 }
 
 void
@@ -1085,9 +1089,75 @@ Mission::set_mission_items()
 						     pos_sp_triplet->previous.lat, pos_sp_triplet->previous.lon);
 	}
 
+	publish_waypoint_horizon(pos_sp_triplet->next);
+
 	_navigator->set_position_setpoint_triplet_updated();
 }
 
+void
+Mission::publish_waypoint_horizon(const position_setpoint_s &next)
+{
+	position_setpoint_horizon_s horizon{};
+
+	if (next.valid && _mission_type == MISSION_TYPE_MISSION) {
+		const bool reverse = _mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_REVERSE;
+		const bool execute_jumps = _mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_NORMAL;
+		const int max_items_to_read = 3 * position_setpoint_horizon_s::HORIZON_LENGTH;
+		const dm_item_t dm_item = (dm_item_t)_mission.dataman_id;
+		bool next_found = false;
+
+		/* walk the items once, following DO_JUMPs with local repeat counters like read_mission_item() would */
+		MissionItemCursor cursor(_current_mission_index + (reverse ? -1 : 1), reverse, execute_jumps);
+
+		/* the next position item is already in the triplet (with limitations applied), use that one */
+		horizon.lat[0] = next.lat;
+		horizon.lon[0] = next.lon;
+		horizon.alt[0] = next.alt;
+		horizon.acceptance_radius[0] = next.acceptance_radius;
+		horizon.count = 1;
+
+		for (int i = 0; i < max_items_to_read && horizon.count < position_setpoint_horizon_s::HORIZON_LENGTH; i++) {
+			if (cursor.index() < 0 || cursor.index() >= (int)_mission.count) {
+				break;
+			}
+
+			struct mission_item_s item;
+			const ssize_t len = sizeof(item);
+
+			if (dm_read(dm_item, cursor.index(), &item, len) != len) {
+				break;
+			}
+
+			if (!cursor.advance(item)) {
+				break;
+			}
+
+			if (!item_contains_position(item)) {
+				continue;
+			}
+
+			if (next_found) {
+				const unsigned n = horizon.count++;
+				horizon.lat[n] = item.lat;
+				horizon.lon[n] = item.lon;
+				horizon.alt[n] = get_absolute_altitude_for_item(item);
+				horizon.acceptance_radius[n] = (item.acceptance_radius > 0.0f && PX4_ISFINITE(item.acceptance_radius)) ?
+							       item.acceptance_radius : _navigator->get_default_acceptance_radius();
+			}
+
+			next_found = true;
+
+			/* the vehicle stops at this waypoint, nothing after it matters for the speed planning */
+			if (item.nav_cmd != NAV_CMD_WAYPOINT || !item.autocontinue || get_time_inside(item) > FLT_EPSILON) {
+				break;
+			}
+		}
+	}
+
+	horizon.timestamp = hrt_absolute_time();
+	_waypoint_horizon_pub.publish(horizon);
+}
+
 bool
 Mission::do_need_vertical_takeoff()
 {
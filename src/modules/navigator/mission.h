@@ -53,10 +53,12 @@
 #include <dataman/dataman.h>
 #include <drivers/drv_hrt.h>
 #include <px4_module_params.h>
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/mission_result.h>
+#include <uORB/topics/position_setpoint_horizon.h>
 #include <uORB/topics/position_setpoint_triplet.h>
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/vehicle_status.h>
@@ -176,6 +178,12 @@ private:
 	bool prepare_mission_items(mission_item_s *mission_item,
 				   mission_item_s *next_position_mission_item, bool *has_next_position_item);
 
+	/**
+	 * Publish the upcoming position mission items, starting with the next position setpoint,
+	 * until the first one at which the vehicle has to stop.
+	 */
+	void publish_waypoint_horizon(const position_setpoint_s &next);
+
 	/**
 	 * Read current (offset == 0) or a specific (offset > 0) mission item
 	 * from the dataman and watch out for DO_JUMPS
@@ -244,6 +252,7 @@ private:
 	)
 
 	uORB::Subscription	_mission_sub{ORB_ID(mission)};		/**< mission subscription */
+	uORB::Publication<position_setpoint_horizon_s>	_waypoint_horizon_pub{ORB_ID(position_setpoint_horizon)};
 	mission_s		_mission {};
 
 	int32_t _current_mission_index{-1};
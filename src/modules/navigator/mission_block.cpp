@@ -142,11 +142,11 @@ MissionBlock::is_mission_item_reached()
 				      ? _mission_item.altitude + _navigator->get_home_position()->alt
 				      : _mission_item.altitude;
 
-		dist = get_distance_to_point_global_wgs84(_mission_item.lat, _mission_item.lon, altitude_amsl,
-				_navigator->get_global_position()->lat,
-				_navigator->get_global_position()->lon,
-				_navigator->get_global_position()->alt,
-				&dist_xy, &dist_z);
+		dist = _navigator->get_distance_global(_mission_item.lat, _mission_item.lon, altitude_amsl,
+						       _navigator->get_global_position()->lat,
+						       _navigator->get_global_position()->lon,
+						       _navigator->get_global_position()->alt,
+						       &dist_xy, &dist_z);
 
 		/* FW special case for NAV_CMD_WAYPOINT to achieve altitude via loiter */
 		if (_navigator->get_vstatus()->vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING &&
@@ -244,11 +244,11 @@ MissionBlock::is_mission_item_reached()
 				dist_xy = -1.0f;
 				dist_z = -1.0f;
 
-				dist = get_distance_to_point_global_wgs84(_mission_item.lat, _mission_item.lon, curr_sp->alt,
-						_navigator->get_global_position()->lat,
-						_navigator->get_global_position()->lon,
-						_navigator->get_global_position()->alt,
-						&dist_xy, &dist_z);
+				dist = _navigator->get_distance_global(_mission_item.lat, _mission_item.lon, curr_sp->alt,
+								       _navigator->get_global_position()->lat,
+								       _navigator->get_global_position()->lon,
+								       _navigator->get_global_position()->alt,
+								       &dist_xy, &dist_z);
 
 				if (dist >= 0.0f && dist <= _navigator->get_acceptance_radius(fabsf(_mission_item.loiter_radius) * 1.2f)
 				    && dist_z <= _navigator->get_default_altitude_acceptance_radius()) {
@@ -57,6 +57,7 @@
 
 #include "navigation.h"
 
+#include <lib/LocalProjection/LocalProjection.hpp>
 #include <lib/perf/perf_counter.h>
 #include <px4_module.h>
 #include <px4_module_params.h>
@@ -167,6 +168,21 @@ public:
 
 	Geofence	&get_geofence() { return _geofence; }
 
+	/**
+	 * Local projection around home, or around the first global position while there is no home.
+	 * Not initialized before either is known.
+	 */
+	const LocalProjection &get_home_projection() const { return _home_projection; }
+
+	/**
+	 * Distance between two global positions, same as get_distance_to_point_global_wgs84() but using the
+	 * cached home projection if it is initialized
+	 *
+	 * @return 3D distance [m]
+	 */
+	float		get_distance_global(double lat_now, double lon_now, float alt_now,
+					    double lat_next, double lon_next, float alt_next, float *dist_xy, float *dist_z) const;
+
 	bool		get_can_loiter_at_sp() { return _can_loiter_at_sp; }
 	float		get_loiter_radius() { return _param_nav_loiter_rad.get(); }
 
@@ -356,6 +372,8 @@ private:
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
 	Geofence	_geofence;			/**< class that handles the geofence */
+
+	LocalProjection	_home_projection;		/**< projection around home for the navigation geometry */
 	bool		_geofence_violation_warning_sent{false}; /**< prevents spaming to mavlink */
 
 	bool		_can_loiter_at_sp{false};			/**< flags if current position SP can be used to loiter */
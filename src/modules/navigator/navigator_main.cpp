@@ -212,7 +212,13 @@ Navigator::run()
 		_vstatus_sub.update(&_vstatus);
 		_land_detected_sub.update(&_land_detected);
 		_position_controller_status_sub.update();
-		_home_pos_sub.update(&_home_pos);
+
+		if (_home_pos_sub.update(&_home_pos) && _home_pos.valid_hpos) {
+			_home_projection.init(_home_pos.lat, _home_pos.lon);
+
+		} else if (!_home_projection.isInitialized() && _global_pos.timestamp > 0) {
+			_home_projection.init(_global_pos.lat, _global_pos.lon);
+		}
 
 		if (_vehicle_command_sub.updated()) {
 			vehicle_command_s cmd{};
@@ -563,6 +569,14 @@ Navigator::run()
 
 					break;
 
+				case RTL::RTL_CLOSEST:
+					if (rtl_activated) {
+						mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Closest activated");
+					}
+
+					navigation_mode_new = &_rtl;
+					break;
+
 				default:
 					if (rtl_activated) {
 						mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL HOME activated");
@@ -737,6 +751,23 @@ Navigator::publish_position_setpoint_triplet()
 	_pos_sp_triplet_updated = false;
 }
 
+float
+Navigator::get_distance_global(double lat_now, double lon_now, float alt_now,
+			       double lat_next, double lon_next, float alt_next, float *dist_xy, float *dist_z) const
+{
+	if (!_home_projection.isInitialized()) {
+		return get_distance_to_point_global_wgs84(lat_now, lon_now, alt_now, lat_next, lon_next, alt_next, dist_xy, dist_z);
+	}
+
+	const float dxy = _home_projection.distance(lat_now, lon_now, lat_next, lon_next);
+	const float dz = alt_now - alt_next;
+
+	*dist_xy = dxy;
+	*dist_z = fabsf(dz);
+
+	return sqrtf(dxy * dxy + dz * dz);
+}
+
 float
 Navigator::get_default_acceptance_radius()
 {
@@ -961,8 +992,7 @@ void Navigator::check_traffic()
 		}
 
 		float d_hor, d_vert;
-		get_distance_to_point_global_wgs84(lat, lon, alt,
-						   tr.lat, tr.lon, tr.altitude, &d_hor, &d_vert);
+		get_distance_global(lat, lon, alt, tr.lat, tr.lon, tr.altitude, &d_hor, &d_vert);
 
 
 		// predict final altitude (positive is up) in prediction time frame
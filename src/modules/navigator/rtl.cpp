@@ -45,6 +45,9 @@
 
 static constexpr float DELAY_SIGMA = 0.01f;
 
+// minimum time between two checks of the dataman safe point stats
+static constexpr hrt_abstime SAFE_POINTS_CHECK_INTERVAL = 1000000;
+
 RTL::RTL(Navigator *navigator) :
 	MissionBlock(navigator),
 	ModuleParams(navigator)
@@ -56,6 +59,10 @@ RTL::on_inactive()
 {
 	// Reset RTL state.
 	_rtl_state = RTL_STATE_NONE;
+
+	// Keep the safe point cache current so activation does not need to wait for dataman,
+	// rtl_energy uses the published copy for every RTL_TYPE.
+	update_safe_points();
 }
 
 int
@@ -67,6 +74,7 @@ RTL::rtl_type() const
 void
 RTL::on_activation()
 {
+	find_RTL_destination();
 
 	_rtl_alt = calculate_return_alt_from_cone_half_angle((float)_param_rtl_cone_half_angle_deg.get());
 
@@ -77,7 +85,7 @@ RTL::on_activation()
 	} else if ((rtl_type() == RTL_LAND) && _navigator->on_mission_landing()) {
 		// RTL straight to RETURN state, but mission will takeover for landing.
 
-	} else if ((_navigator->get_global_position()->alt < _navigator->get_home_position()->alt + _param_rtl_return_alt.get())
+	} else if ((_navigator->get_global_position()->alt < _destination.alt + _param_rtl_return_alt.get())
 		   || _rtl_alt_min) {
 
 		// If lower than return altitude, climb up first.
@@ -128,16 +136,17 @@ RTL::set_rtl_item()
 
 	_navigator->set_can_loiter_at_sp(false);
 
-	const home_position_s &home = *_navigator->get_home_position();
+	const RTLPosition &destination = _destination;
+	const char *destination_name = _destination_is_home ? "home" : "safe point";
 	const vehicle_global_position_s &gpos = *_navigator->get_global_position();
 
 	position_setpoint_triplet_s *pos_sp_triplet = _navigator->get_position_setpoint_triplet();
 
-	// Check if we are pretty close to home already.
-	const float home_dist = get_distance_to_next_waypoint(home.lat, home.lon, gpos.lat, gpos.lon);
+	// Check if we are pretty close to the destination already.
+	const float destination_dist = get_distance_to_next_waypoint(destination.lat, destination.lon, gpos.lat, gpos.lon);
 
 	// Compute the loiter altitude.
-	const float loiter_altitude = math::min(home.alt + _param_rtl_descend_alt.get(), gpos.alt);
+	const float loiter_altitude = math::min(destination.alt + _param_rtl_descend_alt.get(), gpos.alt);
 
 	switch (_rtl_state) {
 	case RTL_STATE_CLIMB: {
@@ -153,8 +162,8 @@ RTL::set_rtl_item()
 			_mission_item.autocontinue = true;
 			_mission_item.origin = ORIGIN_ONBOARD;
 
-			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: climb to %d m (%d m above home)",
-						     (int)ceilf(_rtl_alt), (int)ceilf(_rtl_alt - _navigator->get_home_position()->alt));
+			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: climb to %d m (%d m above %s)",
+						     (int)ceilf(_rtl_alt), (int)ceilf(_rtl_alt - destination.alt), destination_name);
 			break;
 		}
 
@@ -162,19 +171,19 @@ RTL::set_rtl_item()
 
 			// Don't change altitude.
 			_mission_item.nav_cmd = NAV_CMD_WAYPOINT;
-			_mission_item.lat = home.lat;
-			_mission_item.lon = home.lon;
+			_mission_item.lat = destination.lat;
+			_mission_item.lon = destination.lon;
 			_mission_item.altitude = _rtl_alt;
 			_mission_item.altitude_is_relative = false;
 
-			// Use home yaw if close to home.
-			// Check if we are pretty close to home already.
-			if (home_dist < _param_rtl_min_dist.get()) {
-				_mission_item.yaw = home.yaw;
+			// Use destination yaw if close to the destination.
+			// Check if we are pretty close to the destination already.
+			if (destination_dist < _param_rtl_min_dist.get()) {
+				_mission_item.yaw = destination.yaw;
 
 			} else {
-				// Use current heading to home.
-				_mission_item.yaw = get_bearing_to_next_waypoint(gpos.lat, gpos.lon, home.lat, home.lon);
+				// Use current heading to the destination.
+				_mission_item.yaw = get_bearing_to_next_waypoint(gpos.lat, gpos.lon, destination.lat, destination.lon);
 			}
 
 			_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
@@ -182,8 +191,9 @@ RTL::set_rtl_item()
 			_mission_item.autocontinue = true;
 			_mission_item.origin = ORIGIN_ONBOARD;
 
-			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: return at %d m (%d m above home)",
-						     (int)ceilf(_mission_item.altitude), (int)ceilf(_mission_item.altitude - home.alt));
+			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: return at %d m (%d m above %s)",
+						     (int)ceilf(_mission_item.altitude), (int)ceilf(_mission_item.altitude - destination.alt),
+						     destination_name);
 
 			break;
 		}
@@ -195,8 +205,8 @@ RTL::set_rtl_item()
 
 	case RTL_STATE_DESCEND: {
 			_mission_item.nav_cmd = NAV_CMD_WAYPOINT;
-			_mission_item.lat = home.lat;
-			_mission_item.lon = home.lon;
+			_mission_item.lat = destination.lat;
+			_mission_item.lon = destination.lon;
 			_mission_item.altitude = loiter_altitude;
 			_mission_item.altitude_is_relative = false;
 
@@ -207,7 +217,7 @@ RTL::set_rtl_item()
 				_mission_item.yaw = get_bearing_to_next_waypoint(gpos.lat, gpos.lon, _mission_item.lat, _mission_item.lon);
 
 			} else {
-				_mission_item.yaw = home.yaw;
+				_mission_item.yaw = destination.yaw;
 			}
 
 			_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
@@ -218,8 +228,9 @@ RTL::set_rtl_item()
 			// Disable previous setpoint to prevent drift.
 			pos_sp_triplet->previous.valid = false;
 
-			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: descend to %d m (%d m above home)",
-						     (int)ceilf(_mission_item.altitude), (int)ceilf(_mission_item.altitude - home.alt));
+			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: descend to %d m (%d m above %s)",
+						     (int)ceilf(_mission_item.altitude), (int)ceilf(_mission_item.altitude - destination.alt),
+						     destination_name);
 			break;
 		}
 
@@ -227,11 +238,11 @@ RTL::set_rtl_item()
 			const bool autoland = (_param_rtl_land_delay.get() > FLT_EPSILON);
 
 			// Don't change altitude.
-			_mission_item.lat = home.lat;
-			_mission_item.lon = home.lon;
+			_mission_item.lat = destination.lat;
+			_mission_item.lon = destination.lon;
 			_mission_item.altitude = loiter_altitude;
 			_mission_item.altitude_is_relative = false;
-			_mission_item.yaw = home.yaw;
+			_mission_item.yaw = destination.yaw;
 			_mission_item.loiter_radius = _navigator->get_loiter_radius();
 			_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
 			_mission_item.time_inside = math::max(_param_rtl_land_delay.get(), 0.0f);
@@ -254,19 +265,19 @@ RTL::set_rtl_item()
 		}
 
 	case RTL_STATE_LAND: {
-			// Land at home position.
+			// Land at the destination.
 			_mission_item.nav_cmd = NAV_CMD_LAND;
-			_mission_item.lat = home.lat;
-			_mission_item.lon = home.lon;
-			_mission_item.yaw = home.yaw;
-			_mission_item.altitude = home.alt;
+			_mission_item.lat = destination.lat;
+			_mission_item.lon = destination.lon;
+			_mission_item.yaw = destination.yaw;
+			_mission_item.altitude = destination.alt;
 			_mission_item.altitude_is_relative = false;
 			_mission_item.acceptance_radius = _navigator->get_acceptance_radius();
 			_mission_item.time_inside = 0.0f;
 			_mission_item.autocontinue = true;
 			_mission_item.origin = ORIGIN_ONBOARD;
 
-			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: land at home");
+			mavlink_and_console_log_info(_navigator->get_mavlink_log_pub(), "RTL: land at %s", destination_name);
 			break;
 		}
 
@@ -350,36 +361,182 @@ RTL::advance_rtl()
 }
 
 
-float RTL::calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg)
+void
+RTL::update_safe_points()
 {
 	const home_position_s &home = *_navigator->get_home_position();
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (!_navigator->home_position_valid()) {
+		return;
+	}
+
+	if (_safe_points_valid && (now - _safe_points_last_check < SAFE_POINTS_CHECK_INTERVAL)) {
+		return;
+	}
+
+	_safe_points_last_check = now;
+
+	mission_stats_entry_s stats;
+
+	if (dm_read(DM_KEY_SAFE_POINTS, 0, &stats, sizeof(mission_stats_entry_s)) != sizeof(mission_stats_entry_s)) {
+		// nothing uploaded yet
+		stats.num_items = 0;
+		stats.update_counter = 0;
+	}
+
+	// the geofence decides which safe points are acceptable destinations
+	mission_stats_entry_s fence_stats;
+
+	if (dm_read(DM_KEY_FENCE_POINTS, 0, &fence_stats, sizeof(mission_stats_entry_s)) != sizeof(mission_stats_entry_s)) {
+		fence_stats.update_counter = 0;
+	}
+
+	if (_safe_points_valid && stats.update_counter == _safe_points_update_counter
+	    && home.timestamp == _safe_points_home_timestamp
+	    && fence_stats.update_counter == _safe_points_fence_counter) {
+		return;
+	}
+
+	_safe_points_num = 0;
+
+	const int num_items = math::min((int)stats.num_items, SAFE_POINTS_MAX);
+
+	for (int i = 0; i < num_items; i++) {
+		mission_save_point_s point;
+
+		if (dm_read(DM_KEY_SAFE_POINTS, i + 1, &point, sizeof(mission_save_point_s)) != sizeof(mission_save_point_s)) {
+			continue;
+		}
+
+		switch (point.frame) {
+		case NAV_FRAME_GLOBAL:
+		case NAV_FRAME_GLOBAL_INT:
+			_safe_points_alt[_safe_points_num] = point.alt;
+			break;
+
+		case NAV_FRAME_GLOBAL_RELATIVE_ALT:
+		case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
+			_safe_points_alt[_safe_points_num] = point.alt + home.alt;
+			break;
+
+		default:
+			// terrain relative or local frames can't be flown to as an RTL destination
+			continue;
+		}
+
+		_safe_points_lat[_safe_points_num] = point.lat;
+		_safe_points_lon[_safe_points_num] = point.lon;
+		_safe_points_num++;
+	}
+
+	// home is the fallback destination and the origin of all queries
+	_navigator->get_home_projection().project(_safe_points_lat, _safe_points_lon, _safe_points_local, _safe_points_num);
+
+	rtl_safe_points_s safe_points{};
+
+	for (int i = 0; i < _safe_points_num; i++) {
+		_safe_points_inside_fence[i] = _navigator->get_geofence().checkPoint(_safe_points_lat[i], _safe_points_lon[i],
+					       _safe_points_alt[i]);
+
+		safe_points.lat[i] = _safe_points_lat[i];
+		safe_points.lon[i] = _safe_points_lon[i];
+		safe_points.alt[i] = _safe_points_alt[i];
+		safe_points.inside_geofence[i] = _safe_points_inside_fence[i];
+	}
+
+	safe_points.count = _safe_points_num;
+	safe_points.timestamp = hrt_absolute_time();
+	_rtl_safe_points_pub.publish(safe_points);
+
+	_safe_points_update_counter = stats.update_counter;
+	_safe_points_home_timestamp = home.timestamp;
+	_safe_points_fence_counter = fence_stats.update_counter;
+	_safe_points_valid = true;
+}
+
+void
+RTL::find_RTL_destination()
+{
+	const home_position_s &home = *_navigator->get_home_position();
+	const vehicle_global_position_s &gpos = *_navigator->get_global_position();
+
+	// default to home
+	_destination.lat = home.lat;
+	_destination.lon = home.lon;
+	_destination.alt = home.alt;
+	_destination.yaw = home.yaw;
+	_destination_is_home = true;
+
+	if (rtl_type() != RTL_CLOSEST) {
+		return;
+	}
+
+	update_safe_points();
+
+	if (_safe_points_num == 0) {
+		return;
+	}
+
+	// home is the origin of the projection, so a safe point only qualifies if it is closer than that
+	const matrix::Vector2f position = _navigator->get_home_projection().project(gpos.lat, gpos.lon);
+	const float home_dist_sq = position.norm_squared();
+
+	// the closest safe point inside the geofence, rtl_energy makes the same choice from the published cache
+	int closest = -1;
+	float closest_dist_sq = home_dist_sq;
+
+	for (int i = 0; i < _safe_points_num; i++) {
+		const float dist_sq = (_safe_points_local[i] - position).norm_squared();
+
+		if (_safe_points_inside_fence[i] && dist_sq < closest_dist_sq) {
+			closest = i;
+			closest_dist_sq = dist_sq;
+		}
+	}
+
+	if (closest >= 0) {
+		_destination.lat = _safe_points_lat[closest];
+		_destination.lon = _safe_points_lon[closest];
+		_destination.alt = _safe_points_alt[closest];
+		// safe points have no heading, keep the one we arrive with
+		const matrix::Vector2f to_point = _safe_points_local[closest] - position;
+		_destination.yaw = atan2f(to_point(1), to_point(0));
+		_destination_is_home = false;
+	}
+}
+
+
+float RTL::calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg)
+{
+	const RTLPosition &destination = _destination;
 	const vehicle_global_position_s &gpos = *_navigator->get_global_position();
 
-	// horizontal distance to home position
-	const float home_dist = get_distance_to_next_waypoint(home.lat, home.lon, gpos.lat, gpos.lon);
+	// horizontal distance to the destination
+	const float destination_dist = get_distance_to_next_waypoint(destination.lat, destination.lon, gpos.lat, gpos.lon);
 
 	float rtl_altitude;
 
-	if (home_dist <= _param_rtl_min_dist.get()) {
-		rtl_altitude = home.alt + _param_rtl_descend_alt.get();
+	if (destination_dist <= _param_rtl_min_dist.get()) {
+		rtl_altitude = destination.alt + _param_rtl_descend_alt.get();
 
-	} else if (gpos.alt > home.alt + _param_rtl_return_alt.get() || cone_half_angle_deg >= 90.0f) {
+	} else if (gpos.alt > destination.alt + _param_rtl_return_alt.get() || cone_half_angle_deg >= 90.0f) {
 		rtl_altitude = gpos.alt;
 
 	} else if (cone_half_angle_deg <= 0) {
-		rtl_altitude = home.alt + _param_rtl_return_alt.get();
+		rtl_altitude = destination.alt + _param_rtl_return_alt.get();
 
 	} else {
 
 		// constrain cone half angle to meaningful values. All other cases are already handled above.
 		const float cone_half_angle_rad = math::radians(math::constrain(cone_half_angle_deg, 1.0f, 89.0f));
 
-		// minimum height above home position required
-		float height_above_home_min = home_dist / tanf(cone_half_angle_rad);
+		// minimum height above the destination required
+		float height_above_destination_min = destination_dist / tanf(cone_half_angle_rad);
 
 		// minimum altitude we need in order to be within the user defined cone
-		const float altitude_min = math::constrain(height_above_home_min + home.alt, home.alt,
-					   home.alt + _param_rtl_return_alt.get());
+		const float altitude_min = math::constrain(height_above_destination_min + destination.alt, destination.alt,
+					   destination.alt + _param_rtl_return_alt.get());
 
 		if (gpos.alt < altitude_min) {
 			rtl_altitude = altitude_min;
@@ -390,7 +547,7 @@ float RTL::calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg)
 	}
 
 	// always demand altitude which is higher or equal the RTL descend altitude
-	rtl_altitude = math::max(rtl_altitude, home.alt + _param_rtl_descend_alt.get());
+	rtl_altitude = math::max(rtl_altitude, destination.alt + _param_rtl_descend_alt.get());
 
 	return rtl_altitude;
 }
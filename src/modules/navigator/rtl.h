@@ -43,6 +43,11 @@
 
 #include <px4_module_params.h>
 
+#include <dataman/dataman.h>
+#include <matrix/matrix/math.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/rtl_safe_points.h>
+
 #include "navigator_mode.h"
 #include "mission_block.h"
 
@@ -55,6 +60,7 @@ public:
 		RTL_HOME = 0,
 		RTL_LAND,
 		RTL_MISSION,
+		RTL_CLOSEST,
 	};
 
 	RTL(Navigator *navigator);
@@ -80,6 +86,17 @@ private:
 	 */
 	void		advance_rtl();
 
+	/**
+	 * Choose where to return to: home, or for RTL_CLOSEST the closest safe point
+	 * which is nearer than home and inside the geofence.
+	 */
+	void		find_RTL_destination();
+
+	/**
+	 * Refresh the safe point cache if the dataman copy, the home position or the geofence changed
+	 * and publish it
+	 */
+	void		update_safe_points();
 
 	float calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg);
 
@@ -94,9 +111,37 @@ private:
 		RTL_STATE_LANDED,
 	} _rtl_state{RTL_STATE_NONE};
 
-	float _rtl_alt{0.0f};	// AMSL altitude at which the vehicle should return to the home position
+	float _rtl_alt{0.0f};	// AMSL altitude at which the vehicle should return to the destination
 	bool _rtl_alt_min{false};
 
+	struct RTLPosition {
+		double lat;
+		double lon;
+		float alt;	// AMSL
+		float yaw;
+	} _destination{};	// home or the selected safe point
+
+	bool _destination_is_home{true};
+
+	static constexpr int SAFE_POINTS_MAX = DM_KEY_SAFE_POINTS_MAX - 1;
+
+	static_assert(SAFE_POINTS_MAX <= sizeof(rtl_safe_points_s::lat) / sizeof(double), "rtl_safe_points array too small");
+
+	// cached copy of DM_KEY_SAFE_POINTS (entry 0 in dataman holds the stats), projected around home
+	double _safe_points_lat[SAFE_POINTS_MAX] {};
+	double _safe_points_lon[SAFE_POINTS_MAX] {};
+	float _safe_points_alt[SAFE_POINTS_MAX] {};	// AMSL
+	matrix::Vector2f _safe_points_local[SAFE_POINTS_MAX] {};	// north/east of home [m]
+	bool _safe_points_inside_fence[SAFE_POINTS_MAX] {};
+	int _safe_points_num{0};
+	bool _safe_points_valid{false};
+	uint16_t _safe_points_update_counter{0};
+	hrt_abstime _safe_points_home_timestamp{0};
+	uint16_t _safe_points_fence_counter{0};
+	hrt_abstime _safe_points_last_check{0};
+
+	uORB::Publication<rtl_safe_points_s> _rtl_safe_points_pub{ORB_ID(rtl_safe_points)};
+
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::RTL_RETURN_ALT>) _param_rtl_return_alt,
 		(ParamFloat<px4::params::RTL_DESCEND_ALT>) _param_rtl_descend_alt,
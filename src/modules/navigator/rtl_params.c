@@ -108,11 +108,13 @@ PARAM_DEFINE_FLOAT(RTL_MIN_DIST, 5.0f);
  * Return type
  *
  * Fly straight to the home location or planned mission landing and land there or
- * use the planned mission to get to those points.
+ * use the planned mission to get to those points. Type 3 flies to the closest
+ * uploaded safe point inside the geofence, if it is closer than home.
  *
  * @value 0 Return home via direct path
  * @value 1 Return to a planned mission landing, if available, via direct path, else return to home via direct path
  * @value 2 Return to a planned mission landing, if available, using the mission path, else return to home via the reverse mission path
+ * @value 3 Return to the closest safe point or home, whichever is closer, via direct path
  * @group Return Mode
  */
 PARAM_DEFINE_INT32(RTL_TYPE, 0);
@@ -57,6 +57,9 @@
  * Writes to unimplemented registers are ignored. Reads from unimplemented
  * registers return undefined values.
  *
+ * Several reads, writes and bit modifications on any pages can be combined
+ * into one batched transaction (PKT_CODE_BATCH), see lib/px4io_batch.
+ *
  * As convention, values that would be floating point in other parts of
  * the PX4 system are expressed as signed integer values scaled by 10000,
  * e.g. control values range from -10000..10000.  Use the REG_TO_SIGNED and
@@ -80,7 +83,7 @@
 
 #define REG_TO_BOOL(_reg) 	((bool)(_reg))
 
-#define PX4IO_PROTOCOL_VERSION		4
+#define PX4IO_PROTOCOL_VERSION		5
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -343,6 +346,7 @@ struct IOPacket {
 
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
+#define PKT_CODE_BATCH		0x80	/* FMU->IO batched multi-page transaction */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
 #define PKT_CODE_CORRUPT	0x40	/* IO->FMU bad packet reply */
 #define PKT_CODE_ERROR		0x80	/* IO->FMU register op error reply */
@@ -350,6 +354,30 @@ struct IOPacket {
 #define PKT_CODE_MASK		0xc0
 #define PKT_COUNT_MASK		0x3f
 
+/*
+ * Batched transactions ignore page and offset of the packet. The registers
+ * carry a list of entries, each starting with two header registers:
+ *
+ *   PKT_BATCH_ADDRESS(page, offset)
+ *   operation | register count
+ *
+ * Write entries are followed by their register values, modify entries by the
+ * clear and set bit masks for one register. The reply carries the registers
+ * of all read entries, concatenated in request order. Entries are applied
+ * independently; the reply page and offset hold a bitmap of the entries IO
+ * rejected (bit n for entry n), the registers of a rejected read are zero.
+ * Only a malformed request is answered with PKT_CODE_ERROR.
+ */
+#define PKT_BATCH_HEADER_REGS	2
+#define PKT_BATCH_ADDRESS(_page, _offset)	((uint16_t)(((_page) << 8) | (_offset)))
+#define PKT_BATCH_OP_READ	0x0000
+#define PKT_BATCH_OP_WRITE	0x4000
+#define PKT_BATCH_OP_MODIFY	0x8000	/* read-modify-write of a single register: clear bits, set bits */
+#define PKT_BATCH_OP_MASK	0xc000
+#define PKT_BATCH_COUNT_MASK	0x003f
+#define PKT_BATCH_MAX_ENTRIES	(PKT_MAX_REGS / PKT_BATCH_HEADER_REGS)
+#define PKT_BATCH_FAILED(_p)	((uint16_t)(((_p).page << 8) | (_p).offset))
+
 #define PKT_COUNT(_p)	((_p).count_code & PKT_COUNT_MASK)
 #define PKT_CODE(_p)	((_p).count_code & PKT_CODE_MASK)
 #define PKT_SIZE(_p)	((size_t)((uint8_t *)&((_p).regs[PKT_COUNT(_p)]) - ((uint8_t *)&(_p))))
@@ -52,6 +52,7 @@
 #include <up_arch.h>
 #include <stm32.h>
 #include <perf/perf_counter.h>
+#include <px4io_batch/px4io_batch.h>
 
 //#define DEBUG
 #include "px4io.h"
@@ -212,6 +213,16 @@ rx_handle_packet(void)
 		return;
 	}
 
+	if (PKT_CODE(dma_packet) == PKT_CODE_BATCH) {
+
+		/* several reads/writes in one packet - the reply is built in place */
+		if (px4io_batch_handle(&dma_packet, registers_set, registers_get)) {
+			perf_count(pc_regerr);
+		}
+
+		return;
+	}
+
 	/* send a bad-packet error reply */
 	dma_packet.count_code = PKT_CODE_CORRUPT;
 	dma_packet.page = 0xff;
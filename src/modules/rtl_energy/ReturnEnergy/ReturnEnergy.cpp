@@ -0,0 +1,185 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ReturnEnergy.cpp
+ */
+
+#include "ReturnEnergy.hpp"
+
+#include <math.h>
+#include <px4_defines.h>
+
+namespace return_energy
+{
+
+// weight of a new sample, the power in a bin follows changes over a few tens of samples
+static constexpr float POWER_FILTER_GAIN = 0.05f;
+
+void PowerModel::reset()
+{
+	for (int i = 0; i < NUM_BINS; i++) {
+		_power[i] = 0.f;
+		_samples[i] = 0;
+	}
+}
+
+int PowerModel::bin(float airspeed)
+{
+	const int i = (int)(airspeed / BIN_WIDTH);
+	return (i < 0) ? 0 : ((i >= NUM_BINS) ? NUM_BINS - 1 : i);
+}
+
+void PowerModel::update(float airspeed, float power)
+{
+	if (!PX4_ISFINITE(airspeed) || !PX4_ISFINITE(power) || power < 0.f) {
+		return;
+	}
+
+	const int i = bin(airspeed);
+
+	if (_samples[i] == 0) {
+		_power[i] = power;
+
+	} else {
+		// plain average until the filter gain takes over
+		const float gain = fmaxf(1.f / (_samples[i] + 1), POWER_FILTER_GAIN);
+		_power[i] += gain * (power - _power[i]);
+	}
+
+	if (_samples[i] < UINT16_MAX) {
+		_samples[i]++;
+	}
+}
+
+float PowerModel::getPower(float airspeed) const
+{
+	const int i = bin(airspeed);
+
+	if (_samples[i] > 0) {
+		return _power[i];
+	}
+
+	int below = -1;
+	int above = -1;
+
+	for (int j = i - 1; j >= 0; j--) {
+		if (_samples[j] > 0) {
+			below = j;
+			break;
+		}
+	}
+
+	for (int j = i + 1; j < NUM_BINS; j++) {
+		if (_samples[j] > 0) {
+			above = j;
+			break;
+		}
+	}
+
+	if (below >= 0 && above >= 0) {
+		const float t = (float)(i - below) / (float)(above - below);
+		return _power[below] + t * (_power[above] - _power[below]);
+
+	} else if (below >= 0) {
+		return _power[below];
+
+	} else if (above >= 0) {
+		return _power[above];
+	}
+
+	return NAN;
+}
+
+float legTime(float north, float east, float airspeed, float wind_north, float wind_east)
+{
+	const float length = sqrtf(north * north + east * east);
+
+	if (length < 1e-3f) {
+		return 0.f;
+	}
+
+	const float dir_north = north / length;
+	const float dir_east = east / length;
+
+	// the heading is chosen to cancel the crosswind, what is left of the airspeed adds to the tailwind
+	const float tailwind = wind_north * dir_north + wind_east * dir_east;
+	const float crosswind = wind_east * dir_north - wind_north * dir_east;
+	const float along_sq = airspeed * airspeed - crosswind * crosswind;
+
+	if (along_sq <= 0.f) {
+		return INFINITY;
+	}
+
+	const float groundspeed = sqrtf(along_sq) + tailwind;
+
+	if (groundspeed < 0.1f) {
+		return INFINITY;
+	}
+
+	return length / groundspeed;
+}
+
+void ReturnPath::setConditions(float airspeed, float cruise_power, float vertical_power, float climb_speed,
+			       float descent_speed)
+{
+	_airspeed = airspeed;
+	_cruise_power = cruise_power;
+	_vertical_power = vertical_power;
+	_climb_speed = fmaxf(climb_speed, 0.1f);
+	_descent_speed = fmaxf(descent_speed, 0.1f);
+}
+
+void ReturnPath::setWind(float wind_north, float wind_east)
+{
+	_wind_north = wind_north;
+	_wind_east = wind_east;
+}
+
+void ReturnPath::reset()
+{
+	_time = 0.f;
+	_energy = 0.f;
+}
+
+void ReturnPath::addLeg(float north, float east, float up)
+{
+	const float horizontal_time = legTime(north, east, _airspeed, _wind_north, _wind_east);
+	const float vertical_time = (up > 0.f) ? up / _climb_speed : -up / _descent_speed;
+
+	_time += horizontal_time + vertical_time;
+	_energy += (_cruise_power * horizontal_time + _vertical_power * vertical_time) / 3600.f;
+}
+
+} // namespace return_energy
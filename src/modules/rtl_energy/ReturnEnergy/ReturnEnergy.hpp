@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ReturnEnergy.hpp
+ *
+ * Model of the time and energy a return flight needs: a table of measured
+ * electrical power over airspeed and the integration of a path of legs
+ * flown through a constant wind.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace return_energy
+{
+
+/**
+ * Electrical power as a function of airspeed, learned in flight
+ */
+class PowerModel
+{
+public:
+	static constexpr int NUM_BINS = 16;
+	static constexpr float BIN_WIDTH = 2.f; ///< [m/s]
+
+	PowerModel() { reset(); }
+	~PowerModel() = default;
+
+	void reset();
+
+	/**
+	 * Add a measurement
+	 * @param airspeed [m/s]
+	 * @param power electrical power drawn from the battery [W]
+	 */
+	void update(float airspeed, float power);
+
+	/**
+	 * @return the learned power at this airspeed [W] or NAN if there are no measurements at all,
+	 * bins without samples are interpolated from their closest neighbours
+	 */
+	float getPower(float airspeed) const;
+
+private:
+	static int bin(float airspeed);
+
+	float _power[NUM_BINS];
+	uint16_t _samples[NUM_BINS];
+};
+
+/**
+ * Time needed to fly a horizontal leg at constant airspeed through a constant wind
+ * @param north leg length in north direction [m]
+ * @param east leg length in east direction [m]
+ * @return [s] or INFINITY if the wind is too strong to make progress along the leg
+ */
+float legTime(float north, float east, float airspeed, float wind_north, float wind_east);
+
+/**
+ * Accumulates time and energy along a return path
+ */
+class ReturnPath
+{
+public:
+	ReturnPath() = default;
+	~ReturnPath() = default;
+
+	/**
+	 * @param airspeed return airspeed [m/s]
+	 * @param cruise_power power at the return airspeed [W]
+	 * @param vertical_power power while climbing or descending [W]
+	 * @param climb_speed [m/s]
+	 * @param descent_speed [m/s]
+	 */
+	void setConditions(float airspeed, float cruise_power, float vertical_power, float climb_speed, float descent_speed);
+	void setWind(float wind_north, float wind_east);
+
+	void reset();
+
+	/**
+	 * Add a leg, the horizontal and vertical part are flown one after the other
+	 * @param up altitude change [m], positive for climbing
+	 */
+	void addLeg(float north, float east, float up);
+
+	float getTime() const { return _time; } ///< [s]
+	float getEnergy() const { return _energy; } ///< [Wh]
+
+private:
+	float _airspeed{0.f};
+	float _cruise_power{0.f};
+	float _vertical_power{0.f};
+	float _climb_speed{1.f};
+	float _descent_speed{1.f};
+	float _wind_north{0.f};
+	float _wind_east{0.f};
+
+	float _time{0.f};
+	float _energy{0.f};
+};
+
+} // namespace return_energy
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the return energy model
+ * Run this test only using make tests TESTFILTER=ReturnEnergy
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include <ReturnEnergy.hpp>
+
+using namespace return_energy;
+
+TEST(ReturnEnergyTest, LegTimeNoWind)
+{
+	EXPECT_FLOAT_EQ(legTime(300.f, 400.f, 10.f, 0.f, 0.f), 50.f);
+	EXPECT_FLOAT_EQ(legTime(0.f, 0.f, 10.f, 0.f, 0.f), 0.f);
+}
+
+TEST(ReturnEnergyTest, LegTimeWind)
+{
+	// head- and tailwind
+	EXPECT_FLOAT_EQ(legTime(100.f, 0.f, 10.f, 5.f, 0.f), 100.f / 15.f);
+	EXPECT_FLOAT_EQ(legTime(100.f, 0.f, 10.f, -5.f, 0.f), 100.f / 5.f);
+
+	// crosswind costs groundspeed along the leg: sqrt(10^2 - 6^2) = 8
+	EXPECT_FLOAT_EQ(legTime(0.f, 80.f, 10.f, 6.f, 0.f), 10.f);
+
+	// too much wind
+	EXPECT_FALSE(std::isfinite(legTime(100.f, 0.f, 10.f, -12.f, 0.f)));
+	EXPECT_FALSE(std::isfinite(legTime(100.f, 0.f, 10.f, 0.f, 11.f)));
+}
+
+TEST(ReturnEnergyTest, PowerModel)
+{
+	PowerModel model;
+	EXPECT_FALSE(std::isfinite(model.getPower(10.f)));
+
+	// a single bin answers for all airspeeds
+	model.update(1.f, 200.f);
+	EXPECT_FLOAT_EQ(model.getPower(1.f), 200.f);
+	EXPECT_FLOAT_EQ(model.getPower(15.f), 200.f);
+
+	// empty bins are interpolated
+	model.update(9.f, 300.f);
+	EXPECT_FLOAT_EQ(model.getPower(5.f), 250.f);
+	EXPECT_FLOAT_EQ(model.getPower(30.f), 300.f);
+
+	// the first samples of a bin are averaged, later ones filtered
+	model.update(9.f, 400.f);
+	EXPECT_FLOAT_EQ(model.getPower(9.f), 350.f);
+
+	for (int i = 0; i < 500; i++) {
+		model.update(9.f, 500.f);
+	}
+
+	EXPECT_NEAR(model.getPower(9.f), 500.f, 0.1f);
+
+	// invalid samples are ignored
+	model.update(NAN, 1000.f);
+	model.update(9.f, NAN);
+	EXPECT_NEAR(model.getPower(9.f), 500.f, 0.1f);
+}
+
+TEST(ReturnEnergyTest, ReturnPath)
+{
+	ReturnPath path;
+	path.setConditions(10.f, 360.f, 720.f, 2.f, 1.f);
+	path.setWind(0.f, 0.f);
+	path.reset();
+
+	// 100 s cruise at 360 W, 10 s climb and 20 s descent at 720 W
+	path.addLeg(0.f, 0.f, 20.f);
+	path.addLeg(1000.f, 0.f, 0.f);
+	path.addLeg(0.f, 0.f, -20.f);
+
+	EXPECT_FLOAT_EQ(path.getTime(), 130.f);
+	EXPECT_FLOAT_EQ(path.getEnergy(), 16.f);
+
+	// a headwind on the way back makes it more expensive
+	path.reset();
+	path.setWind(-5.f, 0.f);
+	path.addLeg(1000.f, 0.f, 0.f);
+	EXPECT_FLOAT_EQ(path.getTime(), 200.f);
+	EXPECT_FLOAT_EQ(path.getEnergy(), 20.f);
+}
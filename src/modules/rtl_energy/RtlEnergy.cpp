@@ -0,0 +1,641 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "RtlEnergy.hpp"
+
+using namespace time_literals;
+
+// changes of the inputs that are large enough to integrate the return path again
+static constexpr float POSITION_CHANGE_HORIZONTAL = 25.f; // [m]
+static constexpr float POSITION_CHANGE_VERTICAL = 10.f; // [m]
+static constexpr float WIND_CHANGE = 1.f; // [m/s]
+static constexpr float POWER_CHANGE_RELATIVE = 0.05f;
+
+// the vertical speed up to which power measurements count as level flight
+static constexpr float LEVEL_FLIGHT_VZ_MAX = 1.f; // [m/s]
+
+RtlEnergy::RtlEnergy() :
+	ModuleParams(nullptr),
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default)
+{
+	_param_handle_bat_capacity = param_find("BAT_CAPACITY");
+	_param_handle_rtl_type = param_find("RTL_TYPE");
+	_param_handle_rtl_return_alt = param_find("RTL_RETURN_ALT");
+	_param_handle_mpc_xy_cruise = param_find("MPC_XY_CRUISE");
+	_param_handle_mpc_z_vel_max_up = param_find("MPC_Z_VEL_MAX_UP");
+	_param_handle_mpc_land_speed = param_find("MPC_LAND_SPEED");
+	_param_handle_fw_airspd_trim = param_find("FW_AIRSPD_TRIM");
+
+	parameters_update(true);
+}
+
+RtlEnergy::~RtlEnergy()
+{
+	ScheduleClear();
+
+	perf_free(_cycle_perf);
+	perf_free(_integration_perf);
+}
+
+int RtlEnergy::task_spawn(int argc, char *argv[])
+{
+	RtlEnergy *obj = new RtlEnergy();
+
+	if (!obj) {
+		PX4_ERR("alloc failed");
+		return -1;
+	}
+
+	_object.store(obj);
+	_task_id = task_id_is_work_queue;
+
+	obj->start();
+
+	return 0;
+}
+
+void RtlEnergy::start()
+{
+	ScheduleOnInterval(RUN_INTERVAL_US);
+}
+
+void RtlEnergy::parameters_update(bool force)
+{
+	if (_parameter_update_sub.updated() || force) {
+		parameter_update_s update;
+		_parameter_update_sub.copy(&update);
+
+		updateParams();
+
+		if (_param_handle_bat_capacity != PARAM_INVALID) { param_get(_param_handle_bat_capacity, &_bat_capacity); }
+
+		if (_param_handle_rtl_type != PARAM_INVALID) { param_get(_param_handle_rtl_type, &_rtl_type); }
+
+		if (_param_handle_rtl_return_alt != PARAM_INVALID) { param_get(_param_handle_rtl_return_alt, &_rtl_return_alt); }
+
+		if (_param_handle_mpc_xy_cruise != PARAM_INVALID) { param_get(_param_handle_mpc_xy_cruise, &_mpc_xy_cruise); }
+
+		if (_param_handle_mpc_z_vel_max_up != PARAM_INVALID) { param_get(_param_handle_mpc_z_vel_max_up, &_mpc_z_vel_max_up); }
+
+		if (_param_handle_mpc_land_speed != PARAM_INVALID) { param_get(_param_handle_mpc_land_speed, &_mpc_land_speed); }
+
+		if (_param_handle_fw_airspd_trim != PARAM_INVALID) { param_get(_param_handle_fw_airspd_trim, &_fw_airspd_trim); }
+
+		// the return path or its speeds might have changed
+		_integrate_requested = true;
+	}
+}
+
+void RtlEnergy::Run()
+{
+	if (should_exit()) {
+		ScheduleClear();
+		exit_and_cleanup();
+		return;
+	}
+
+	perf_begin(_cycle_perf);
+
+	parameters_update();
+
+	_battery_status_sub.update(&_battery_status);
+	_home_position_sub.update(&_home_position);
+	_mission_sub.update(&_mission);
+	_vehicle_global_position_sub.update(&_global_position);
+	_vehicle_land_detected_sub.update(&_land_detected);
+	_vehicle_status_sub.update(&_vehicle_status);
+	_wind_estimate_sub.update(&_wind);
+
+	learn_power();
+
+	rtl_time_estimate_s estimate{};
+	estimate.destination = _destination;
+	estimate.time_estimate = NAN;
+	estimate.energy_estimate = NAN;
+	estimate.energy_remaining = NAN;
+	estimate.time_to_must_return = NAN;
+
+	const bool home_valid = _home_position.timestamp > 0 && _home_position.valid_hpos && _home_position.valid_alt;
+	const bool position_valid = _global_position.timestamp > 0 && hrt_elapsed_time(&_global_position.timestamp) < 1_s;
+
+	update_safe_points();
+
+	if (home_valid && position_valid) {
+		perf_begin(_integration_perf);
+
+		if (_step == IntegrationStep::IDLE && inputs_changed()) {
+			begin_integration();
+		}
+
+		if (_step != IntegrationStep::IDLE) {
+			continue_integration();
+		}
+
+		perf_end(_integration_perf);
+
+		estimate.destination = _destination;
+		estimate.time_estimate = _time_required;
+		estimate.energy_estimate = _energy_required;
+		estimate.energy_home = _energy_home;
+
+		for (int i = 0; i < _num_safe_points; i++) {
+			estimate.energy_safe_point[i] = _safe_points[i].energy;
+		}
+
+		estimate.safe_point_count = _num_safe_points;
+
+	} else {
+		estimate.energy_home = NAN;
+	}
+
+	const bool battery_valid = _battery_status.connected && (_battery_status.remaining >= 0.f)
+				   && (_battery_status.voltage_filtered_v > 0.f) && (_bat_capacity > 0.f);
+
+	if (battery_valid) {
+		// [Wh] = [mAh] / 1000 * [V]
+		const float usable = math::max(_battery_status.remaining - _param_rtl_e_reserve.get(), 0.f);
+		estimate.energy_remaining = usable * _bat_capacity * 1e-3f * _battery_status.voltage_filtered_v;
+
+		if (PX4_ISFINITE(estimate.energy_estimate)) {
+			// current draw, or the learned cruise power while it is not measured (e.g. still on the ground)
+			float power = _battery_status.voltage_filtered_v * _battery_status.current_filtered_a;
+
+			if (_land_detected.landed || power < 1.f) {
+				power = _power_model.getPower(return_airspeed());
+			}
+
+			if (PX4_ISFINITE(power) && power > 1.f) {
+				const float energy_margin = estimate.energy_remaining - estimate.energy_estimate;
+				estimate.time_to_must_return = math::max(energy_margin / power * 3600.f, 0.f);
+				estimate.valid = true;
+			}
+		}
+	}
+
+	estimate.timestamp = hrt_absolute_time();
+	_rtl_time_estimate_pub.publish(estimate);
+
+	perf_end(_cycle_perf);
+}
+
+float RtlEnergy::return_airspeed() const
+{
+	if (_vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING) {
+		return _fw_airspd_trim;
+	}
+
+	return _mpc_xy_cruise;
+}
+
+void RtlEnergy::learn_power()
+{
+	if (!_battery_status.connected || _land_detected.landed
+	    || (_battery_status.voltage_filtered_v <= 0.f) || (_battery_status.current_filtered_a <= 0.f)
+	    || (hrt_elapsed_time(&_battery_status.timestamp) > 1_s)
+	    || (hrt_elapsed_time(&_global_position.timestamp) > 1_s)) {
+		return;
+	}
+
+	// climbing and descending would distort the power at this airspeed
+	if (fabsf(_global_position.vel_d) > LEVEL_FLIGHT_VZ_MAX) {
+		return;
+	}
+
+	const float air_north = _global_position.vel_n - _wind.windspeed_north;
+	const float air_east = _global_position.vel_e - _wind.windspeed_east;
+	const float airspeed = sqrtf(air_north * air_north + air_east * air_east);
+
+	_power_model.update(airspeed, _battery_status.voltage_filtered_v * _battery_status.current_filtered_a);
+}
+
+bool RtlEnergy::inputs_changed()
+{
+	if (_integrate_requested) {
+		return true;
+	}
+
+	if ((_home_position.timestamp != _integrated.home_timestamp)
+	    || (_mission.timestamp != _integrated.mission_timestamp)
+	    || (_mission.current_seq != _integrated.mission_seq)
+	    || (_rtl_type != _integrated.rtl_type)
+	    || (_safe_points_timestamp != _integrated.safe_points_timestamp)) {
+		return true;
+	}
+
+	const float moved = get_distance_to_next_waypoint(_integrated.lat, _integrated.lon,
+			    _global_position.lat, _global_position.lon);
+
+	if ((moved > POSITION_CHANGE_HORIZONTAL) || (fabsf(_global_position.alt - _integrated.alt) > POSITION_CHANGE_VERTICAL)) {
+		return true;
+	}
+
+	const float wind_change_north = _wind.windspeed_north - _integrated.wind_north;
+	const float wind_change_east = _wind.windspeed_east - _integrated.wind_east;
+
+	if (wind_change_north * wind_change_north + wind_change_east * wind_change_east > WIND_CHANGE * WIND_CHANGE) {
+		return true;
+	}
+
+	const float cruise_power = _power_model.getPower(return_airspeed());
+
+	if (PX4_ISFINITE(cruise_power) != PX4_ISFINITE(_integrated.cruise_power)) {
+		return true;
+	}
+
+	if (PX4_ISFINITE(cruise_power)
+	    && fabsf(cruise_power - _integrated.cruise_power) > POWER_CHANGE_RELATIVE * _integrated.cruise_power) {
+		return true;
+	}
+
+	return false;
+}
+
+void RtlEnergy::begin_integration()
+{
+	_integrate_requested = false;
+
+	const bool fixed_wing = _vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING;
+	const float airspeed = return_airspeed();
+	const float cruise_power = _power_model.getPower(airspeed);
+
+	// a multicopter climbs and descends in hover, a fixed-wing at about cruise power
+	const float vertical_power = fixed_wing ? cruise_power : _power_model.getPower(0.f);
+
+	_integrated.lat = _global_position.lat;
+	_integrated.lon = _global_position.lon;
+	_integrated.alt = _global_position.alt;
+	_integrated.wind_north = _wind.windspeed_north;
+	_integrated.wind_east = _wind.windspeed_east;
+	_integrated.cruise_power = cruise_power;
+	_integrated.home_timestamp = _home_position.timestamp;
+	_integrated.mission_timestamp = _mission.timestamp;
+	_integrated.mission_seq = _mission.current_seq;
+	_integrated.safe_points_timestamp = _safe_points_timestamp;
+	_integrated.rtl_type = _rtl_type;
+
+	_path.setConditions(airspeed, cruise_power, vertical_power, _mpc_z_vel_max_up, _mpc_land_speed);
+	_path.setWind(_wind.windspeed_north, _wind.windspeed_east);
+	_path.reset();
+
+	_direct_path.setConditions(airspeed, cruise_power, vertical_power, _mpc_z_vel_max_up, _mpc_land_speed);
+	_direct_path.setWind(_wind.windspeed_north, _wind.windspeed_east);
+
+	map_projection_init(&_path_ref, _global_position.lat, _global_position.lon);
+	_path_north = 0.f;
+	_path_east = 0.f;
+	_path_alt = _global_position.alt;
+
+	// direct returns, these only need the cached safe points
+	direct_return(_home_position.lat, _home_position.lon, _home_position.alt, _time_home, _energy_home);
+
+	for (int i = 0; i < _num_safe_points; i++) {
+		SafePoint &point = _safe_points[i];
+		direct_return(point.lat, point.lon, point.alt, point.time, point.energy);
+	}
+
+	switch (_rtl_type) {
+	case RTL_LAND:
+	case RTL_MISSION:
+		if (_land_start_mission_timestamp != _mission.timestamp) {
+			// the mission only needs to be searched for the landing sequence once per upload
+			_land_start = -1;
+			_land_start_scan = 0;
+			_step = IntegrationStep::FIND_LAND_START;
+
+		} else {
+			plan_mission_legs();
+		}
+
+		break;
+
+	case RTL_CLOSEST: {
+			// same choice as RTL: the closest safe point inside the geofence if it is closer than home
+			float closest_dist = get_distance_to_next_waypoint(_global_position.lat, _global_position.lon,
+					     _home_position.lat, _home_position.lon);
+			int closest = -1;
+
+			for (int i = 0; i < _num_safe_points; i++) {
+				const float dist = get_distance_to_next_waypoint(_global_position.lat, _global_position.lon,
+						   _safe_points[i].lat, _safe_points[i].lon);
+
+				if (_safe_points[i].inside_geofence && dist < closest_dist) {
+					closest_dist = dist;
+					closest = i;
+				}
+			}
+
+			if (closest >= 0) {
+				_time_required = _safe_points[closest].time;
+				_energy_required = _safe_points[closest].energy;
+				_destination = rtl_time_estimate_s::DESTINATION_SAFE_POINT;
+
+			} else {
+				_time_required = _time_home;
+				_energy_required = _energy_home;
+				_destination = rtl_time_estimate_s::DESTINATION_HOME;
+			}
+
+			_step = IntegrationStep::IDLE;
+			break;
+		}
+
+	default:
+		_time_required = _time_home;
+		_energy_required = _energy_home;
+		_destination = rtl_time_estimate_s::DESTINATION_HOME;
+		_step = IntegrationStep::IDLE;
+		break;
+	}
+}
+
+void RtlEnergy::plan_mission_legs()
+{
+	const int mission_count = _mission.count;
+	const int mission_seq = math::constrain((int)_mission.current_seq, 0, mission_count);
+
+	if (_land_start >= 0) {
+		// with a planned landing both fly the remaining mission from the landing sequence (RTL_LAND)
+		// or from the current item (RTL_MISSION) to the end
+		_mission_index = (_rtl_type == RTL_LAND) ? _land_start : mission_seq;
+		_mission_end = mission_count;
+		_return_home_after_mission = false;
+		_step = IntegrationStep::MISSION_LEGS;
+
+	} else if (_rtl_type == RTL_MISSION && mission_seq > 0) {
+		// fly the mission in reverse and return home from its first item
+		_mission_index = mission_seq - 1;
+		_mission_end = -1;
+		_return_home_after_mission = true;
+		_step = IntegrationStep::MISSION_LEGS;
+
+	} else {
+		_time_required = _time_home;
+		_energy_required = _energy_home;
+		_destination = rtl_time_estimate_s::DESTINATION_HOME;
+		_step = IntegrationStep::IDLE;
+	}
+}
+
+void RtlEnergy::continue_integration()
+{
+	if (_mission.timestamp != _integrated.mission_timestamp) {
+		// the mission changed underneath, start over
+		_step = IntegrationStep::IDLE;
+		_integrate_requested = true;
+		return;
+	}
+
+	const dm_item_t dm_item = (dm_item_t)_mission.dataman_id;
+	int reads = 0;
+
+	if (_step == IntegrationStep::FIND_LAND_START) {
+		const int mission_count = _mission.count;
+
+		while (_land_start < 0 && _land_start_scan < mission_count && reads < DM_READS_PER_CYCLE) {
+			mission_item_s item;
+			reads++;
+
+			if (dm_read(dm_item, _land_start_scan, &item, sizeof(mission_item_s)) != sizeof(mission_item_s)) {
+				// direct return home, the mission is searched again next time
+				finish_integration(rtl_time_estimate_s::DESTINATION_HOME);
+				return;
+			}
+
+			if (item.nav_cmd == NAV_CMD_DO_LAND_START) {
+				_land_start = _land_start_scan;
+
+			} else {
+				_land_start_scan++;
+			}
+		}
+
+		if (_land_start < 0 && _land_start_scan < mission_count) {
+			// continue the search next cycle
+			return;
+		}
+
+		_land_start_mission_timestamp = _mission.timestamp;
+		plan_mission_legs();
+	}
+
+	if (_step != IntegrationStep::MISSION_LEGS) {
+		return;
+	}
+
+	const int step = (_mission_end >= _mission_index) ? 1 : -1;
+
+	while (_mission_index != _mission_end && reads < DM_READS_PER_CYCLE) {
+		mission_item_s item;
+		reads++;
+
+		if (dm_read(dm_item, _mission_index, &item, sizeof(mission_item_s)) != sizeof(mission_item_s)) {
+			// direct return home if the mission could not be read
+			finish_integration(rtl_time_estimate_s::DESTINATION_HOME);
+			return;
+		}
+
+		const bool has_position = item.nav_cmd == NAV_CMD_WAYPOINT
+					  || item.nav_cmd == NAV_CMD_LOITER_UNLIMITED
+					  || item.nav_cmd == NAV_CMD_LOITER_TIME_LIMIT
+					  || item.nav_cmd == NAV_CMD_LAND
+					  || item.nav_cmd == NAV_CMD_TAKEOFF
+					  || item.nav_cmd == NAV_CMD_LOITER_TO_ALT
+					  || item.nav_cmd == NAV_CMD_VTOL_TAKEOFF
+					  || item.nav_cmd == NAV_CMD_VTOL_LAND;
+
+		if (has_position) {
+			const float alt = item.altitude_is_relative ? item.altitude + _home_position.alt : item.altitude;
+			add_leg_to(item.lat, item.lon, alt);
+		}
+
+		_mission_index += step;
+	}
+
+	if (_mission_index == _mission_end) {
+		if (_return_home_after_mission) {
+			add_direct_return(_home_position.lat, _home_position.lon, _home_position.alt);
+		}
+
+		finish_integration(rtl_time_estimate_s::DESTINATION_MISSION);
+	}
+}
+
+void RtlEnergy::finish_integration(uint8_t destination)
+{
+	if (destination == rtl_time_estimate_s::DESTINATION_MISSION) {
+		_time_required = _path.getTime();
+		_energy_required = _path.getEnergy();
+
+	} else {
+		_time_required = _time_home;
+		_energy_required = _energy_home;
+	}
+
+	_destination = destination;
+	_step = IntegrationStep::IDLE;
+}
+
+void RtlEnergy::direct_return(double lat, double lon, float alt, float &time, float &energy)
+{
+	const float return_alt = math::max(_global_position.alt, _home_position.alt + _rtl_return_alt);
+
+	float north;
+	float east;
+	map_projection_project(&_path_ref, lat, lon, &north, &east);
+
+	_direct_path.reset();
+	_direct_path.addLeg(0.f, 0.f, return_alt - _global_position.alt);
+	_direct_path.addLeg(north, east, 0.f);
+	_direct_path.addLeg(0.f, 0.f, alt - return_alt);
+
+	time = _direct_path.getTime();
+	energy = _direct_path.getEnergy();
+}
+
+void RtlEnergy::add_direct_return(double lat, double lon, float alt)
+{
+	// climb to the return altitude at the last point of the path, which is not necessarily the vehicle
+	const float return_alt = math::max(_path_alt, _home_position.alt + _rtl_return_alt);
+	_path.addLeg(0.f, 0.f, return_alt - _path_alt);
+	_path_alt = return_alt;
+
+	float north;
+	float east;
+	map_projection_project(&_path_ref, lat, lon, &north, &east);
+	_path.addLeg(north - _path_north, east - _path_east, 0.f);
+	_path_north = north;
+	_path_east = east;
+
+	_path.addLeg(0.f, 0.f, alt - _path_alt);
+	_path_alt = alt;
+}
+
+void RtlEnergy::add_leg_to(double lat, double lon, float alt)
+{
+	float north;
+	float east;
+	map_projection_project(&_path_ref, lat, lon, &north, &east);
+
+	_path.addLeg(north - _path_north, east - _path_east, alt - _path_alt);
+
+	_path_north = north;
+	_path_east = east;
+	_path_alt = alt;
+}
+
+void RtlEnergy::update_safe_points()
+{
+	rtl_safe_points_s safe_points;
+
+	if (!_rtl_safe_points_sub.update(&safe_points)) {
+		return;
+	}
+
+	_num_safe_points = math::min((int)safe_points.count, SAFE_POINTS_MAX);
+
+	for (int i = 0; i < _num_safe_points; i++) {
+		SafePoint &safe_point = _safe_points[i];
+		safe_point.lat = safe_points.lat[i];
+		safe_point.lon = safe_points.lon[i];
+		safe_point.alt = safe_points.alt[i];
+		safe_point.inside_geofence = safe_points.inside_geofence[i];
+		safe_point.time = NAN;
+		safe_point.energy = NAN;
+	}
+
+	_safe_points_timestamp = safe_points.timestamp;
+}
+
+int RtlEnergy::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
+
+int RtlEnergy::print_status()
+{
+	PX4_INFO("running");
+	perf_print_counter(_cycle_perf);
+	perf_print_counter(_integration_perf);
+
+	if (PX4_ISFINITE(_energy_required)) {
+		PX4_INFO("return: %.1f Wh, %.0f s", (double)_energy_required, (double)_time_required);
+	}
+
+	if (PX4_ISFINITE(_energy_home)) {
+		PX4_INFO("direct return home: %.1f Wh, %.0f s", (double)_energy_home, (double)_time_home);
+	}
+
+	for (int i = 0; i < _num_safe_points; i++) {
+		PX4_INFO("direct return to safe point %i: %.1f Wh, %.0f s", i + 1,
+			 (double)_safe_points[i].energy, (double)_safe_points[i].time);
+	}
+
+	PX4_INFO("cruise power: %.0f W", (double)_power_model.getPower(return_airspeed()));
+
+	return 0;
+}
+
+int RtlEnergy::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Background process on the LP work queue estimating the time and energy needed to return and publishing
+the `rtl_time_estimate` topic.
+
+The energy for a direct return to home and to each safe point is kept up to date, as well as the energy along
+the path RTL takes for the configured RTL_TYPE: direct to home, to the closest safe point or along the mission.
+The paths are integrated with the current wind estimate and the electrical power measured in flight at the return
+airspeed. The integration is repeated only when the position, the wind, the power model, the home position, the
+mission or the safe points changed noticeably. Mission items are read in slices over several cycles. Every cycle
+compares the RTL_TYPE result against the remaining battery energy, minus the reserve RTL_E_RESERVE, and publishes
+the time left until the return has to be started.
+
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("rtl_energy", "system");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+int rtl_energy_main(int argc, char *argv[])
+{
+	return RtlEnergy::main(argc, argv);
+}
@@ -0,0 +1,289 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file RtlEnergy.hpp
+ *
+ * Background estimator of the time and energy needed to return.
+ *
+ * The energy for a direct return to home and to every safe point is kept up to date,
+ * as well as the energy along the return path RTL would actually take (direct to home
+ * or the closest safe point, or along the mission, depending on RTL_TYPE). The paths are
+ * integrated with the current wind estimate and a power over airspeed model learned in
+ * flight. The integration is only repeated when one of its inputs changed noticeably,
+ * every cycle just compares the result against the remaining battery energy and publishes
+ * the time left until the return is due.
+ *
+ * Mission items are read from dataman in slices of DM_READS_PER_CYCLE per cycle, so that a
+ * long mission does not block the LP work queue. The previous result stays published until
+ * the new one is complete.
+ */
+
+#pragma once
+
+#include "ReturnEnergy.hpp"
+
+#include <dataman/dataman.h>
+#include <drivers/drv_hrt.h>
+#include <lib/ecl/geo/geo.h>
+#include <lib/perf/perf_counter.h>
+#include <mathlib/mathlib.h>
+#include <parameters/param.h>
+#include <px4_module.h>
+#include <px4_module_params.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/battery_status.h>
+#include <uORB/topics/home_position.h>
+#include <uORB/topics/mission.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/rtl_safe_points.h>
+#include <uORB/topics/rtl_time_estimate.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_land_detected.h>
+#include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/wind_estimate.h>
+
+extern "C" __EXPORT int rtl_energy_main(int argc, char *argv[]);
+
+class RtlEnergy : public ModuleBase<RtlEnergy>, public ModuleParams, public px4::ScheduledWorkItem
+{
+public:
+	RtlEnergy();
+	~RtlEnergy() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	void start();
+
+private:
+	void Run() override;
+
+	void parameters_update(bool force = false);
+
+	/**
+	 * Feed the power model with the current power draw and airspeed
+	 */
+	void learn_power();
+
+	/**
+	 * @return true if the return path has to be integrated again
+	 */
+	bool inputs_changed();
+
+	/**
+	 * Start integrating the return paths: direct to home and to every safe point, which completes
+	 * immediately, and the RTL_TYPE path, which might have to continue over the next cycles
+	 */
+	void begin_integration();
+
+	/**
+	 * Continue the RTL_TYPE path integration with at most DM_READS_PER_CYCLE mission items
+	 */
+	void continue_integration();
+
+	/**
+	 * Set up the mission legs of the RTL_TYPE path once the landing sequence is known,
+	 * or fall back to the direct return home
+	 */
+	void plan_mission_legs();
+
+	/**
+	 * Finish the RTL_TYPE path integration with the accumulated path
+	 */
+	void finish_integration(uint8_t destination);
+
+	/**
+	 * Integrate a direct return from the current position: climb to the return altitude,
+	 * fly there and descend to the destination altitude
+	 */
+	void direct_return(double lat, double lon, float alt, float &time, float &energy);
+
+	/**
+	 * Add the legs to fly from the last point of the path to a destination: climb to the return altitude,
+	 * fly there and descend to the destination altitude.
+	 */
+	void add_direct_return(double lat, double lon, float alt);
+
+	/**
+	 * Add a leg from the last point of the path to this point
+	 */
+	void add_leg_to(double lat, double lon, float alt);
+
+	/**
+	 * Copy the safe points navigator published, together with its geofence check
+	 */
+	void update_safe_points();
+
+	float return_airspeed() const;
+
+	static constexpr int RUN_INTERVAL_US = 500000;
+
+	// mission items read from dataman per cycle while integrating along the mission
+	static constexpr int DM_READS_PER_CYCLE = 20;
+
+	static constexpr int SAFE_POINTS_MAX = sizeof(rtl_safe_points_s::lat) / sizeof(double);
+
+	static_assert(SAFE_POINTS_MAX <= sizeof(rtl_time_estimate_s::energy_safe_point) / sizeof(float),
+		      "rtl_time_estimate safe point array too small");
+
+	// values of RTL_TYPE, see RTL::RTLType in navigator
+	enum RTLType {
+		RTL_HOME = 0,
+		RTL_LAND,
+		RTL_MISSION,
+		RTL_CLOSEST,
+	};
+
+	uORB::Subscription _battery_status_sub{ORB_ID(battery_status)};
+	uORB::Subscription _home_position_sub{ORB_ID(home_position)};
+	uORB::Subscription _mission_sub{ORB_ID(mission)};
+	uORB::Subscription _parameter_update_sub{ORB_ID(parameter_update)};
+	uORB::Subscription _rtl_safe_points_sub{ORB_ID(rtl_safe_points)};
+	uORB::Subscription _vehicle_global_position_sub{ORB_ID(vehicle_global_position)};
+	uORB::Subscription _vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
+	uORB::Subscription _vehicle_status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription _wind_estimate_sub{ORB_ID(wind_estimate)};
+
+	uORB::Publication<rtl_time_estimate_s> _rtl_time_estimate_pub{ORB_ID(rtl_time_estimate)};
+
+	battery_status_s _battery_status{};
+	home_position_s _home_position{};
+	mission_s _mission{};
+	vehicle_global_position_s _global_position{};
+	vehicle_land_detected_s _land_detected{};
+	vehicle_status_s _vehicle_status{};
+	wind_estimate_s _wind{};
+
+	return_energy::PowerModel _power_model;
+	return_energy::ReturnPath _path;
+	return_energy::ReturnPath _direct_path;
+
+	// state of the path integration
+	map_projection_reference_s _path_ref{};
+	float _path_north{0.f};
+	float _path_east{0.f};
+	float _path_alt{0.f};
+
+	// inputs of the last integration, compared to decide when to integrate again
+	struct {
+		double lat;
+		double lon;
+		float alt;
+		float wind_north;
+		float wind_east;
+		float cruise_power;
+		hrt_abstime home_timestamp;
+		hrt_abstime mission_timestamp;
+		int32_t mission_seq;
+		hrt_abstime safe_points_timestamp;
+		int rtl_type;
+	} _integrated{};
+
+	bool _integrate_requested{true};
+
+	enum class IntegrationStep {
+		IDLE,
+		FIND_LAND_START,
+		MISSION_LEGS,
+	} _step{IntegrationStep::IDLE};
+
+	// mission legs still to integrate, from _mission_index towards _mission_end (exclusive)
+	int _mission_index{0};
+	int _mission_end{0};
+	bool _return_home_after_mission{false};
+
+	// result of the last integration along the RTL_TYPE path
+	float _time_required{NAN};
+	float _energy_required{NAN};
+	uint8_t _destination{rtl_time_estimate_s::DESTINATION_HOME};
+
+	// result of the last integration of the direct return home
+	float _time_home{NAN};
+	float _energy_home{NAN};
+
+	int _land_start{-1};
+	int _land_start_scan{0};
+	hrt_abstime _land_start_mission_timestamp{0};
+
+	struct SafePoint {
+		double lat;
+		double lon;
+		float alt;	// AMSL
+		bool inside_geofence;	// RTL_CLOSEST only returns to points inside the geofence
+
+		// result of the last integration of the direct return to this point
+		float time;
+		float energy;
+	};
+
+	SafePoint _safe_points[SAFE_POINTS_MAX] {};
+	int _num_safe_points{0};
+	hrt_abstime _safe_points_timestamp{0};
+
+	// parameters of other modules, these might not exist in every build
+	param_t _param_handle_bat_capacity{PARAM_INVALID};
+	param_t _param_handle_rtl_type{PARAM_INVALID};
+	param_t _param_handle_rtl_return_alt{PARAM_INVALID};
+	param_t _param_handle_mpc_xy_cruise{PARAM_INVALID};
+	param_t _param_handle_mpc_z_vel_max_up{PARAM_INVALID};
+	param_t _param_handle_mpc_land_speed{PARAM_INVALID};
+	param_t _param_handle_fw_airspd_trim{PARAM_INVALID};
+
+	float _bat_capacity{-1.f};	// [mAh]
+	int32_t _rtl_type{0};
+	float _rtl_return_alt{60.f};
+	float _mpc_xy_cruise{5.f};
+	float _mpc_z_vel_max_up{3.f};
+	float _mpc_land_speed{0.7f};
+	float _fw_airspd_trim{15.f};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, "rtl_energy_cycle")};
+	perf_counter_t _integration_perf{perf_alloc(PC_ELAPSED, "rtl_energy_integration")};
+
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::RTL_E_RESERVE>) _param_rtl_e_reserve
+	)
+};
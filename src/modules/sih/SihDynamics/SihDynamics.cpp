@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SihDynamics.cpp
+ */
+
+#include "SihDynamics.hpp"
+
+using namespace matrix;
+
+namespace sih
+{
+
+static StateDerivative derivative(const Parameters &param, const State &state, const Vector3f &T_B,
+				  const Vector3f &Mt_B, const Vector3f &wind_I)
+{
+	const Vector3f Fa_I = -param.kdv * (state.v_I - wind_I);  // first order drag to slow down the aircraft
+	const Vector3f Ma_B = -param.kdw * state.w_B;  // first order angular damper
+
+	StateDerivative d;
+	d.p_I_dot = state.v_I;                                                  // position differential
+	d.v_I_dot = (Fa_I + Dcmf(state.q) * T_B) / param.mass + Vector3f(0.f, 0.f, CONSTANTS_ONE_G); // linear momentum
+	d.q_dot = state.q.derivative1(state.w_B);                               // attitude differential
+	d.w_B_dot = param.inertia_inv * (Mt_B + Ma_B - state.w_B.cross(param.inertia * state.w_B)); // angular momentum
+	return d;
+}
+
+static State integrate(const State &state, const StateDerivative &d, float h)
+{
+	State s;
+	s.p_I = state.p_I + d.p_I_dot * h;
+	s.v_I = state.v_I + d.v_I_dot * h;
+	s.q = state.q + d.q_dot * h;
+	s.w_B = state.w_B + d.w_B_dot * h;
+	s.grounded = state.grounded;
+	return s;
+}
+
+// motor thrust and torques in the body frame
+static void motor_forces(const Parameters &param, const float u[NB_MOTORS], Vector3f &T_B, Vector3f &Mt_B)
+{
+	T_B = Vector3f(0.f, 0.f, -param.t_max * (u[0] + u[1] + u[2] + u[3]));
+	Mt_B = Vector3f(param.l_roll * param.t_max * (-u[0] + u[1] + u[2] - u[3]),
+			param.l_pitch * param.t_max * (u[0] - u[1] + u[2] - u[3]),
+			param.q_max * (u[0] + u[1] - u[2] - u[3]));
+}
+
+StateDerivative derivative(const Parameters &param, const State &state, const float u[NB_MOTORS],
+			   const Vector3f &wind_I)
+{
+	Vector3f T_B;
+	Vector3f Mt_B;
+	motor_forces(param, u, T_B, Mt_B);
+	return derivative(param, state, T_B, Mt_B, wind_I);
+}
+
+Vector3f step(const Parameters &param, State &state, const float u[NB_MOTORS], float dt, const Vector3f &wind_I)
+{
+	Vector3f T_B;
+	Vector3f Mt_B;
+	motor_forces(param, u, T_B, Mt_B);
+
+	const StateDerivative k1 = derivative(param, state, T_B, Mt_B, wind_I);
+
+	// fake ground, avoid free fall
+	if (state.p_I(2) > 0.f && (k1.v_I_dot(2) > 0.f || state.v_I(2) > 0.f)) {
+		Vector3f v_I_dot;
+
+		if (!state.grounded) {
+			// if we just hit the floor, report the acceleration that stops the vehicle in one time step
+			v_I_dot = -state.v_I / dt;
+		}
+
+		state.v_I.setZero();
+		state.w_B.setZero();
+		state.grounded = true;
+		return v_I_dot;
+	}
+
+	const StateDerivative k2 = derivative(param, integrate(state, k1, 0.5f * dt), T_B, Mt_B, wind_I);
+	const StateDerivative k3 = derivative(param, integrate(state, k2, 0.5f * dt), T_B, Mt_B, wind_I);
+	const StateDerivative k4 = derivative(param, integrate(state, k3, dt), T_B, Mt_B, wind_I);
+
+	StateDerivative d;
+	d.p_I_dot = (k1.p_I_dot + (k2.p_I_dot + k3.p_I_dot) * 2.f + k4.p_I_dot) / 6.f;
+	d.v_I_dot = (k1.v_I_dot + (k2.v_I_dot + k3.v_I_dot) * 2.f + k4.v_I_dot) / 6.f;
+	d.q_dot = (k1.q_dot + (k2.q_dot + k3.q_dot) * 2.f + k4.q_dot) / 6.f;
+	d.w_B_dot = (k1.w_B_dot + (k2.w_B_dot + k3.w_B_dot) * 2.f + k4.w_B_dot) / 6.f;
+
+	state = integrate(state, d, dt);
+	state.q.normalize();
+	state.grounded = false;
+
+	return d.v_I_dot;
+}
+
+} // namespace sih
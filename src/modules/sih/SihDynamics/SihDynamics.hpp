@@ -0,0 +1,307 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SihDynamics.hpp
+ *
+ * Rigid body quadrotor dynamics of the simulator in hardware.
+ * The scalar API integrates one vehicle with classic fourth order Runge-Kutta,
+ * SihBatch steps K vehicles at once in a structure of arrays layout so the
+ * inner loops vectorize, which is what Monte-Carlo runs want.
+ *
+ * Motor forces and torques are held constant over a step (zero order hold),
+ * the aerodynamic drag is re-evaluated at every Runge-Kutta stage.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <ecl/geo/geo.h>            // to get the physical constants
+#include <matrix/matrix/math.hpp>
+
+namespace sih
+{
+
+static constexpr int NB_MOTORS = 4;
+
+struct Parameters {
+	float mass{1.f};                // vehicle mass [kg]
+	matrix::Matrix3f inertia;       // vehicle inertia matrix [kg m^2]
+	matrix::Matrix3f inertia_inv;   // inverse of the inertia matrix
+	float t_max{0.f};               // max thrust of one motor [N]
+	float q_max{0.f};               // max yaw torque of one motor [Nm]
+	float l_roll{0.f};              // roll arm length [m]
+	float l_pitch{0.f};             // pitch arm length [m]
+	float kdv{0.f};                 // first order linear drag coefficient [N/(m/s)]
+	float kdw{0.f};                 // first order angular damping coefficient [Nm/(rad/s)]
+};
+
+struct State {
+	matrix::Vector3f p_I;           // inertial position [m]
+	matrix::Vector3f v_I;           // inertial velocity [m/s]
+	matrix::Quatf q{1.f, 0.f, 0.f, 0.f}; // body to inertial attitude
+	matrix::Vector3f w_B;           // body rates in body frame [rad/s]
+	bool grounded{true};            // whether the vehicle rests on the fake ground
+};
+
+struct StateDerivative {
+	matrix::Vector3f p_I_dot;
+	matrix::Vector3f v_I_dot;
+	matrix::Quatf q_dot;
+	matrix::Vector3f w_B_dot;
+};
+
+/**
+ * Evaluate the equations of motion of the rigid body.
+ * @param u motor signals in [0, 1]
+ * @param wind_I wind velocity in inertial frame [m/s], the drag acts on the airspeed
+ */
+StateDerivative derivative(const Parameters &param, const State &state, const float u[NB_MOTORS],
+			   const matrix::Vector3f &wind_I = matrix::Vector3f());
+
+/**
+ * Integrate one step with RK4, including the fake ground which avoids free fall.
+ * @param u motor signals in [0, 1], constant over the step
+ * @param dt step size [s]
+ * @param wind_I wind velocity in inertial frame [m/s], constant over the step
+ * @return inertial acceleration over the step [m/s^2], used to reconstruct the accelerometer
+ */
+matrix::Vector3f step(const Parameters &param, State &state, const float u[NB_MOTORS], float dt,
+		      const matrix::Vector3f &wind_I = matrix::Vector3f());
+
+/**
+ * K vehicles sharing the same parameters, stored as structure of arrays.
+ * x[i][k] is state component i of vehicle k, see StateIndex.
+ */
+template<size_t K>
+class SihBatch
+{
+public:
+	enum StateIndex {
+		PX, PY, PZ,
+		VX, VY, VZ,
+		QW, QX, QY, QZ,
+		WX, WY, WZ,
+		NX
+	};
+
+	SihBatch() { reset(); }
+
+	static constexpr size_t size() { return K; }
+
+	void reset()
+	{
+		for (size_t k = 0; k < K; k++) {
+			setState(k, State{});
+
+			for (int m = 0; m < NB_MOTORS; m++) {
+				u[m][k] = 0.f;
+			}
+
+			for (int i = 0; i < 3; i++) {
+				wind_I[i][k] = 0.f;
+			}
+		}
+	}
+
+	void setState(size_t k, const State &s)
+	{
+		for (int i = 0; i < 3; i++) {
+			x[PX + i][k] = s.p_I(i);
+			x[VX + i][k] = s.v_I(i);
+			x[WX + i][k] = s.w_B(i);
+			acc_I[i][k] = 0.f;
+		}
+
+		for (int i = 0; i < 4; i++) {
+			x[QW + i][k] = s.q(i);
+		}
+
+		grounded[k] = s.grounded;
+	}
+
+	State getState(size_t k) const
+	{
+		State s;
+		s.p_I = matrix::Vector3f(x[PX][k], x[PY][k], x[PZ][k]);
+		s.v_I = matrix::Vector3f(x[VX][k], x[VY][k], x[VZ][k]);
+		s.q = matrix::Quatf(x[QW][k], x[QX][k], x[QY][k], x[QZ][k]);
+		s.w_B = matrix::Vector3f(x[WX][k], x[WY][k], x[WZ][k]);
+		s.grounded = grounded[k];
+		return s;
+	}
+
+	/**
+	 * Integrate all vehicles by one RK4 step with their current motor signals u and wind,
+	 * same semantic as sih::step(), the accelerations are stored in acc_I.
+	 */
+	void step(const Parameters &param, float dt)
+	{
+		Coefficients c(param);
+
+		// zero order hold of the motor forces and torques over the step
+		for (size_t k = 0; k < K; k++) {
+			_thrust[k] = -c.t_max * (u[0][k] + u[1][k] + u[2][k] + u[3][k]);
+			_torque[0][k] = c.l_roll * c.t_max * (-u[0][k] + u[1][k] + u[2][k] - u[3][k]);
+			_torque[1][k] = c.l_pitch * c.t_max * (u[0][k] - u[1][k] + u[2][k] - u[3][k]);
+			_torque[2][k] = c.q_max * (u[0][k] + u[1][k] - u[2][k] - u[3][k]);
+		}
+
+		derivative(c, x, _k1);
+
+		// fake ground, decided on the state at the beginning of the step like the scalar version
+		for (size_t k = 0; k < K; k++) {
+			_ground_contact[k] = x[PZ][k] > 0.f && (_k1[VZ][k] > 0.f || x[VZ][k] > 0.f);
+		}
+
+		stage(x, _k1, 0.5f * dt, _tmp);
+		derivative(c, _tmp, _k2);
+		stage(x, _k2, 0.5f * dt, _tmp);
+		derivative(c, _tmp, _k3);
+		stage(x, _k3, dt, _tmp);
+		derivative(c, _tmp, _k4);
+
+		const float h6 = dt / 6.f;
+
+		for (size_t k = 0; k < K; k++) {
+			for (int i = 0; i < 3; i++) {
+				const float a = (_k1[VX + i][k] + 2.f * (_k2[VX + i][k] + _k3[VX + i][k]) + _k4[VX + i][k]) / 6.f;
+				// on first ground contact report the acceleration that stops the vehicle in one step
+				const float a_ground = grounded[k] ? 0.f : -x[VX + i][k] / dt;
+				acc_I[i][k] = _ground_contact[k] ? a_ground : a;
+			}
+		}
+
+		for (int i = 0; i < NX; i++) {
+			const bool frozen = (i >= VX && i <= VZ) || (i >= WX);
+
+			for (size_t k = 0; k < K; k++) {
+				const float next = x[i][k] + h6 * (_k1[i][k] + 2.f * (_k2[i][k] + _k3[i][k]) + _k4[i][k]);
+				x[i][k] = _ground_contact[k] ? (frozen ? 0.f : x[i][k]) : next;
+			}
+		}
+
+		for (size_t k = 0; k < K; k++) {
+			const float n = sqrtf(x[QW][k] * x[QW][k] + x[QX][k] * x[QX][k] + x[QY][k] * x[QY][k] + x[QZ][k] * x[QZ][k]);
+			const float n_inv = 1.f / n;
+			x[QW][k] *= n_inv;
+			x[QX][k] *= n_inv;
+			x[QY][k] *= n_inv;
+			x[QZ][k] *= n_inv;
+			grounded[k] = _ground_contact[k];
+		}
+	}
+
+	float x[NX][K];                 // states
+	float u[NB_MOTORS][K];          // motor signals in [0, 1]
+	float wind_I[3][K];             // wind velocity in inertial frame [m/s]
+	float acc_I[3][K];              // inertial acceleration of the last step [m/s^2]
+	bool grounded[K];
+
+private:
+	// parameters unpacked to plain floats so they stay in registers in the lane loops
+	struct Coefficients {
+		explicit Coefficients(const Parameters &p) :
+			mass_inv(1.f / p.mass), t_max(p.t_max), q_max(p.q_max), l_roll(p.l_roll), l_pitch(p.l_pitch),
+			kdv(p.kdv), kdw(p.kdw)
+		{
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					I[i][j] = p.inertia(i, j);
+					Im1[i][j] = p.inertia_inv(i, j);
+				}
+			}
+		}
+
+		float mass_inv, t_max, q_max, l_roll, l_pitch, kdv, kdw;
+		float I[3][3];
+		float Im1[3][3];
+	};
+
+	void derivative(const Coefficients &c, const float (&s)[NX][K], float (&d)[NX][K]) const
+	{
+		for (size_t k = 0; k < K; k++) {
+			const float qw = s[QW][k], qx = s[QX][k], qy = s[QY][k], qz = s[QZ][k];
+			const float wx = s[WX][k], wy = s[WY][k], wz = s[WZ][k];
+
+			d[PX][k] = s[VX][k];
+			d[PY][k] = s[VY][k];
+			d[PZ][k] = s[VZ][k];
+
+			// thrust along body z rotated to the inertial frame, third column of the dcm
+			const float t = _thrust[k];
+			d[VX][k] = (-c.kdv * (s[VX][k] - wind_I[0][k]) + t * 2.f * (qw * qy + qx * qz)) * c.mass_inv;
+			d[VY][k] = (-c.kdv * (s[VY][k] - wind_I[1][k]) + t * 2.f * (qy * qz - qw * qx)) * c.mass_inv;
+			d[VZ][k] = (-c.kdv * (s[VZ][k] - wind_I[2][k]) + t * (qw * qw - qx * qx - qy * qy + qz * qz)) * c.mass_inv
+				   + CONSTANTS_ONE_G;
+
+			d[QW][k] = 0.5f * (-qx * wx - qy * wy - qz * wz);
+			d[QX][k] = 0.5f * (qw * wx + qy * wz - qz * wy);
+			d[QY][k] = 0.5f * (qw * wy - qx * wz + qz * wx);
+			d[QZ][k] = 0.5f * (qw * wz + qx * wy - qy * wx);
+
+			const float hx = c.I[0][0] * wx + c.I[0][1] * wy + c.I[0][2] * wz;
+			const float hy = c.I[1][0] * wx + c.I[1][1] * wy + c.I[1][2] * wz;
+			const float hz = c.I[2][0] * wx + c.I[2][1] * wy + c.I[2][2] * wz;
+
+			const float mx = _torque[0][k] - c.kdw * wx - (wy * hz - wz * hy);
+			const float my = _torque[1][k] - c.kdw * wy - (wz * hx - wx * hz);
+			const float mz = _torque[2][k] - c.kdw * wz - (wx * hy - wy * hx);
+
+			d[WX][k] = c.Im1[0][0] * mx + c.Im1[0][1] * my + c.Im1[0][2] * mz;
+			d[WY][k] = c.Im1[1][0] * mx + c.Im1[1][1] * my + c.Im1[1][2] * mz;
+			d[WZ][k] = c.Im1[2][0] * mx + c.Im1[2][1] * my + c.Im1[2][2] * mz;
+		}
+	}
+
+	static void stage(const float (&s)[NX][K], const float (&d)[NX][K], float h, float (&out)[NX][K])
+	{
+		for (int i = 0; i < NX; i++) {
+			for (size_t k = 0; k < K; k++) {
+				out[i][k] = s[i][k] + h * d[i][k];
+			}
+		}
+	}
+
+	float _k1[NX][K];
+	float _k2[NX][K];
+	float _k3[NX][K];
+	float _k4[NX][K];
+	float _tmp[NX][K];
+	float _thrust[K];
+	float _torque[3][K];
+	bool _ground_contact[K];
+};
+
+} // namespace sih
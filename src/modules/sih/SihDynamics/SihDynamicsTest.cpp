@@ -0,0 +1,306 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the SIH rigid body dynamics
+ * Run this test only using make tests TESTFILTER=SihDynamics
+ */
+
+#include <gtest/gtest.h>
+#include <matrix/matrix/math.hpp>
+#include <chrono>
+#include <cstdio>
+
+#include <SihDynamics.hpp>
+#include <Xoshiro128.hpp>
+
+using namespace matrix;
+
+static constexpr float DT = 0.004f; // SIH loop interval
+
+class SihDynamicsTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// default SIH_* parameters
+		_param.mass = 1.f;
+		_param.inertia = diag(Vector3f(0.025f, 0.025f, 0.03f));
+		_param.inertia_inv = inv(_param.inertia);
+		_param.t_max = 5.f;
+		_param.q_max = 0.1f;
+		_param.l_roll = 0.2f;
+		_param.l_pitch = 0.2f;
+		_param.kdv = 1.f;
+		_param.kdw = 0.025f;
+	}
+
+	sih::Parameters _param;
+};
+
+TEST_F(SihDynamicsTest, StaysOnGround)
+{
+	// the vehicle starts at ground level, sinks by one step and then rests on the fake ground
+	sih::State state;
+	const float u[sih::NB_MOTORS] = {};
+
+	for (int i = 0; i < 100; i++) {
+		const Vector3f acc = sih::step(_param, state, u, DT);
+
+		if (i > 1) {
+			EXPECT_FLOAT_EQ(acc.norm(), 0.f);
+		}
+	}
+
+	EXPECT_TRUE(state.grounded);
+	EXPECT_NEAR(state.p_I(2), 0.f, 1e-3f);
+	EXPECT_FLOAT_EQ(state.v_I.norm(), 0.f);
+}
+
+TEST_F(SihDynamicsTest, VerticalMotionMatchesAnalytic)
+{
+	// without drag and constant thrust the vertical motion is a parabola, which RK4 integrates exactly
+	_param.kdv = 0.f;
+	sih::State state;
+	state.p_I(2) = -10.f;
+	state.grounded = false;
+	const float u[sih::NB_MOTORS] = {0.6f, 0.6f, 0.6f, 0.6f};
+	const float acc_z = CONSTANTS_ONE_G - 4.f * 0.6f * _param.t_max / _param.mass;
+
+	const int steps = 250;
+
+	for (int i = 0; i < steps; i++) {
+		const Vector3f acc = sih::step(_param, state, u, DT);
+		EXPECT_NEAR(acc(2), acc_z, 1e-4f);
+	}
+
+	const float t = steps * DT;
+	EXPECT_NEAR(state.v_I(2), acc_z * t, 1e-3f);
+	EXPECT_NEAR(state.p_I(2), -10.f + 0.5f * acc_z * t * t, 1e-3f);
+}
+
+TEST_F(SihDynamicsTest, DragConvergesToTerminalVelocity)
+{
+	// exponential velocity decay, forward Euler at this step size would be off by about 0.2%
+	sih::State state;
+	state.p_I(2) = -1000.f;
+	state.v_I(0) = 10.f;
+	state.grounded = false;
+	const float u[sih::NB_MOTORS] = {};
+
+	const int steps = 250;
+
+	for (int i = 0; i < steps; i++) {
+		sih::step(_param, state, u, DT);
+	}
+
+	const float t = steps * DT;
+	const float tau = _param.mass / _param.kdv;
+	EXPECT_NEAR(state.v_I(0), 10.f * expf(-t / tau), 1e-5f);
+	EXPECT_NEAR(state.v_I(2), CONSTANTS_ONE_G * tau * (1.f - expf(-t / tau)), 1e-4f);
+}
+
+TEST_F(SihDynamicsTest, DriftsWithWind)
+{
+	// hovering thrust, the drag pulls the vehicle up to the wind speed
+	sih::State state;
+	state.p_I(2) = -100.f;
+	state.grounded = false;
+	const float hover = _param.mass * CONSTANTS_ONE_G / (4.f * _param.t_max);
+	const float u[sih::NB_MOTORS] = {hover, hover, hover, hover};
+	const Vector3f wind(3.f, -2.f, 0.f);
+
+	for (int i = 0; i < 5000; i++) {
+		sih::step(_param, state, u, DT, wind);
+	}
+
+	EXPECT_NEAR(state.v_I(0), wind(0), 1e-3f);
+	EXPECT_NEAR(state.v_I(1), wind(1), 1e-3f);
+	EXPECT_NEAR(state.v_I(2), 0.f, 1e-3f);
+}
+
+TEST_F(SihDynamicsTest, ConstantYawRateKeepsUnitQuaternion)
+{
+	_param.kdw = 0.f;
+	sih::State state;
+	state.p_I(2) = -1000.f;
+	state.w_B(2) = 1.f;
+	state.grounded = false;
+	const float u[sih::NB_MOTORS] = {};
+
+	for (int i = 0; i < 250; i++) {
+		sih::step(_param, state, u, DT);
+	}
+
+	EXPECT_NEAR(state.q.norm(), 1.f, 1e-6f);
+	EXPECT_NEAR(Eulerf(state.q).psi(), 1.f, 1e-4f);
+	EXPECT_NEAR(state.w_B(2), 1.f, 1e-6f);
+}
+
+TEST_F(SihDynamicsTest, BatchMatchesScalar)
+{
+	static constexpr size_t K = 8;
+	sih::SihBatch<K> batch;
+	sih::State states[K];
+	float u[K][sih::NB_MOTORS];
+	Vector3f wind[K];
+
+	for (size_t k = 0; k < K; k++) {
+		states[k].p_I = Vector3f(0.f, 0.f, -0.5f * k);
+		states[k].q = Quatf(Eulerf(0.1f * k, -0.05f * k, 0.2f * k));
+		states[k].w_B = Vector3f(0.1f, -0.2f, 0.05f * k);
+		states[k].grounded = (k == 0);
+		batch.setState(k, states[k]);
+
+		wind[k] = Vector3f(0.5f * k, -0.2f * k, 0.f);
+
+		for (int j = 0; j < 3; j++) {
+			batch.wind_I[j][k] = wind[k](j);
+		}
+
+		for (int m = 0; m < sih::NB_MOTORS; m++) {
+			u[k][m] = 0.4f + 0.05f * ((k + m) % 4);
+			batch.u[m][k] = u[k][m];
+		}
+	}
+
+	for (int i = 0; i < 500; i++) {
+		batch.step(_param, DT);
+
+		for (size_t k = 0; k < K; k++) {
+			const Vector3f acc = sih::step(_param, states[k], u[k], DT, wind[k]);
+
+			for (int j = 0; j < 3; j++) {
+				EXPECT_NEAR(batch.acc_I[j][k], acc(j), 1e-3f);
+			}
+		}
+	}
+
+	for (size_t k = 0; k < K; k++) {
+		const sih::State s = batch.getState(k);
+		EXPECT_EQ(s.grounded, states[k].grounded);
+
+		for (int j = 0; j < 3; j++) {
+			EXPECT_NEAR(s.p_I(j), states[k].p_I(j), 1e-3f);
+			EXPECT_NEAR(s.v_I(j), states[k].v_I(j), 1e-3f);
+			EXPECT_NEAR(s.w_B(j), states[k].w_B(j), 1e-3f);
+		}
+
+		for (int j = 0; j < 4; j++) {
+			EXPECT_NEAR(s.q(j), states[k].q(j), 1e-4f);
+		}
+	}
+}
+
+TEST(SihXoshiroTest, Deterministic)
+{
+	sih::Xoshiro128 a(1234);
+	sih::Xoshiro128 b(1234);
+	sih::Xoshiro128 c(1235);
+	int differ = 0;
+
+	for (int i = 0; i < 1000; i++) {
+		const uint32_t va = a.next();
+		EXPECT_EQ(va, b.next());
+		differ += (va != c.next());
+	}
+
+	EXPECT_GT(differ, 990);
+}
+
+TEST(SihXoshiroTest, GaussianStatistics)
+{
+	sih::Xoshiro128 rng(42);
+	static constexpr int N = 200000;
+	double sum = 0.0;
+	double sum_sq = 0.0;
+
+	for (int i = 0; i < N; i++) {
+		const double x = rng.gaussian();
+		sum += x;
+		sum_sq += x * x;
+	}
+
+	const double mean = sum / N;
+	EXPECT_NEAR(mean, 0.0, 0.01);
+	EXPECT_NEAR(sum_sq / N - mean * mean, 1.0, 0.02);
+}
+
+TEST_F(SihDynamicsTest, Benchmark)
+{
+	static constexpr size_t K = 64;
+	static constexpr int STEPS = 2000;
+	sih::SihBatch<K> batch;
+	sih::State state;
+	state.p_I(2) = -100.f;
+	state.grounded = false;
+
+	for (size_t k = 0; k < K; k++) {
+		batch.setState(k, state);
+
+		for (int m = 0; m < sih::NB_MOTORS; m++) {
+			batch.u[m][k] = 0.45f + 0.001f * k;
+		}
+	}
+
+	const float u[sih::NB_MOTORS] = {0.45f, 0.45f, 0.45f, 0.45f};
+	sih::State states[K];
+
+	for (size_t k = 0; k < K; k++) {
+		states[k] = state;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < STEPS; i++) {
+		for (size_t k = 0; k < K; k++) {
+			sih::step(_param, states[k], u, DT);
+		}
+	}
+
+	const double scalar_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < STEPS; i++) {
+		batch.step(_param, DT);
+	}
+
+	const double batch_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("vehicle steps per second: scalar %.0f, batch of %zu %.0f\n",
+	       K * STEPS / scalar_s, K, K * STEPS / batch_s);
+
+	EXPECT_TRUE(std::isfinite(batch.x[sih::SihBatch<K>::PZ][K - 1]));
+	EXPECT_TRUE(std::isfinite(states[K - 1].p_I(2)));
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file Xoshiro128.hpp
+ *
+ * xoshiro128+ pseudo random number generator with Gaussian sampling.
+ * Small per instance state, no locking and much faster than rand(),
+ * so every simulated vehicle can own its own reproducible noise stream.
+ *
+ * Reference: D. Blackman, S. Vigna, "Scrambled linear pseudorandom number generators", 2018.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+namespace sih
+{
+
+class Xoshiro128
+{
+public:
+	explicit Xoshiro128(uint64_t seed = 1) { setSeed(seed); }
+
+	/** Seed the state with splitmix64, any seed including 0 is valid. */
+	void setSeed(uint64_t seed)
+	{
+		for (int i = 0; i < 4; i++) {
+			seed += 0x9e3779b97f4a7c15ull;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			_s[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+		}
+
+		_has_spare = false;
+	}
+
+	uint32_t next()
+	{
+		const uint32_t result = _s[0] + _s[3];
+		const uint32_t t = _s[1] << 9;
+
+		_s[2] ^= _s[0];
+		_s[3] ^= _s[1];
+		_s[1] ^= _s[2];
+		_s[0] ^= _s[3];
+		_s[2] ^= t;
+		_s[3] = (_s[3] << 11) | (_s[3] >> 21);
+
+		return result;
+	}
+
+	/** @return uniform sample in [0, 1) from the upper 24 bits */
+	float uniform() { return (float)(next() >> 8) * (1.f / 16777216.f); }
+
+	/** @return standard normal sample (Marsaglia polar method, the second sample is cached) */
+	float gaussian()
+	{
+		if (_has_spare) {
+			_has_spare = false;
+			return _spare;
+		}
+
+		float v1, v2, s;
+
+		do {
+			v1 = 2.f * uniform() - 1.f;
+			v2 = 2.f * uniform() - 1.f;
+			s = v1 * v1 + v2 * v2;
+		} while (s >= 1.f || s < 1e-8f);
+
+		const float scale = sqrtf(-2.f * logf(s) / s);
+		_spare = v2 * scale;
+		_has_spare = true;
+
+		return v1 * scale;
+	}
+
+private:
+	uint32_t _s[4];
+	float _spare{0.f};
+	bool _has_spare{false};
+};
+
+} // namespace sih
@@ -159,8 +159,6 @@ void Sih::inner_loop()
 
 	read_motors();
 
-	generate_force_and_torques();
-
 	equations_of_motion();
 
 	reconstruct_sensors_signals();
@@ -199,28 +197,27 @@ void Sih::parameters_update_poll()
 // store the parameters in a more convenient form
 void Sih::parameters_updated()
 {
-	_T_MAX = _sih_t_max.get();
-	_Q_MAX = _sih_q_max.get();
-	_L_ROLL = _sih_l_roll.get();
-	_L_PITCH = _sih_l_pitch.get();
-	_KDV = _sih_kdv.get();
-	_KDW = _sih_kdw.get();
+	_param.t_max = _sih_t_max.get();
+	_param.q_max = _sih_q_max.get();
+	_param.l_roll = _sih_l_roll.get();
+	_param.l_pitch = _sih_l_pitch.get();
+	_param.kdv = _sih_kdv.get();
+	_param.kdw = _sih_kdw.get();
 	_H0 = _sih_h0.get();
 
 	_LAT0 = (double)_sih_lat0.get() * 1.0e-7;
 	_LON0 = (double)_sih_lon0.get() * 1.0e-7;
 	_COS_LAT0 = cosl(radians(_LAT0));
 
-	_MASS = _sih_mass.get();
-
-	_W_I = Vector3f(0.0f, 0.0f, _MASS * CONSTANTS_ONE_G);
+	_param.mass = _sih_mass.get();
 
-	_I = diag(Vector3f(_sih_ixx.get(), _sih_iyy.get(), _sih_izz.get()));
-	_I(0, 1) = _I(1, 0) = _sih_ixy.get();
-	_I(0, 2) = _I(2, 0) = _sih_ixz.get();
-	_I(1, 2) = _I(2, 1) = _sih_iyz.get();
+	Matrix3f &I = _param.inertia;
+	I = diag(Vector3f(_sih_ixx.get(), _sih_iyy.get(), _sih_izz.get()));
+	I(0, 1) = I(1, 0) = _sih_ixy.get();
+	I(0, 2) = I(2, 0) = _sih_ixz.get();
+	I(1, 2) = I(2, 1) = _sih_iyz.get();
 
-	_Im1 = inv(_I);
+	_param.inertia_inv = inv(I);
 
 	_mu_I = Vector3f(_sih_mu_x.get(), _sih_mu_y.get(), _sih_mu_z.get());
 }
@@ -228,12 +225,10 @@ void Sih::parameters_updated()
 // initialization of the variables for the simulator
 void Sih::init_variables()
 {
-	srand(1234);    // initialize the random seed once before calling generate_wgn()
+	_rng.setSeed(1234);    // same noise sequence on every start
 
-	_p_I = Vector3f(0.0f, 0.0f, 0.0f);
-	_v_I = Vector3f(0.0f, 0.0f, 0.0f);
-	_q = Quatf(1.0f, 0.0f, 0.0f, 0.0f);
-	_w_B = Vector3f(0.0f, 0.0f, 0.0f);
+	_state = sih::State{};
+	_C_IB = _state.q.to_dcm();
 
 	_u[0] = _u[1] = _u[2] = _u[3] = 0.0f;
 }
@@ -270,52 +265,11 @@ void Sih::read_motors()
 	}
 }
 
-// generate the motors thrust and torque in the body frame
-void Sih::generate_force_and_torques()
-{
-	_T_B = Vector3f(0.0f, 0.0f, -_T_MAX * (+_u[0] + _u[1] + _u[2] + _u[3]));
-	_Mt_B = Vector3f(_L_ROLL * _T_MAX * (-_u[0] + _u[1] + _u[2] - _u[3]),
-			 _L_PITCH * _T_MAX * (+_u[0] - _u[1] + _u[2] - _u[3]),
-			 _Q_MAX * (+_u[0] + _u[1] - _u[2] - _u[3]));
-
-	_Fa_I = -_KDV * _v_I;   // first order drag to slow down the aircraft
-	_Ma_B = -_KDW * _w_B;   // first order angular damper
-}
-
-// apply the equations of motion of a rigid body and integrate one step
+// integrate the equations of motion of a rigid body by one step
 void Sih::equations_of_motion()
 {
-	_C_IB = _q.to_dcm(); // body to inertial transformation
-
-	// Equations of motion of a rigid body
-	_p_I_dot = _v_I;                        // position differential
-	_v_I_dot = (_W_I + _Fa_I + _C_IB * _T_B) / _MASS;   // conservation of linear momentum
-	_q_dot = _q.derivative1(_w_B);              // attitude differential
-	_w_B_dot = _Im1 * (_Mt_B + _Ma_B - _w_B.cross(_I * _w_B)); // conservation of angular momentum
-
-	// fake ground, avoid free fall
-	if (_p_I(2) > 0.0f && (_v_I_dot(2) > 0.0f || _v_I(2) > 0.0f)) {
-		if (!_grounded) {    // if we just hit the floor
-			// for the accelerometer, compute the acceleration that will stop the vehicle in one time step
-			_v_I_dot = -_v_I / _dt;
-
-		} else {
-			_v_I_dot.setZero();
-		}
-
-		_v_I.setZero();
-		_w_B.setZero();
-		_grounded = true;
-
-	} else {
-		// integration: Euler forward
-		_p_I = _p_I + _p_I_dot * _dt;
-		_v_I = _v_I + _v_I_dot * _dt;
-		_q = _q + _q_dot * _dt; // as given in attitude_estimator_q_main.cpp
-		_q.normalize();
-		_w_B = _w_B + _w_B_dot * _dt;
-		_grounded = false;
-	}
+	_v_I_dot = sih::step(_param, _state, _u, _dt);
+	_C_IB = _state.q.to_dcm(); // body to inertial transformation
 }
 
 // reconstruct the noisy sensor signals
@@ -327,24 +281,24 @@ void Sih::reconstruct_sensors_signals()
 
 	// IMU
 	_acc = _C_IB.transpose() * (_v_I_dot - Vector3f(0.0f, 0.0f, CONSTANTS_ONE_G)) + noiseGauss3f(0.5f, 1.7f, 1.4f);
-	_gyro = _w_B + noiseGauss3f(0.14f, 0.07f, 0.03f);
+	_gyro = _state.w_B + noiseGauss3f(0.14f, 0.07f, 0.03f);
 	_mag = _C_IB.transpose() * _mu_I + noiseGauss3f(0.02f, 0.02f, 0.03f);
 
 	// barometer
-	float altitude = (_H0 - _p_I(2)) + generate_wgn() * 0.14f; // altitude with noise
+	float altitude = (_H0 - _state.p_I(2)) + generate_wgn() * 0.14f; // altitude with noise
 	_baro_p_mBar = CONSTANTS_STD_PRESSURE_MBAR *        // reconstructed pressure in mBar
 		       powf((1.0f + altitude * TEMP_GRADIENT / T1_K), -CONSTANTS_ONE_G / (TEMP_GRADIENT * CONSTANTS_AIR_GAS_CONST));
 	_baro_temp_c = T1_K + CONSTANTS_ABSOLUTE_NULL_CELSIUS + TEMP_GRADIENT * altitude; // reconstructed temperture in celcius
 
 	// GPS
-	_gps_lat_noiseless = _LAT0 + degrees((double)_p_I(0) / CONSTANTS_RADIUS_OF_EARTH);
-	_gps_lon_noiseless = _LON0 + degrees((double)_p_I(1) / CONSTANTS_RADIUS_OF_EARTH) / _COS_LAT0;
-	_gps_alt_noiseless = _H0 - _p_I(2);
+	_gps_lat_noiseless = _LAT0 + degrees((double)_state.p_I(0) / CONSTANTS_RADIUS_OF_EARTH);
+	_gps_lon_noiseless = _LON0 + degrees((double)_state.p_I(1) / CONSTANTS_RADIUS_OF_EARTH) / _COS_LAT0;
+	_gps_alt_noiseless = _H0 - _state.p_I(2);
 
 	_gps_lat = _gps_lat_noiseless + (double)(generate_wgn() * 7.2e-6f); // latitude in degrees
 	_gps_lon = _gps_lon_noiseless + (double)(generate_wgn() * 1.75e-5f); // longitude in degrees
 	_gps_alt = _gps_alt_noiseless + generate_wgn() * 1.78f;
-	_gps_vel = _v_I + noiseGauss3f(0.06f, 0.077f, 0.158f);
+	_gps_vel = _state.v_I + noiseGauss3f(0.06f, 0.077f, 0.158f);
 }
 
 void Sih::send_IMU()
@@ -408,9 +362,9 @@ void Sih::publish_sih()
 {
 	// publish angular velocity groundtruth
 	_vehicle_angular_velocity_gt.timestamp = hrt_absolute_time();
-	_vehicle_angular_velocity_gt.xyz[0] = _w_B(0); // rollspeed;
-	_vehicle_angular_velocity_gt.xyz[1] = _w_B(1); // pitchspeed;
-	_vehicle_angular_velocity_gt.xyz[2] = _w_B(2); // yawspeed;
+	_vehicle_angular_velocity_gt.xyz[0] = _state.w_B(0); // rollspeed;
+	_vehicle_angular_velocity_gt.xyz[1] = _state.w_B(1); // pitchspeed;
+	_vehicle_angular_velocity_gt.xyz[2] = _state.w_B(2); // yawspeed;
 
 	if (_vehicle_angular_velocity_gt_pub != nullptr) {
 		orb_publish(ORB_ID(vehicle_angular_velocity_groundtruth), _vehicle_angular_velocity_gt_pub,
@@ -423,10 +377,10 @@ void Sih::publish_sih()
 
 	// publish attitude groundtruth
 	_att_gt.timestamp = hrt_absolute_time();
-	_att_gt.q[0] = _q(0);
-	_att_gt.q[1] = _q(1);
-	_att_gt.q[2] = _q(2);
-	_att_gt.q[3] = _q(3);
+	_att_gt.q[0] = _state.q(0);
+	_att_gt.q[1] = _state.q(1);
+	_att_gt.q[2] = _state.q(2);
+	_att_gt.q[3] = _state.q(3);
 
 	if (_att_gt_pub != nullptr) {
 		orb_publish(ORB_ID(vehicle_attitude_groundtruth), _att_gt_pub, &_att_gt);
@@ -439,9 +393,9 @@ void Sih::publish_sih()
 	_gpos_gt.lat = _gps_lat_noiseless;
 	_gpos_gt.lon = _gps_lon_noiseless;
 	_gpos_gt.alt = _gps_alt_noiseless;
-	_gpos_gt.vel_n = _v_I(0);
-	_gpos_gt.vel_e = _v_I(1);
-	_gpos_gt.vel_d = _v_I(2);
+	_gpos_gt.vel_n = _state.v_I(0);
+	_gpos_gt.vel_e = _state.v_I(1);
+	_gpos_gt.vel_d = _state.v_I(2);
 
 	if (_gpos_gt_pub != nullptr) {
 		orb_publish(ORB_ID(vehicle_global_position_groundtruth), _gpos_gt_pub, &_gpos_gt);
@@ -451,35 +405,6 @@ void Sih::publish_sih()
 	}
 }
 
-float Sih::generate_wgn()   // generate white Gaussian noise sample with std=1
-{
-	// algorithm 1:
-	// float temp=((float)(rand()+1))/(((float)RAND_MAX+1.0f));
-	// return sqrtf(-2.0f*logf(temp))*cosf(2.0f*M_PI_F*rand()/RAND_MAX);
-	// algorithm 2: from BlockRandGauss.hpp
-	static float V1, V2, S;
-	static bool phase = true;
-	float X;
-
-	if (phase) {
-		do {
-			float U1 = (float)rand() / RAND_MAX;
-			float U2 = (float)rand() / RAND_MAX;
-			V1 = 2.0f * U1 - 1.0f;
-			V2 = 2.0f * U2 - 1.0f;
-			S = V1 * V1 + V2 * V2;
-		} while (S >= 1.0f || fabsf(S) < 1e-8f);
-
-		X = V1 * float(sqrtf(-2.0f * float(logf(S)) / S));
-
-	} else {
-		X = V2 * float(sqrtf(-2.0f * float(logf(S)) / S));
-	}
-
-	phase = !phase;
-	return X;
-}
-
 // generate white Gaussian noise sample vector with specified std
 Vector3f Sih::noiseGauss3f(float stdx, float stdy, float stdz)
 {
@@ -512,7 +437,7 @@ in order to incorporate the state estimator in the loop.
 ### Implementation
 The simulator implements the equations of motion using matrix algebra.
 Quaternion representation is used for the attitude.
-Forward Euler is used for integration.
+Fourth order Runge-Kutta is used for integration (see SihDynamics).
 Most of the variables are declared global in the .hpp file to avoid stack overflow.
 
 
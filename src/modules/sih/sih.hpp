@@ -53,6 +53,9 @@
 #include <uORB/topics/vehicle_global_position.h>    // to publish groundtruth
 #include <uORB/topics/vehicle_gps_position.h>
 
+#include <SihDynamics.hpp>
+#include <Xoshiro128.hpp>
+
 extern "C" __EXPORT int sih_main(int argc, char *argv[]);
 
 class Sih : public ModuleBase<Sih>, public ModuleParams
@@ -80,10 +83,10 @@ public:
 	/** @see ModuleBase::print_status() */
 	int print_status() override;
 
-	static float generate_wgn();    // generate white Gaussian noise sample
+	float generate_wgn() { return _rng.gaussian(); }    // generate white Gaussian noise sample
 
 	// generate white Gaussian noise sample as a 3D vector with specified std
-	static matrix::Vector3f noiseGauss3f(float stdx, float stdy, float stdz);
+	matrix::Vector3f noiseGauss3f(float stdx, float stdy, float stdz);
 
 	// timer called periodically to post the semaphore
 	static void timer_callback(void *sem);
@@ -124,7 +127,7 @@ private:
 	int _actuator_out_sub {-1};
 
 	// hard constants
-	static constexpr uint16_t NB_MOTORS = 4;
+	static constexpr uint16_t NB_MOTORS = sih::NB_MOTORS;
 	static constexpr float T1_C = 15.0f;                        // ground temperature in celcius
 	static constexpr float T1_K = T1_C - CONSTANTS_ABSOLUTE_NULL_CELSIUS;   // ground temperature in Kelvin
 	static constexpr float TEMP_GRADIENT  = -6.5f / 1000.0f;    // temperature gradient in degrees per metre
@@ -133,7 +136,6 @@ private:
 	void init_variables();
 	void init_sensors();
 	void read_motors();
-	void generate_force_and_torques();
 	void equations_of_motion();
 	void reconstruct_sensors_signals();
 	void send_IMU();
@@ -152,24 +154,15 @@ private:
 	hrt_abstime _serial_time;
 	hrt_abstime _now;
 	float       _dt;            // sampling time [s]
-	bool        _grounded{true};// whether the vehicle is on the ground
-
-	matrix::Vector3f    _T_B;           // thrust force in body frame [N]
-	matrix::Vector3f    _Fa_I;          // aerodynamic force in inertial frame [N]
-	matrix::Vector3f    _Mt_B;          // thruster moments in the body frame [Nm]
-	matrix::Vector3f    _Ma_B;          // aerodynamic moments in the body frame [Nm]
-	matrix::Vector3f    _p_I;           // inertial position [m]
-	matrix::Vector3f    _v_I;           // inertial velocity [m/s]
-	matrix::Vector3f    _v_B;           // body frame velocity [m/s]
-	matrix::Vector3f    _p_I_dot;       // inertial position differential
-	matrix::Vector3f    _v_I_dot;       // inertial velocity differential
-	matrix::Quatf       _q;             // quaternion attitude
+
+	sih::Parameters     _param;         // vehicle dynamics parameters
+	sih::State          _state;         // position, velocity, attitude and body rates
+	matrix::Vector3f    _v_I_dot;       // inertial acceleration of the last step
 	matrix::Dcmf        _C_IB;          // body to inertial transformation
-	matrix::Vector3f    _w_B;           // body rates in body frame [rad/s]
-	matrix::Quatf       _q_dot;         // quaternion differential
-	matrix::Vector3f    _w_B_dot;       // body rates differential
 	float       _u[NB_MOTORS];  // thruster signals
 
+	sih::Xoshiro128     _rng;           // noise generator, seeded in init_variables()
+
 
 	// sensors reconstruction
 	matrix::Vector3f    _acc;
@@ -183,11 +176,8 @@ private:
 	float       _baro_temp_c;   // reconstructed (simulated) barometer temperature in celcius
 
 	// parameters
-	float _MASS, _T_MAX, _Q_MAX, _L_ROLL, _L_PITCH, _KDV, _KDW, _H0;
+	float _H0;
 	double _LAT0, _LON0, _COS_LAT0;
-	matrix::Vector3f _W_I;  // weight of the vehicle in inertial frame [N]
-	matrix::Matrix3f _I;    // vehicle inertia matrix
-	matrix::Matrix3f _Im1;  // inverse of the intertia matrix
 	matrix::Vector3f _mu_I; // NED magnetic field in inertial frame [G]
 
 	// parameters defined in sih_params.c
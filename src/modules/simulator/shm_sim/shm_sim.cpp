@@ -0,0 +1,567 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file shm_sim.cpp
+ *
+ * Quadrotor physics stepping PX4 in lockstep over the shared memory simulator
+ * link, using the SIH rigid body dynamics. It stands in for a full simulator
+ * to test the link, to measure the SITL step rate without IPC overhead
+ * dominating and as the vehicle model of Tools/montecarlo_run.py.
+ *
+ * Besides the nominal vehicle it can perturb the flight for Monte-Carlo runs
+ * (mass and thrust scaling, wind with gusts, sensor noise, a motor failure) and
+ * write ground truth metrics of the flight to a json file when it exits.
+ *
+ * Usage: shm_sim [-n shm_name] [-r rate_hz] [-d duration_s] [-s seed] [-M mass_scale]
+ *                [-T thrust_scale] [-w north,east,gust] [-N noise_scale]
+ *                [-f motor,time_s,efficiency] [-o result.json] [-l] [-p]
+ */
+
+#include "../simulator_shm.h"
+
+#include <SihDynamics.hpp>
+#include <Xoshiro128.hpp>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace simulator;
+using matrix::Dcmf;
+using matrix::Vector3f;
+
+namespace
+{
+
+// Iris like quadrotor
+static constexpr float MASS = 1.5f;			// kg
+static constexpr float MOTOR_THRUST_MAX = 8.f;		// N per motor
+static constexpr float MOTOR_MOMENT_RATIO = 0.05f;	// m, yaw moment per unit thrust
+static constexpr float ARM = 0.18f;			// m, motor offset along x and y
+static constexpr float INERTIA[3] {0.03f, 0.03f, 0.05f};	// kg m^2
+static constexpr float DRAG_LINEAR = 0.1f;		// N / (m/s)
+static constexpr float DRAG_ANGULAR = 0.01f;		// Nm / (rad/s)
+
+// home position and earth field (Zurich)
+static constexpr double LAT_HOME = 47.397742;
+static constexpr double LON_HOME = 8.545594;
+static constexpr float ALT_HOME = 488.f;		// m AMSL
+static const Vector3f MAG_EARTH{0.21f, 0.015f, 0.42f};	// gauss, NED
+static constexpr double EARTH_RADIUS = 6371000.0;
+
+// sensor noise standard deviations at noise scale 1
+static constexpr float NOISE_ACCEL = 0.1f;		// m/s^2
+static constexpr float NOISE_GYRO = 0.01f;		// rad/s
+static constexpr float NOISE_MAG = 0.005f;		// gauss
+static constexpr float NOISE_BARO = 0.1f;		// m
+static constexpr float NOISE_GPS_POS = 0.3f;		// m
+static constexpr float NOISE_GPS_VEL = 0.05f;		// m/s
+
+static constexpr float GUST_TIME_CONSTANT = 2.f;	// s
+static constexpr float AIRBORNE_ALT = 0.5f;		// m above ground to count as flying
+static constexpr double EXIT_AFTER_LANDING = 3.0;	// s
+
+struct Scenario {
+	uint64_t seed{1};
+	float mass_scale{1.f};
+	float thrust_scale{1.f};
+	float wind[2] {};		// mean wind north, east [m/s]
+	float gust{0.f};		// gust standard deviation [m/s]
+	float noise_scale{0.f};
+	int failed_motor{-1};
+	double failure_time{0.0};	// s
+	float failure_efficiency{0.f};
+};
+
+// ground truth flight metrics, horizontal errors are relative to the takeoff point
+struct Metrics {
+	bool flown{false};
+	bool landed{false};
+	double takeoff_time{0.0};
+	double landing_time{0.0};
+	float max_alt{0.f};
+	float max_tilt{0.f};
+	float touchdown_speed{0.f};
+	float landing_error{0.f};
+	float horizontal_max{0.f};
+	double horizontal_sq_sum{0.0};
+	uint64_t airborne_steps{0};
+};
+
+sih::Parameters vehicle_parameters(const Scenario &scenario)
+{
+	sih::Parameters p;
+	p.mass = MASS * scenario.mass_scale;
+	p.inertia = matrix::diag(Vector3f(INERTIA[0], INERTIA[1], INERTIA[2])) * scenario.mass_scale;
+	p.inertia_inv = matrix::inv(p.inertia);
+	p.t_max = MOTOR_THRUST_MAX * scenario.thrust_scale;
+	p.q_max = MOTOR_MOMENT_RATIO * p.t_max;
+	p.l_roll = ARM;
+	p.l_pitch = ARM;
+	p.kdv = DRAG_LINEAR;
+	p.kdw = DRAG_ANGULAR;
+	return p;
+}
+
+// first order Gauss-Markov gusts around the mean wind
+Vector3f update_wind(const Scenario &scenario, Vector3f &gust, sih::Xoshiro128 &rng, float dt)
+{
+	if (scenario.gust > 0.f) {
+		const float drive = scenario.gust * sqrtf(2.f * dt / GUST_TIME_CONSTANT);
+
+		for (int i = 0; i < 2; i++) {
+			gust(i) += -gust(i) / GUST_TIME_CONSTANT * dt + drive * rng.gaussian();
+		}
+	}
+
+	return Vector3f(scenario.wind[0] + gust(0), scenario.wind[1] + gust(1), 0.f);
+}
+
+Vector3f noise3(sih::Xoshiro128 &rng, float std)
+{
+	return Vector3f(rng.gaussian(), rng.gaussian(), rng.gaussian()) * std;
+}
+
+void update_metrics(const sih::State &s, bool was_grounded, const Vector3f &v_before, double time, Metrics &m)
+{
+	const float alt = -s.p_I(2);
+	const float horizontal = sqrtf(s.p_I(0) * s.p_I(0) + s.p_I(1) * s.p_I(1));
+
+	if (!m.flown && alt > AIRBORNE_ALT) {
+		m.flown = true;
+		m.takeoff_time = time;
+	}
+
+	if (!m.flown || m.landed) {
+		return;
+	}
+
+	if (s.grounded && !was_grounded) {
+		m.landed = true;
+		m.landing_time = time;
+		m.touchdown_speed = v_before.norm();
+		m.landing_error = horizontal;
+		return;
+	}
+
+	// tilt from the z axis of the body, third row of the dcm
+	const float tilt = acosf(fminf(fmaxf(Dcmf(s.q)(2, 2), -1.f), 1.f));
+
+	m.max_alt = fmaxf(m.max_alt, alt);
+	m.max_tilt = fmaxf(m.max_tilt, tilt);
+	m.horizontal_max = fmaxf(m.horizontal_max, horizontal);
+	m.horizontal_sq_sum += (double)(horizontal * horizontal);
+	m.airborne_steps++;
+}
+
+bool write_metrics(const char *path, const Metrics &m, double sim_time, double steps_per_s)
+{
+	FILE *f = fopen(path, "w");
+
+	if (f == nullptr) {
+		return false;
+	}
+
+	const double rms = m.airborne_steps > 0 ? sqrt(m.horizontal_sq_sum / m.airborne_steps) : 0.0;
+	fprintf(f, "{\n");
+	fprintf(f, "  \"sim_time_s\": %.3f,\n", sim_time);
+	fprintf(f, "  \"flown\": %s,\n", m.flown ? "true" : "false");
+	fprintf(f, "  \"landed\": %s,\n", m.landed ? "true" : "false");
+	fprintf(f, "  \"takeoff_time_s\": %.3f,\n", m.takeoff_time);
+	fprintf(f, "  \"landing_time_s\": %.3f,\n", m.landing_time);
+	fprintf(f, "  \"max_alt_m\": %.3f,\n", (double)m.max_alt);
+	fprintf(f, "  \"max_tilt_deg\": %.2f,\n", (double)m.max_tilt * 180.0 / M_PI);
+	fprintf(f, "  \"touchdown_speed_m_s\": %.3f,\n", (double)m.touchdown_speed);
+	fprintf(f, "  \"landing_error_m\": %.3f,\n", (double)m.landing_error);
+	fprintf(f, "  \"horizontal_max_m\": %.3f,\n", (double)m.horizontal_max);
+	fprintf(f, "  \"horizontal_rms_m\": %.3f,\n", rms);
+	fprintf(f, "  \"steps_per_s\": %.0f\n", steps_per_s);
+	fprintf(f, "}\n");
+	fclose(f);
+	return true;
+}
+
+void fill_frame(const sih::State &s, const Vector3f &accel_I, uint64_t time_usec, bool gps, float noise,
+		sih::Xoshiro128 &rng, shm::SensorFrame &frame)
+{
+	memset(&frame, 0, sizeof(frame));
+
+	const Dcmf C_BI = Dcmf(s.q).transpose();
+
+	// specific force in body frame
+	const Vector3f acc = C_BI * (accel_I - Vector3f(0.f, 0.f, CONSTANTS_ONE_G)) + noise3(rng, NOISE_ACCEL * noise);
+	const Vector3f gyro = s.w_B + noise3(rng, NOISE_GYRO * noise);
+	const Vector3f mag = C_BI * MAG_EARTH + noise3(rng, NOISE_MAG * noise);
+
+	const float alt = ALT_HOME - s.p_I(2);
+	const float baro_alt = alt + NOISE_BARO * noise * rng.gaussian();
+
+	mavlink_hil_sensor_t &sensor = frame.sensor;
+	sensor.time_usec = time_usec;
+	sensor.xacc = acc(0);
+	sensor.yacc = acc(1);
+	sensor.zacc = acc(2);
+	sensor.xgyro = gyro(0);
+	sensor.ygyro = gyro(1);
+	sensor.zgyro = gyro(2);
+	sensor.xmag = mag(0);
+	sensor.ymag = mag(1);
+	sensor.zmag = mag(2);
+	sensor.abs_pressure = 1013.25f * powf(1.f - 2.25577e-5f * baro_alt, 5.25588f); // hPa
+	sensor.diff_pressure = 0.f;
+	sensor.pressure_alt = baro_alt;
+	sensor.temperature = 20.f;
+	sensor.fields_updated = 0x1FFF;
+
+	const double lat = LAT_HOME + (double)s.p_I(0) / EARTH_RADIUS * 180.0 / M_PI;
+	const double lon = LON_HOME + (double)s.p_I(1) / (EARTH_RADIUS * cos(LAT_HOME * M_PI / 180.0)) * 180.0 / M_PI;
+
+	if (gps) {
+		const Vector3f pos_noise = noise3(rng, NOISE_GPS_POS * noise);
+		const Vector3f vel = s.v_I + noise3(rng, NOISE_GPS_VEL * noise);
+
+		mavlink_hil_gps_t &hil_gps = frame.gps;
+		hil_gps.time_usec = time_usec;
+		hil_gps.lat = (int32_t)((lat + (double)pos_noise(0) / EARTH_RADIUS * 180.0 / M_PI) * 1e7);
+		hil_gps.lon = (int32_t)((lon + (double)pos_noise(1) / (EARTH_RADIUS * cos(LAT_HOME * M_PI / 180.0)) * 180.0 / M_PI)
+					* 1e7);
+		hil_gps.alt = (int32_t)((alt - pos_noise(2)) * 1000.f);
+		hil_gps.eph = 30;
+		hil_gps.epv = 40;
+		hil_gps.vel = (uint16_t)(sqrtf(vel(0) * vel(0) + vel(1) * vel(1)) * 100.f);
+		hil_gps.vn = (int16_t)(vel(0) * 100.f);
+		hil_gps.ve = (int16_t)(vel(1) * 100.f);
+		hil_gps.vd = (int16_t)(vel(2) * 100.f);
+		hil_gps.cog = UINT16_MAX;
+		hil_gps.fix_type = 3;
+		hil_gps.satellites_visible = 10;
+		frame.updated |= shm::UPDATED_GPS;
+	}
+
+	// ground truth
+	mavlink_hil_state_quaternion_t &state = frame.state;
+	const Vector3f acc_true = C_BI * (accel_I - Vector3f(0.f, 0.f, CONSTANTS_ONE_G));
+	state.time_usec = time_usec;
+
+	for (int i = 0; i < 4; i++) {
+		state.attitude_quaternion[i] = s.q(i);
+	}
+
+	state.rollspeed = s.w_B(0);
+	state.pitchspeed = s.w_B(1);
+	state.yawspeed = s.w_B(2);
+	state.lat = (int32_t)(lat * 1e7);
+	state.lon = (int32_t)(lon * 1e7);
+	state.alt = (int32_t)(alt * 1000.f);
+	state.vx = (int16_t)(s.v_I(0) * 100.f);
+	state.vy = (int16_t)(s.v_I(1) * 100.f);
+	state.vz = (int16_t)(s.v_I(2) * 100.f);
+	state.xacc = (int16_t)(acc_true(0) / CONSTANTS_ONE_G * 1000.f);
+	state.yacc = (int16_t)(acc_true(1) / CONSTANTS_ONE_G * 1000.f);
+	state.zacc = (int16_t)(acc_true(2) / CONSTANTS_ONE_G * 1000.f);
+	frame.updated |= shm::UPDATED_STATE;
+}
+
+double wall_time()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Re-attach if PX4 exited or was restarted and replaced the segment, otherwise both sides would
+ * wait on a ring the other one does not serve anymore.
+ * @return false if no live segment showed up
+ */
+bool check_link(shm::Link &link, const char *name, bool &lockstep)
+{
+	if (link.valid()) {
+		return true;
+	}
+
+	printf("shm_sim: shared memory %s is stale, re-attaching\n", name);
+	link.close();
+	lockstep = false;
+
+	if (!link.attach(name, 60 * 1000)) {
+		printf("shm_sim: shared memory %s not found\n", name);
+		return false;
+	}
+
+	printf("shm_sim: re-attached\n");
+	fflush(stdout);
+	return true;
+}
+
+void usage()
+{
+	printf("Usage: shm_sim [-n shm_name] [-r rate_hz] [-d duration_s] [-s seed] [-M mass_scale]\n");
+	printf("               [-T thrust_scale] [-w north,east,gust] [-N noise_scale]\n");
+	printf("               [-f motor,time_s,efficiency] [-o result.json] [-l] [-p]\n");
+	printf("  -n  shared memory name passed to 'simulator start -s' (default px4_sim_0)\n");
+	printf("  -r  physics and IMU rate (default 250)\n");
+	printf("  -d  stop after this many simulated seconds (default: run forever)\n");
+	printf("  -s  seed of the noise and gust generator (default 1)\n");
+	printf("  -M  scale mass and inertia (default 1)\n");
+	printf("  -T  scale the maximum motor thrust (default 1)\n");
+	printf("  -w  mean wind north and east and gust standard deviation in m/s (default 0,0,0)\n");
+	printf("  -N  scale the sensor noise, 0 disables it (default 0)\n");
+	printf("  -f  scale the thrust of a motor (0-3) by efficiency from the given simulated time on\n");
+	printf("  -o  write ground truth flight metrics to this json file on exit\n");
+	printf("  -l  exit %.0f simulated seconds after the vehicle has flown and landed\n", EXIT_AFTER_LANDING);
+	printf("  -p  print progress every simulated second\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const char *name = "px4_sim_0";
+	const char *result_path = nullptr;
+	int rate = 250;
+	double duration = 0.0;
+	bool exit_after_landing = false;
+	bool progress = false;
+	Scenario scenario;
+
+	int ch;
+
+	while ((ch = getopt(argc, argv, "n:r:d:s:M:T:w:N:f:o:lph")) != -1) {
+		switch (ch) {
+		case 'n':
+			name = optarg;
+			break;
+
+		case 'r':
+			rate = atoi(optarg);
+			break;
+
+		case 'd':
+			duration = atof(optarg);
+			break;
+
+		case 's':
+			scenario.seed = strtoull(optarg, nullptr, 10);
+			break;
+
+		case 'M':
+			scenario.mass_scale = atof(optarg);
+			break;
+
+		case 'T':
+			scenario.thrust_scale = atof(optarg);
+			break;
+
+		case 'w':
+			if (sscanf(optarg, "%f,%f,%f", &scenario.wind[0], &scenario.wind[1], &scenario.gust) < 2) {
+				usage();
+				return 1;
+			}
+
+			break;
+
+		case 'N':
+			scenario.noise_scale = atof(optarg);
+			break;
+
+		case 'f':
+			if (sscanf(optarg, "%d,%lf,%f", &scenario.failed_motor, &scenario.failure_time,
+				   &scenario.failure_efficiency) != 3 || scenario.failed_motor < 0 || scenario.failed_motor >= sih::NB_MOTORS) {
+				usage();
+				return 1;
+			}
+
+			break;
+
+		case 'o':
+			result_path = optarg;
+			break;
+
+		case 'l':
+			exit_after_landing = true;
+			break;
+
+		case 'p':
+			progress = true;
+			break;
+
+		default:
+			usage();
+			return 1;
+		}
+	}
+
+	if (rate <= 0 || scenario.mass_scale <= 0.f || scenario.thrust_scale <= 0.f) {
+		usage();
+		return 1;
+	}
+
+	shm::Link link;
+
+	printf("shm_sim: waiting for PX4 on shared memory %s\n", name);
+
+	if (!link.attach(name, 60 * 1000)) {
+		printf("shm_sim: shared memory %s not found\n", name);
+		return 1;
+	}
+
+	printf("shm_sim: attached, stepping at %d Hz\n", rate);
+	fflush(stdout);
+
+	const uint64_t dt_us = 1000000 / rate;
+	const float dt = dt_us * 1e-6f;
+	const uint64_t gps_interval_us = 100000; // 10 Hz
+
+	const sih::Parameters param = vehicle_parameters(scenario);
+	sih::Xoshiro128 rng(scenario.seed);
+	sih::State state;
+	Vector3f gust;
+	Metrics metrics;
+	float controls[sih::NB_MOTORS] {};
+	bool lockstep = false;
+
+	uint64_t time_usec = 0;
+	uint64_t last_gps_usec = 0;
+	uint64_t last_progress_usec = 0;
+	uint64_t steps = 0;
+	uint64_t report_steps = 0;
+	double report_time = wall_time();
+	const double start_time = report_time;
+
+	shm::SensorFrame frame;
+	shm::ActuatorFrame actuators;
+
+	while (duration <= 0.0 || time_usec * 1e-6 < duration) {
+		time_usec += dt_us;
+		const double time = time_usec * 1e-6;
+
+		float u[sih::NB_MOTORS];
+
+		for (int i = 0; i < sih::NB_MOTORS; i++) {
+			u[i] = fminf(fmaxf(controls[i], 0.f), 1.f);
+		}
+
+		if (scenario.failed_motor >= 0 && time >= scenario.failure_time) {
+			u[scenario.failed_motor] *= scenario.failure_efficiency;
+		}
+
+		const bool was_grounded = state.grounded;
+		const Vector3f v_before = state.v_I;
+		const Vector3f wind = update_wind(scenario, gust, rng, dt);
+		const Vector3f accel_I = sih::step(param, state, u, dt, wind);
+		update_metrics(state, was_grounded, v_before, time, metrics);
+
+		const bool gps = (time_usec - last_gps_usec >= gps_interval_us);
+
+		if (gps) {
+			last_gps_usec = time_usec;
+		}
+
+		fill_frame(state, accel_I, time_usec, gps, scenario.noise_scale, rng, frame);
+
+		int retries = 0;
+		bool link_ok = true;
+
+		while (link_ok && !link.send_sensor(frame)) {
+			usleep(100);
+
+			// sensor ring full for 100 ms: PX4 is not reading it
+			if (++retries % 1000 == 0) {
+				link_ok = check_link(link, name, lockstep);
+			}
+		}
+
+		if (!link_ok) {
+			break;
+		}
+
+		// Until PX4 produces outputs pace the simulation in real time, then run in strict lockstep.
+		if (link.receive_actuator(actuators, lockstep ? 1000 : (int)(dt_us / 1000) + 1)) {
+			// only the most recent outputs matter
+			while (link.receive_actuator(actuators, 0)) {}
+
+			for (int i = 0; i < sih::NB_MOTORS; i++) {
+				controls[i] = actuators.controls.controls[i];
+			}
+
+			lockstep = true;
+
+		} else if (lockstep) {
+			printf("shm_sim: no actuator outputs at t=%.3f s\n", time);
+
+			if (!check_link(link, name, lockstep)) {
+				break;
+			}
+		}
+
+		steps++;
+
+		if (progress && time_usec - last_progress_usec >= 1000000) {
+			last_progress_usec = time_usec;
+			printf("shm_sim: t=%.1f alt=%.2f flown=%d landed=%d\n", time, (double) - state.p_I(2), metrics.flown,
+			       metrics.landed);
+			fflush(stdout);
+		}
+
+		if (exit_after_landing && metrics.landed && time - metrics.landing_time >= EXIT_AFTER_LANDING) {
+			break;
+		}
+
+		const double now = wall_time();
+
+		if (now - report_time >= 5.0) {
+			printf("shm_sim: t=%.1f s, %.0f steps/s, %.1fx real time, alt %.2f m\n", time,
+			       (steps - report_steps) / (now - report_time), (steps - report_steps) * (double)dt / (now - report_time),
+			       (double) - state.p_I(2));
+			fflush(stdout);
+			report_steps = steps;
+			report_time = now;
+		}
+	}
+
+	const double elapsed = wall_time() - start_time;
+	printf("shm_sim: %llu steps in %.2f s, %.0f steps/s\n", (unsigned long long)steps, elapsed, steps / elapsed);
+
+	if (result_path != nullptr && !write_metrics(result_path, metrics, time_usec * 1e-6, steps / elapsed)) {
+		printf("shm_sim: failed to write %s\n", result_path);
+		return 1;
+	}
+
+	return 0;
+}
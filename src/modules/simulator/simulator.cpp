@@ -105,9 +105,20 @@ int Simulator::start(int argc, char *argv[])
 			_instance->set_port(atoi(argv[3]));
 		}
 
+		if (argc == 4 && strcmp(argv[2], "-s") == 0) {
+			_instance->set_shm_name(argv[3]);
+		}
+
 #ifndef __PX4_QURT
+
 		// Update sensor data
-		_instance->poll_for_MAVLink_messages();
+		if (_instance->_use_shm) {
+			_instance->run_shm_link();
+
+		} else {
+			_instance->poll_for_MAVLink_messages();
+		}
+
 #endif
 
 		return 0;
@@ -128,12 +139,19 @@ void Simulator::set_port(unsigned port)
 	_port = port;
 }
 
+void Simulator::set_shm_name(const char *name)
+{
+	_use_shm = true;
+	strncpy(_shm_name, name, sizeof(_shm_name) - 1);
+}
+
 static void usage()
 {
-	PX4_WARN("Usage: simulator {start -[spt] [-u udp_port / -c tcp_port] |stop}");
+	PX4_WARN("Usage: simulator {start -[spt] [-u udp_port / -c tcp_port / -s shm_name] |stop}");
 	PX4_WARN("Start simulator:     simulator start");
 	PX4_WARN("Connect using UDP: simulator start -u udp_port");
 	PX4_WARN("Connect using TCP: simulator start -c tcp_port");
+	PX4_WARN("Connect using shared memory (Linux): simulator start -s shm_name");
 }
 
 __BEGIN_DECLS
@@ -53,6 +53,7 @@
 #include <perf/perf_counter.h>
 #include <px4_module_params.h>
 #include <px4_posix.h>
+#include <px4_shutdown.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/actuator_outputs.h>
 #include <uORB/topics/battery_status.h>
@@ -73,6 +74,10 @@
 #include <v2.0/common/mavlink.h>
 #include <v2.0/mavlink_types.h>
 
+#if defined(__PX4_LINUX)
+#include "simulator_shm.h"
+#endif
+
 namespace simulator
 {
 
@@ -171,6 +176,7 @@ public:
 
 	void set_ip(InternetProtocol ip);
 	void set_port(unsigned port);
+	void set_shm_name(const char *name);
 
 private:
 	Simulator() :
@@ -232,6 +238,9 @@ private:
 
 	InternetProtocol _ip{InternetProtocol::UDP};
 
+	bool _use_shm{false};			///< use the shared memory link instead of MAVLink
+	char _shm_name[32] {};
+
 	double _realtime_factor{1.0};		///< How fast the simulation runs in comparison to real system time
 
 	hrt_abstime _last_sim_timestamp{0};
@@ -259,6 +268,11 @@ private:
 	void parameters_update(bool force);
 	void poll_topics();
 	void poll_for_MAVLink_messages();
+	void process_hil_sensor(const mavlink_hil_sensor_t &imu);
+	void process_hil_state_quaternion(const mavlink_hil_state_quaternion_t &hil_state);
+	void run_shm_link();
+	static bool shm_shutdown_hook();
+	void start_sender();
 	void request_hil_state_quaternion();
 	void send();
 	void send_controls();
@@ -280,6 +294,10 @@ private:
 	int _actuator_outputs_sub{-1};
 	int _vehicle_status_sub{-1};
 
+#if defined(__PX4_LINUX)
+	simulator::shm::Link _shm_link;
+#endif
+
 	// hil map_ref data
 	struct map_projection_reference_s _hil_local_proj_ref {};
 
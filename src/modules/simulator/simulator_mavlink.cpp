@@ -33,6 +33,7 @@
  *
  ****************************************************************************/
 
+#include <inttypes.h>
 #include <termios.h>
 #include <px4_log.h>
 #include <px4_time.h>
@@ -183,10 +184,22 @@ void Simulator::send_controls()
 		if (actuators.timestamp > 0) {
 			const mavlink_hil_actuator_controls_t hil_act_control = actuator_controls_from_outputs(actuators);
 
+#if defined(__PX4_LINUX)
+
+			if (_use_shm) {
+				if (!_shm_link.send_actuator(shm::ActuatorFrame{hil_act_control})) {
+					PX4_DEBUG("actuator ring full, dropping controls t=%" PRIu64, hil_act_control.time_usec);
+				}
+
+				return;
+			}
+
+#endif
+
 			mavlink_message_t message{};
 			mavlink_msg_hil_actuator_controls_encode(_param_mav_sys_id.get(), _param_mav_comp_id.get(), &message, &hil_act_control);
 
-			PX4_DEBUG("sending controls t=%ld (%ld)", actuators.timestamp, hil_act_control.time_usec);
+			PX4_DEBUG("sending controls t=%" PRIu64 " (%" PRIu64 ")", actuators.timestamp, hil_act_control.time_usec);
 
 			send_mavlink_message(message);
 		}
@@ -350,6 +363,11 @@ void Simulator::handle_message_hil_sensor(const mavlink_message_t *msg)
 	mavlink_hil_sensor_t imu;
 	mavlink_msg_hil_sensor_decode(msg, &imu);
 
+	process_hil_sensor(imu);
+}
+
+void Simulator::process_hil_sensor(const mavlink_hil_sensor_t &imu)
+{
 	struct timespec ts;
 	abstime_to_ts(&ts, imu.time_usec);
 	px4_clock_settime(CLOCK_MONOTONIC, &ts);
@@ -406,6 +424,11 @@ void Simulator::handle_message_hil_state_quaternion(const mavlink_message_t *msg
 	mavlink_hil_state_quaternion_t hil_state;
 	mavlink_msg_hil_state_quaternion_decode(msg, &hil_state);
 
+	process_hil_state_quaternion(hil_state);
+}
+
+void Simulator::process_hil_state_quaternion(const mavlink_hil_state_quaternion_t &hil_state)
+{
 	uint64_t timestamp = hrt_absolute_time();
 
 	/* angular velocity */
@@ -601,7 +624,10 @@ void Simulator::send()
 	// simulator to start sending sensor data which will set the time and
 	// get everything rolling.
 	// Without this, we get stuck at px4_poll which waits for a time update.
-	send_heartbeat();
+	// The shared memory physics starts stepping as soon as it attached.
+	if (!_use_shm) {
+		send_heartbeat();
+	}
 
 	px4_pollfd_struct_t fds[1] = {};
 	fds[0].fd = _actuator_outputs_sub;
@@ -727,21 +753,6 @@ void Simulator::poll_for_MAVLink_messages()
 
 	}
 
-	// Create a thread for sending data to the simulator.
-	pthread_t sender_thread;
-
-	pthread_attr_t sender_thread_attr;
-	pthread_attr_init(&sender_thread_attr);
-	pthread_attr_setstacksize(&sender_thread_attr, PX4_STACK_ADJUSTED(4000));
-
-	struct sched_param param;
-	(void)pthread_attr_getschedparam(&sender_thread_attr, &param);
-
-	// sender thread should run immediately after new outputs are available
-	//  to send the lockstep update to the simulation
-	param.sched_priority = SCHED_PRIORITY_ACTUATOR_OUTPUTS + 1;
-	(void)pthread_attr_setschedparam(&sender_thread_attr, &param);
-
 	struct pollfd fds[2] = {};
 	unsigned fd_count = 1;
 	fds[0].fd = _fd;
@@ -766,14 +777,7 @@ void Simulator::poll_for_MAVLink_messages()
 
 #endif
 
-	// Subscribe to topics.
-	// Only subscribe to the first actuator_outputs to fill a single HIL_ACTUATOR_CONTROLS.
-	_actuator_outputs_sub = orb_subscribe_multi(ORB_ID(actuator_outputs), 0);
-	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
-
-	// got data from simulator, now activate the sending thread
-	pthread_create(&sender_thread, &sender_thread_attr, Simulator::sending_trampoline, nullptr);
-	pthread_attr_destroy(&sender_thread_attr);
+	start_sender();
 
 	mavlink_status_t mavlink_status = {};
 
@@ -836,6 +840,91 @@ void Simulator::poll_for_MAVLink_messages()
 	orb_unsubscribe(_vehicle_status_sub);
 }
 
+void Simulator::start_sender()
+{
+	// Create a thread for sending data to the simulator.
+	pthread_t sender_thread;
+
+	pthread_attr_t sender_thread_attr;
+	pthread_attr_init(&sender_thread_attr);
+	pthread_attr_setstacksize(&sender_thread_attr, PX4_STACK_ADJUSTED(4000));
+
+	struct sched_param param;
+	(void)pthread_attr_getschedparam(&sender_thread_attr, &param);
+
+	// sender thread should run immediately after new outputs are available
+	//  to send the lockstep update to the simulation
+	param.sched_priority = SCHED_PRIORITY_ACTUATOR_OUTPUTS + 1;
+	(void)pthread_attr_setschedparam(&sender_thread_attr, &param);
+
+	// Subscribe to topics.
+	// Only subscribe to the first actuator_outputs to fill a single HIL_ACTUATOR_CONTROLS.
+	_actuator_outputs_sub = orb_subscribe_multi(ORB_ID(actuator_outputs), 0);
+	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
+
+	// got data from simulator, now activate the sending thread
+	pthread_create(&sender_thread, &sender_thread_attr, Simulator::sending_trampoline, nullptr);
+	pthread_attr_destroy(&sender_thread_attr);
+}
+
+bool Simulator::shm_shutdown_hook()
+{
+#if defined(__PX4_LINUX)
+	// remove the segment so that a physics process started later does not attach to it
+	_instance->_shm_link.unlink();
+#endif
+	return true;
+}
+
+void Simulator::run_shm_link()
+{
+#if defined(__PX4_LINUX)
+	pthread_setname_np(pthread_self(), "sim_rcv");
+
+	if (!_shm_link.create(_shm_name)) {
+		PX4_ERR("Creating shared memory %s failed: %s", _shm_name, strerror(errno));
+		return;
+	}
+
+	px4_register_shutdown_hook(&Simulator::shm_shutdown_hook);
+
+	PX4_INFO("Waiting for simulator to attach to shared memory %s", _shm_name);
+
+	while (!_shm_link.wait_for_physics(1000)) {
+		// keep waiting
+	}
+
+	PX4_INFO("Simulator attached to shared memory %s.", _shm_name);
+
+	start_sender();
+
+	shm::SensorFrame frame;
+
+	while (true) {
+		if (!_shm_link.receive_sensor(frame, 1000)) {
+			// Timed out.
+			continue;
+		}
+
+		// the sensor frame sets the lockstep time, handle it first
+		process_hil_sensor(frame.sensor);
+
+		if (frame.updated & shm::UPDATED_GPS) {
+			update_gps(&frame.gps);
+		}
+
+		if (frame.updated & shm::UPDATED_STATE) {
+			process_hil_state_quaternion(frame.state);
+		}
+	}
+
+	orb_unsubscribe(_actuator_outputs_sub);
+	orb_unsubscribe(_vehicle_status_sub);
+#else
+	PX4_ERR("Shared memory link is only supported on Linux");
+#endif
+}
+
 
 #ifdef ENABLE_UART_RC_INPUT
 int openUart(const char *uart_name, int baud)
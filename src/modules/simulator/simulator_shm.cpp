@@ -0,0 +1,269 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file simulator_shm.cpp
+ *
+ * Shared memory lockstep transport, see simulator_shm.h.
+ */
+
+#include "simulator_shm.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <new>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace simulator
+{
+namespace shm
+{
+
+Link::~Link()
+{
+	close();
+}
+
+void Link::set_name(const char *name)
+{
+	if (name[0] == '/') {
+		snprintf(_name, sizeof(_name), "%s", name);
+
+	} else {
+		snprintf(_name, sizeof(_name), "/%s", name);
+	}
+}
+
+bool Link::map(int fd, bool initialize)
+{
+	void *addr = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (addr == MAP_FAILED) {
+		return false;
+	}
+
+	if (initialize) {
+		// the segment is zero filled, construct it and publish the magic last
+		_layout = new (addr) Layout{};
+		_layout->version = VERSION;
+		_layout->creator_pid = getpid();
+		std::atomic_thread_fence(std::memory_order_release);
+		_layout->magic = MAGIC;
+
+	} else {
+		_layout = static_cast<Layout *>(addr);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (_layout->magic != MAGIC || _layout->version != VERSION) {
+			munmap(addr, sizeof(Layout));
+			_layout = nullptr;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Link::create(const char *name)
+{
+	close();
+	set_name(name);
+
+	// remove a stale segment of a previous run
+	shm_unlink(_name);
+
+	int fd = shm_open(_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	if (ftruncate(fd, sizeof(Layout)) != 0) {
+		::close(fd);
+		shm_unlink(_name);
+		return false;
+	}
+
+	if (!map(fd, true)) {
+		shm_unlink(_name);
+		return false;
+	}
+
+	_owner = true;
+	return true;
+}
+
+bool Link::attach(const char *name, int timeout_ms)
+{
+	close();
+	set_name(name);
+
+	for (int waited_ms = 0; waited_ms <= timeout_ms; waited_ms += 10) {
+		int fd = shm_open(_name, O_RDWR, 0600);
+
+		if (fd >= 0) {
+			struct stat st {};
+
+			if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(Layout)) {
+				// map() takes care of the descriptor
+				if (map(fd, false)) {
+					if (creator_alive()) {
+						_dev = st.st_dev;
+						_ino = st.st_ino;
+						_layout->physics_attached.store(1);
+						return true;
+					}
+
+					// left behind by a PX4 that exited, wait for the new one to replace it
+					munmap(_layout, sizeof(Layout));
+					_layout = nullptr;
+				}
+
+			} else {
+				::close(fd);
+			}
+		}
+
+		usleep(10000);
+	}
+
+	return false;
+}
+
+void Link::close()
+{
+	if (_layout) {
+		if (_owner) {
+			_layout->creator_closed.store(1);
+
+		} else {
+			_layout->physics_attached.store(0);
+		}
+
+		munmap(_layout, sizeof(Layout));
+		_layout = nullptr;
+	}
+
+	if (_owner) {
+		shm_unlink(_name);
+		_owner = false;
+	}
+}
+
+void Link::unlink()
+{
+	if (_layout && _owner) {
+		_layout->creator_closed.store(1);
+		shm_unlink(_name);
+		_owner = false;
+	}
+}
+
+bool Link::creator_alive() const
+{
+	if (_layout->creator_closed.load()) {
+		return false;
+	}
+
+	// signal 0 only checks whether the process exists
+	return (kill(_layout->creator_pid, 0) == 0) || (errno == EPERM);
+}
+
+bool Link::valid() const
+{
+	if (!_layout || !creator_alive()) {
+		return false;
+	}
+
+	int fd = shm_open(_name, O_RDONLY, 0);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st {};
+
+	const bool same_segment = (fstat(fd, &st) == 0) && (st.st_dev == _dev) && (st.st_ino == _ino);
+
+	::close(fd);
+
+	return same_segment;
+}
+
+bool Link::physics_attached() const
+{
+	return _layout && _layout->physics_attached.load();
+}
+
+bool Link::wait_for_physics(int timeout_ms)
+{
+	for (int waited_ms = 0; waited_ms <= timeout_ms; waited_ms += 10) {
+		if (physics_attached()) {
+			return true;
+		}
+
+		usleep(10000);
+	}
+
+	return false;
+}
+
+bool Link::futex_wait(std::atomic<uint32_t> &word, uint32_t expected, int timeout_ms)
+{
+	struct timespec timeout;
+	timeout.tv_sec = timeout_ms / 1000;
+	timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+
+	// not FUTEX_PRIVATE_FLAG: the word is shared between processes
+	long ret = syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+
+	return !(ret != 0 && errno == ETIMEDOUT);
+}
+
+void Link::futex_wake(std::atomic<uint32_t> &word)
+{
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+} // namespace shm
+} // namespace simulator
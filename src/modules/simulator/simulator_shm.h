@@ -0,0 +1,247 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file simulator_shm.h
+ *
+ * Shared memory lockstep transport between PX4 and a physics process on the
+ * same host. The physics process pushes sensor frames into one ring and waits
+ * for actuator frames on the other. Both sides block on futexes, so a lockstep
+ * step costs two wake-ups instead of MAVLink encoding and socket round trips.
+ *
+ * The frames carry the MAVLink HIL payload structs unencoded so the simulator
+ * module can reuse its HIL handlers.
+ *
+ * Only available on Linux.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <v2.0/common/mavlink.h>
+
+namespace simulator
+{
+namespace shm
+{
+
+static constexpr uint32_t MAGIC = 0x50345348; // "P4SH"
+static constexpr uint32_t VERSION = 2;
+
+static constexpr uint32_t SENSOR_RING_SIZE = 8;
+static constexpr uint32_t ACTUATOR_RING_SIZE = 8;
+
+/** SensorFrame::updated flags */
+static constexpr uint8_t UPDATED_GPS = 1 << 0;
+static constexpr uint8_t UPDATED_STATE = 1 << 1;
+
+struct SensorFrame {
+	mavlink_hil_sensor_t sensor;			///< always valid, sensor.time_usec drives the lockstep clock
+	mavlink_hil_gps_t gps;				///< valid if UPDATED_GPS is set
+	mavlink_hil_state_quaternion_t state;		///< ground truth, valid if UPDATED_STATE is set
+	uint8_t updated;
+};
+
+struct ActuatorFrame {
+	mavlink_hil_actuator_controls_t controls;
+};
+
+/**
+ * Single producer, single consumer ring living in shared memory.
+ * head is also the futex word the consumer sleeps on.
+ */
+template<typename T, uint32_t N>
+struct Ring {
+	static_assert((N & (N - 1)) == 0, "ring size must be a power of two");
+
+	std::atomic<uint32_t> head;	///< next slot to write, only written by the producer
+	std::atomic<uint32_t> tail;	///< next slot to read, only written by the consumer
+	std::atomic<uint32_t> waiting;	///< consumer is (about to be) blocked on head
+	T slots[N];
+};
+
+struct Layout {
+	uint32_t magic;
+	uint32_t version;
+	int32_t creator_pid;			///< PX4 process that created the segment
+	std::atomic<uint32_t> creator_closed;	///< PX4 shut down, the segment is not served anymore
+	std::atomic<uint32_t> physics_attached;
+	Ring<SensorFrame, SENSOR_RING_SIZE> sensor;
+	Ring<ActuatorFrame, ACTUATOR_RING_SIZE> actuator;
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bit");
+
+class Link
+{
+public:
+	Link() = default;
+	~Link();
+
+	Link(const Link &) = delete;
+	Link &operator=(const Link &) = delete;
+
+	/**
+	 * Create the shared memory segment (PX4 side).
+	 * @param name segment name, a leading '/' is added if missing
+	 */
+	bool create(const char *name);
+
+	/**
+	 * Attach to an existing segment (physics side) and mark the physics as attached.
+	 * Segments left behind by a PX4 process that exited are skipped.
+	 * @param timeout_ms how long to wait for a live segment to appear
+	 */
+	bool attach(const char *name, int timeout_ms);
+
+	void close();
+
+	/**
+	 * PX4 side: mark the segment as closed and remove its name, e.g. on shutdown.
+	 * The mapping stays valid, so the receive thread can keep running until exit.
+	 */
+	void unlink();
+
+	/**
+	 * Physics side: check that the attached segment is still served. It is stale if PX4 closed
+	 * it or exited, or if the name refers to a different segment (PX4 restarted and created a
+	 * new one). This costs a few system calls, don't call it every step.
+	 */
+	bool valid() const;
+
+	/** @return true once the physics process has attached */
+	bool physics_attached() const;
+
+	/**
+	 * Wait until the physics process attached.
+	 * @return false on timeout
+	 */
+	bool wait_for_physics(int timeout_ms);
+
+	/** Physics side: queue a sensor frame. @return false if PX4 does not keep up */
+	bool send_sensor(const SensorFrame &frame) { return push(_layout->sensor, frame); }
+
+	/** PX4 side: wait for the next sensor frame. @return false on timeout */
+	bool receive_sensor(SensorFrame &frame, int timeout_ms) { return pop(_layout->sensor, frame, timeout_ms); }
+
+	/** PX4 side: queue an actuator frame. @return false if the physics does not keep up */
+	bool send_actuator(const ActuatorFrame &frame) { return push(_layout->actuator, frame); }
+
+	/** Physics side: wait for the next actuator frame. @return false on timeout */
+	bool receive_actuator(ActuatorFrame &frame, int timeout_ms) { return pop(_layout->actuator, frame, timeout_ms); }
+
+private:
+	template<typename T, uint32_t N>
+	bool push(Ring<T, N> &ring, const T &item);
+
+	template<typename T, uint32_t N>
+	bool pop(Ring<T, N> &ring, T &item, int timeout_ms);
+
+	/** @return false on timeout */
+	static bool futex_wait(std::atomic<uint32_t> &word, uint32_t expected, int timeout_ms);
+	static void futex_wake(std::atomic<uint32_t> &word);
+
+	bool map(int fd, bool initialize);
+	void set_name(const char *name);
+
+	/** @return true if the process which created the segment still runs and did not close it */
+	bool creator_alive() const;
+
+	Layout *_layout{nullptr};
+	bool _owner{false};
+	char _name[64] {};
+
+	// identity of the attached segment, to detect a new one under the same name
+	dev_t _dev{0};
+	ino_t _ino{0};
+};
+
+template<typename T, uint32_t N>
+bool Link::push(Ring<T, N> &ring, const T &item)
+{
+	const uint32_t head = ring.head.load(std::memory_order_relaxed);
+
+	if (head - ring.tail.load(std::memory_order_acquire) >= N) {
+		return false;
+	}
+
+	ring.slots[head & (N - 1)] = item;
+	ring.head.store(head + 1, std::memory_order_seq_cst);
+
+	// skip the syscall unless the consumer sleeps
+	if (ring.waiting.load(std::memory_order_seq_cst)) {
+		futex_wake(ring.head);
+	}
+
+	return true;
+}
+
+template<typename T, uint32_t N>
+bool Link::pop(Ring<T, N> &ring, T &item, int timeout_ms)
+{
+	const uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+	uint32_t head = ring.head.load(std::memory_order_acquire);
+
+	if (head == tail) {
+		if (timeout_ms <= 0) {
+			return false;
+		}
+
+		ring.waiting.store(1, std::memory_order_seq_cst);
+
+		bool timed_out = false;
+
+		while (!timed_out && (ring.head.load(std::memory_order_seq_cst) == tail)) {
+			timed_out = !futex_wait(ring.head, tail, timeout_ms);
+		}
+
+		ring.waiting.store(0, std::memory_order_relaxed);
+		head = ring.head.load(std::memory_order_acquire);
+
+		if (head == tail) {
+			return false;
+		}
+	}
+
+	item = ring.slots[tail & (N - 1)];
+	ring.tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+} // namespace shm
+} // namespace simulator
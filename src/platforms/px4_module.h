@@ -51,13 +51,17 @@
 
 #include <cstring>
 
+#if defined(__PX4_NUTTX)
 /**
  * @brief This mutex protects against race conditions during startup & shutdown of modules.
  *        There could be one mutex per module instantiation, but to reduce the memory footprint
  *        there is only a single global mutex. This sounds bad, but we actually don't expect
  *        contention here, as module startup is sequential.
+ *        On POSIX modules can be started concurrently (see px4_start), so there each module
+ *        has its own mutex.
  */
 extern pthread_mutex_t px4_modules_mutex;
+#endif
 
 /**
  * @class ModuleBase
@@ -401,6 +405,7 @@ protected:
 	static constexpr const int task_id_is_work_queue = -2;
 
 private:
+#if defined(__PX4_NUTTX)
 	/**
 	 * @brief lock_module Mutex to lock the module thread.
 	 */
@@ -416,6 +421,26 @@ private:
 	{
 		pthread_mutex_unlock(&px4_modules_mutex);
 	}
+#else
+	/**
+	 * @brief lock_module Mutex to lock the module thread.
+	 */
+	static void lock_module()
+	{
+		pthread_mutex_lock(&_module_mutex);
+	}
+
+	/**
+	 * @brief unlock_module Mutex to unlock the module thread.
+	 */
+	static void unlock_module()
+	{
+		pthread_mutex_unlock(&_module_mutex);
+	}
+
+	/** @var _module_mutex Protects _object and _task_id during startup & shutdown of this module. */
+	static pthread_mutex_t _module_mutex;
+#endif
 
 	/** @var _task_should_exit Boolean flag to indicate if the task should exit. */
 	px4::atomic_bool _task_should_exit{false};
@@ -427,6 +452,11 @@ px4::atomic<T *> ModuleBase<T>::_object{nullptr};
 template<class T>
 int ModuleBase<T>::_task_id = -1;
 
+#if !defined(__PX4_NUTTX)
+template<class T>
+pthread_mutex_t ModuleBase<T>::_module_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 
 #endif /* __cplusplus */
 
@@ -0,0 +1,300 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_SpscRingBuffer.cpp
+ * Tests the lock-free single-producer/single-consumer ring buffer.
+ */
+
+#include <unit_test.h>
+#include <drivers/device/SpscRingBuffer.hpp>
+#include <drivers/drv_hrt.h>
+#include <px4_tasks.h>
+#include <px4_time.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+using namespace time_literals;
+
+struct TestItem {
+	uint32_t seq;
+	uint32_t check;		///< ~seq, used to detect torn reads
+};
+
+class SpscRingBufferTest : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+	bool test_put_get();
+	bool test_batch();
+	bool test_force();
+	bool test_contention();
+	bool test_contention_force();
+
+private:
+	static constexpr size_t CAPACITY = 64;
+	static constexpr uint32_t NUM_ITEMS = 1000000;
+	static constexpr size_t BATCH_SIZE = 7; // deliberately not aligned with the capacity
+	static constexpr hrt_abstime TIMEOUT = 30_s; // a contention run normally takes well below a second
+
+	using Buffer = ringbuffer::SpscRingBuffer<TestItem, CAPACITY>;
+
+	struct ProducerArgs {
+		Buffer *buffer;
+		bool use_force;
+		px4::atomic_bool stop{false};	///< set by the consumer when it gives up
+	};
+
+	static void *producer_trampoline(void *arg);
+	bool run_contention(bool use_force);
+};
+
+bool SpscRingBufferTest::run_tests()
+{
+	ut_run_test(test_put_get);
+	ut_run_test(test_batch);
+	ut_run_test(test_force);
+#if defined(__PX4_POSIX)
+	ut_run_test(test_contention);
+	ut_run_test(test_contention_force);
+#endif
+
+	return (_tests_failed == 0);
+}
+
+bool SpscRingBufferTest::test_put_get()
+{
+	ringbuffer::SpscRingBuffer<uint32_t, 4> buffer;
+
+	ut_assert_true(buffer.empty());
+	ut_compare("size", buffer.size(), 4);
+	ut_compare("space initially", buffer.space(), 4);
+
+	uint32_t val = 0;
+	ut_assert_false(buffer.get(val));
+
+	for (uint32_t i = 0; i < 4; i++) {
+		ut_assert_true(buffer.put(i));
+		ut_compare("count increasing", buffer.count(), i + 1);
+	}
+
+	ut_assert_true(buffer.full());
+	ut_assert_false(buffer.put(4u));
+
+	// wrap around several times
+	for (uint32_t i = 0; i < 20; i++) {
+		ut_assert_true(buffer.get(val));
+		ut_compare("FIFO order", val, i);
+		ut_assert_true(buffer.put(i + 4));
+	}
+
+	buffer.flush();
+	ut_assert_true(buffer.empty());
+
+	return true;
+}
+
+bool SpscRingBufferTest::test_batch()
+{
+	ringbuffer::SpscRingBuffer<uint32_t, 8> buffer;
+
+	uint32_t in[12];
+	uint32_t out[12];
+
+	for (uint32_t i = 0; i < 12; i++) {
+		in[i] = i;
+	}
+
+	// only as many as there is space for
+	ut_compare("batch put limited", buffer.put(in, 12), 8);
+	ut_compare("batch get", buffer.get(out, 5), 5);
+
+	for (uint32_t i = 0; i < 5; i++) {
+		ut_compare("batch order", out[i], i);
+	}
+
+	// this batch wraps around the end of the storage
+	ut_compare("batch put wrap", buffer.put(&in[8], 4), 4);
+	ut_compare("batch get all", buffer.get(out, 12), 7);
+
+	for (uint32_t i = 0; i < 7; i++) {
+		ut_compare("batch order after wrap", out[i], i + 5);
+	}
+
+	ut_assert_true(buffer.empty());
+
+	return true;
+}
+
+bool SpscRingBufferTest::test_force()
+{
+	ringbuffer::SpscRingBuffer<uint32_t, 4> buffer;
+
+	for (uint32_t i = 0; i < 4; i++) {
+		ut_assert_false(buffer.force(i));
+	}
+
+	// the oldest items get discarded
+	ut_assert_true(buffer.force(4u));
+	ut_assert_true(buffer.force(5u));
+	ut_compare("count", buffer.count(), 4);
+
+	uint32_t val = 0;
+
+	for (uint32_t i = 2; i < 6; i++) {
+		ut_assert_true(buffer.get(val));
+		ut_compare("newest items kept", val, i);
+	}
+
+	return true;
+}
+
+void *SpscRingBufferTest::producer_trampoline(void *arg)
+{
+	ProducerArgs *args = static_cast<ProducerArgs *>(arg);
+	TestItem batch[BATCH_SIZE];
+	uint32_t seq = 0;
+
+	while (seq < NUM_ITEMS && !args->stop.load()) {
+		if (args->use_force) {
+			args->buffer->force(TestItem{seq, ~seq});
+			seq++;
+
+		} else if (seq % 2 == 0) {
+			// alternate between batches and single items
+			size_t n = 0;
+
+			for (; n < BATCH_SIZE && seq + n < NUM_ITEMS; n++) {
+				batch[n] = TestItem{seq + (uint32_t)n, ~(seq + (uint32_t)n)};
+			}
+
+			const size_t put = args->buffer->put(batch, n);
+			seq += put;
+
+			if (put == 0) {
+				// full, let the consumer run (there might be only one core)
+				sched_yield();
+			}
+
+		} else if (args->buffer->put(TestItem{seq, ~seq})) {
+			seq++;
+
+		} else {
+			sched_yield();
+		}
+	}
+
+	return nullptr;
+}
+
+bool SpscRingBufferTest::run_contention(bool use_force)
+{
+	Buffer *buffer = new Buffer();
+	ut_assert_true(buffer != nullptr);
+
+	ProducerArgs args;
+	args.buffer = buffer;
+	args.use_force = use_force;
+
+	pthread_t producer;
+	const hrt_abstime start = hrt_absolute_time();
+	ut_compare("producer thread", pthread_create(&producer, nullptr, &producer_trampoline, &args), 0);
+
+	TestItem items[BATCH_SIZE];
+	uint32_t received = 0;
+	uint32_t expected_seq = 0;
+	bool ok = true;
+	bool done = false;
+
+	while (ok && !done) {
+		const size_t n = buffer->get(items, BATCH_SIZE);
+
+		if (n == 0) {
+			sched_yield();
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			if (items[i].check != ~items[i].seq) {
+				PX4_ERR("torn item %u", items[i].seq);
+				ok = false;
+
+			} else if (use_force ? (items[i].seq < expected_seq) : (items[i].seq != expected_seq)) {
+				PX4_ERR("out of order: got %u, expected %u", items[i].seq, expected_seq);
+				ok = false;
+			}
+
+			expected_seq = items[i].seq + 1;
+			received++;
+		}
+
+		done = (expected_seq == NUM_ITEMS);
+
+		if (!done && hrt_elapsed_time(&start) > TIMEOUT) {
+			PX4_ERR("timeout: %u items received", received);
+			ok = false;
+		}
+	}
+
+	// a producer still waiting for space would never finish once the consumer stopped
+	args.stop.store(true);
+	pthread_join(producer, nullptr);
+
+	const hrt_abstime elapsed = hrt_elapsed_time(&start);
+	PX4_INFO("%s: %u items in %.3f ms (%.2f M items/s)", use_force ? "force" : "put",
+		 received, elapsed / 1e3, (elapsed > 0) ? (double)received / elapsed : 0.0);
+
+	delete buffer;
+
+	ut_assert_true(ok);
+
+	if (!use_force) {
+		ut_compare("all items received", received, NUM_ITEMS);
+	}
+
+	return true;
+}
+
+bool SpscRingBufferTest::test_contention()
+{
+	return run_contention(false);
+}
+
+bool SpscRingBufferTest::test_contention_force()
+{
+	return run_contention(true);
+}
+
+ut_declare_test_c(test_SpscRingBuffer, SpscRingBufferTest)
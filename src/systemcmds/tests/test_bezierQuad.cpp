@@ -40,6 +40,7 @@
 #include <float.h>
 #include <stdlib.h>
 #include <time.h>
+#include <drivers/drv_hrt.h>
 
 #include "../../lib/bezier/BezierQuad.hpp"
 
@@ -53,6 +54,10 @@ private:
 	bool _get_states_from_time();
 	bool _get_arc_length();
 	bool _set_bez_from_vel();
+	bool _get_states_batch();
+	bool _get_arc_length_table();
+	bool _get_points_equidistant();
+	bool _benchmark_states();
 
 	float random(float min, float max);
 
@@ -64,6 +69,10 @@ bool BezierQuadTest::run_tests()
 	ut_run_test(_get_states_from_time);
 	ut_run_test(_get_arc_length);
 	ut_run_test(_set_bez_from_vel);
+	ut_run_test(_get_states_batch);
+	ut_run_test(_get_arc_length_table);
+	ut_run_test(_get_points_equidistant);
+	ut_run_test(_benchmark_states);
 
 	return (_tests_failed == 0);
 }
@@ -268,6 +277,159 @@ bool BezierQuadTest::_set_bez_from_vel()
 	return true;
 }
 
+bool BezierQuadTest::_get_states_batch()
+{
+	srand(200); // choose a constant to make it deterministic
+
+	static constexpr int N = 20;
+	float min = -50.f;
+	float max = 50.f;
+
+	for (int i = 0; i < 20; i++) {
+		matrix::Vector3f pt0(random(min, max), random(min, max), random(min, max));
+		matrix::Vector3f ctrl(random(min, max), random(min, max), random(min, max));
+		matrix::Vector3f pt1(random(min, max), random(min, max), random(min, max));
+		float duration = random(1.0f, 100.0f);
+
+		bezier::BezierQuad_f bz(pt0, ctrl, pt1, duration);
+
+		float t[N];
+		matrix::Vector3f pos[N], vel[N], acc[N];
+
+		for (int k = 0; k < N; k++) {
+			t[k] = duration * k / (N - 1);
+		}
+
+		bz.getStates(t, pos, vel, acc, N);
+
+		for (int k = 0; k < N; k++) {
+			// reference in Bernstein form
+			float u = t[k] / duration;
+			matrix::Vector3f pos_ref = pt0 * (1.f - u) * (1.f - u) + ctrl * 2.f * (1.f - u) * u + pt1 * u * u;
+			matrix::Vector3f vel_ref = ((ctrl - pt0) * (1.f - u) + (pt1 - ctrl) * u) * 2.f / duration;
+			matrix::Vector3f acc_ref = (pt0 - ctrl * 2.f + pt1) * 2.f / (duration * duration);
+
+			ut_assert_true((pos[k] - pos_ref).length() < 0.001f);
+			ut_assert_true((vel[k] - vel_ref).length() < 0.0001f);
+			ut_assert_true((acc[k] - acc_ref).length() < 0.0001f);
+
+			// batch and single evaluation must agree
+			ut_assert_true((pos[k] - bz.getPoint(t[k])).length() < 0.0001f);
+			ut_assert_true((vel[k] - bz.getVelocity(t[k])).length() < 0.0001f);
+		}
+
+		// outputs may be skipped
+		bz.getStates(t, pos, nullptr, nullptr, N);
+	}
+
+	return true;
+}
+
+bool BezierQuadTest::_get_arc_length_table()
+{
+	srand(300); // choose a constant to make it deterministic
+
+	float min = -50.f;
+	float max = 50.f;
+
+	for (int i = 0; i < 50; i++) {
+		matrix::Vector3f pt0(random(min, max), random(min, max), random(min, max));
+		matrix::Vector3f ctrl(random(min, max), random(min, max), random(min, max));
+		matrix::Vector3f pt1(random(min, max), random(min, max), random(min, max));
+		float duration = random(1.0f, 100.0f);
+
+		bezier::BezierQuad_f bz(pt0, ctrl, pt1, duration);
+
+		// total length from the lookup table must match the integrated arc length
+		float arc_length = bz.getArcLength(0.01f);
+		float arc_length_table = bz.getArcLengthAtTime(duration);
+		ut_assert_true(fabsf(arc_length - arc_length_table) < 0.001f * arc_length + 0.01f);
+
+		// arc length and time are inverse to each other
+		for (int k = 1; k < 10; k++) {
+			float s = arc_length_table * k / 10.f;
+			float t = bz.getTimeAtArcLength(s);
+			ut_assert_true(fabsf(bz.getArcLengthAtTime(t) - s) < 0.01f);
+		}
+	}
+
+	return true;
+}
+
+bool BezierQuadTest::_get_points_equidistant()
+{
+	// curve with strongly varying speed: it starts at rest
+	matrix::Vector3f pt0(0.0f, 0.0f, 0.0f);
+	matrix::Vector3f ctrl(0.0f, 0.0f, 0.0f);
+	matrix::Vector3f pt1(10.0f, 5.0f, 0.0f);
+
+	bezier::BezierQuad_f bz(pt0, ctrl, pt1, 2.0f);
+
+	static constexpr int N = 11;
+	matrix::Vector3f pos[N];
+	float t[N];
+	bz.getPointsEquidistant(pos, t, N);
+
+	ut_compare_float("first point not pt0", (pos[0] - pt0).length(), 0.0f, 0.001f);
+	ut_compare_float("last point not pt1", (pos[N - 1] - pt1).length(), 0.0f, 0.001f);
+
+	const float step = (pt1 - pt0).length() / (N - 1);
+
+	for (int k = 1; k < N; k++) {
+		ut_assert_true(t[k] > t[k - 1]);
+		ut_compare_float("points not equidistant", (pos[k] - pos[k - 1]).length(), step, 0.001f);
+	}
+
+	return true;
+}
+
+bool BezierQuadTest::_benchmark_states()
+{
+	static constexpr int N = 100;
+	static constexpr int ITERATIONS = 100;
+
+	matrix::Vector3f pt0(-5.0f, 0.0f, 1.0f);
+	matrix::Vector3f ctrl(0.0f, 5.0f, 2.0f);
+	matrix::Vector3f pt1(5.0f, 0.0f, 3.0f);
+	float duration = 3.0f;
+
+	bezier::BezierQuad_f bz(pt0, ctrl, pt1, duration);
+
+	float t[N];
+	matrix::Vector3f pos[N], vel[N];
+
+	for (int k = 0; k < N; k++) {
+		t[k] = duration * k / (N - 1);
+	}
+
+	// Bernstein form, one sample at a time
+	hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		for (int k = 0; k < N; k++) {
+			float u = t[k] / duration;
+			pos[k] = pt0 * (1.f - u) * (1.f - u) + ctrl * 2.f * (1.f - u) * u + pt1 * u * u;
+			vel[k] = ((ctrl - pt0) * (1.f - u) + (pt1 - ctrl) * u) * 2.f / duration;
+		}
+	}
+
+	hrt_abstime bernstein = hrt_elapsed_time(&start);
+
+	// polynomial form, batch
+	start = hrt_absolute_time();
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		bz.getStates(t, pos, vel, nullptr, N);
+	}
+
+	hrt_abstime batch = hrt_elapsed_time(&start);
+
+	PX4_INFO("%d states: Bernstein %.3f us, batch %.3f us", N, (double)bernstein / ITERATIONS,
+		 (double)batch / ITERATIONS);
+
+	return true;
+}
+
 float BezierQuadTest::random(float min, float max)
 {
 	float s = rand() / (float)RAND_MAX;
@@ -112,6 +112,7 @@ const struct {
 	{"servo",		test_servo,		OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"sleep",		test_sleep,		OPT_NOJIGTEST},
 	{"smoothz", 		test_smooth_z,		0},
+	{"SpscRingBuffer",	test_SpscRingBuffer,	0},
 	{"tone",		test_tone,		0},
 	{"uart_loopback",	test_uart_loopback,	OPT_NOJIGTEST | OPT_NOALLTEST},
 	{"uart_send",		test_uart_send,		OPT_NOJIGTEST | OPT_NOALLTEST},
@@ -78,6 +78,7 @@ extern int test_search_min(int argc, char *argv[]);
 extern int test_servo(int argc, char *argv[]);
 extern int test_sleep(int argc, char *argv[]);
 extern int test_smooth_z(int argc, char *argv[]);
+extern int test_SpscRingBuffer(int argc, char *argv[]);
 extern int test_time(int argc, char *argv[]);
 extern int test_tone(int argc, char *argv[]);
 extern int test_uart_baudchange(int argc, char *argv[]);